@@ -1,3 +1,4 @@
 include(CMakeFindDependencyMacro)
 find_dependency(PostgreSQL)
+find_dependency(Threads)
 include("${CMAKE_CURRENT_LIST_DIR}/libpqxx-targets.cmake")
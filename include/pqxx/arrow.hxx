@@ -0,0 +1,419 @@
+/* Definitions for exporting query data as Apache Arrow arrays.
+ *
+ * Fills arrays in the Arrow C Data Interface format, without linking Arrow.
+ *
+ * DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/arrow instead.
+ *
+ * Copyright (c) 2000-2026, Jeroen T. Vermeulen.
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this
+ * mistake, or contact the author.
+ */
+#ifndef PQXX_ARROW_HXX
+#define PQXX_ARROW_HXX
+
+#if !defined(PQXX_HEADER_PRE)
+#  error "Include libpqxx headers as <pqxx/header>, not <pqxx/header.hxx>."
+#endif
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "pqxx/result.hxx"
+#include "pqxx/row_schema.hxx"
+
+
+// The Arrow C Data Interface structs, exactly as the Arrow specification
+// defines them.  Any other library that defines them uses the same guard.
+#ifndef ARROW_C_DATA_INTERFACE
+#  define ARROW_C_DATA_INTERFACE
+
+#  define ARROW_FLAG_DICTIONARY_ORDERED 1
+#  define ARROW_FLAG_NULLABLE 2
+#  define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+struct ArrowSchema
+{
+  // Array type description
+  char const *format;
+  char const *name;
+  char const *metadata;
+  std::int64_t flags;
+  std::int64_t n_children;
+  struct ArrowSchema **children;
+  struct ArrowSchema *dictionary;
+
+  // Release callback
+  void (*release)(struct ArrowSchema *);
+  // Opaque producer-specific data
+  void *private_data;
+};
+
+struct ArrowArray
+{
+  // Array data description
+  std::int64_t length;
+  std::int64_t null_count;
+  std::int64_t offset;
+  std::int64_t n_buffers;
+  std::int64_t n_children;
+  void const **buffers;
+  struct ArrowArray **children;
+  struct ArrowArray *dictionary;
+
+  // Release callback
+  void (*release)(struct ArrowArray *);
+  // Opaque producer-specific data
+  void *private_data;
+};
+// NOLINTEND(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+#endif // ARROW_C_DATA_INTERFACE
+
+
+namespace pqxx::internal
+{
+/// Strip a `std::optional` off a type, if it has one.
+template<typename TYPE> struct arrow_value final
+{
+  using type = TYPE;
+};
+
+template<typename TYPE> struct arrow_value<std::optional<TYPE>> final
+{
+  using type = TYPE;
+};
+
+
+/// Arrow format string for values of C++ type `TYPE`.
+template<typename TYPE> consteval char const *arrow_format()
+{
+  if constexpr (std::is_same_v<TYPE, bool>)
+    return "b";
+  else if constexpr (
+    std::is_integral_v<TYPE> and not std::is_same_v<TYPE, char>)
+  {
+    constexpr bool is_signed{std::is_signed_v<TYPE>};
+    if constexpr (sizeof(TYPE) == 1)
+      return is_signed ? "c" : "C";
+    else if constexpr (sizeof(TYPE) == 2)
+      return is_signed ? "s" : "S";
+    else if constexpr (sizeof(TYPE) == 4)
+      return is_signed ? "i" : "I";
+    else
+    {
+      static_assert(sizeof(TYPE) == 8, "Unsupported integer size for Arrow.");
+      return is_signed ? "l" : "L";
+    }
+  }
+  else if constexpr (std::is_same_v<TYPE, float>)
+    return "f";
+  else if constexpr (std::is_same_v<TYPE, double>)
+    return "g";
+  else if constexpr (
+    std::is_same_v<TYPE, bytes> or std::is_same_v<TYPE, bytes_view>)
+    return "z";
+  else
+  {
+    static_assert(
+      std::is_convertible_v<TYPE const &, std::string_view>,
+      "No Arrow type for this C++ type.");
+    return "u";
+  }
+}
+
+
+/// One column of an Arrow export, under construction.
+struct arrow_column final
+{
+  /// How does the column store its values?
+  enum class layout
+  {
+    /// One bit per value.
+    boolean,
+    /// A fixed number of bytes per value.
+    fixed,
+    /// Offsets into a buffer of bytes.
+    variable,
+  };
+
+  arrow_column(std::string_view col_name, char const *col_format);
+
+  std::string name;
+  char const *format;
+  layout kind;
+  /// For fixed-width values: bytes per value.
+  std::size_t width{0};
+
+  /// Number of values so far.
+  std::int64_t length{0};
+  /// Number of null values so far.
+  std::int64_t null_count{0};
+  /// One bit per value, set if the value is not null.
+  std::vector<std::uint8_t> validity;
+  /// The values themselves, or the bytes of all variable-length values.
+  std::vector<std::byte> data;
+  /// For variable-length values: where each value starts, plus the end.
+  std::vector<std::int32_t> offsets;
+};
+
+
+/// Untyped column buffers for an Arrow export.
+/** This does the work that does not depend on the C++ types: building up the
+ * buffers, and handing them over in the Arrow C Data Interface format.
+ */
+class PQXX_LIBEXPORT arrow_columns final
+{
+public:
+  void add_column(std::string_view name, char const *format);
+
+  /// Number of complete rows so far.
+  [[nodiscard]] std::int64_t rows() const noexcept { return m_rows; }
+
+  /// Start a new value: grow the validity bitmap if needed, and mark it.
+  void start_value(std::size_t col, bool valid)
+  {
+    auto &c{m_columns[col]};
+    auto const bit{static_cast<std::size_t>(c.length % 8)};
+    if (bit == 0)
+    {
+      c.validity.push_back(0u);
+      if (c.kind == arrow_column::layout::boolean)
+        c.data.push_back(std::byte{0});
+    }
+    if (valid)
+      c.validity.back() |= static_cast<std::uint8_t>(1u << bit);
+    else
+      ++c.null_count;
+  }
+
+  void append_null(std::size_t col)
+  {
+    start_value(col, false);
+    auto &c{m_columns[col]};
+    switch (c.kind)
+    {
+    case arrow_column::layout::boolean: break;
+    case arrow_column::layout::fixed:
+      c.data.resize(std::size(c.data) + c.width);
+      break;
+    case arrow_column::layout::variable:
+      c.offsets.push_back(c.offsets.back());
+      break;
+    }
+    ++c.length;
+  }
+
+  void append_bool(std::size_t col, bool value)
+  {
+    start_value(col, true);
+    auto &c{m_columns[col]};
+    if (value)
+      c.data.back() |= std::byte{1} << static_cast<int>(c.length % 8);
+    ++c.length;
+  }
+
+  template<typename TYPE> void append_fixed(std::size_t col, TYPE value)
+  {
+    start_value(col, true);
+    auto &c{m_columns[col]};
+    auto const here{std::size(c.data)};
+    c.data.resize(here + sizeof(value));
+    std::memcpy(std::data(c.data) + here, &value, sizeof(value));
+    ++c.length;
+  }
+
+  void append_bytes(std::size_t col, bytes_view value, sl loc);
+
+  /// Mark the end of a row.  Call this after appending a value to each column.
+  void end_row() noexcept { ++m_rows; }
+
+  /// Undo any values past the last complete row.
+  void truncate() noexcept;
+
+  /// Describe the columns.
+  void export_schema(ArrowSchema *out) const;
+
+  /// Hand over the rows so far as a struct array, and start afresh.
+  void export_chunk(ArrowArray *out);
+
+private:
+  std::vector<arrow_column> m_columns;
+  std::int64_t m_rows{0};
+};
+} // namespace pqxx::internal
+
+
+namespace pqxx
+{
+/// Build Apache Arrow arrays from query data, in chunks.
+/** This fills arrays in the Arrow C Data Interface format, which any Arrow
+ * implementation in the same process can take over without copying the data.
+ * It does not need the Arrow library itself.  For the details, see
+ * https://arrow.apache.org/docs/format/CDataInterface.html
+ *
+ * The template arguments are the C++ types of the respective columns.  Each
+ * maps to an Arrow type:
+ * * `bool` becomes a boolean.
+ * * An integral type becomes a signed or unsigned integer of the same size.
+ * * `float` and `double` become floating-point numbers of the same size.
+ * * `bytes` and `bytes_view` become binary data.
+ * * Any type that converts to `std::string_view` becomes UTF-8 text.
+ * * A `std::optional` of any of these becomes the same type, but nullable.
+ *
+ * To read a large query, stream it using @ref transaction_base::stream with
+ * the same types, and pass each row to @ref append.  Every so often, call
+ * @ref export_chunk to hand over the rows you have so far as one batch.  For
+ * text, use `std::string_view` so that the values go straight from the stream
+ * into the Arrow buffers.
+ *
+ * All columns are nullable in the Arrow schema, but if a column's type can't
+ * be null, then of course it will not contain any nulls.
+ *
+ * The text and binary columns use 32-bit offsets, so one chunk can't hold
+ * more than 2 GiB of data in any one such column.
+ */
+template<typename... TYPE> class arrow_builder final
+{
+public:
+  using value_type = std::tuple<TYPE...>;
+
+  /// Number of columns.
+  static constexpr row_size_type width{sizeof...(TYPE)};
+
+  /// Build arrays with the given column names.
+  explicit arrow_builder(
+    std::array<std::string_view, sizeof...(TYPE)> const &names)
+  {
+    add_columns(names, std::index_sequence_for<TYPE...>{});
+  }
+
+  /// Build arrays with the same column names as `res`.
+  /** @throw usage_error if `res` does not have `sizeof...(TYPE)` columns.
+   */
+  explicit arrow_builder(result const &res, sl loc = sl::current()) :
+          arrow_builder{column_names(res, loc)}
+  {}
+
+  /// Number of rows in the current chunk.
+  [[nodiscard]] std::int64_t rows() const noexcept
+  {
+    return m_columns.rows();
+  }
+
+  /// Append one row, e.g. from a @ref transaction_base::stream.
+  /** @throw range_error if a text or binary column grows beyond 2 GiB in the
+   * current chunk.
+   */
+  void append(value_type const &row, sl loc = sl::current())
+  {
+    try
+    {
+      append_row(row, std::index_sequence_for<TYPE...>{}, loc);
+    }
+    catch (...)
+    {
+      m_columns.truncate();
+      throw;
+    }
+    m_columns.end_row();
+  }
+
+  /// Append all rows of `res`.
+  /** @throw usage_error if `res` does not have `sizeof...(TYPE)` columns.
+   * @throw conversion_error if a field does not convert to its C++ type.
+   */
+  void append(result const &res, sl loc = sl::current())
+  {
+    row_schema<TYPE...> const schema{res, loc};
+    value_type row;
+    for (result_size_type row_num{0}, end{res.size()}; row_num < end;
+         ++row_num)
+    {
+      schema.read(row_num, row, loc);
+      append(row, loc);
+    }
+  }
+
+  /// Describe the columns as an Arrow struct type.
+  /** This fills in `*out`.  The Arrow C Data Interface makes you, or the
+   * library you pass it to, responsible for releasing it.
+   */
+  void export_schema(ArrowSchema *out) const
+  {
+    m_columns.export_schema(out);
+  }
+
+  /// Hand over all rows so far as an Arrow struct array.
+  /** This fills in `*out`, without copying the data.  The builder then starts
+   * on a new chunk.  The Arrow C Data Interface makes you, or the library you
+   * pass it to, responsible for releasing the array.
+   */
+  void export_chunk(ArrowArray *out) { m_columns.export_chunk(out); }
+
+private:
+  static std::array<std::string_view, sizeof...(TYPE)>
+  column_names(result const &res, sl loc)
+  {
+    res.expect_columns(width, loc);
+    std::array<std::string_view, sizeof...(TYPE)> names;
+    for (row_size_type col{0}; col < width; ++col)
+      names.at(static_cast<std::size_t>(col)) = res.column_name(col, loc);
+    return names;
+  }
+
+  template<std::size_t... COL>
+  void add_columns(
+    std::array<std::string_view, sizeof...(TYPE)> const &names,
+    std::index_sequence<COL...>)
+  {
+    (m_columns.add_column(
+       std::get<COL>(names),
+       internal::arrow_format<typename internal::arrow_value<
+         std::tuple_element_t<COL, value_type>>::type>()),
+     ...);
+  }
+
+  template<std::size_t... COL>
+  void
+  append_row(value_type const &row, std::index_sequence<COL...>, sl loc)
+  {
+    (append_value(COL, std::get<COL>(row), loc), ...);
+  }
+
+  template<typename VALUE>
+  void append_value(std::size_t col, std::optional<VALUE> const &value, sl loc)
+  {
+    if (value.has_value())
+      append_value(col, *value, loc);
+    else
+      m_columns.append_null(col);
+  }
+
+  template<typename VALUE>
+  void append_value(std::size_t col, VALUE const &value, sl loc)
+  {
+    if constexpr (std::is_same_v<VALUE, bool>)
+      m_columns.append_bool(col, value);
+    else if constexpr (std::is_arithmetic_v<VALUE>)
+      m_columns.append_fixed(col, value);
+    else if constexpr (
+      std::is_same_v<VALUE, bytes> or std::is_same_v<VALUE, bytes_view>)
+      m_columns.append_bytes(col, value, loc);
+    else
+      m_columns.append_bytes(col, binary_cast(std::string_view{value}), loc);
+  }
+
+  internal::arrow_columns m_columns;
+};
+} // namespace pqxx
+#endif
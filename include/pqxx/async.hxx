@@ -0,0 +1,468 @@
+/* Coroutine-based asynchronous query execution.
+ *
+ * DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/async instead.
+ *
+ * Copyright (c) 2000-2026, Jeroen T. Vermeulen.
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this
+ * mistake, or contact the author.
+ */
+#ifndef PQXX_ASYNC_HXX
+#define PQXX_ASYNC_HXX
+
+#if !defined(PQXX_HEADER_PRE)
+#  error "Include libpqxx headers as <pqxx/header>, not <pqxx/header.hxx>."
+#endif
+
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <list>
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "pqxx/except.hxx"
+#include "pqxx/transaction_base.hxx"
+
+
+namespace pqxx::internal
+{
+/// The parts of a @ref pqxx::task's promise that don't depend on its type.
+class task_promise_base
+{
+public:
+  /// When a task finishes, resume the coroutine that was waiting for it.
+  struct final_awaiter final
+  {
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+    template<typename PROMISE>
+    std::coroutine_handle<>
+    await_suspend(std::coroutine_handle<PROMISE> h) const noexcept
+    {
+      auto const next{h.promise().m_continuation};
+      if (next)
+        return next;
+      else
+        return std::noop_coroutine();
+    }
+    void await_resume() const noexcept {}
+  };
+
+  // A task does not start until something awaits it, or starts it.
+  [[nodiscard]] std::suspend_always initial_suspend() const noexcept
+  {
+    return {};
+  }
+  [[nodiscard]] final_awaiter final_suspend() const noexcept { return {}; }
+  void unhandled_exception() noexcept { m_error = std::current_exception(); }
+
+  /// Set the coroutine to resume once the task is done.
+  void set_continuation(std::coroutine_handle<> next) noexcept
+  {
+    m_continuation = next;
+  }
+
+protected:
+  /// Rethrow the exception that the coroutine exited with, if any.
+  void check() const
+  {
+    if (m_error)
+      std::rethrow_exception(m_error);
+  }
+
+private:
+  std::coroutine_handle<> m_continuation;
+  std::exception_ptr m_error;
+};
+
+
+/// The promise type for a @ref pqxx::task producing a `T`.
+template<typename T> class task_promise final : public task_promise_base
+{
+public:
+  [[nodiscard]] task<T> get_return_object() noexcept;
+
+  template<typename V>
+    requires std::convertible_to<V, T>
+  void return_value(V &&value)
+  {
+    m_value.emplace(std::forward<V>(value));
+  }
+
+  /// Return the task's outcome: its value, or the exception it threw.
+  T take()
+  {
+    check();
+    return std::move(*m_value);
+  }
+
+private:
+  std::optional<T> m_value;
+};
+
+
+template<> class task_promise<void> final : public task_promise_base
+{
+public:
+  [[nodiscard]] task<void> get_return_object() noexcept;
+
+  void return_void() const noexcept {}
+
+  void take() const { check(); }
+};
+} // namespace pqxx::internal
+
+
+namespace pqxx
+{
+/// An asynchronous operation producing a `T`, for use in coroutines.
+/** A `task` is the return type for a coroutine.  It does not start running
+ * until you `co_await` it from another coroutine, or call @ref start on it.
+ * At the top level, which is not a coroutine, you can pass a task to an
+ * @ref event_loop to run it.
+ *
+ * A `task` owns its coroutine.  Destroying the task destroys the coroutine,
+ * so don't destroy a task while it is waiting for something.
+ */
+template<typename T = void> class task final
+{
+public:
+  using promise_type = internal::task_promise<T>;
+
+  task() = delete;
+  task(task const &) = delete;
+  task(task &&other) noexcept :
+          m_handle{std::exchange(other.m_handle, {})},
+          m_started{other.m_started}
+  {}
+  task &operator=(task const &) = delete;
+  task &operator=(task &&other) noexcept
+  {
+    if (this != &other)
+    {
+      if (m_handle)
+        m_handle.destroy();
+      m_handle = std::exchange(other.m_handle, {});
+      m_started = other.m_started;
+    }
+    return *this;
+  }
+
+  ~task() noexcept
+  {
+    if (m_handle)
+      m_handle.destroy();
+  }
+
+  /// Has the task finished?
+  [[nodiscard]] bool done() const noexcept
+  {
+    return not m_handle or m_handle.done();
+  }
+
+  /// Start running the task, if it has not started yet.
+  /** Runs the task until it completes, or until it first needs to wait.
+   * You'll only need this if you're driving tasks without a coroutine, e.g.
+   * when you write your own @ref event_loop.
+   */
+  void start()
+  {
+    if (not m_started)
+    {
+      m_started = true;
+      m_handle.resume();
+    }
+  }
+
+  /// Get the task's result, or rethrow the exception it exited with.
+  /** The task must be done.  Call this only once.
+   */
+  T get(sl loc = sl::current())
+  {
+    if (not done())
+      throw usage_error{"Getting the result of a task that is not done.", loc};
+    return m_handle.promise().take();
+  }
+
+  /// Wait for the task to finish, and get its result.
+  [[nodiscard]] auto operator co_await() noexcept { return awaiter{*this}; }
+
+private:
+  friend promise_type;
+
+  explicit task(std::coroutine_handle<promise_type> h) noexcept : m_handle{h}
+  {}
+
+  struct awaiter final
+  {
+    task &home;
+
+    [[nodiscard]] bool await_ready() const noexcept { return home.done(); }
+
+    std::coroutine_handle<>
+    await_suspend(std::coroutine_handle<> waiter) const noexcept
+    {
+      home.m_handle.promise().set_continuation(waiter);
+      if (home.m_started)
+        return std::noop_coroutine();
+      home.m_started = true;
+      return home.m_handle;
+    }
+
+    T await_resume() const { return home.m_handle.promise().take(); }
+  };
+
+  std::coroutine_handle<promise_type> m_handle;
+  bool m_started = false;
+};
+
+
+/// Interface between libpqxx's coroutines and an event loop.
+/** When a libpqxx coroutine needs to wait for its connection's socket, it
+ * calls @ref wait_for, and suspends.  The event loop must resume it once the
+ * socket is ready.
+ *
+ * To run libpqxx's coroutines on an event loop of your choice (Asio, libuv,
+ * etc.), derive a class from `event_loop` and implement @ref wait_for.
+ * Otherwise, use @ref epoll_loop.
+ */
+class PQXX_LIBEXPORT event_loop
+{
+public:
+  /// A suspension point: wait for a socket to become ready.
+  struct fd_awaiter final
+  {
+    event_loop &loop;
+    int fd;
+    bool read;
+    bool write;
+    sl loc;
+
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) const
+    {
+      loop.wait_for(fd, read, write, h, loc);
+    }
+    void await_resume() const noexcept {}
+  };
+
+  event_loop() = default;
+  event_loop(event_loop const &) = delete;
+  event_loop &operator=(event_loop const &) = delete;
+  virtual ~event_loop() noexcept;
+
+  /// Resume `h` once `fd` is ready for reading or writing.
+  /** If `read` is set, resume `h` when `fd` has data to read.  If `write` is
+   * set, resume `h` when `fd` can take data to write.  If both are set,
+   * resume `h` when either is the case.
+   *
+   * The event loop must not resume `h` from inside this call.  It resumes
+   * `h` only once, and there's only ever one coroutine waiting for any given
+   * socket.
+   */
+  virtual void wait_for(
+    int fd, bool read, bool write, std::coroutine_handle<> h, sl loc) = 0;
+
+  /// `co_await` this to wait until `fd` has data to read.
+  [[nodiscard]] fd_awaiter readable(int fd, sl loc = sl::current()) noexcept
+  {
+    return {*this, fd, true, false, loc};
+  }
+
+  /// `co_await` this to wait until `fd` can take data to write.
+  [[nodiscard]] fd_awaiter writable(int fd, sl loc = sl::current()) noexcept
+  {
+    return {*this, fd, false, true, loc};
+  }
+
+  /// `co_await` this to wait until `fd` can either read or write.
+  [[nodiscard]] fd_awaiter
+  readable_or_writable(int fd, sl loc = sl::current()) noexcept
+  {
+    return {*this, fd, true, true, loc};
+  }
+
+  /// Start running `t` in the background.
+  /** The event loop keeps the task until it's done.  If it fails, the next
+   * call to @ref reap rethrows its exception.
+   */
+  void spawn(task<> &&t);
+
+protected:
+  /// Clean up spawned tasks that have finished.
+  /** If any of them failed, rethrows the first one's exception.
+   */
+  void reap();
+
+  /// Number of spawned tasks that have not been reaped yet.
+  [[nodiscard]] std::size_t running() const noexcept
+  {
+    return std::size(m_tasks);
+  }
+
+private:
+  std::list<task<>> m_tasks;
+};
+
+
+/// Simple @ref event_loop based on Linux's `epoll`.
+/** This is a reference implementation, for use in a single thread.  You could
+ * run one per thread, each with its own connections.
+ *
+ * On systems without `epoll`, constructing one throws
+ * @ref feature_not_supported.
+ */
+class PQXX_LIBEXPORT epoll_loop final : public event_loop
+{
+public:
+  explicit epoll_loop(sl = sl::current());
+  ~epoll_loop() noexcept override;
+
+  void wait_for(
+    int fd, bool read, bool write, std::coroutine_handle<> h,
+    sl loc) override;
+
+  /// Run until all tasks passed to @ref spawn have finished.
+  /** If a task fails, rethrows its exception.  The other tasks stay where
+   * they are, and you can call `run()` again to continue.
+   */
+  void run(sl = sl::current());
+
+  /// Run `t` to completion, and return its result.
+  /** Any tasks passed to @ref spawn run alongside it.
+   */
+  template<typename T> T run(task<T> t, sl loc = sl::current())
+  {
+    t.start();
+    while (not t.done()) step(loc);
+    return t.get(loc);
+  }
+
+private:
+  /// Wait for socket events, and resume the coroutines waiting for them.
+  void step(sl);
+
+  /// The `epoll` file descriptor.
+  int m_fd = -1;
+
+  /// Coroutines waiting for sockets, by socket.
+  std::map<int, std::coroutine_handle<>> m_waiting;
+};
+} // namespace pqxx
+
+
+namespace pqxx::internal
+{
+template<typename T>
+inline task<T> task_promise<T>::get_return_object() noexcept
+{
+  return task<T>{std::coroutine_handle<task_promise>::from_promise(*this)};
+}
+
+
+inline task<void> task_promise<void>::get_return_object() noexcept
+{
+  return task<void>{std::coroutine_handle<task_promise>::from_promise(*this)};
+}
+
+
+/// Stream query results asynchronously.  Used by `async_stream()`.
+/** This wraps a @ref stream_query, and suspends the calling coroutine whenever
+ * it needs to wait for data.
+ *
+ * Any `std::string_view` or @ref zview fields in a row remain valid only until
+ * your next call to @ref next.
+ */
+template<typename... TYPE> class async_stream_query final
+{
+public:
+  async_stream_query(
+    transaction_base &tx, event_loop &loop, result const &started,
+    result const &described, conversion_context c, format fmt) :
+          m_loop{&loop},
+          m_sock{tx.conn().sock()},
+          m_stream{std::make_unique<stream_query<TYPE...>>(
+            tx, started, described, c, fmt)}
+  {}
+
+  /// Read the next row.  At the end of the data, returns an empty optional.
+  task<std::optional<std::tuple<TYPE...>>> next(sl loc = sl::current()) &
+  {
+    for (;;)
+    {
+      if (auto row{m_stream->try_read_row(loc)})
+        co_return std::move(row);
+      if (m_stream->done())
+        co_return std::optional<std::tuple<TYPE...>>{};
+      co_await m_loop->readable(m_sock, loc);
+    }
+  }
+
+  /// Has this stream reached the end of its data?
+  [[nodiscard]] bool done() const noexcept { return m_stream->done(); }
+
+private:
+  event_loop *m_loop;
+  int m_sock;
+  std::unique_ptr<stream_query<TYPE...>> m_stream;
+};
+
+
+/// Wait for `pending`, and iterate its result.
+template<typename... TYPE>
+inline task<result_iteration<row_schema<TYPE...>>>
+iterate_async(task<result> pending)
+{
+  result const res{co_await pending};
+  co_return res.iter<TYPE...>();
+}
+
+
+/// Ask the server what columns `query` produces, without executing it.
+/** This is the asynchronous version of what a binary @ref stream_query does
+ * when it reads into strings.  Costs two round trips.
+ */
+PQXX_LIBEXPORT task<result> async_describe(
+  transaction_base &tx, event_loop &loop, std::string query, sl loc);
+
+
+/// Start a `COPY` for `query`, then stream its data.
+template<typename... TYPE>
+inline task<async_stream_query<TYPE...>> start_async_stream(
+  transaction_base &tx, event_loop &loop, std::string query,
+  conversion_context c, format fmt)
+{
+  result described;
+  if (stream_query<TYPE...>::needs_types(fmt))
+    described = co_await async_describe(tx, loop, query, c.loc);
+  result const started{co_await tx.async_exec(
+    loop, stream_query<TYPE...>::copy_query(query, fmt), c.loc)};
+  co_return async_stream_query<TYPE...>{
+    tx, loop, started, described, c, fmt};
+}
+} // namespace pqxx::internal
+
+
+template<typename... TYPE>
+inline pqxx::task<
+  pqxx::internal::result_iteration<pqxx::row_schema<TYPE...>>>
+pqxx::transaction_base::async_query(
+  event_loop &loop, std::string_view query, params const &parms, sl loc)
+{
+  return internal::iterate_async<TYPE...>(
+    async_exec(loop, query, parms, loc));
+}
+
+
+template<std::move_constructible... TYPE>
+inline pqxx::task<pqxx::internal::async_stream_query<TYPE...>>
+pqxx::transaction_base::async_stream(
+  event_loop &loop, std::string_view query, format fmt, sl loc)
+{
+  return internal::start_async_stream<TYPE...>(
+    *this, loop, std::string{query}, make_context(loc), fmt);
+}
+#endif
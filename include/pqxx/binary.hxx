@@ -0,0 +1,713 @@
+/* Decoding of values in PostgreSQL's binary format.
+ *
+ * DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/binary instead.
+ *
+ * Copyright (c) 2000-2026, Jeroen T. Vermeulen.
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this
+ * mistake, or contact the author.
+ */
+#ifndef PQXX_BINARY_HXX
+#define PQXX_BINARY_HXX
+
+#if !defined(PQXX_HEADER_PRE)
+#  error "Include libpqxx headers as <pqxx/header>, not <pqxx/header.hxx>."
+#endif
+
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pqxx/strconv.hxx"
+#include "pqxx/types.hxx"
+#include "pqxx/util.hxx"
+
+
+namespace pqxx::internal
+{
+/// OIDs of the built-in types that libpqxx can read in binary format.
+/** These are fixed in PostgreSQL's system catalogue; they never change.
+ */
+//@{
+inline constexpr oid oid_bool{16};
+inline constexpr oid oid_bytea{17};
+inline constexpr oid oid_char{18};
+inline constexpr oid oid_name{19};
+inline constexpr oid oid_int8{20};
+inline constexpr oid oid_int2{21};
+inline constexpr oid oid_int4{23};
+inline constexpr oid oid_text{25};
+inline constexpr oid oid_oid{26};
+inline constexpr oid oid_json{114};
+inline constexpr oid oid_float4{700};
+inline constexpr oid oid_float8{701};
+inline constexpr oid oid_unknown{705};
+inline constexpr oid oid_bpchar{1042};
+inline constexpr oid oid_varchar{1043};
+inline constexpr oid oid_date{1082};
+inline constexpr oid oid_timestamp{1114};
+inline constexpr oid oid_timestamptz{1184};
+inline constexpr oid oid_numeric{1700};
+inline constexpr oid oid_uuid{2950};
+inline constexpr oid oid_jsonb{3802};
+//@}
+
+
+/// Throw @ref conversion_error: can't read a value of type `oid` as `TYPE`.
+[[noreturn]] PQXX_COLD PQXX_LIBEXPORT void throw_binary_mismatch(
+  std::string_view type_name, oid type, std::size_t size, sl);
+
+
+/// Throw @ref conversion_error: there is no binary decoder for this type.
+[[noreturn]] PQXX_COLD PQXX_LIBEXPORT void
+throw_no_binary_decoder(std::string_view type_name, sl);
+
+
+/// Throw @ref conversion_error: there is no binary encoder for this type.
+[[noreturn]] PQXX_COLD PQXX_LIBEXPORT void
+throw_no_binary_encoder(std::string_view type_name, sl);
+
+
+/// Throw @ref conversion_error: this type can only be read in binary format.
+[[noreturn]] PQXX_COLD PQXX_LIBEXPORT void
+throw_binary_only(std::string_view type_name, sl);
+
+
+/// Render a binary `numeric` value in PostgreSQL's text format.
+[[nodiscard]] PQXX_LIBEXPORT std::string
+numeric_to_string(bytes_view data, sl);
+
+
+/// Render a binary `uuid` value in PostgreSQL's text format.
+[[nodiscard]] PQXX_LIBEXPORT std::string uuid_to_string(bytes_view data, sl);
+
+
+/// Read a big-endian ("network byte order") integer from `data`.
+/** The caller must ensure that there are at least `sizeof(INT)` bytes.
+ */
+template<std::integral INT>
+[[nodiscard]] PQXX_PURE inline INT read_big_endian(std::byte const *data)
+{
+  using unsigned_type = std::make_unsigned_t<INT>;
+  unsigned_type value{0};
+  for (std::size_t i{0}; i < sizeof(INT); ++i)
+    value = static_cast<unsigned_type>(
+      (value << 8u) | static_cast<unsigned_type>(data[i]));
+  return static_cast<INT>(value);
+}
+
+
+/// Append `value` to `out` as a big-endian integer.
+template<std::integral INT>
+inline void append_big_endian(std::string &out, INT value)
+{
+  using unsigned_type = std::make_unsigned_t<INT>;
+  auto const bits{static_cast<unsigned_type>(value)};
+  for (auto shift{8 * sizeof(INT)}; shift > 0u;)
+  {
+    shift -= 8;
+    out.push_back(static_cast<char>((bits >> shift) & 0xffu));
+  }
+}
+
+
+/// Overwrite the bytes at `here` with `value` as a big-endian integer.
+/** The caller must ensure that there is room for `sizeof(INT)` bytes.
+ */
+template<std::integral INT> inline void store_big_endian(char *here, INT value)
+{
+  using unsigned_type = std::make_unsigned_t<INT>;
+  auto const bits{static_cast<unsigned_type>(value)};
+  for (std::size_t i{0}; i < sizeof(INT); ++i)
+    here[i] = static_cast<char>(
+      (bits >> (8 * (sizeof(INT) - 1 - i))) & 0xffu);
+}
+
+
+/// Read a binary integer of type `int2`, `int4`, `int8`, or `oid`.
+/** @return The value, in the largest integral type that fits all of those.
+ * The `bool` in the pair says whether it's unsigned (i.e., an `oid`).
+ */
+[[nodiscard]] inline std::pair<std::int64_t, bool>
+read_binary_integer(bytes_view data, oid type, std::string_view target, sl loc)
+{
+  switch (type)
+  {
+  case oid_int2:
+    if (std::size(data) == 2) [[likely]]
+      return {read_big_endian<std::int16_t>(std::data(data)), false};
+    break;
+  case oid_int4:
+    if (std::size(data) == 4) [[likely]]
+      return {read_big_endian<std::int32_t>(std::data(data)), false};
+    break;
+  case oid_int8:
+    if (std::size(data) == 8) [[likely]]
+      return {read_big_endian<std::int64_t>(std::data(data)), false};
+    break;
+  case oid_oid:
+    if (std::size(data) == 4) [[likely]]
+      return {read_big_endian<std::uint32_t>(std::data(data)), true};
+    break;
+  default: break;
+  }
+  throw_binary_mismatch(target, type, std::size(data), loc);
+}
+
+
+/// View binary data as a `std::string_view`.
+[[nodiscard]] inline std::string_view as_chars(bytes_view data) noexcept
+{
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  return {reinterpret_cast<char const *>(std::data(data)), std::size(data)};
+}
+
+
+/// Is `type` one whose binary representation is simply its text?
+[[nodiscard]] PQXX_PURE inline constexpr bool is_textual(oid type) noexcept
+{
+  switch (type)
+  {
+  case oid_char:
+  case oid_name:
+  case oid_text:
+  case oid_json:
+  case oid_unknown:
+  case oid_bpchar:
+  case oid_varchar: return true;
+  default: return false;
+  }
+}
+
+
+/// PostgreSQL's epoch for dates and timestamps: 2000-01-01, in Unix days.
+inline constexpr std::int64_t postgres_epoch_days{10957};
+} // namespace pqxx::internal
+
+
+namespace pqxx
+{
+/// Traits class for reading values in PostgreSQL's binary format.
+/** Results normally come in text format, and libpqxx converts them to C++
+ * types using @ref string_traits.  But if you execute a query asking for
+ * results in binary format, then @ref field::as() and friends will use
+ * `binary_traits` instead.
+ *
+ * A binary format is specific to the SQL type, so the decoder gets the
+ * column's type OID as well.  If the combination is not supported, it throws
+ * @ref conversion_error.
+ *
+ * To add binary support for your own type, specialise this template and give
+ * it a member function:
+ *
+ * ```cxx
+ * static TYPE from_binary(bytes_view data, oid type, ctx c);
+ * ```
+ *
+ * If you also want to write the type in binary format, e.g. to a
+ * @ref stream_to in binary mode, add a function that appends the binary
+ * representation of a non-null `value` to `out`:
+ *
+ * ```cxx
+ * static void into_binary(std::string &out, TYPE const &value, ctx c);
+ * ```
+ */
+template<typename TYPE> struct binary_traits;
+} // namespace pqxx
+
+
+namespace pqxx::internal
+{
+/// Concept: we have a @ref binary_traits specialisation for `TYPE`.
+template<typename TYPE>
+concept binary_decodable = requires(bytes_view data, oid type, ctx c) {
+  TYPE{binary_traits<TYPE>::from_binary(data, type, c)};
+};
+
+
+/// Concept: @ref binary_traits for `TYPE` can write binary data.
+template<typename TYPE>
+concept binary_encodable =
+  requires(std::string &out, TYPE const &value, ctx c) {
+    binary_traits<TYPE>::into_binary(out, value, c);
+  };
+
+
+/// Is `TYPE` one that we can only read from binary data, not from text?
+template<typename TYPE> inline constexpr bool binary_only{false};
+
+
+/// Base for @ref binary_traits specialisations for integral types.
+template<std::integral INT> struct integer_binary_traits
+{
+  [[nodiscard]] static INT from_binary(bytes_view data, oid type, ctx c)
+  {
+    if (type == oid_numeric)
+      return pqxx::from_string<INT>(numeric_to_string(data, c.loc), c);
+    auto const [value, is_unsigned]{
+      read_binary_integer(data, type, name_type<INT>(), c.loc)};
+    if (is_unsigned)
+      return check_cast<INT>(
+        static_cast<std::uint64_t>(value), name_type<INT>(), c.loc);
+    return check_cast<INT>(value, name_type<INT>(), c.loc);
+  }
+
+  /// Write as an SQL integer of the same size: `int2`, `int4`, or `int8`.
+  static void into_binary(std::string &out, INT value, ctx c)
+  {
+    static_assert(
+      (sizeof(INT) == 2) or (sizeof(INT) == 4) or (sizeof(INT) == 8),
+      "No SQL integer type of this size.");
+    append_big_endian(
+      out,
+      check_cast<std::make_signed_t<INT>>(value, name_type<INT>(), c.loc));
+  }
+};
+
+
+/// Base for @ref binary_traits specialisations for floating-point types.
+template<std::floating_point FLOAT> struct float_binary_traits
+{
+  [[nodiscard]] static FLOAT from_binary(bytes_view data, oid type, ctx c)
+  {
+    if ((type == oid_float8) and (std::size(data) == 8)) [[likely]]
+      return static_cast<FLOAT>(std::bit_cast<double>(
+        read_big_endian<std::uint64_t>(std::data(data))));
+    if ((type == oid_float4) and (std::size(data) == 4))
+      return static_cast<FLOAT>(std::bit_cast<float>(
+        read_big_endian<std::uint32_t>(std::data(data))));
+    if (type == oid_numeric)
+      return pqxx::from_string<FLOAT>(numeric_to_string(data, c.loc), c);
+    auto const [value, is_unsigned]{
+      read_binary_integer(data, type, name_type<FLOAT>(), c.loc)};
+    if (is_unsigned)
+      return static_cast<FLOAT>(static_cast<std::uint64_t>(value));
+    return static_cast<FLOAT>(value);
+  }
+
+  /// Write a `float` as `float4`, or a `double` or `long double` as `float8`.
+  static void into_binary(std::string &out, FLOAT value, ctx)
+  {
+    if constexpr (std::is_same_v<FLOAT, float>)
+      append_big_endian(out, std::bit_cast<std::uint32_t>(value));
+    else
+      append_big_endian(
+        out, std::bit_cast<std::uint64_t>(static_cast<double>(value)));
+  }
+};
+} // namespace pqxx::internal
+
+
+namespace pqxx
+{
+#define PQXX_SPECIALIZE_INT_BINARY_TRAIT(typ)                                 \
+  template<>                                                                  \
+  struct binary_traits<typ> final                                             \
+          : pqxx::internal::integer_binary_traits<typ>                        \
+  {}
+
+PQXX_SPECIALIZE_INT_BINARY_TRAIT(short);
+PQXX_SPECIALIZE_INT_BINARY_TRAIT(unsigned short);
+PQXX_SPECIALIZE_INT_BINARY_TRAIT(int);
+PQXX_SPECIALIZE_INT_BINARY_TRAIT(unsigned);
+PQXX_SPECIALIZE_INT_BINARY_TRAIT(long);
+PQXX_SPECIALIZE_INT_BINARY_TRAIT(unsigned long);
+PQXX_SPECIALIZE_INT_BINARY_TRAIT(long long);
+PQXX_SPECIALIZE_INT_BINARY_TRAIT(unsigned long long);
+
+#undef PQXX_SPECIALIZE_INT_BINARY_TRAIT
+
+
+template<>
+struct binary_traits<float> final : pqxx::internal::float_binary_traits<float>
+{};
+template<>
+struct binary_traits<double> final
+        : pqxx::internal::float_binary_traits<double>
+{};
+template<>
+struct binary_traits<long double> final
+        : pqxx::internal::float_binary_traits<long double>
+{};
+
+
+template<> struct binary_traits<bool> final
+{
+  [[nodiscard]] static bool from_binary(bytes_view data, oid type, ctx c)
+  {
+    if ((type != pqxx::internal::oid_bool) or (std::size(data) != 1))
+      [[unlikely]]
+      pqxx::internal::throw_binary_mismatch(
+        "bool", type, std::size(data), c.loc);
+    return data[0] != std::byte{0};
+  }
+
+  static void into_binary(std::string &out, bool value, ctx)
+  {
+    out.push_back(value ? '\1' : '\0');
+  }
+};
+
+
+/// Read a binary value as a string.
+/** This works for the text-like types, whose binary representation is simply
+ * the text; for `jsonb`; and for `numeric` and `uuid`, which get rendered in
+ * their usual text format.
+ */
+template<> struct binary_traits<std::string> final
+{
+  [[nodiscard]] static std::string
+  from_binary(bytes_view data, oid type, ctx c)
+  {
+    using namespace pqxx::internal;
+    if (is_textual(type)) [[likely]]
+      return std::string{as_chars(data)};
+    switch (type)
+    {
+    case oid_jsonb:
+      // A jsonb value starts with a version byte.  Version 1 is the only one
+      // so far, and it's followed by the JSON text.
+      if (not std::empty(data) and (data[0] == std::byte{1}))
+        return std::string{as_chars(data.subspan(1))};
+      break;
+    case oid_numeric: return numeric_to_string(data, c.loc);
+    case oid_uuid: return uuid_to_string(data, c.loc);
+    default: break;
+    }
+    throw_binary_mismatch(
+      name_type<std::string>(), type, std::size(data), c.loc);
+  }
+
+  /// Write as a text-like type.  This won't work for `jsonb`, `numeric` etc.
+  static void into_binary(std::string &out, std::string const &value, ctx)
+  {
+    out.append(value);
+  }
+};
+
+
+/// Read a text-like binary value as a `std::string_view`.
+/** The view points directly into the result's data, so it is only valid for
+ * as long as the @ref result object exists.
+ */
+template<> struct binary_traits<std::string_view> final
+{
+  [[nodiscard]] static std::string_view
+  from_binary(bytes_view data, oid type, ctx c)
+  {
+    if (not pqxx::internal::is_textual(type)) [[unlikely]]
+      pqxx::internal::throw_binary_mismatch(
+        name_type<std::string_view>(), type, std::size(data), c.loc);
+    return pqxx::internal::as_chars(data);
+  }
+
+  static void into_binary(std::string &out, std::string_view value, ctx)
+  {
+    out.append(value);
+  }
+};
+
+
+/// Read any binary value as raw bytes.
+/** This is the natural way to read a `bytea`, but you can also use it to get
+ * at the raw binary representation of any other type.
+ */
+template<binary DATA> struct binary_traits<DATA> final
+{
+  [[nodiscard]] static DATA from_binary(bytes_view data, oid, ctx c)
+  {
+    if constexpr (std::constructible_from<
+                    DATA, std::byte const *, std::byte const *>)
+      return DATA{std::data(data), std::data(data) + std::size(data)};
+    else if constexpr (std::constructible_from<
+                         DATA, std::byte const *, std::size_t>)
+      return DATA{std::data(data), std::size(data)};
+    else
+      pqxx::internal::throw_no_binary_decoder(name_type<DATA>(), c.loc);
+  }
+
+  static void into_binary(std::string &out, DATA const &value, ctx)
+  {
+    auto const view{binary_cast(value)};
+    out.append(pqxx::internal::as_chars(view));
+  }
+};
+
+
+#if defined(PQXX_HAVE_YEAR_MONTH_DAY)
+/// Read a binary `date` value.
+template<> struct binary_traits<std::chrono::year_month_day> final
+{
+  [[nodiscard]] static std::chrono::year_month_day
+  from_binary(bytes_view data, oid type, ctx c)
+  {
+    if ((type != pqxx::internal::oid_date) or (std::size(data) != 4))
+      [[unlikely]]
+      pqxx::internal::throw_binary_mismatch(
+        "date", type, std::size(data), c.loc);
+    auto const days{pqxx::internal::read_big_endian<std::int32_t>(
+      std::data(data))};
+    // PostgreSQL represents "infinity" and "-infinity" as extreme values.
+    if (
+      (days == (std::numeric_limits<std::int32_t>::max)()) or
+      (days == (std::numeric_limits<std::int32_t>::min)())) [[unlikely]]
+      throw conversion_error{"Can't convert infinite date.", c.loc};
+    return std::chrono::year_month_day{std::chrono::sys_days{
+      std::chrono::days{pqxx::internal::postgres_epoch_days + days}}};
+  }
+
+  static void into_binary(
+    std::string &out, std::chrono::year_month_day const &value, ctx c)
+  {
+    if (not value.ok()) [[unlikely]]
+      throw conversion_error{"Can't write invalid date.", c.loc};
+    auto const days{
+      std::chrono::sys_days{value}.time_since_epoch().count() -
+      pqxx::internal::postgres_epoch_days};
+    pqxx::internal::append_big_endian(
+      out, check_cast<std::int32_t>(days, std::string_view{"date"}, c.loc));
+  }
+};
+#endif // PQXX_HAVE_YEAR_MONTH_DAY
+
+
+/// Read a binary `timestamp` or `timestamp with time zone` value.
+/** Both types are stored as microseconds since 2000-01-01.  For a
+ * `timestamp with time zone`, that is in UTC.  For a `timestamp` without time
+ * zone, there is no time zone at all; it's up to you to interpret it.
+ *
+ * There is no conversion between this type and SQL text, so you can only read
+ * it from a result in binary format.
+ */
+template<>
+struct binary_traits<
+  std::chrono::sys_time<std::chrono::microseconds>> final
+{
+  using time_type = std::chrono::sys_time<std::chrono::microseconds>;
+
+  [[nodiscard]] static time_type from_binary(bytes_view data, oid type, ctx c)
+  {
+    if (
+      ((type != pqxx::internal::oid_timestamp) and
+       (type != pqxx::internal::oid_timestamptz)) or
+      (std::size(data) != 8)) [[unlikely]]
+      pqxx::internal::throw_binary_mismatch(
+        "timestamp", type, std::size(data), c.loc);
+    auto const micros{pqxx::internal::read_big_endian<std::int64_t>(
+      std::data(data))};
+    // PostgreSQL represents "infinity" and "-infinity" as extreme values.
+    if (
+      (micros == (std::numeric_limits<std::int64_t>::max)()) or
+      (micros == (std::numeric_limits<std::int64_t>::min)())) [[unlikely]]
+      throw conversion_error{"Can't convert infinite timestamp.", c.loc};
+    return time_type{
+      std::chrono::sys_days{
+        std::chrono::days{pqxx::internal::postgres_epoch_days}} +
+      std::chrono::microseconds{micros}};
+  }
+
+  static void into_binary(std::string &out, time_type const &value, ctx)
+  {
+    auto const epoch{std::chrono::sys_days{
+      std::chrono::days{pqxx::internal::postgres_epoch_days}}};
+    pqxx::internal::append_big_endian(
+      out, static_cast<std::int64_t>((value - epoch).count()));
+  }
+};
+
+
+template<typename T> struct nullness<std::chrono::sys_time<T>> final
+        : no_null<std::chrono::sys_time<T>>
+{};
+} // namespace pqxx
+
+
+namespace pqxx::internal
+{
+template<>
+inline constexpr bool
+  binary_only<std::chrono::sys_time<std::chrono::microseconds>>{true};
+} // namespace pqxx::internal
+
+
+namespace pqxx
+{
+
+/// Read a binary value into a `std::optional`.
+/** Nulls never get this far; @ref field::as() takes care of those.
+ */
+template<pqxx::internal::binary_decodable T>
+struct binary_traits<std::optional<T>> final
+{
+  [[nodiscard]] static std::optional<T>
+  from_binary(bytes_view data, oid type, ctx c)
+  {
+    return std::optional<T>{binary_traits<T>::from_binary(data, type, c)};
+  }
+
+  /// Write the contained value.  The caller must check for null first.
+  static void
+  into_binary(std::string &out, std::optional<T> const &value, ctx c)
+    requires pqxx::internal::binary_encodable<T>
+  {
+    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+    binary_traits<T>::into_binary(out, *value, c);
+  }
+};
+
+
+/// Read a one-dimensional binary SQL array into a `std::vector`.
+/** Null elements convert to the element type's null value.  If the element
+ * type has no null value, a null element will throw @ref conversion_error.
+ */
+template<pqxx::internal::binary_decodable T>
+  requires(not std::same_as<T, std::byte>)
+struct binary_traits<std::vector<T>> final
+{
+  [[nodiscard]] static std::vector<T>
+  from_binary(bytes_view data, oid type, ctx c)
+  {
+    using pqxx::internal::read_big_endian;
+    std::vector<T> out;
+
+    // Header: dimensions, flags, element type.  Then, per dimension: size and
+    // lower bound.  We only support one dimension (or zero, if empty).
+    constexpr std::size_t header{12}, dim_header{8}, elt_header{4};
+    if (std::size(data) < header) [[unlikely]]
+      pqxx::internal::throw_binary_mismatch(
+        name_type<std::vector<T>>(), type, std::size(data), c.loc);
+    auto const ndims{read_big_endian<std::int32_t>(std::data(data))};
+    auto const elt_type{read_big_endian<oid>(std::data(data) + 8)};
+    if (ndims == 0)
+      return out;
+    if (ndims != 1) [[unlikely]]
+      throw conversion_error{
+        std::format(
+          "Can't read {}-dimensional binary array into {}.", ndims,
+          name_type<std::vector<T>>()),
+        c.loc};
+    if (std::size(data) < header + dim_header) [[unlikely]]
+      pqxx::internal::throw_binary_mismatch(
+        name_type<std::vector<T>>(), type, std::size(data), c.loc);
+    auto const count{check_cast<std::size_t>(
+      read_big_endian<std::int32_t>(std::data(data) + header),
+      std::string_view{"binary array size"}, c.loc)};
+    out.reserve(count);
+
+    auto rest{data.subspan(header + dim_header)};
+    for (std::size_t i{0}; i < count; ++i)
+    {
+      if (std::size(rest) < elt_header) [[unlikely]]
+        throw conversion_error{"Binary array data is truncated.", c.loc};
+      auto const len{read_big_endian<std::int32_t>(std::data(rest))};
+      rest = rest.subspan(elt_header);
+      if (len < 0)
+      {
+        if constexpr (has_null<T>())
+          out.push_back(make_null<T>());
+        else
+          pqxx::internal::throw_null_conversion(name_type<T>(), c.loc);
+      }
+      else
+      {
+        auto const ulen{static_cast<std::size_t>(len)};
+        if (std::size(rest) < ulen) [[unlikely]]
+          throw conversion_error{"Binary array data is truncated.", c.loc};
+        out.push_back(
+          binary_traits<T>::from_binary(rest.first(ulen), elt_type, c));
+        rest = rest.subspan(ulen);
+      }
+    }
+    return out;
+  }
+};
+} // namespace pqxx
+
+
+namespace pqxx::internal
+{
+/// Is `TYPE` a `std::optional`?
+template<typename TYPE> inline constexpr bool is_optional{false};
+template<typename TYPE>
+inline constexpr bool is_optional<std::optional<TYPE>>{true};
+
+
+/// Does reading a binary value into `TYPE` depend on its actual SQL type?
+/** This is the case for the string types.  They accept only text-like SQL
+ * types, plus the few types that they know how to render as text.  Any
+ * other type has a binary representation that makes no sense as a string.
+ */
+template<typename TYPE>
+inline constexpr bool needs_sql_type{
+  std::same_as<TYPE, std::string> or std::same_as<TYPE, std::string_view>};
+template<typename TYPE>
+inline constexpr bool needs_sql_type<std::optional<TYPE>>{
+  needs_sql_type<TYPE>};
+
+
+/// Guess the SQL type of a binary value, given the C++ type we want.
+/** Binary `COPY` data does not say what SQL types its fields have.  So when
+ * reading a field from a binary `COPY` stream, we assume that its SQL type
+ * is the natural one for the C++ type to which we're converting it: an
+ * integer of the same size, a `float4` or `float8`, `bool`, `bytea`, `date`,
+ * `timestamptz`, or else `text`.
+ *
+ * For a type where that guess would not be good enough (see
+ * @ref needs_sql_type), the stream asks the server for the actual types.
+ */
+template<typename TYPE>
+[[nodiscard]] PQXX_PURE inline constexpr oid
+guess_binary_type(std::size_t size) noexcept
+{
+  if constexpr (is_optional<TYPE>)
+  {
+    return guess_binary_type<typename TYPE::value_type>(size);
+  }
+  else if constexpr (std::same_as<TYPE, bool>)
+  {
+    return oid_bool;
+  }
+  else if constexpr (std::integral<TYPE>)
+  {
+    switch (size)
+    {
+    case 2: return oid_int2;
+    case 4: return oid_int4;
+    case 8: return oid_int8;
+    default: return oid_unknown;
+    }
+  }
+  else if constexpr (std::floating_point<TYPE>)
+  {
+    return (size == 4) ? oid_float4 : oid_float8;
+  }
+  else if constexpr (binary<TYPE>)
+  {
+    return oid_bytea;
+  }
+#if defined(PQXX_HAVE_YEAR_MONTH_DAY)
+  else if constexpr (std::same_as<TYPE, std::chrono::year_month_day>)
+  {
+    return oid_date;
+  }
+#endif
+  else if constexpr (std::same_as<
+                       TYPE, std::chrono::sys_time<std::chrono::microseconds>>)
+  {
+    return oid_timestamptz;
+  }
+  else
+  {
+    return oid_text;
+  }
+}
+} // namespace pqxx::internal
+#endif
@@ -0,0 +1,190 @@
+/* Streaming access to binary large objects.
+ *
+ * DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/blob_stream instead.
+ *
+ * Copyright (c) 2000-2026, Jeroen T. Vermeulen.
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this
+ * mistake, or contact the author.
+ */
+#ifndef PQXX_BLOB_STREAM_HXX
+#define PQXX_BLOB_STREAM_HXX
+
+#if !defined(PQXX_HEADER_PRE)
+#  error "Include libpqxx headers as <pqxx/header>, not <pqxx/header.hxx>."
+#endif
+
+#include <deque>
+#include <optional>
+#include <span>
+
+#include "pqxx/dbtransaction.hxx"
+#include "pqxx/pipeline.hxx"
+
+
+namespace pqxx
+{
+/// Read a binary large object from start to end, with readahead.
+/** A @ref blob makes one round trip to the server for every read.  On a
+ * high-latency connection, that makes reading a large object slow, no matter
+ * how big you make each read.
+ *
+ * A `blob_reader` instead keeps several reads outstanding at a time, using a
+ * @ref pipeline: while you process one chunk, the next ones are already on
+ * their way.  It receives the chunks in binary, and copies them straight from
+ * libpq's buffer into the buffer you pass to @ref read.  That buffer can be
+ * a memory-mapped file, for instance.
+ *
+ * The reader requires libpq 14 or better, since that is what the pipeline
+ * needs.  While it exists, it occupies its transaction: you can't execute
+ * other queries on the transaction until you @ref close the reader or destroy
+ * it.
+ */
+class PQXX_LIBEXPORT blob_reader final
+{
+public:
+  /// Default number of bytes to fetch per round trip.
+  static constexpr std::size_t default_chunk{256u * 1024u};
+  /// Default number of chunks to keep on the way.
+  static constexpr int default_depth{4};
+
+  /// Open large object `id` for reading.
+  /** @param chunk_size Number of bytes to fetch per round trip.
+   * @param depth Number of chunks to request ahead of time.
+   */
+  blob_reader(
+    dbtransaction &tx, oid id, std::size_t chunk_size = default_chunk,
+    int depth = default_depth, sl = sl::current());
+
+  blob_reader(blob_reader const &) = delete;
+  blob_reader &operator=(blob_reader const &) = delete;
+  ~blob_reader() noexcept;
+
+  /// Read up to `std::size(buf)` bytes into `buf`.
+  /** Fills `buf` completely, unless it reaches the end of the object first.
+   *
+   * Returns the filled portion of `buf`.  This is empty once you've read
+   * everything.
+   */
+  writable_bytes_view read(std::span<std::byte> buf, sl = sl::current());
+
+  /// Read up to `std::size(buf)` bytes into `buf`.
+  /** Returns the filled portion of `buf`.
+   */
+  template<binary DATA>
+  writable_bytes_view read(DATA &buf, sl loc = sl::current())
+  {
+    return read(std::span<std::byte>{std::data(buf), std::size(buf)}, loc);
+  }
+
+  /// Have we read all of the object's data?
+  /** Any readahead requests that are still on their way at that point can
+   * only produce empty chunks.  The reader discards them when it closes.
+   */
+  [[nodiscard]] bool eof() const noexcept
+  {
+    return m_end and std::empty(m_chunk);
+  }
+
+  /// Stop reading, and close the large object.
+  /** Discards any data that is still on its way.  The destructor will do this
+   * for you, but it can't report errors.
+   */
+  void close(sl = sl::current());
+
+private:
+  /// Request the next chunk.
+  PQXX_PRIVATE void request(sl);
+  /// Wait for the next chunk to arrive.  Returns false at the end.
+  PQXX_PRIVATE bool receive(sl);
+
+  dbtransaction *m_trans;
+  std::size_t m_chunk_size;
+  /// Descriptor for the large object, on the server side.
+  int m_fd = -1;
+  /// Number of chunks we've requested but not yet received.
+  int m_pending = 0;
+  /// Have we received a short chunk, i.e. reached the end of the object?
+  bool m_end = false;
+  /// The result holding the current chunk.
+  result m_result;
+  /// The part of the current chunk that we have not handed out yet.
+  bytes_view m_chunk;
+  std::optional<pipeline> m_pipe;
+};
+
+
+/// Write a binary large object from start to end, without waiting.
+/** A @ref blob makes one round trip to the server for every write.  A
+ * `blob_writer` instead sends its chunks through a @ref pipeline, without
+ * waiting for earlier ones to complete.  It only waits once it has `depth`
+ * chunks in flight.
+ *
+ * Small writes accumulate in a buffer until there's a full chunk.  Large
+ * writes go straight from your buffer (a memory-mapped file, for instance)
+ * into libpq's, one chunk at a time.
+ *
+ * The writer starts at the beginning of the object.  Like @ref blob, it
+ * overwrites existing data but does not truncate the object.
+ *
+ * Call @ref complete when you're done.  The writer requires libpq 14 or
+ * better.  While it exists, it occupies its transaction: you can't execute
+ * other queries on the transaction until you complete the writer or destroy
+ * it.
+ */
+class PQXX_LIBEXPORT blob_writer final
+{
+public:
+  /// Default number of bytes to send per statement.
+  static constexpr std::size_t default_chunk{256u * 1024u};
+  /// Default number of chunks to have in flight before waiting.
+  static constexpr int default_depth{4};
+
+  /// Open large object `id` for writing.
+  /** @param chunk_size Number of bytes to send per statement.
+   * @param depth Number of chunks to send before waiting for results.
+   */
+  blob_writer(
+    dbtransaction &tx, oid id, std::size_t chunk_size = default_chunk,
+    int depth = default_depth, sl = sl::current());
+
+  blob_writer(blob_writer const &) = delete;
+  blob_writer &operator=(blob_writer const &) = delete;
+
+  /// Close the writer.  Call @ref complete first, or you may lose data.
+  ~blob_writer() noexcept;
+
+  /// Write `data` to the object.
+  void write(bytes_view data, sl = sl::current());
+
+  /// Write `data` to the object.
+  template<binary DATA> void write(DATA const &data, sl loc = sl::current())
+  {
+    write(binary_cast(data), loc);
+  }
+
+  /// Send any buffered data, wait for all writes to finish, and close.
+  void complete(sl = sl::current());
+
+private:
+  /// Send one chunk.  Waits first, if there are too many in flight.
+  PQXX_PRIVATE void send(bytes_view, sl);
+  /// Wait for the oldest write to finish, and check its result.
+  PQXX_PRIVATE void receive(sl);
+  /// Close the large object.
+  PQXX_PRIVATE void close(sl = sl::current());
+
+  dbtransaction *m_trans;
+  std::size_t m_chunk_size;
+  int m_depth;
+  /// Descriptor for the large object, on the server side.
+  int m_fd = -1;
+  /// Sizes of the chunks that are in flight, oldest first.
+  std::deque<std::size_t> m_pending;
+  /// Data that we have not sent yet, because it does not make a full chunk.
+  bytes m_buffer;
+  std::optional<pipeline> m_pipe;
+};
+} // namespace pqxx
+#endif
@@ -25,10 +25,13 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <string_view>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "pqxx/errorhandler.hxx"
 #include "pqxx/except.hxx"
@@ -92,12 +95,17 @@ PQXX_COLD PQXX_LIBEXPORT void skip_init_ssl(int skips) noexcept;
 
 namespace pqxx::internal::gate
 {
+class connection_adaptive_cursorstream;
+class connection_async;
+class connection_chunked_query;
 class connection_dbtransaction;
 class connection_errorhandler;
 class connection_largeobject;
 class connection_notification_receiver;
+class connection_notification_listener;
 class connection_pipeline;
 class connection_sql_cursor;
+class connection_statement_batch;
 class connection_stream_from;
 class connection_stream_to;
 class connection_transaction;
@@ -802,6 +810,9 @@ public:
    * A connection can only have one handler per channel, so if you register two
    * different handlers on the same channel, then the second overwrites the
    * first.
+   *
+   * If you need to handle notifications in large volumes, or off the thread
+   * that owns the connection, consider a @ref notification_listener.
    */
   void listen(
     std::string_view channel, notification_handler handler = {},
@@ -960,6 +971,21 @@ public:
   /// Drop prepared statement.
   void unprepare(std::string_view name, sl loc = sl::current());
 
+  /// Ask the server about a prepared statement.
+  /** Returns a result without rows, which describes the statement's result
+   * columns (see @ref result::columns, @ref result::column_name, and
+   * @ref result::column_type) as well as its parameters (see
+   * @ref result::param_count and @ref result::param_type).
+   *
+   * For a statement that you defined through @ref prepare, this only asks the
+   * server once; after that it's cached until you @ref unprepare the
+   * statement, or prepare a new one by the same name.  While it's cached,
+   * executing the statement with the wrong number of parameters throws
+   * @ref argument_error without contacting the server.
+   */
+  [[nodiscard]] result
+  describe_prepared(zview name, sl loc = sl::current());
+
   //@}
 
   /// Suffix unique number to name to make it unique within session context.
@@ -1343,9 +1369,21 @@ private:
   /// Complete setup after libpq has completed creating its connection.
   void complete_connection(sl);
 
+  /// Get a shared copy of a query text, or statement name, for a result.
+  /** Reuses the copy from a previous execution if there is one.
+   */
+  std::shared_ptr<std::string> intern_query(std::string_view query);
+
+  /// Wrap a `PGresult` in a @ref result, and check it for errors.
+  /** If `columns` is not null, it points to a prepared statement's column
+   * index.  If the index is missing or has the wrong number of columns, this
+   * (re)builds it.  Otherwise the result reuses it, and checks the column
+   * names only when it first looks up a column by name.
+   */
   result make_result(
     internal::pq::PGresult *pgr, std::shared_ptr<std::string> const &query,
-    std::string_view desc, sl = sl::current());
+    std::string_view desc, sl = sl::current(),
+    std::shared_ptr<internal::column_index const> *columns = nullptr);
 
   result make_result(
     internal::pq::PGresult *pgr, std::shared_ptr<std::string> const &query,
@@ -1369,7 +1407,7 @@ private:
 
   result exec_prepared(
     std::string_view statement, internal::c_params const &,
-    sl loc = sl::current());
+    format result_format = format::text, sl loc = sl::current());
 
   /// Throw @ref usage_error if this connection is not in a movable state.
   void check_movable(sl) const;
@@ -1393,6 +1431,30 @@ private:
   PQXX_PRIVATE void register_transaction(transaction_base *);
   PQXX_PRIVATE void unregister_transaction(transaction_base *) noexcept;
 
+  /// Execute `first`, and then `query`, in a single round trip.
+  /** Sends the two as one multi-statement query.  Returns the result for
+   * `query`.  If `first` fails, throws the exception for that instead.
+   *
+   * If the server rejects the combined string, e.g. because `query` has a
+   * syntax error, neither command runs.  In that case this falls back to
+   * executing them one by one, so the error comes from `query` itself.
+   */
+  PQXX_PRIVATE result
+  exec_after(zview first, std::string_view query, std::string_view desc, sl);
+
+  /// Execute a statement between two commands, in a single round trip.
+  /** Either of the commands `before` and `after` may be empty.  Uses pipeline
+   * mode where available.  Returns the statement's result, or throws the
+   * exception for the first of the three that failed.
+   */
+  PQXX_PRIVATE result exec_bracketed(
+    zview before, std::string_view statement, bool prepared,
+    internal::c_params const &args, format result_format, zview after,
+    sl);
+
+  /// Is the session inside a transaction block on the server side?
+  PQXX_PRIVATE [[nodiscard]] bool in_transaction_block() const noexcept;
+
   friend class internal::gate::connection_stream_from;
   /// Read a line of COPY output.
   /** If the output indicates that the COPY has ended, the buffer pointer
@@ -1402,9 +1464,27 @@ private:
    */
   std::pair<std::unique_ptr<char[], void (*)(void const *)>, std::size_t>
     read_copy_line(sl);
+  /// Read a line of COPY output, but only if we can do so without blocking.
+  /** Returns an empty `std::optional` if there is no line available yet.
+   * Otherwise, returns the same as @ref read_copy_line.  When the COPY ends,
+   * it returns a null buffer pointer, but only once the final result is in.
+   *
+   * @param ended Set to `true` once the server has signalled the end of the
+   *     COPY.  Start out with `false`, and pass the same variable to every
+   *     call for the same COPY.
+   */
+  std::optional<
+    std::pair<std::unique_ptr<char[], void (*)(void const *)>, std::size_t>>
+  read_copy_line_nonblocking(bool &ended, sl);
+  /// Ask the server what columns `query` produces, without executing it.
+  /** Prepares `query` as the unnamed statement, and describes that.  Costs
+   * two round trips.
+   */
+  result describe_query(std::string_view query, sl);
 
   friend class internal::gate::connection_stream_to;
   PQXX_PRIVATE void write_copy_line(std::string_view, sl);
+  PQXX_PRIVATE void write_copy_data(std::string_view, sl);
   PQXX_PRIVATE void end_copy_write(sl);
 
   friend class internal::gate::connection_largeobject;
@@ -1418,16 +1498,65 @@ private:
   void remove_receiver(notification_receiver *, sl) noexcept;
 
   friend class internal::gate::connection_pipeline;
-  PQXX_PRIVATE PQXX_ZARGS void start_exec(char const query[]);
+  /// Put the connection in libpq's "pipeline mode."
+  /** Requires libpq 14 or better.  Throws @ref feature_not_supported if the
+   * libpq against which libpqxx was built does not support pipelining.
+   */
+  PQXX_PRIVATE void enter_pipeline_mode(sl);
+  /// Leave pipeline mode.  There must be no pending results.
+  PQXX_PRIVATE void exit_pipeline_mode(sl);
+  /// Queue a parameterised statement for execution, but don't wait for it.
+  PQXX_PRIVATE void start_exec_params(
+    zview query, internal::c_params const &args, format result_format, sl);
+  /// Queue a prepared statement for execution, but don't wait for it.
+  PQXX_PRIVATE void start_exec_prepared(
+    zview statement, internal::c_params const &args, format result_format,
+    sl);
+  /// Queue a pipeline synchronisation point.
+  /** May or may not flush the connection's output buffer; call
+   * @ref flush_output() when you need that.
+   */
+  PQXX_PRIVATE void pipeline_sync(sl);
+  /// Send any queued output to the server.
+  PQXX_PRIVATE void flush_output(sl);
+  /// Read the result for a pipeline sync point.  Blocks if needed.
+  /** Throws @ref internal_error if the next result is not a sync point.
+   */
+  PQXX_PRIVATE void consume_pipeline_sync(sl);
   PQXX_PRIVATE bool consume_input() noexcept;
   PQXX_PRIVATE [[nodiscard]] bool is_busy() const noexcept;
   internal::pq::PGresult *get_result();
 
   friend class internal::gate::connection_dbtransaction;
   friend class internal::gate::connection_sql_cursor;
+  friend class internal::gate::connection_notification_listener;
+  friend class internal::gate::connection_statement_batch;
+  friend class internal::gate::connection_adaptive_cursorstream;
+
+  friend class internal::gate::connection_chunked_query;
+  /// Have the command we just sent return its rows a few at a time.
+  /** Returns chunks of up to `rows` rows, if libpq supports that (it takes
+   * libpq 17 or better).  Otherwise, returns one row at a time.
+   */
+  PQXX_PRIVATE void set_row_chunks(int rows, sl);
+
+  friend class internal::gate::connection_async;
+  /// Make libpq's sending functions return, rather than wait, when busy.
+  PQXX_PRIVATE void set_nonblocking(bool, sl);
+  /// Queue preparation of `query` as the unnamed statement.
+  PQXX_PRIVATE void start_prepare_unnamed(zview query, sl);
+  /// Queue a request to describe the unnamed statement.
+  PQXX_PRIVATE void start_describe_unnamed(sl);
+  /// Send as much queued output as we can without waiting.
+  /** Returns `true` once all output has gone out.  Until then, wait for the
+   * socket to become writable, and try again.
+   */
+  PQXX_PRIVATE [[nodiscard]] bool try_flush_output(sl);
 
   result
-  exec_params(std::string_view query, internal::c_params const &args, sl);
+  exec_params(
+    std::string_view query, internal::c_params const &args,
+    format result_format, sl);
 
   /// Connection handle.
   internal::pq::PGconn *m_conn = nullptr;
@@ -1459,8 +1588,60 @@ private:
    * The map does not contain any `std::function` which are empty.  If the
    * caller registers an empty function, that simply cancels any subscription
    * to that channel.
+   *
+   * It's a hash map, so routing an incoming notification to its handler does
+   * not depend on how many channels we're listening on.
    */
-  std::map<std::string, notification_handler> m_notification_handlers;
+  std::unordered_map<
+    std::string, notification_handler, internal::string_hash, std::equal_to<>>
+    m_notification_handlers;
+
+  /// What we know about a prepared statement we defined.
+  struct statement_info final
+  {
+    /// The server's description of the statement, once we've asked for it.
+    result description;
+    /// Index of the statement's result columns, once we know them.
+    /** Results of the statement share this, so looking up their columns by
+     * name is a hash lookup.
+     */
+    std::shared_ptr<internal::column_index const> columns;
+  };
+
+  /// Named prepared statements defined through @ref prepare.
+  /** We don't track the unnamed statement, since every parameterised query
+   * replaces it.  If you prepare or deallocate statements by executing SQL
+   * commands, we won't know about it.
+   */
+  std::map<std::string, statement_info, std::less<>> m_statements;
+
+  /// Recently executed query texts and prepared statement names.
+  /** Each @ref result keeps a copy of its query, for use in error messages.
+   * When we execute the same query again, the new result can share the
+   * existing copy instead of allocating a new one.
+   *
+   * The cache has a fixed number of slots.  Once they're all full, a "clock"
+   * sweep picks one to reuse: it passes over the slots in turn, skipping (but
+   * clearing the mark on) any slot that's been used since the last pass.
+   */
+  struct query_cache final
+  {
+    // NOLINTBEGIN(misc-non-private-member-variables-in-classes)
+    /// One cached query text.
+    struct slot final
+    {
+      std::shared_ptr<std::string> text;
+      /// Have we used this text since the clock hand last passed it?
+      bool recent = false;
+    };
+
+    std::vector<slot> slots;
+    /// Slot numbers by query text.  The keys point into the slots' strings.
+    std::unordered_map<std::string_view, std::size_t> index;
+    /// The "clock hand": next slot to consider for reuse.
+    std::size_t hand = 0;
+    // NOLINTEND(misc-non-private-member-variables-in-classes)
+  } m_queries;
 
   /// A `std::source_location` for where this object was created.
   sl m_created_loc;
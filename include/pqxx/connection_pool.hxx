@@ -0,0 +1,351 @@
+/* Definition of the pqxx::connection_pool class.
+ *
+ *   A thread-safe pool of database connections.
+ *
+ * DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/connection_pool instead.
+ *
+ * Copyright (c) 2000-2026, Jeroen T. Vermeulen.
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this
+ * mistake, or contact the author.
+ */
+#ifndef PQXX_CONNECTION_POOL_HXX
+#define PQXX_CONNECTION_POOL_HXX
+
+#if !defined(PQXX_HEADER_PRE)
+#  error "Include libpqxx headers as <pqxx/header>, not <pqxx/header.hxx>."
+#endif
+
+#include <chrono>
+#include <condition_variable>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "pqxx/connection.hxx"
+
+
+namespace pqxx
+{
+class connection_pool;
+
+
+/// Settings for a @ref connection_pool.
+struct pool_config final
+{
+  /// Number of connections the pool tries to keep open at all times.
+  std::size_t min_size{1};
+
+  /// Maximum number of connections the pool will have open at the same time.
+  /** This includes connections that are checked out, and ones that are still
+   * in the process of connecting.
+   */
+  std::size_t max_size{10};
+
+  /// Close a connection once it has been idle this long.
+  /** The pool never closes idle connections if that would bring it below
+   * `min_size`.
+   */
+  std::chrono::milliseconds idle_timeout{std::chrono::minutes{10}};
+
+  /// How long @ref connection_pool::checkout may wait for a connection.
+  std::chrono::milliseconds checkout_timeout{std::chrono::seconds{30}};
+
+  /// Check that a connection still works if it has been idle this long.
+  /** The check costs a round trip to the server, so it only happens for
+   * connections that have been sitting idle for a while.
+   */
+  std::chrono::milliseconds health_check_after{std::chrono::seconds{10}};
+};
+
+
+/// Activity counters for a @ref connection_pool.
+struct pool_stats final
+{
+  /// Open connections that are waiting to be checked out.
+  std::size_t idle{0};
+  /// Connections that are currently checked out.
+  std::size_t in_use{0};
+  /// Connections that are still in the process of connecting.
+  std::size_t connecting{0};
+
+  /// Successful checkouts.
+  std::size_t checkouts{0};
+  /// Checkouts that had to wait for a connection.
+  /** That is, for another thread to return one, or for a connection attempt
+   * that was already in progress to complete.  A checkout that opens a new
+   * connection of its own doesn't count as waiting.
+   */
+  std::size_t waits{0};
+  /// Checkouts that gave up because they waited too long.
+  std::size_t timeouts{0};
+  /// New connections established.
+  std::size_t connects{0};
+  /// Connection attempts that failed.
+  std::size_t connect_failures{0};
+  /// Connections closed because they were broken or failed a health check.
+  std::size_t discarded{0};
+
+  /// Total time that checkouts spent waiting for a connection.
+  /** This counts only the checkouts in `waits`.
+   */
+  std::chrono::nanoseconds wait_time{0};
+  /// Longest time that any one checkout spent waiting for a connection.
+  std::chrono::nanoseconds max_wait_time{0};
+  /// Total time spent in successful checkouts, from call to return.
+  std::chrono::nanoseconds checkout_time{0};
+  /// Longest time that any one successful checkout took.
+  std::chrono::nanoseconds max_checkout_time{0};
+};
+
+
+/// A connection that's checked out from a @ref connection_pool.
+/** While you hold this object, you have exclusive use of the connection.
+ * Destroying the object (or calling @ref give_back) returns the connection to
+ * the pool.
+ *
+ * Do not keep transactions, streams, pipelines, or other objects that
+ * operate on the connection alive after you return it.
+ *
+ * @warning Return the connection before you destroy its pool.
+ */
+class PQXX_LIBEXPORT pooled_connection final
+{
+public:
+  pooled_connection() = delete;
+  pooled_connection(pooled_connection const &) = delete;
+  pooled_connection(pooled_connection &&rhs) noexcept :
+          m_pool{rhs.m_pool},
+          m_conn{std::move(rhs.m_conn)},
+          m_replayed{rhs.m_replayed}
+  {}
+  ~pooled_connection() noexcept { give_back(); }
+
+  pooled_connection &operator=(pooled_connection const &) = delete;
+  pooled_connection &operator=(pooled_connection &&rhs) noexcept;
+
+  /// The connection itself.
+  [[nodiscard]] connection &get() const & noexcept { return *m_conn; }
+  [[nodiscard]] connection &operator*() const & noexcept { return *m_conn; }
+  [[nodiscard]] connection *operator->() const & noexcept
+  {
+    return m_conn.get();
+  }
+
+  /// Does this object still hold a connection?
+  [[nodiscard]] explicit operator bool() const noexcept
+  {
+    return m_conn != nullptr;
+  }
+
+  /// Return the connection to the pool now, rather than on destruction.
+  /** After this, the object no longer holds a connection.
+   */
+  void give_back() noexcept;
+
+private:
+  friend class connection_pool;
+  pooled_connection(
+    connection_pool &pool, std::unique_ptr<connection> &&conn,
+    std::size_t replayed) noexcept :
+          m_pool{&pool}, m_conn{std::move(conn)}, m_replayed{replayed}
+  {}
+
+  connection_pool *m_pool;
+  std::unique_ptr<connection> m_conn;
+  /// Version of the pool's registrations that this connection has.
+  std::size_t m_replayed;
+};
+
+
+/// A thread-safe pool of connections to the same database.
+/** Call @ref checkout to get exclusive use of a connection, for as long as you
+ * hold on to the @ref pooled_connection.  When it's destroyed, the connection
+ * goes back into the pool for the next checkout.
+ *
+ * If there is no idle connection, a checkout opens a new one, unless the pool
+ * is at its maximum size.  In that case, it waits for another thread to
+ * return a connection.
+ *
+ * Each connection you get from the pool has all prepared statements and
+ * session variables that you registered with the pool, regardless of when you
+ * registered them: the pool replays any it has not yet applied to a
+ * connection before it hands that connection out.
+ *
+ * The pool does not start threads of its own.  Call @ref maintain regularly,
+ * e.g. from a timer or a housekeeping thread, to progress new connections in
+ * the background, top the pool up to its minimum size, and close connections
+ * that have been idle for too long.  A checkout that needs a connection will
+ * also finish any connection attempt that is still in progress.
+ *
+ * All member functions are thread-safe.  The connections themselves are not:
+ * only the thread that checked out a connection should use it.
+ *
+ * @warning A @ref pooled_connection must not outlive its pool.
+ */
+class PQXX_LIBEXPORT connection_pool final
+{
+public:
+  /// Create a pool.
+  /** This starts connecting the first `config.min_size` connections, but
+   * does not wait for them to complete.  (Starting them can still block
+   * while libpq looks up the host name; see @ref maintain.)
+   *
+   * @param connection_string Connection string for each connection.
+   * @param config The pool's settings.
+   * @throw argument_error if `config` makes no sense.
+   */
+  explicit connection_pool(
+    std::string connection_string, pool_config config = {},
+    sl loc = sl::current());
+
+  connection_pool(connection_pool const &) = delete;
+  connection_pool(connection_pool &&) = delete;
+  ~connection_pool() noexcept;
+  connection_pool &operator=(connection_pool const &) = delete;
+  connection_pool &operator=(connection_pool &&) = delete;
+
+  /// Get a connection from the pool.
+  /** Waits for a connection to become available if necessary, but no longer
+   * than the configured `checkout_timeout`.
+   *
+   * @throw failure if the checkout times out.
+   * @throw broken_connection if the pool needs a new connection but can't
+   *   connect.
+   */
+  [[nodiscard]] pooled_connection checkout(sl loc = sl::current());
+
+  /// Register a prepared statement for every connection in the pool.
+  /** Connections will have this prepared statement from their next
+   * checkout onwards.
+   *
+   * @throw argument_error if there already is a registered statement of the
+   * same name.
+   */
+  void prepare(
+    std::string_view name, std::string_view definition,
+    sl loc = sl::current());
+
+  /// Set a session variable on every connection in the pool.
+  /** Connections will have this setting from their next checkout onwards.
+   * If you set the same variable again, the new value replaces the old one.
+   *
+   * @throw variable_set_to_null if the value is null; this is not allowed.
+   */
+  template<typename TYPE>
+  void set_session_var(
+    std::string_view var, TYPE const &value, sl loc = sl::current())
+  {
+    if constexpr (has_null<TYPE>())
+    {
+      if (is_null(value))
+        throw variable_set_to_null{
+          std::format("Attempted to set variable {} to null.", var), loc};
+    }
+    add_session_var(var, pqxx::to_string(value), loc);
+  }
+
+  /// Do housekeeping work that does not need to hold up a checkout.
+  /** This progresses any connection attempts that are still in progress,
+   * starts new ones as needed to reach the pool's minimum size, and closes
+   * connections that have been idle for too long.
+   *
+   * This does not wait for connection attempts to progress.  But starting a
+   * new attempt can block: libpq looks up the host name, and creates the
+   * socket, before it returns.  So if the pool needs new connections and
+   * name resolution is slow, so is this call.
+   *
+   * Failed connection attempts are counted in the pool's statistics, but
+   * they do not throw.
+   */
+  void maintain(sl loc = sl::current());
+
+  /// Take a snapshot of the pool's activity counters.
+  [[nodiscard]] pool_stats stats() const;
+
+  /// The pool's settings.
+  [[nodiscard]] pool_config const &config() const noexcept
+  {
+    return m_config;
+  }
+
+private:
+  friend class pooled_connection;
+  using clock = std::chrono::steady_clock;
+
+  /// A prepared statement or session variable to apply to each connection.
+  struct registration final
+  {
+    /// Is this a prepared statement, or a session variable?
+    bool is_statement;
+    std::string name;
+    /// Statement definition, or variable value.
+    std::string value;
+    /// The value of `m_version` when this was last registered or changed.
+    std::size_t version;
+  };
+
+  /// A connection that's waiting in the pool.
+  struct idle_connection final
+  {
+    std::unique_ptr<connection> conn;
+    /// When the connection came (back) into the pool.
+    clock::time_point since;
+    /// Version of `m_registrations` that this connection has.
+    std::size_t replayed;
+  };
+
+  void add_session_var(std::string_view var, std::string &&value, sl);
+
+  /// Take back a connection that was checked out.
+  /** If the connection is no longer usable, leaves it in the pointer for the
+   * caller to close.
+   */
+  void
+  take_back(std::unique_ptr<connection> &&, std::size_t replayed) noexcept;
+
+  /// Registrations that are newer than `version`, oldest first.
+  /** Call with `m_mutex` locked.
+   */
+  [[nodiscard]] std::vector<registration>
+  registrations_since(std::size_t version) const;
+
+  /// Apply registrations that a connection doesn't have yet.
+  /** Sets `replayed` to the version of each registration as it applies it.
+   */
+  static void replay(
+    connection &, std::vector<registration> const &missing,
+    std::size_t &replayed, sl);
+
+  /// Record a checkout in the statistics.  Call with `m_mutex` locked.
+  void count_checkout(
+    clock::time_point start, clock::time_point got, bool waited) noexcept;
+
+  std::string const m_connect;
+  pool_config const m_config;
+
+  mutable std::mutex m_mutex;
+  /// Signalled whenever a connection comes (back) into the pool.
+  std::condition_variable m_available;
+
+  /// Idle connections, in the order in which they came into the pool.
+  /** Checkouts take the most recently used connection, from the back.
+   */
+  std::vector<idle_connection> m_idle;
+  /// Connection attempts in progress.
+  std::vector<connecting> m_pending;
+  /// Number of connections: idle, checked out, or still connecting.
+  std::size_t m_size{0};
+  /// Number of connections that are checked out.
+  std::size_t m_in_use{0};
+  /// Prepared statements and session variables, one entry for each name.
+  std::vector<registration> m_registrations;
+  /// Latest version of `m_registrations`.  Every change increments it.
+  std::size_t m_version{0};
+  pool_stats m_stats;
+};
+} // namespace pqxx
+#endif
@@ -17,11 +17,15 @@
 #  error "Include libpqxx headers as <pqxx/header>, not <pqxx/header.hxx>."
 #endif
 
+#include <cstddef>
 #include <limits>
+#include <memory>
 #include <stdexcept>
+#include <string>
 
 #include "pqxx/result.hxx"
 #include "pqxx/transaction_base.hxx"
+#include "pqxx/transaction_focus.hxx"
 
 
 namespace pqxx
@@ -574,5 +578,137 @@ private:
 
   icursor_iterator *m_prev{nullptr}, *m_next{nullptr};
 };
+
+
+/// Settings for an @ref adaptive_cursorstream.
+struct cursorstream_config final
+{
+  /// Aim for roughly this many bytes of data per fetch.
+  /** This is what limits the stride.  The stream estimates the size of a row
+   * from what it has fetched so far, and never fetches more rows at a time
+   * than it thinks will fit in this budget.
+   */
+  std::size_t fetch_bytes{1024u * 1024u};
+
+  /// Number of rows in the first fetch, before we know anything about them.
+  cursor_base::difference_type initial_stride{64};
+
+  /// Never fetch more than this many rows at a time.
+  cursor_base::difference_type max_stride{65536};
+
+  /// Ask for each next batch before handing the current one to the caller.
+  /** This overlaps the round trip to the server with your processing of the
+   * rows you just received.
+   */
+  bool prefetch{true};
+};
+
+
+/// Read-only cursor stream that picks its own stride, and reads ahead.
+/** Like @ref icursorstream, this reads a query's rows through an SQL cursor,
+ * a block at a time.  But instead of fetching a fixed number of rows per
+ * block, it adapts its stride as it goes:
+ * * It starts out with @ref cursorstream_config::initial_stride rows.
+ * * Whenever you have to wait for a block to arrive, it doubles its stride,
+ *   so that you pay for fewer round trips.
+ * * But it keeps each block to about @ref cursorstream_config::fetch_bytes
+ *   bytes, based on the sizes of the rows it has seen so far.
+ *
+ * With prefetching enabled, as it is by default, `get()` sends the `FETCH`
+ * for the next block before it returns the current one.  While you process
+ * one block, the next is already on its way.  In a steady state, you may not
+ * need to wait for the network at all.
+ *
+ * @warning While a prefetch is in flight, the stream occupies its
+ * transaction.  You can't execute anything else in the transaction until
+ * you've read all of the data, or destroyed the stream.
+ *
+ * As with @ref icursorstream, the last block of data may contain fewer rows,
+ * and you get an empty result only once there are no more rows.
+ */
+class PQXX_LIBEXPORT adaptive_cursorstream final : transaction_focus
+{
+public:
+  using size_type = cursor_base::size_type;
+  using difference_type = cursor_base::difference_type;
+
+  /// Set up a read-only, forward-only cursor.
+  /**
+   * @param context Transaction context in which this cursor will be active.
+   * @param query SQL query whose results this cursor shall iterate.
+   * @param basename Suggested name for the SQL cursor; the library will append
+   * a unique code to ensure its uniqueness.
+   * @param config Settings for fetching rows.
+   */
+  adaptive_cursorstream(
+    transaction_base &context, std::string_view query,
+    std::string_view basename, cursorstream_config config = {},
+    sl = sl::current());
+
+  adaptive_cursorstream() = delete;
+  adaptive_cursorstream(adaptive_cursorstream const &) = delete;
+  adaptive_cursorstream(adaptive_cursorstream &&) = delete;
+  adaptive_cursorstream &operator=(adaptive_cursorstream const &) = delete;
+  adaptive_cursorstream &operator=(adaptive_cursorstream &&) = delete;
+
+  /// Discard any block that's still on its way, and close the cursor.
+  ~adaptive_cursorstream() noexcept;
+
+  // NOLINTBEGIN(google-explicit-constructor,hicpp-explicit-conversions)
+
+  /// Return `true` if this stream may still return more data.
+  constexpr operator bool() const & noexcept { return not m_done; }
+
+  // NOLINTEND(google-explicit-constructor,hicpp-explicit-conversions)
+
+  /// Read the next block of rows into `res`.
+  /** The result may contain any number of rows.  An empty result will only
+   * be returned if there are no more rows to retrieve.
+   */
+  adaptive_cursorstream &get(result &res, sl loc = sl::current())
+  {
+    res = fetchblock(loc);
+    return *this;
+  }
+  /// Read the next block of rows into `res`; same as `get(result&)`.
+  adaptive_cursorstream &operator>>(result &res) { return get(res); }
+
+  /// The number of rows that the stream will ask for in its next fetch.
+  [[nodiscard]] constexpr difference_type stride() const noexcept
+  {
+    return m_stride;
+  }
+
+  /// The ``std::source_location` for where this stream was created.
+  [[nodiscard]] PQXX_PURE sl created_loc() const noexcept
+  {
+    return m_cur.created_loc();
+  }
+
+private:
+  result fetchblock(sl);
+  /// Send a `FETCH` for the next `m_stride` rows.
+  void send_fetch(sl);
+  /// Wait for the `FETCH` in flight, and adjust the stride.
+  result receive_fetch(sl);
+  /// Receive and discard any `FETCH` in flight.
+  void discard_fetch() noexcept;
+
+  internal::sql_cursor m_cur;
+  cursorstream_config m_config;
+
+  /// The `FETCH` in flight, if any.
+  std::shared_ptr<std::string> m_fetch;
+  /// Number of rows requested by the `FETCH` in flight.
+  difference_type m_requested{0};
+
+  difference_type m_stride;
+  /// Running estimate of the size of a row, in bytes.
+  std::size_t m_row_bytes{0};
+
+  /// Has the cursor returned its last row?
+  bool m_at_end = false;
+  bool m_done = false;
+};
 } // namespace pqxx
 #endif
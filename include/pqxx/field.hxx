@@ -20,6 +20,7 @@
 #include <optional>
 
 #include "pqxx/array.hxx"
+#include "pqxx/binary.hxx"
 #include "pqxx/composite.hxx"
 #include "pqxx/internal/gates/result-field_ref.hxx"
 #include "pqxx/result.hxx"
@@ -32,6 +33,13 @@ class field_ref_const_row_iterator;
 } // namespace pqxx::internal::gate
 
 
+namespace pqxx::internal
+{
+/// Convert a non-null field's value to `T`, whether in text or binary format.
+template<typename T> T convert_field(field_ref const &, ctx);
+} // namespace pqxx::internal
+
+
 namespace pqxx
 {
 /// Lightweight reference to a field in a result set.
@@ -142,6 +150,9 @@ public:
    *
    * Many built-in types come with conversions predefined.  To find out how to
    * add your own, see @ref datatypes.
+   *
+   * If the result came in binary format, the conversion uses
+   * @ref binary_traits instead, and it does care about the SQL type.
    */
   //@{
   /// Read as @ref zview, or an empty one if null.
@@ -181,7 +192,7 @@ public:
     if (is_null())
       return default_value;
     else
-      return from_string<T>(this->view(), make_context(loc));
+      return pqxx::internal::convert_field<T>(*this, make_context(loc));
   }
 
   /// Return value as object of given type, or throw exception if null.
@@ -201,7 +212,7 @@ public:
     }
     else
     {
-      return from_string<T>(this->view(), make_context(loc));
+      return pqxx::internal::convert_field<T>(*this, make_context(loc));
     }
   }
 
@@ -220,7 +231,7 @@ public:
     }
     else
     {
-      from_string(view(), obj, make_context(loc));
+      obj = pqxx::internal::convert_field<T>(*this, make_context(loc));
       return true;
     }
   }
@@ -233,7 +244,7 @@ public:
     if (null)
       obj = default_value;
     else
-      obj = from_string<T>(this->view(), make_context(loc));
+      obj = pqxx::internal::convert_field<T>(*this, make_context(loc));
     return not null;
   }
 
@@ -298,6 +309,10 @@ private:
 
 namespace pqxx
 {
+class field;
+template<typename T> T from_string(field const &value, ctx c = {});
+
+
 /// Reference to a field in a result set.
 /** This is like @ref field_ref, except it's safe to destroy the @ref result
  * object or move it to a different place in memory.
@@ -457,7 +472,7 @@ public:
     }
     else
     {
-      obj = from_string<T>(view(), make_context(loc));
+      obj = pqxx::internal::convert_field<T>(as_field_ref(), make_context(loc));
       return true;
     }
   }
@@ -581,6 +596,8 @@ public:
   }
 
 private:
+  template<typename T> friend T from_string(field const &, ctx);
+
   /** Create field as reference to a field in a result set.
    * @param r Row that this field is part of.
    * @param c Column number of this field.
@@ -656,6 +673,26 @@ inline oid field_ref::table(sl loc) const
 }
 
 
+template<typename T>
+inline T pqxx::internal::convert_field(field_ref const &f, ctx c)
+{
+  if (f.home().column_format(f.column_number()) == format::binary)
+  {
+    if constexpr (binary_decodable<T>)
+      return binary_traits<T>::from_binary(
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        bytes_view{reinterpret_cast<std::byte const *>(f.c_str()), f.size()},
+        f.type(c.loc), c);
+    else
+      throw_no_binary_decoder(name_type<T>(), c.loc);
+  }
+  if constexpr (binary_only<T>)
+    throw_binary_only(name_type<T>(), c.loc);
+  else
+    return from_string<T>(f.view(), c);
+}
+
+
 /// Specialization: `to(zview &)`.
 /** This conversion is not generally available, since the general conversion
  * would not know whether there was indeed a terminating zero at the end of
@@ -828,7 +865,7 @@ template<typename CHAR>
 /** Unlike the "regular" `from_string`, this knows how to deal with null
  * values.
  */
-template<typename T> inline T from_string(field const &value, ctx c = {})
+template<typename T> inline T from_string(field const &value, ctx c)
 {
   if (value.is_null())
   {
@@ -839,7 +876,7 @@ template<typename T> inline T from_string(field const &value, ctx c = {})
   }
   else
   {
-    return from_string<T>(value.view(), c);
+    return pqxx::internal::convert_field<T>(value.as_field_ref(), c);
   }
 }
 
@@ -859,7 +896,7 @@ template<typename T> inline T from_string(field_ref const &value, ctx c = {})
   }
   else
   {
-    return from_string<T>(value.view(), c);
+    return pqxx::internal::convert_field<T>(value, c);
   }
 }
 
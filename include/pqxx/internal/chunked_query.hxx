@@ -0,0 +1,200 @@
+/* Definition of the pqxx::internal::chunked_query class.
+ *
+ * Iterates a query's rows as they arrive, without loading the full result.
+ *
+ * DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/transaction_base instead.
+ *
+ * Copyright (c) 2000-2026, Jeroen T. Vermeulen.
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this
+ * mistake, or contact the author.
+ */
+#ifndef PQXX_INTERNAL_CHUNKED_QUERY_HXX
+#define PQXX_INTERNAL_CHUNKED_QUERY_HXX
+
+#if !defined(PQXX_HEADER_PRE)
+#  error "Include libpqxx headers as <pqxx/header>, not <pqxx/header.hxx>."
+#endif
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "pqxx/internal/statement_parameters.hxx"
+#include "pqxx/result.hxx"
+#include "pqxx/row_schema.hxx"
+#include "pqxx/transaction_focus.hxx"
+
+
+namespace pqxx
+{
+class transaction_base;
+} // namespace pqxx
+
+
+namespace pqxx::internal
+{
+/// Execute a query, and receive its rows in chunks as they arrive.
+/** This is the untyped core of @ref chunked_query.
+ *
+ * It uses libpq's "chunked rows mode" where available (libpq 17 or better).
+ * Otherwise, it uses "single-row mode," and each chunk holds just one row.
+ */
+class PQXX_LIBEXPORT row_chunks final : transaction_focus
+{
+public:
+  /// Start executing `query` on `tx`.
+  row_chunks(
+    transaction_base &tx, std::string_view query, c_params const &args,
+    int chunk_rows, sl);
+
+  row_chunks() = delete;
+  row_chunks(row_chunks const &) = delete;
+  row_chunks(row_chunks &&) = delete;
+  row_chunks &operator=(row_chunks const &) = delete;
+  row_chunks &operator=(row_chunks &&) = delete;
+
+  /// Discard any rows we haven't received yet.
+  ~row_chunks() noexcept;
+
+  /// Wait for the next chunk of rows.
+  /** Returns an empty `std::optional` once there are no more rows.  By then,
+   * the transaction is free for other work.
+   *
+   * @throw sql_error if the query fails.  This may happen after you've
+   * already received some of its rows.
+   */
+  [[nodiscard]] std::optional<result> next(sl);
+
+  /// Have we received all rows?
+  [[nodiscard]] bool done() const noexcept { return m_done; }
+
+private:
+  /// Receive and discard any remaining results, and release the transaction.
+  void close() noexcept;
+
+  std::shared_ptr<std::string> m_query;
+  bool m_done = false;
+};
+
+
+/// Iterate a query's rows as they arrive.  Used by `query_chunked()`.
+/** Where @ref transaction_base::query loads the query's full result before
+ * you see the first row, a `chunked_query` receives the rows a chunk at a
+ * time.  It only keeps one chunk in memory at a time.
+ *
+ * Unlike @ref stream_query, this does not use `COPY`.  So it works with
+ * any query, e.g. `INSERT ... RETURNING`, but it's not quite as fast.
+ *
+ * Converts each row to a `std::tuple<TYPE...>`.  Any `std::string_view` or
+ * @ref zview fields remain valid only until you move on to the next row.
+ *
+ * If you stop iterating early, the `chunked_query` still receives the rest of
+ * the rows when you destroy it, and discards them.  Use `LIMIT` in your query
+ * if you won't need all rows.
+ *
+ * @warning While you iterate, the transaction is busy.  You cannot execute
+ * queries, open a pipeline, etc. on it until you've read all the rows, or
+ * destroyed the `chunked_query`.
+ */
+template<typename... TYPE> class chunked_query final
+{
+public:
+  using value_type = std::tuple<TYPE...>;
+
+  /// Iterator.  Just barely enough to support range-based "for" loops.
+  /** A default-constructed iterator denotes the end of any iteration.
+   */
+  class iterator final
+  {
+  public:
+    using value_type = std::tuple<TYPE...>;
+    using difference_type = long;
+
+    iterator() = default;
+    explicit iterator(chunked_query &home) : m_home{&home} {}
+
+    iterator &operator++()
+    {
+      if (not m_home->advance(m_home->m_loc))
+        m_home = nullptr;
+      return *this;
+    }
+
+    [[nodiscard]] value_type const &operator*() const noexcept
+    {
+      return m_home->m_value;
+    }
+
+    /// Comparison only works for comparing to `end()`.
+    [[nodiscard]] bool operator==(iterator const &rhs) const noexcept
+    {
+      return m_home == rhs.m_home;
+    }
+
+  private:
+    chunked_query *m_home = nullptr;
+  };
+
+  chunked_query(
+    transaction_base &tx, std::string_view query, c_params const &args,
+    int chunk_rows, sl loc) :
+          m_chunks{tx, query, args, chunk_rows, loc}, m_loc{loc}
+  {}
+
+  /// Begin iterator.  Only for use by "range for."
+  /** Waits for the first row.
+   */
+  [[nodiscard]] iterator begin() &
+  {
+    if (advance(m_loc))
+      return iterator{*this};
+    else
+      return {};
+  }
+
+  /// End iterator.  Only for use by "range for."
+  [[nodiscard]] iterator end() const & noexcept { return {}; }
+
+private:
+  /// Move on to the next row.  Returns `false` if there are no more.
+  bool advance(sl loc)
+  {
+    ++m_row;
+    while (m_row >= m_size)
+    {
+      auto chunk{m_chunks.next(loc)};
+      if (not chunk)
+      {
+        m_chunk = {};
+        m_row = m_size = 0;
+        return false;
+      }
+      m_chunk = std::move(*chunk);
+      m_row = 0;
+      m_size = std::size(m_chunk);
+      // All chunks have the same columns, so build the schema only once.  It
+      // reads from `m_chunk`, which keeps its address as we replace it.
+      if ((m_size > 0) and not m_schema)
+        m_schema.emplace(m_chunk, loc);
+    }
+    m_schema->read(m_row, m_value, loc);
+    return true;
+  }
+
+  row_chunks m_chunks;
+  /// The chunk of rows we're reading.
+  result m_chunk;
+  /// The schema for reading `m_chunk`, once we've seen the first row.
+  std::optional<row_schema<TYPE...>> m_schema;
+  /// Number of the current row in `m_chunk`.
+  result::size_type m_row = -1;
+  /// Number of rows in `m_chunk`.
+  result::size_type m_size = 0;
+  /// The current row.
+  value_type m_value;
+  sl m_loc;
+};
+} // namespace pqxx::internal
+#endif
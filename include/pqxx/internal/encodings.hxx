@@ -9,10 +9,14 @@
 #ifndef PQXX_INTERNAL_ENCODINGS_HXX
 #define PQXX_INTERNAL_ENCODINGS_HXX
 
+#include <array>
+#include <bit>
 #include <cassert>
+#include <cstdint>
 #include <iomanip>
 #include <string>
 #include <string_view>
+#include <type_traits>
 
 #include "pqxx/encoding_group.hxx"
 #include "pqxx/strconv.hxx"
@@ -90,12 +94,38 @@ template<encoding_group> struct glyph_scanner final
 };
 
 
+/// Skip ahead to the first byte that matches any of `needles`.
+/** Where the library was built for SSE2 or NEON, this scans `haystack` 16
+ * bytes at a time, starting at `here`.  It stops at the first byte that
+ * matches any of the ASCII characters in `needles`, or if `stop_at_high` is
+ * set, at the first byte outside the ASCII range.  It returns that byte's
+ * offset.
+ *
+ * Towards the end of `haystack` there may not be enough bytes left for a full
+ * block.  In that case, this returns the offset where it stopped scanning,
+ * which may not be at any match.  The same happens if the library has no SIMD
+ * support, or if there are more than 8 `needles`.
+ *
+ * This is what @ref find_ascii_char uses under the bonnet.  It is not a
+ * template, so that the intrinsics stay out of the public headers.
+ */
+[[nodiscard]] PQXX_LIBEXPORT PQXX_PURE std::size_t find_ascii_or_high(
+  std::string_view haystack, std::size_t here, std::string_view needles,
+  bool stop_at_high) noexcept;
+
+
 /// Find any of the ASCII characters in `NEEDLE` in `haystack`.
 /** Scans through `haystack` until it finds a single-byte character that
  * matches any of the values in `NEEDLE`.
  *
  * Returns the offset of the character it finds, or the end of the `haystack`
  * otherwise.
+ *
+ * Where the library targets SSE2 or NEON, this scans 16 bytes at a time (see
+ * @ref find_ascii_or_high).  In the ASCII-safe encodings it simply compares
+ * every byte against `NEEDLE`.  In the other encodings it can do the same for
+ * stretches of pure ASCII text, but it walks any multibyte characters one by
+ * one so as not to mistake one of their trailing bytes for a match.
  */
 template<encoding_group ENC, char... NEEDLE>
 PQXX_INLINE_COV PQXX_HOT inline constexpr std::size_t
@@ -107,6 +137,34 @@ find_ascii_char(std::string_view haystack, std::size_t here, sl loc)
 
   auto const sz{std::size(haystack)};
   char const *PQXX_RESTRICT const data{std::data(haystack)};
+
+  if (not std::is_constant_evaluated())
+  {
+    constexpr std::array<char, sizeof...(NEEDLE)> needles{NEEDLE...};
+    constexpr bool multibyte{ENC != encoding_group::ascii_safe};
+    while (here < sz)
+    {
+      here = find_ascii_or_high(
+        haystack, here, {std::data(needles), std::size(needles)}, multibyte);
+      if (here >= sz)
+        return sz;
+      auto const c{data[here]};
+      // We're at a character boundary, so an ASCII byte here is a
+      // single-byte character.  If it matches, it's a real match.
+      if ((... or (c == NEEDLE)))
+        return here;
+      if (not multibyte or (get_byte(haystack, here) < 0x80))
+      {
+        // Not enough text left for the fast scan.  Finish it below.
+        break;
+      }
+
+      // Walk past any multibyte characters, until we're back in ASCII.
+      while ((here < sz) and (get_byte(haystack, here) >= 0x80))
+        here = glyph_scanner<ENC>::call(haystack, here, loc);
+    }
+  }
+
   while (here < sz)
   {
     // Look up the next character boundary.  This can be quite costly, so we
@@ -287,6 +345,18 @@ template<> struct glyph_scanner<encoding_group::sjis> final
 };
 
 
+/// Get the fastest available function for finding a tab or a backslash.
+/** This is the search at the heart of parsing text-format `COPY` data.  The
+ * function only works for the ASCII-safe encodings.
+ *
+ * Where the CPU supports it, the function uses SIMD instructions (SSE2, AVX2,
+ * or NEON) to scan 16 or 32 bytes at a time.  Which one that is depends on
+ * the CPU the program runs on, so we pick it at run time.
+ */
+[[nodiscard]] PQXX_LIBEXPORT PQXX_RETURNS_NONNULL char_finder_func *
+get_tab_or_backslash_finder() noexcept;
+
+
 /// Look up a character search function for an encoding group.
 /** We only define a few individual instantiations of this function, as needed.
  *
@@ -0,0 +1,39 @@
+#if !defined(PQXX_FLOAT_HXX)
+#  define PQXX_FLOAT_HXX
+
+#  include <charconv>
+#  include <span>
+
+#  include "pqxx/types.hxx"
+
+
+namespace pqxx::internal
+{
+/// Parse a decimal floating-point number.  Supports `float` and `double`.
+/** This works like `std::from_chars` in its default format, regardless of
+ * locale, and the result is correctly rounded.  It uses the Eisel-Lemire
+ * algorithm, with Clinger's fast path for the easy cases.
+ *
+ * There is one case that it leaves to the caller: when the text has more
+ * significant digits than fit in 64 bits, _and_ the digits that don't fit
+ * could make a difference to the rounding.  PostgreSQL never writes that
+ * many digits.  In that case the function returns `std::errc::not_supported`
+ * with a pointer to the end of the number, and leaves `out` unchanged.  The
+ * caller will have to use a slower method for that text.
+ */
+template<typename T>
+PQXX_LIBEXPORT std::from_chars_result
+parse_float(char const *begin, char const *end, T &out) noexcept;
+
+
+/// Write the shortest text that reads back as exactly `value`.
+/** Supports `float` and `double`.  The output is the same as what
+ * `std::to_chars(begin, end, value)` would write: fixed-point or scientific
+ * notation, whichever is shorter.  It uses the Schubfach algorithm.
+ *
+ * @return A pointer just past the text, or null if `buf` was too small.
+ */
+template<typename T>
+PQXX_LIBEXPORT char *format_float(std::span<char> buf, T value) noexcept;
+} // namespace pqxx::internal
+#endif
@@ -0,0 +1,48 @@
+#ifndef PQXX_INTERNAL_GATES_CONNECTION_ADAPTIVE_CURSORSTREAM_HXX
+#define PQXX_INTERNAL_GATES_CONNECTION_ADAPTIVE_CURSORSTREAM_HXX
+
+#include <pqxx/internal/callgate.hxx>
+
+namespace pqxx
+{
+class adaptive_cursorstream;
+} // namespace pqxx
+
+
+#include "pqxx/connection.hxx"
+
+namespace pqxx::internal::gate
+{
+class PQXX_PRIVATE connection_adaptive_cursorstream final
+        : callgate<connection>
+{
+  friend class pqxx::adaptive_cursorstream;
+
+  explicit constexpr connection_adaptive_cursorstream(reference x) noexcept :
+          super{x}
+  {}
+
+  [[nodiscard]] std::shared_ptr<std::string>
+  intern_query(std::string_view query)
+  {
+    return home().intern_query(query);
+  }
+  void start_exec_params(zview query, sl loc)
+  {
+    home().start_exec_params(query, c_params{}, format::text, loc);
+  }
+  bool consume_input() noexcept { return home().consume_input(); }
+  [[nodiscard]] bool is_busy() const noexcept { return home().is_busy(); }
+  [[nodiscard]] pqxx::internal::pq::PGresult *get_result()
+  {
+    return home().get_result();
+  }
+  result make_result(
+    pqxx::internal::pq::PGresult *pgr,
+    std::shared_ptr<std::string> const &query, sl loc)
+  {
+    return home().make_result(pgr, query, loc);
+  }
+};
+} // namespace pqxx::internal::gate
+#endif
@@ -0,0 +1,63 @@
+#ifndef PQXX_INTERNAL_GATES_CONNECTION_ASYNC_HXX
+#define PQXX_INTERNAL_GATES_CONNECTION_ASYNC_HXX
+
+#include <pqxx/internal/callgate.hxx>
+
+namespace pqxx::internal
+{
+class async_command;
+} // namespace pqxx::internal
+
+
+#include "pqxx/connection.hxx"
+
+namespace pqxx::internal::gate
+{
+class PQXX_PRIVATE connection_async final : callgate<connection>
+{
+  friend class pqxx::internal::async_command;
+
+  explicit constexpr connection_async(reference x) noexcept : super{x} {}
+
+  void set_nonblocking(bool nonblock, sl loc)
+  {
+    home().set_nonblocking(nonblock, loc);
+  }
+  [[nodiscard]] std::shared_ptr<std::string>
+  intern_query(std::string_view query)
+  {
+    return home().intern_query(query);
+  }
+  void start_prepare_unnamed(zview query, sl loc)
+  {
+    home().start_prepare_unnamed(query, loc);
+  }
+  void start_describe_unnamed(sl loc) { home().start_describe_unnamed(loc); }
+  void start_exec_params(
+    zview query, c_params const &args, format result_format, sl loc)
+  {
+    home().start_exec_params(query, args, result_format, loc);
+  }
+  [[nodiscard]] bool try_flush_output(sl loc)
+  {
+    return home().try_flush_output(loc);
+  }
+  [[nodiscard]] char const *err_msg() const noexcept
+  {
+    return home().err_msg();
+  }
+  bool consume_input() noexcept { return home().consume_input(); }
+  [[nodiscard]] bool is_busy() const noexcept { return home().is_busy(); }
+  [[nodiscard]] pqxx::internal::pq::PGresult *get_result()
+  {
+    return home().get_result();
+  }
+  result make_result(
+    pqxx::internal::pq::PGresult *pgr,
+    std::shared_ptr<std::string> const &query, sl loc)
+  {
+    return home().make_result(pgr, query, loc);
+  }
+};
+} // namespace pqxx::internal::gate
+#endif
@@ -0,0 +1,46 @@
+#ifndef PQXX_INTERNAL_GATES_CONNECTION_CHUNKED_QUERY_HXX
+#define PQXX_INTERNAL_GATES_CONNECTION_CHUNKED_QUERY_HXX
+
+#include <pqxx/internal/callgate.hxx>
+
+namespace pqxx::internal
+{
+class row_chunks;
+} // namespace pqxx::internal
+
+
+#include "pqxx/connection.hxx"
+
+namespace pqxx::internal::gate
+{
+class PQXX_PRIVATE connection_chunked_query final : callgate<connection>
+{
+  friend class pqxx::internal::row_chunks;
+
+  explicit constexpr connection_chunked_query(reference x) noexcept :
+          super{x}
+  {}
+
+  [[nodiscard]] std::shared_ptr<std::string>
+  intern_query(std::string_view query)
+  {
+    return home().intern_query(query);
+  }
+  void start_exec_params(zview query, c_params const &args, sl loc)
+  {
+    home().start_exec_params(query, args, format::text, loc);
+  }
+  void set_row_chunks(int rows, sl loc) { home().set_row_chunks(rows, loc); }
+  [[nodiscard]] pqxx::internal::pq::PGresult *get_result()
+  {
+    return home().get_result();
+  }
+  result make_result(
+    pqxx::internal::pq::PGresult *pgr,
+    std::shared_ptr<std::string> const &query, sl loc)
+  {
+    return home().make_result(pgr, query, loc);
+  }
+};
+} // namespace pqxx::internal::gate
+#endif
@@ -0,0 +1,35 @@
+#ifndef PQXX_INTERNAL_GATES_CONNECTION_NOTIFICATION_LISTENER_HXX
+#define PQXX_INTERNAL_GATES_CONNECTION_NOTIFICATION_LISTENER_HXX
+
+#include <pqxx/internal/callgate.hxx>
+
+namespace pqxx
+{
+class notification_listener;
+} // namespace pqxx
+
+
+#include "pqxx/connection.hxx"
+
+namespace pqxx::internal::gate
+{
+class PQXX_PRIVATE connection_notification_listener final
+        : callgate<connection>
+{
+  friend class pqxx::notification_listener;
+
+  explicit constexpr connection_notification_listener(reference x) noexcept :
+          super{x}
+  {}
+
+  [[nodiscard]] bool consume_input() noexcept
+  {
+    return home().consume_input();
+  }
+  PQXX_PURE [[nodiscard]] pq::PGconn *raw_connection() const noexcept
+  {
+    return home().raw_connection();
+  }
+};
+} // namespace pqxx::internal::gate
+#endif
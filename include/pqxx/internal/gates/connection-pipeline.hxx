@@ -13,7 +13,21 @@ class PQXX_PRIVATE connection_pipeline final : callgate<connection>
 
   explicit constexpr connection_pipeline(reference x) noexcept : super(x) {}
 
-  PQXX_ZARGS void start_exec(char const query[]) { home().start_exec(query); }
+  void enter_pipeline_mode(sl loc) { home().enter_pipeline_mode(loc); }
+  void exit_pipeline_mode(sl loc) { home().exit_pipeline_mode(loc); }
+  void start_exec_params(
+    zview query, c_params const &args, format result_format, sl loc)
+  {
+    home().start_exec_params(query, args, result_format, loc);
+  }
+  void start_exec_prepared(
+    zview statement, c_params const &args, format result_format, sl loc)
+  {
+    home().start_exec_prepared(statement, args, result_format, loc);
+  }
+  void pipeline_sync(sl loc) { home().pipeline_sync(loc); }
+  void flush_output(sl loc) { home().flush_output(loc); }
+  void consume_pipeline_sync(sl loc) { home().consume_pipeline_sync(loc); }
   [[nodiscard]] pqxx::internal::pq::PGresult *get_result()
   {
     return home().get_result();
@@ -0,0 +1,58 @@
+#ifndef PQXX_INTERNAL_GATES_CONNECTION_STATEMENT_BATCH_HXX
+#define PQXX_INTERNAL_GATES_CONNECTION_STATEMENT_BATCH_HXX
+
+#include <pqxx/internal/callgate.hxx>
+
+namespace pqxx::internal
+{
+class statement_batch;
+} // namespace pqxx::internal
+
+
+#include "pqxx/connection.hxx"
+
+namespace pqxx::internal::gate
+{
+class PQXX_PRIVATE connection_statement_batch final : callgate<connection>
+{
+  friend class pqxx::internal::statement_batch;
+
+  explicit constexpr connection_statement_batch(reference x) noexcept :
+          super{x}
+  {}
+
+  [[nodiscard]] std::shared_ptr<std::string>
+  intern_query(std::string_view query)
+  {
+    return home().intern_query(query);
+  }
+  void set_nonblocking(bool nonblock, sl loc)
+  {
+    home().set_nonblocking(nonblock, loc);
+  }
+  void enter_pipeline_mode(sl loc) { home().enter_pipeline_mode(loc); }
+  void exit_pipeline_mode(sl loc) { home().exit_pipeline_mode(loc); }
+  void start_exec_params(zview query, c_params const &args, sl loc)
+  {
+    home().start_exec_params(query, args, format::text, loc);
+  }
+  void start_exec_prepared(zview statement, c_params const &args, sl loc)
+  {
+    home().start_exec_prepared(statement, args, format::text, loc);
+  }
+  void pipeline_sync(sl loc) { home().pipeline_sync(loc); }
+  void flush_output(sl loc) { home().flush_output(loc); }
+  void consume_pipeline_sync(sl loc) { home().consume_pipeline_sync(loc); }
+  [[nodiscard]] pqxx::internal::pq::PGresult *get_result()
+  {
+    return home().get_result();
+  }
+  result make_result(
+    pqxx::internal::pq::PGresult *pgr,
+    std::shared_ptr<std::string> const &query, sl loc)
+  {
+    return home().make_result(pgr, query, loc);
+  }
+};
+} // namespace pqxx::internal::gate
+#endif
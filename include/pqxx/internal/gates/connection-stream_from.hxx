@@ -21,6 +21,14 @@ class PQXX_PRIVATE connection_stream_from final : callgate<connection>
   explicit constexpr connection_stream_from(reference x) noexcept : super{x} {}
 
   auto read_copy_line(sl loc) { return home().read_copy_line(loc); }
+  auto read_copy_line_nonblocking(bool &ended, sl loc)
+  {
+    return home().read_copy_line_nonblocking(ended, loc);
+  }
+  result describe_query(std::string_view query, sl loc)
+  {
+    return home().describe_query(query, loc);
+  }
 };
 } // namespace pqxx::internal::gate
 #endif
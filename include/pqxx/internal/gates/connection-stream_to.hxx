@@ -14,9 +14,9 @@ class PQXX_PRIVATE connection_stream_to final : callgate<connection>
 
   explicit constexpr connection_stream_to(reference x) noexcept : super(x) {}
 
-  void write_copy_line(std::string_view line, sl loc)
+  void write_copy_data(std::string_view data, sl loc)
   {
-    home().write_copy_line(line, loc);
+    home().write_copy_data(data, loc);
   }
   void end_copy_write(sl loc) { home().end_copy_write(loc); }
 };
@@ -36,6 +36,26 @@ class PQXX_PRIVATE connection_transaction final : callgate<connection>
     home().unregister_transaction(t);
   }
 
+  result exec_after(
+    zview first, std::string_view query, std::string_view desc, sl loc)
+  {
+    return home().exec_after(first, query, desc, loc);
+  }
+
+  result exec_bracketed(
+    zview before, std::string_view statement, bool prepared,
+    internal::c_params const &args, format result_format, zview after,
+    sl loc)
+  {
+    return home().exec_bracketed(
+      before, statement, prepared, args, result_format, after, loc);
+  }
+
+  [[nodiscard]] bool in_transaction_block() const noexcept
+  {
+    return home().in_transaction_block();
+  }
+
   auto read_copy_line(sl loc) { return home().read_copy_line(loc); }
   void write_copy_line(std::string_view line, sl loc)
   {
@@ -44,15 +64,17 @@ class PQXX_PRIVATE connection_transaction final : callgate<connection>
   void end_copy_write(sl loc) { home().end_copy_write(loc); }
 
   result exec_prepared(
-    std::string_view statement, internal::c_params const &args, sl loc)
+    std::string_view statement, internal::c_params const &args,
+    format result_format, sl loc)
   {
-    return home().exec_prepared(statement, args, loc);
+    return home().exec_prepared(statement, args, result_format, loc);
   }
 
-  result
-  exec_params(std::string_view query, internal::c_params const &args, sl loc)
+  result exec_params(
+    std::string_view query, internal::c_params const &args,
+    format result_format, sl loc)
   {
-    return home().exec_params(query, args, loc);
+    return home().exec_params(query, args, result_format, loc);
   }
 };
 } // namespace pqxx::internal::gate
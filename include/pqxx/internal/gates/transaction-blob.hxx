@@ -0,0 +1,28 @@
+#ifndef PQXX_INTERNAL_GATES_TRANSACTION_BLOB_HXX
+#define PQXX_INTERNAL_GATES_TRANSACTION_BLOB_HXX
+
+#include <pqxx/internal/callgate.hxx>
+
+#include "pqxx/transaction_base.hxx"
+
+namespace pqxx
+{
+class blob;
+} // namespace pqxx
+
+namespace pqxx::internal::gate
+{
+class PQXX_PRIVATE transaction_blob final : callgate<transaction_base>
+{
+  friend class pqxx::blob;
+
+  explicit constexpr transaction_blob(reference x) noexcept : super(x) {}
+
+  /// Make sure the transaction has started on the server.
+  /** Large object calls bypass the transaction, so if its start command is
+   * still pending, we need to send it first.
+   */
+  void start(sl loc) { home().send_pending_begin(loc); }
+};
+} // namespace pqxx::internal::gate
+#endif
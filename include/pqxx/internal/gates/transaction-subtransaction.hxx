@@ -0,0 +1,31 @@
+#ifndef PQXX_INTERNAL_GATES_TRANSACTION_SUBTRANSACTION_HXX
+#define PQXX_INTERNAL_GATES_TRANSACTION_SUBTRANSACTION_HXX
+
+#include <pqxx/internal/callgate.hxx>
+
+#include "pqxx/transaction_base.hxx"
+
+namespace pqxx
+{
+class subtransaction;
+} // namespace pqxx
+
+namespace pqxx::internal::gate
+{
+class PQXX_PRIVATE transaction_subtransaction final
+        : callgate<transaction_base>
+{
+  friend class pqxx::subtransaction;
+
+  explicit constexpr transaction_subtransaction(reference x) noexcept :
+          super(x)
+  {}
+
+  /// Make sure the parent transaction has started on the server.
+  /** A savepoint only makes sense inside a transaction, so if the parent's
+   * start command is still pending, we need to send it first.
+   */
+  void start(sl loc) { home().send_pending_begin(loc); }
+};
+} // namespace pqxx::internal::gate
+#endif
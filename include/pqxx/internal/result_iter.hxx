@@ -10,8 +10,9 @@
 #define PQXX_INTERNAL_RESULT_ITER_HXX
 
 #include <memory>
+#include <optional>
 
-#include "pqxx/internal/gates/row_ref-result.hxx"
+#include "pqxx/row_schema.hxx"
 #include "pqxx/strconv.hxx"
 
 namespace pqxx
@@ -25,12 +26,15 @@ namespace pqxx::internal
 // TODO: Replace with generator?
 // TODO: Separate type for `end()` iterator.
 /// Iterator for looped unpacking of a result.
-/** A default-constructed `result_iter` denotes the `end()` of any iteration.
+/** Reads each row using a `SCHEMA`, such as @ref pqxx::row_schema or
+ * @ref pqxx::struct_schema.
+ *
+ * A default-constructed `result_iter` denotes the `end()` of any iteration.
  */
-template<typename... TYPE> class result_iter final
+template<typename SCHEMA> class result_iter final
 {
 public:
-  using value_type = std::tuple<TYPE...>;
+  using value_type = typename SCHEMA::value_type;
 
   /// Construct an "end" iterator.
   result_iter() = default;
@@ -42,7 +46,9 @@ public:
   result_iter &operator=(result_iter &&) = delete;
 
   explicit result_iter(result const &home, sl loc = sl::current()) :
-          m_home{&home}, m_size{std::size(home)}
+          m_home{&home},
+          m_size{std::size(home)},
+          m_schema{std::in_place, home, loc}
   {
     if (not std::empty(home))
       read(loc);
@@ -75,24 +81,37 @@ public:
   value_type const &operator*() const noexcept { return m_value; }
 
 private:
-  void read(sl loc) { (*m_home)[m_index].convert(m_value, loc); }
+  void read(sl loc) { m_schema->read(m_index, m_value, loc); }
 
   result const *m_home{nullptr};
   result::size_type m_index{0};
   result::size_type m_size{0};
+  /// The schema for reading rows.  An "end" iterator doesn't have one.
+  std::optional<SCHEMA> m_schema;
   value_type m_value;
 };
 
 
+/// The @ref pqxx::row_schema for reading rows into a `std::tuple` type.
+template<typename TUPLE> struct schema_for;
+
+template<typename... TYPE> struct schema_for<std::tuple<TYPE...>> final
+{
+  using type = row_schema<TYPE...>;
+};
+
+template<typename TUPLE> using schema_for_t = typename schema_for<TUPLE>::type;
+
+
 /// Iterator for implementing @ref pqxx::result::iter().
-template<typename... TYPE> class result_iteration final
+template<typename SCHEMA> class result_iteration final
 {
 public:
-  using iterator = result_iter<TYPE...>;
+  using iterator = result_iter<SCHEMA>;
 
   explicit result_iteration(result home) : m_home{std::move(home)}
   {
-    m_home.expect_columns(sizeof...(TYPE));
+    m_home.expect_columns(SCHEMA::width);
   }
 
   [[nodiscard]] iterator begin() const
@@ -113,7 +132,13 @@ private:
 
 template<typename... TYPE> inline auto pqxx::result::iter() const
 {
-  return pqxx::internal::result_iteration<TYPE...>{*this};
+  return pqxx::internal::result_iteration<row_schema<TYPE...>>{*this};
+}
+
+
+template<auto... MEMBER> inline auto pqxx::result::iter_struct() const
+{
+  return pqxx::internal::result_iteration<struct_schema<MEMBER...>>{*this};
 }
 
 
@@ -140,9 +165,10 @@ inline void pqxx::result::for_each(CALLABLE &&func, sl loc) const
         sz, cols),
       loc};
 
-  using pass_tuple = pqxx::internal::strip_types_t<args_tuple>;
-  for (auto const r : *this)
-    std::apply(
-      func, pqxx::internal::gate::row_ref_result{r}.as_tuple<pass_tuple>(loc));
+  using schema =
+    pqxx::internal::schema_for_t<pqxx::internal::strip_types_t<args_tuple>>;
+  schema const reader{*this, loc};
+  for (size_type row{0}, rows{size()}; row < rows; ++row)
+    std::apply(func, reader.read(row, loc));
 }
 #endif
@@ -0,0 +1,151 @@
+/* Definition of the pqxx::internal::statement_batch class.
+ *
+ * Executes one statement many times over, through a pipeline.
+ *
+ * DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/transaction_base instead.
+ *
+ * Copyright (c) 2000-2026, Jeroen T. Vermeulen.
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this
+ * mistake, or contact the author.
+ */
+#ifndef PQXX_INTERNAL_STATEMENT_BATCH_HXX
+#define PQXX_INTERNAL_STATEMENT_BATCH_HXX
+
+#if !defined(PQXX_HEADER_PRE)
+#  error "Include libpqxx headers as <pqxx/header>, not <pqxx/header.hxx>."
+#endif
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "pqxx/params.hxx"
+#include "pqxx/result.hxx"
+#include "pqxx/transaction_focus.hxx"
+
+
+namespace pqxx
+{
+class transaction_base;
+} // namespace pqxx
+
+
+namespace pqxx::internal
+{
+/// Execute one statement for many sets of parameters, in a pipeline.
+/** This is the untyped core of `transaction_base::execute_many()`.
+ *
+ * It sends executions to the server without waiting for their results, but
+ * keeps a limited number in flight.  Each execution gets its own sync point,
+ * so each is like a separate call to `exec()`.
+ *
+ * If an execution fails, the batch stops sending more.  @ref finish then
+ * throws that first error.
+ */
+class PQXX_LIBEXPORT statement_batch final : transaction_focus
+{
+public:
+  /// Start a batch of executions of `statement` on `tx`.
+  /** If `keep_results` is false, the batch only keeps each execution's
+   * number of affected rows, and discards its result right away.
+   */
+  statement_batch(
+    transaction_base &tx, std::string_view statement, bool prepared,
+    bool keep_results, sl);
+
+  statement_batch() = delete;
+  statement_batch(statement_batch const &) = delete;
+  statement_batch(statement_batch &&) = delete;
+  statement_batch &operator=(statement_batch const &) = delete;
+  statement_batch &operator=(statement_batch &&) = delete;
+
+  /// Discard any results we haven't received yet.
+  ~statement_batch() noexcept;
+
+  /// Make room for `n` results.
+  void reserve(std::size_t n);
+
+  /// Queue one execution.  May receive results of earlier ones.
+  void send(params const &args, sl);
+
+  /// Has an execution failed?  If so, there's no point in sending more.
+  [[nodiscard]] bool failed() const noexcept
+  {
+    return static_cast<bool>(m_error);
+  }
+
+  /// Wait for all executions to complete.
+  /** @throw The exception for the first execution that failed, if any.
+   */
+  void finish(sl);
+
+  /// Take the results, one per execution.
+  [[nodiscard]] std::vector<result> take_results() noexcept
+  {
+    return std::move(m_results);
+  }
+
+  /// Take the numbers of affected rows, one per execution.
+  [[nodiscard]] std::vector<result::size_type> take_counts() noexcept
+  {
+    return std::move(m_counts);
+  }
+
+private:
+  /// Receive the result for the oldest execution in flight.
+  void receive(sl);
+
+  /// Receive any remaining results, and release the transaction.
+  void close(sl) noexcept;
+
+  /// Put the connection back in blocking mode, if at all possible.
+  void leave_nonblocking_mode(sl) noexcept;
+
+  std::shared_ptr<std::string> m_statement;
+  std::vector<result> m_results;
+  std::vector<result::size_type> m_counts;
+  /// The first error that came back, if any.
+  std::exception_ptr m_error;
+  /// Number of executions whose results we haven't received yet.
+  std::size_t m_in_flight = 0;
+  bool m_prepared;
+  bool m_keep_results;
+  bool m_done = false;
+};
+
+
+/// Append the fields of one `execute_many()` input row to `args`.
+/** If `MEMBER` is empty, `row` must be a @ref params, or a tuple-like type
+ * such as `std::tuple`, `std::pair`, or `std::array`.  Otherwise, `MEMBER`
+ * lists pointers to the data members (or getters) of `row` to pass.
+ */
+template<auto... MEMBER, typename ROW>
+inline void append_row(params &args, ROW const &row, sl loc)
+{
+  if constexpr (sizeof...(MEMBER) > 0)
+  {
+    (args.append(std::invoke(MEMBER, row), loc), ...);
+  }
+  else if constexpr (std::is_same_v<ROW, params>)
+  {
+    args.append(row, loc);
+  }
+  else
+  {
+    static_assert(
+      requires { std::tuple_size<ROW>::value; },
+      "For a row that is not a tuple or a params, list the members to pass.");
+    std::apply(
+      [&args, loc](auto const &...field) { (args.append(field, loc), ...); },
+      row);
+  }
+}
+} // namespace pqxx::internal
+#endif
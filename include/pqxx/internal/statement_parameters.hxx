@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "pqxx/strconv.hxx"
+#include "pqxx/types.hxx"
 #include "pqxx/util.hxx"
 
 
@@ -42,11 +43,17 @@ constexpr inline auto const iterator_identity{
  */
 struct PQXX_LIBEXPORT c_params final
 {
-  c_params() = default;
+  /// Create an empty `c_params`.
+  /** Where possible, this takes over the buffers of a `c_params` that the
+   * same thread destroyed earlier.  That way, executing a statement usually
+   * needn't allocate them anew.
+   */
+  c_params() noexcept;
   /// Copying these objects is pointless and expensive.  Don't do it.
   c_params(c_params const &) = delete;
   c_params(c_params &&) = default;
-  ~c_params() = default;
+  /// Leave the buffers for the next `c_params` in this thread to reuse.
+  ~c_params() noexcept;
 
   c_params &operator=(c_params const &) = delete;
   c_params &operator=(c_params &&) = default;
@@ -62,6 +69,11 @@ struct PQXX_LIBEXPORT c_params final
   std::vector<int> lengths;
   /// As used by libpq: effectively boolean "is this a binary parameter?"
   std::vector<int> formats;
+  /// As used by libpq: parameter types, or empty to let the server decide.
+  /** Where there are types, a zero means the server decides that parameter's
+   * type.
+   */
+  std::vector<oid> types;
 
   // NOLINTEND(misc-non-private-member-variables-in-classes)
 };
@@ -17,6 +17,11 @@
 #  error "Include libpqxx headers as <pqxx/header>, not <pqxx/header.hxx>."
 #endif
 
+#include <array>
+#include <string_view>
+#include <utility>
+
+#include "pqxx/binary.hxx"
 #include "pqxx/internal/encodings.hxx"
 #include "pqxx/internal/gates/connection-stream_from.hxx"
 #include "pqxx/transaction_focus.hxx"
@@ -56,6 +61,21 @@ class stream_query_end_iterator
  * state, so you won't be able to do many other things with the connection or
  * the transaction while the stream is open.
  *
+ * The stream can read the `COPY` data in text or binary format.  In binary
+ * format there is no escaping or text parsing, but the data doesn't say what
+ * SQL type each field has.  The stream assumes that each column has the SQL
+ * type that matches the C++ type you're reading it into: see
+ * @ref pqxx::internal::guess_binary_type.  If that's not the case, cast the
+ * column in your query.  Strings are the exception: if you read any column
+ * into a string, the stream first asks the server for the columns' types.
+ * That costs extra round trips, but it means that reading, say, a `uuid`
+ * into a string will convert it, and reading a `timestamptz` into a string
+ * will throw @ref conversion_error, rather than give you raw binary data.
+ *
+ * Normally you iterate a stream, and every step waits for the next row to
+ * arrive.  But you can also read it without blocking, using @ref try_read_row.
+ * That way, a single thread can serve many streams on different connections.
+ *
  * Usually you'll want the `stream` convenience wrapper in
  * @ref transaction_base, so you don't need to deal with this class directly.
  *
@@ -71,7 +91,37 @@ public:
 
   /// Execute `query` on `tx`, stream results.
   inline stream_query(
-    transaction_base &tx, std::string_view query, conversion_context c);
+    transaction_base &tx, std::string_view query, conversion_context c,
+    format fmt = format::text);
+
+  /// Take over a `COPY` that the caller already started, on `tx`.
+  /** The caller executed @ref copy_query, and `started` is its result.  This
+   * is how an @ref async_stream_query starts its stream without blocking.
+   *
+   * If @ref needs_types says so, `described` must be the server's
+   * description of the query.  Otherwise, it may be an empty result.
+   */
+  inline stream_query(
+    transaction_base &tx, result const &started, result const &described,
+    conversion_context c, format fmt);
+
+  /// Does the stream need to know the query's column types up front?
+  /** This is the case for a binary stream that reads any column into a
+   * string.
+   */
+  [[nodiscard]] static constexpr bool needs_types(format fmt) noexcept
+  {
+    return (fmt == format::binary) and (needs_sql_type<TYPE> or ...);
+  }
+
+  /// The `COPY` command that streams the output of `query`.
+  [[nodiscard]] static std::string
+  copy_query(std::string_view query, format fmt)
+  {
+    return std::format(
+      "COPY ({}) TO STDOUT{}", query,
+      (fmt == format::binary) ? " (FORMAT binary)" : "");
+  }
 
   stream_query(stream_query const &) = delete;
   stream_query(stream_query &&) = delete;
@@ -106,39 +156,131 @@ public:
    */
   [[nodiscard]] auto end() const & { return stream_query_end_iterator{}; }
 
+  /// Is this stream reading binary `COPY` data?
+  [[nodiscard]] bool binary() const noexcept
+  {
+    return m_format == format::binary;
+  }
+
   /// Parse and convert the latest line of data we received.
-  std::tuple<TYPE...> parse_line(std::string_view line) &
+  /** In text format, this works directly in the line's buffer.  It unescapes
+   * each field in place, and terminates it with a zero.  A field that needs
+   * no unescaping (which is the normal case) just stays where it is.
+   *
+   * In text format, `line` must be followed by a field separator and a
+   * terminating zero, as set up by @ref prepare_line.
+   */
+  std::tuple<TYPE...> parse_line(std::span<char> line) &
   {
     assert(not done());
+    if (binary())
+      return parse_binary_line(std::as_bytes(line));
+    return convert_fields(unescape_line(line));
+  }
 
-    auto const line_size{std::size(line)};
-
-    // This function uses m_row as a buffer, across calls.  The only reason for
-    // it to carry over across calls is to avoid reallocation.
+  /// Views on a text line's fields, once unescaped.  Null fields are null.
+  using field_views = std::array<std::string_view, sizeof...(TYPE)>;
 
-    // Make room for unescaping the line.  It's a pessimistic size.
-    // Unusually, we're storing terminating zeroes *inside* the string.
-    // This is the only place where we modify m_row.  MAKE SURE THE BUFFER DOES
-    // NOT GET RESIZED while we're working, because we're working with views
-    // into its buffer.
-    m_row.resize(line_size + 1);
+  /// Like @ref parse_line, but safe to call repeatedly for the same line.
+  /** In text format, unescaping a line overwrites it, so it can only happen
+   * once.  The first call for a line unescapes it, stores views on its fields
+   * in `fields`, and sets `unescaped`.  Later calls just convert those same
+   * fields again.
+   */
+  std::tuple<TYPE...>
+  reparse_line(std::span<char> line, field_views &fields, bool &unescaped) &
+  {
+    assert(not done());
+    if (binary())
+      return parse_binary_line(std::as_bytes(line));
+    if (not unescaped)
+    {
+      fields = unescape_line(line);
+      unescaped = true;
+    }
+    return convert_fields(fields);
+  }
 
-    std::size_t offset{0u};
-    char *write{m_row.data()};
+  /// Read a COPY line from the server.
+  std::pair<line_handle, std::size_t> read_line(sl) &;
 
-    // DO NOT shrink m_row to fit.  We're carrying views pointing into the
-    // buffer.  (Also, how useful would shrinking really be?)
+  /// Read the next row, but only if we can do that without blocking.
+  /** This lets one thread serve many streams, on different connections.  You
+   * can use `poll()`, `epoll()` or similar on each connection's socket (see
+   * @ref connection::sock) to find out when it has data for you.
+   *
+   * If a row is available, this function returns it.  If not, it returns an
+   * empty `std::optional`.  In that case, either the stream has finished (see
+   * @ref done), or the server simply hasn't sent the data yet.  Wait for the
+   * connection's socket to become readable, and try again.
+   *
+   * Any `std::string_view` or @ref zview fields in the row will only remain
+   * valid until your next call.
+   *
+   * Do not mix this with iteration on the same stream.
+   */
+  std::optional<std::tuple<TYPE...>> try_read_row(sl loc = sl::current()) &;
 
-    // Folding expression: scan and unescape each field, and convert it to its
-    // requested type.
-    std::tuple<TYPE...> data{parse_field<TYPE>(line, offset, write, m_ctx)...};
+  /// Get a newly read COPY line ready for @ref parse_line.
+  /** The line's buffer must have room for one more byte after `size`; libpq
+   * guarantees that.
+   *
+   * @return The row data to parse, or an empty `std::optional` if the line
+   * contains no row.  That happens at the end of binary data.
+   */
+  std::optional<std::span<char>>
+  prepare_line(char *line, std::size_t size, sl loc) &
+  {
+    if (binary())
+    {
+      // The size we get excludes the last byte, which in text format is the
+      // newline.  Binary data has no newline, so that byte is real data.
+      ++size;
+      auto const start{binary_row_start({line, size}, loc)};
+      if (start == size)
+        return {};
+      return std::span<char>{line + start, size - start};
+    }
 
-    assert(offset == line_size + 1u);
-    return data;
+    // Replace the newline at the end with the field separator, so the parsing
+    // loop only needs to scan for a tab, not a tab or a newline.
+    assert(line[size] == '\n');
+    line[size] = '\t';
+    return std::span<char>{line, size};
   }
 
-  /// Read a COPY line from the server.
-  std::pair<line_handle, std::size_t> read_line(sl) &;
+  /// Find where the row starts in a message of binary `COPY` data.
+  /** The first message starts with a file header, which this skips.
+   *
+   * @return Offset of the row data in `msg`, or `std::size(msg)` if `msg`
+   * contains no row, only the end-of-data marker.
+   */
+  std::size_t binary_row_start(std::string_view msg, sl loc) &
+  {
+    constexpr std::string_view signature{"PGCOPY\n\377\r\n\0", 11};
+    // Signature, flags, and length of the header extension.
+    constexpr std::size_t header{std::size(signature) + 4 + 4};
+    std::size_t offset{0};
+    if (m_header_pending)
+    {
+      if (
+        (std::size(msg) < header) or
+        (msg.substr(0, std::size(signature)) != signature)) [[unlikely]]
+        throw failure{"Binary COPY data has no valid header.", loc};
+      auto const ext{read_big_endian<std::uint32_t>(
+        std::data(binary_cast(msg)) + std::size(signature) + 4)};
+      offset = header + ext;
+      if (offset > std::size(msg)) [[unlikely]]
+        throw failure{"Binary COPY header is truncated.", loc};
+      m_header_pending = false;
+    }
+    if (
+      (std::size(msg) - offset == 2) and
+      (read_big_endian<std::int16_t>(
+         std::data(binary_cast(msg)) + offset) == -1))
+      return std::size(msg);
+    return offset;
+  }
 
 private:
   /// Look up a char_finder_func.
@@ -148,31 +290,31 @@ private:
   PQXX_PURE PQXX_RETURNS_NONNULL static inline char_finder_func *
   get_finder(transaction_base const &tx, sl);
 
-  /// Scan and unescape a field into the row buffer.
-  /** The row buffer is `m_row`.
+  /// Scan and unescape a field, in place.
+  /** Unescaping only ever makes a field shorter, so we can write the field's
+   * unescaped text over the original.  In the common case where the field
+   * contains no escape sequences, it stays exactly where it is, and the only
+   * write is a terminating zero over the field separator.
    *
    * @param line The line of COPY output.
    * @param offset The current scanning position inside `line`.
-   * @param write The current writing position in the row buffer.
    *
-   * @return new `offset`; new `write`; and a `string_view` on the unescaped
-   * field text in the row buffer.
+   * @return new `offset`, and a `string_view` on the unescaped field text.
    *
    * The `string_view`'s data pointer will be nullptr for a null field.
    *
    * After reading the final field in a row, if all goes well, offset should be
    * one greater than the size of the line, pointing at the terminating zero.
    */
-  std::tuple<std::size_t, char *, std::string_view>
-  read_field(std::string_view line, std::size_t offset, char *write, ctx c)
+  std::pair<std::size_t, std::string_view>
+  read_field(std::span<char> line, std::size_t offset, ctx c)
   {
-#if !defined(NDEBUG)
     auto const line_size{std::size(line)};
-#endif
 
     assert(offset <= line_size);
 
-    char const *lp{std::data(line)};
+    char *const lp{std::data(line)};
+    std::string_view const text{lp, line_size};
 
     // The COPY line now ends in a tab.  (We replace the trailing newline with
     // that to simplify the loop here.)
@@ -185,12 +327,15 @@ private:
       offset += 3;
       assert(offset <= (line_size + 1));
       assert(lp[offset - 1] == '\t');
-      // Return a null value.  There's nothing to write into m_row.
-      return {offset, write, {}};
+      // Return a null value.
+      return {offset, {}};
     }
 
-    // Beginning of the field text in the row buffer.
-    char const *const field_begin{write};
+    // Beginning of the field text.
+    char *const field_begin{lp + offset};
+    // Where we write the unescaped text.  Until we find an escape sequence,
+    // this is the same as the reading position.
+    char *write{field_begin};
 
     // We're relying on several assumptions just for making the main loop
     // condition work:
@@ -207,12 +352,15 @@ private:
       // It may be right where we start searching, and this won't loop forever
       // since the previous iteration (if any) put us right _after_ the
       // previous character of interest.
-      auto const stop_char{m_char_finder(line, offset, c.loc)};
+      auto const stop_char{m_char_finder(text, offset, c.loc)};
       PQXX_ASSUME(stop_char >= offset);
       assert(stop_char < (line_size + 1));
 
-      // Copy the text we have so far.  It's got no special characters in it.
-      std::memcpy(write, &lp[offset], stop_char - offset);
+      // Move the text we have so far, if an earlier escape sequence left us
+      // writing behind the reading position.  It's got no special characters
+      // in it.
+      if (write != lp + offset)
+        std::memmove(write, lp + offset, stop_char - offset);
       write += (stop_char - offset);
       offset = stop_char;
 
@@ -243,44 +391,51 @@ private:
       }
     }
 
-    // Hit the end of the field.
+    // Hit the end of the field.  Terminate the unescaped text, overwriting
+    // the separator if there was nothing to unescape.
     assert(lp[offset] == '\t');
     *write = '\0';
-    ++write;
     ++offset;
     return {
-      offset,
-      write,
-      {field_begin, static_cast<std::size_t>(write - field_begin - 1)}};
+      offset, {field_begin, static_cast<std::size_t>(write - field_begin)}};
   }
 
-  /// Parse the next field.
-  /** Unescapes the field into the row buffer (m_row), and converts it to its
-   * TARGET type.
-   *
-   * Using non-const reference parameters here, so we can propagate side
-   * effects across a fold expression.
-   *
-   * @param line The latest COPY line.
-   * @param offset The current parsing offset in `line`.  The function will
-   *   update this value.
-   * @param write The current writing position in the row buffer.  The
-   *   function will update this value.
-   * @return Field value converted to TARGET type.
+  /// Scan and unescape all fields in a text line, in place.
+  /** This overwrites the line, so do it only once per line.
+   */
+  field_views unescape_line(std::span<char> line) &
+  {
+    field_views fields;
+    std::size_t offset{0u};
+    for (auto &field : fields)
+    {
+      auto const [new_offset, text]{read_field(line, offset, m_ctx)};
+      PQXX_ASSUME(new_offset > offset);
+      offset = new_offset;
+      field = text;
+    }
+    assert(offset == std::size(line) + 1u);
+    return fields;
+  }
+
+  /// Convert a text line's unescaped fields to their respective types.
+  std::tuple<TYPE...> convert_fields(field_views const &fields) &
+  {
+    return [this, &fields]<std::size_t... INDEX>(
+             std::index_sequence<INDEX...>) {
+      return std::tuple<TYPE...>{
+        convert_field_text<TYPE>(fields[INDEX], m_ctx)...};
+    }(std::index_sequence_for<TYPE...>{});
+  }
+
+  /// Convert an unescaped field's text to its TARGET type.
+  /** The text's data pointer is null for a null field.
    */
   template<typename TARGET>
-  TARGET
-  parse_field(std::string_view line, std::size_t &offset, char *&write, ctx c)
+  TARGET convert_field_text(std::string_view text, ctx c)
   {
     using field_type = std::remove_cvref_t<TARGET>;
 
-    assert(offset <= std::size(line));
-
-    auto [new_offset, new_write, text]{read_field(line, offset, write, c)};
-    PQXX_ASSUME(new_offset > offset);
-    PQXX_ASSUME(new_write >= write);
-    offset = new_offset;
-    write = new_write;
     if constexpr (pqxx::always_null<TARGET>())
     {
       if (std::data(text) != nullptr)
@@ -302,6 +457,84 @@ private:
     }
   }
 
+  /// Parse and convert a row of binary `COPY` data.
+  std::tuple<TYPE...> parse_binary_line(bytes_view row) &
+  {
+    if (std::size(row) < 2) [[unlikely]]
+      throw conversion_error{"Binary COPY row is truncated.", m_ctx.loc};
+    auto const fields{read_big_endian<std::int16_t>(std::data(row))};
+    if (std::cmp_not_equal(fields, sizeof...(TYPE))) [[unlikely]]
+      throw conversion_error{
+        std::format(
+          "Binary COPY row has {} fields; expected {}.", fields,
+          sizeof...(TYPE)),
+        m_ctx.loc};
+    std::size_t offset{2};
+    auto data{[this, row, &offset]<std::size_t... INDEX>(
+                std::index_sequence<INDEX...>) {
+      // Braced initialisation evaluates the fields in order.
+      return std::tuple<TYPE...>{
+        parse_binary_field<TYPE>(row, offset, m_types[INDEX], m_ctx)...};
+    }(std::index_sequence_for<TYPE...>{})};
+    if (offset != std::size(row)) [[unlikely]]
+      throw conversion_error{
+        "Binary COPY row has unexpected data at the end.", m_ctx.loc};
+    return data;
+  }
+
+  /// Parse the next field in a row of binary `COPY` data.
+  /** @param row The row of binary data.
+   * @param offset The current parsing offset in `row`.  The function will
+   *   move it past the field.
+   * @param type The field's SQL type, or @ref oid_none if we don't know it.
+   * @return Field value converted to TARGET type.
+   */
+  template<typename TARGET>
+  TARGET
+  parse_binary_field(bytes_view row, std::size_t &offset, oid type, ctx c)
+  {
+    using field_type = std::remove_cvref_t<TARGET>;
+    constexpr std::size_t len_size{4};
+
+    if (std::size(row) - offset < len_size) [[unlikely]]
+      throw conversion_error{"Binary COPY row is truncated.", c.loc};
+    auto const len{read_big_endian<std::int32_t>(std::data(row) + offset)};
+    offset += len_size;
+
+    if (len < 0)
+    {
+      if constexpr (has_null<TARGET>())
+        return make_null<TARGET>();
+      else
+        internal::throw_null_conversion(name_type<field_type>(), c.loc);
+    }
+    auto const size{static_cast<std::size_t>(len)};
+    if (std::size(row) - offset < size) [[unlikely]]
+      throw conversion_error{"Binary COPY row is truncated.", c.loc};
+    auto const data{row.subspan(offset, size)};
+    offset += size;
+
+    if constexpr (pqxx::always_null<TARGET>())
+      throw conversion_error{std::format(
+        "Streaming a non-null value into a {}, which must always be null.",
+        name_type<field_type>())};
+    else if constexpr (binary_decodable<field_type>)
+      return binary_traits<field_type>::from_binary(
+        data,
+        (type == oid_none) ? guess_binary_type<field_type>(size) : type, c);
+    else
+      throw_no_binary_decoder(name_type<field_type>(), c.loc);
+  }
+
+  /// Take the columns' SQL types from the server's description of the query.
+  void take_types(result const &described)
+  {
+    described.expect_columns(sizeof...(TYPE), m_ctx.loc);
+    for (std::size_t col{0}; col < sizeof...(TYPE); ++col)
+      m_types[col] =
+        described.column_type(static_cast<row_size_type>(col), m_ctx.loc);
+  }
+
   /// If this stream isn't already closed, close it now.
   void close() noexcept
   {
@@ -319,15 +552,25 @@ private:
    */
   char_finder_func *m_char_finder;
 
-  /// Current row's fields' text, combined into one reusable string.
-  /** We carry this buffer over from one invocation to the next, not because we
-   * need the data, but just so we can re-use the space.  It saves us having to
-   * re-allocate it every time.
-   */
-  std::string m_row;
-
   /// Caller source location, encoding group, possibly more.
   conversion_context const m_ctx;
+
+  /// The `COPY` data format: text or binary.
+  format const m_format;
+
+  /// In binary format: the columns' SQL types, if we asked for them.
+  /** Otherwise, these are all @ref oid_none.
+   */
+  std::array<oid, sizeof...(TYPE)> m_types{};
+
+  /// In binary format: are we still expecting the file header?
+  bool m_header_pending = true;
+
+  /// The last line we read in @ref try_read_row.
+  line_handle m_line{nullptr, pqxx::internal::pq::pqfreemem};
+
+  /// For @ref try_read_row: has the server signalled the end of the COPY?
+  bool m_copy_ended = false;
 };
 } // namespace pqxx::internal
 #endif
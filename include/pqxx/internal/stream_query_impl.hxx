@@ -10,23 +10,51 @@ namespace pqxx::internal
 {
 template<typename... TYPE>
 inline stream_query<TYPE...>::stream_query(
-  transaction_base &tx, std::string_view query, conversion_context c) :
+  transaction_base &tx, std::string_view query, conversion_context c,
+  format fmt) :
         transaction_focus{tx, "stream_query"},
         m_char_finder{get_finder(tx, c.loc)},
-        m_ctx{c}
+        m_ctx{c},
+        m_format{fmt}
 {
-  auto const r{tx.exec(std::format("COPY ({}) TO STDOUT", query), m_ctx.loc)};
+  if (needs_types(fmt))
+    take_types(
+      internal::gate::connection_stream_from{tx.conn()}.describe_query(
+        query, m_ctx.loc));
+  auto const r{tx.exec(copy_query(query, fmt), m_ctx.loc)};
   r.expect_columns(sizeof...(TYPE), m_ctx.loc);
   r.expect_rows(0, m_ctx.loc);
   register_me();
 }
 
 
+template<typename... TYPE>
+inline stream_query<TYPE...>::stream_query(
+  transaction_base &tx, result const &started, result const &described,
+  conversion_context c, format fmt) :
+        transaction_focus{tx, "stream_query"},
+        m_char_finder{get_finder(tx, c.loc)},
+        m_ctx{c},
+        m_format{fmt}
+{
+  if (needs_types(fmt))
+    take_types(described);
+  started.expect_columns(sizeof...(TYPE), m_ctx.loc);
+  started.expect_rows(0, m_ctx.loc);
+  register_me();
+}
+
+
 template<typename... TYPE>
 PQXX_RETURNS_NONNULL inline char_finder_func *
 stream_query<TYPE...>::get_finder(transaction_base const &tx, sl loc)
 {
   auto const group{tx.conn().get_encoding_group(loc)};
+  // This is the hot loop for text-format streams, so for the most common
+  // encodings, we use a search that picks the widest vector instructions the
+  // CPU supports.
+  if (group == encoding_group::ascii_safe)
+    return get_tab_or_backslash_finder();
   return get_char_finder<'\t', '\\'>(group, loc);
 }
 
@@ -76,10 +104,13 @@ public:
     return *this;
   }
 
-  /// Dereference.  There's no caching in here, so don't repeat calls.
+  /// Dereference.
+  /** Converts the row's fields every time, so don't repeat calls if you can
+   * avoid it.
+   */
   value_type operator*() const
   {
-    return m_home->parse_line(std::string_view{m_line.get(), m_line_size});
+    return m_home->reparse_line(m_row, m_fields, m_unescaped);
   }
 
   /// Are we at the end?
@@ -108,22 +139,23 @@ private:
   [[nodiscard]] bool done() const noexcept { return m_home->done(); }
 
   /// Read a line from the stream, store it in the iterator.
-  /** Replaces the newline at the end with a tab, as a sentinel to simplify
-   * (and thus hopefully speed up) the field parsing loop.
+  /** Skips any lines that contain no row data.
    */
   void consume_line(sl loc) &
   {
-    auto [line, size]{m_home->read_line(loc)};
-    m_line = std::move(line);
-    m_line_size = size;
-    if (m_line)
+    m_row = {};
+    m_unescaped = false;
+    while (not done())
     {
-      // We know how many fields to expect.  Replace the newline at the end
-      // with the field separator, so the parsing loop only needs to scan for a
-      // tab, not a tab or a newline.
-      char *const ptr{m_line.get()};
-      assert(ptr[size] == '\n');
-      ptr[size] = '\t';
+      auto [line, size]{m_home->read_line(loc)};
+      m_line = std::move(line);
+      if (not m_line)
+        break;
+      if (auto const row{m_home->prepare_line(m_line.get(), size, loc)})
+      {
+        m_row = *row;
+        break;
+      }
     }
   }
 
@@ -132,8 +164,14 @@ private:
   /// Last COPY line we read, allocated by libpq.
   typename stream_t::line_handle m_line;
 
-  /// Length of the last COPY line we read.
-  std::size_t m_line_size = 0u;
+  /// The row data in `m_line`, ready for parsing.
+  std::span<char> m_row;
+
+  /// The fields in `m_row`, once we've unescaped it.
+  mutable typename stream_t::field_views m_fields;
+
+  /// Have we unescaped `m_row` yet?
+  mutable bool m_unescaped = false;
 
   /// A `std::source_location` for where this object was created.
   sl const m_created_loc;
@@ -169,5 +207,41 @@ stream_query<TYPE...>::read_line(sl loc) &
     throw;
   }
 }
+
+
+template<typename... TYPE>
+inline std::optional<std::tuple<TYPE...>>
+stream_query<TYPE...>::try_read_row(sl loc) &
+{
+  internal::gate::connection_stream_from gate{trans().conn()};
+  while (not done())
+  {
+    decltype(gate.read_copy_line_nonblocking(m_copy_ended, loc)) line;
+    try
+    {
+      line = gate.read_copy_line_nonblocking(m_copy_ended, loc);
+    }
+    catch (std::exception const &)
+    {
+      close();
+      throw;
+    }
+    if (not line)
+    {
+      // Nothing available yet.
+      return {};
+    }
+    if (not line->first) [[unlikely]]
+    {
+      // This is how we get told the iteration is finished.
+      close();
+      return {};
+    }
+    m_line = std::move(line->first);
+    if (auto const row{prepare_line(m_line.get(), line->second, loc)})
+      return parse_line(*row);
+  }
+  return {};
+}
 } // namespace pqxx::internal
 #endif
@@ -36,8 +36,11 @@ PQXX_LIBEXPORT void wait_for(unsigned int microseconds);
  * reduce this particular overhead in your application, until some other source
  * of overhead becomes more significant.  At that point... stop increasing the
  * wait time and go fix that other thing!
+ *
+ * @return Whether the socket became ready, or reported an error, before the
+ * wait ended.  Pass a zero timeout to check without waiting.
  */
-PQXX_LIBEXPORT void wait_fd(
+PQXX_LIBEXPORT bool wait_fd(
   int fd, bool for_read, bool for_write, unsigned seconds = 1,
   unsigned microseconds = 0, sl = sl::current());
 } // namespace pqxx::internal
@@ -30,6 +30,27 @@ enum class write_policy
 };
 
 
+/// When should a transaction start on the server?
+/** Also not an isolation level, but it's a transaction setting all the same.
+ *
+ * With `immediate`, creating a @ref transaction executes a `BEGIN` right
+ * away.  That costs a round trip to the server.
+ *
+ * With `deferred`, the transaction holds on to its `BEGIN`, and sends it
+ * along with the first statement you execute.  Both go to the server in a
+ * single round trip.  If you never execute anything, the transaction never
+ * talks to the server at all.
+ *
+ * @warning The deprecated @ref largeobject and @ref largeobjectaccess classes
+ * don't know about deferred transactions.  Use @ref blob instead.
+ */
+enum class begin_policy
+{
+  immediate,
+  deferred
+};
+
+
 /// Transaction isolation levels.
 /** These are as defined in the SQL standard.  But there are a few notes
  * specific to PostgreSQL.
@@ -0,0 +1,231 @@
+/* Definition of the pqxx::notification_listener class.
+ *
+ *   High-volume notification handling on a dedicated connection.
+ *
+ * DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/notification_listener
+ * instead.
+ *
+ * Copyright (c) 2000-2026, Jeroen T. Vermeulen.
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this
+ * mistake, or contact the author.
+ */
+#ifndef PQXX_NOTIFICATION_LISTENER_HXX
+#define PQXX_NOTIFICATION_LISTENER_HXX
+
+#if !defined(PQXX_HEADER_PRE)
+#  error "Include libpqxx headers as <pqxx/header>, not <pqxx/header.hxx>."
+#endif
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "pqxx/connection.hxx"
+
+
+namespace pqxx
+{
+/// A notification as a @ref notification_listener delivers it.
+/** Unlike @ref notification, this does not refer to the connection.  A
+ * handler may run on a different thread from the one that owns the
+ * connection, so it must not touch the connection anyway.
+ *
+ * @warning The views are only valid for the duration of the handler call.
+ */
+struct received_notification final
+{
+  /// Channel name.
+  zview channel;
+
+  /// Optional payload text.  Empty if the notification carried no payload.
+  zview payload;
+
+  /// Process ID of the backend that sent the notification.
+  int backend_pid = 0;
+};
+
+
+/// Settings for a @ref notification_listener.
+struct listener_config final
+{
+  /// Queue notifications for worker threads, instead of handling them inline.
+  /** If this is `false`, @ref notification_listener::poll calls the handlers
+   * itself, on the thread that reads the notifications.
+   *
+   * If it is `true`, `poll()` only routes each notification to its handler,
+   * and queues it.  Worker threads call @ref notification_listener::serve to
+   * run the handlers.
+   */
+  bool hand_off{false};
+
+  /// Maximum number of notifications that one `poll()` takes in.
+  /** A `poll()` reads whatever input the socket has for us, and then takes
+   * up to this many notifications from it in one go.  In hand-off mode, it
+   * queues them all under a single lock.
+   */
+  std::size_t batch_size{1024};
+};
+
+
+/// Receive and dispatch notifications on a dedicated connection.
+/** Where @ref connection::listen is convenient for the odd notification, a
+ * `notification_listener` is built for heavy traffic:
+ * * Routing a notification to its handler is a hash lookup on the channel
+ *   name, without copying it.
+ * * There is no per-notification copy of the payload either.  The listener
+ *   hands out views into libpq's own buffer.
+ * * It reads notifications in batches, so it can keep up with bursts.
+ * * Optionally, it hands notifications off to a pool of worker threads, so
+ *   that slow handlers don't hold up the thread that reads the socket.
+ *
+ * The listener takes ownership of a connection.  Don't use that connection
+ * for anything else.
+ *
+ * Call @ref listen, @ref poll, and @ref wait from one thread only, the "I/O
+ * thread."  You can wait on @ref sock in your own event loop, and call
+ * `poll()` when it becomes readable; or just call `wait()` in a loop.
+ *
+ * In hand-off mode (see @ref listener_config::hand_off), any number of
+ * worker threads can call @ref serve to run the queued handlers.
+ *
+ * @warning Stop all `serve()` calls before you destroy the listener.
+ */
+class PQXX_LIBEXPORT notification_listener final
+{
+public:
+  /// A callback for incoming notifications on a channel.
+  /** In hand-off mode, several worker threads may call the same handler
+   * concurrently.
+   */
+  using handler = std::function<void(received_notification const &)>;
+
+  /// Take over connection `cx` for listening.
+  /** @throw usage_error if the connection has a transaction open.
+   * @throw argument_error if `config.batch_size` is zero.
+   */
+  explicit notification_listener(
+    connection &&cx, listener_config config = {}, sl loc = sl::current());
+
+  notification_listener() = delete;
+  notification_listener(notification_listener const &) = delete;
+  notification_listener(notification_listener &&) = delete;
+  notification_listener &operator=(notification_listener const &) = delete;
+  notification_listener &operator=(notification_listener &&) = delete;
+  ~notification_listener() noexcept;
+
+  /// Attach a handler to a notification channel.
+  /** Executes a `LISTEN` if we weren't listening on `channel` yet.  If we
+   * were, the new handler replaces the old one.  Notifications that are
+   * already queued still go to the old handler.
+   *
+   * An empty handler (the default) cancels listening on the channel.
+   *
+   * Only call this from the I/O thread.
+   */
+  void listen(
+    std::string_view channel, handler h = {}, sl loc = sl::current());
+
+  /// The listener connection's socket.
+  /** Wait for this to become readable in your own event loop, and then call
+   * @ref poll.
+   */
+  [[nodiscard]] int sock() const noexcept { return m_conn.sock(); }
+
+  /// Take in and dispatch any notifications that have arrived.
+  /** Does not wait for the network.  Takes in at most one batch.
+   *
+   * Without hand-off, this calls the handlers, and passes on any exception
+   * from a handler.  Remaining notifications wait for the next call.
+   *
+   * Only call this from the I/O thread.
+   *
+   * @return Number of notifications taken in.
+   * @throw broken_connection if the connection failed.
+   */
+  std::size_t poll(sl loc = sl::current());
+
+  /// Wait for notifications to arrive, then @ref poll.
+  /** Returns early if notifications come in, but may also return early for
+   * other reasons.
+   *
+   * Only call this from the I/O thread.
+   *
+   * @return Number of notifications taken in.
+   */
+  std::size_t wait(
+    std::chrono::microseconds timeout = std::chrono::seconds{10},
+    sl loc = sl::current());
+
+  /// Run queued handlers, until `stop` is requested.
+  /** For use by worker threads in hand-off mode.  Waits for notifications to
+   * come into the queue, and handles them.  Returns when `stop` is
+   * requested.
+   *
+   * If a handler throws an exception, `serve()` passes it on.  The worker
+   * can call `serve()` again to carry on.
+   */
+  void serve(std::stop_token stop);
+
+  /// Run the handlers for up to `max` queued notifications.
+  /** For use by worker threads in hand-off mode, or for draining the queue.
+   * Does not wait for notifications to arrive.
+   *
+   * If a handler throws an exception, this passes it on.
+   *
+   * @return Number of notifications handled.
+   */
+  std::size_t run_queued(std::size_t max = std::size_t(-1));
+
+  /// Number of notifications waiting in the hand-off queue.
+  [[nodiscard]] std::size_t queued() const;
+
+  /// The listener's settings.
+  [[nodiscard]] listener_config const &config() const noexcept
+  {
+    return m_config;
+  }
+
+private:
+  /// Unique pointer to a libpq notification.
+  using notify_ptr =
+    std::unique_ptr<internal::pq::PGnotify, void (*)(void const *)>;
+
+  /// A notification in the hand-off queue, with its handler.
+  struct job final
+  {
+    std::shared_ptr<handler const> fn;
+    notify_ptr notif;
+  };
+
+  /// Run one job's handler.
+  static void run(job const &);
+
+  connection m_conn;
+  listener_config const m_config;
+
+  /// Handlers by channel name.  Only the I/O thread touches this.
+  /** The handlers live in `shared_ptr`s so that queued jobs can keep theirs
+   * alive, even if the I/O thread replaces it in the meantime.
+   */
+  std::unordered_map<
+    std::string, std::shared_ptr<handler const>, internal::string_hash,
+    std::equal_to<>>
+    m_handlers;
+
+  mutable std::mutex m_mutex;
+  /// Signalled whenever jobs come into the queue.
+  std::condition_variable_any m_ready;
+  std::deque<job> m_queue;
+};
+} // namespace pqxx
+#endif
@@ -16,8 +16,11 @@
 #endif
 
 #include <array>
+#include <chrono>
 #include <format>
+#include <span>
 
+#include "pqxx/binary.hxx"
 #include "pqxx/internal/statement_parameters.hxx"
 #include "pqxx/types.hxx"
 
@@ -51,6 +54,31 @@ get_encoding_group(connection const &, sl = sl::current());
 /// Return transaction's connection's current client encoding.
 [[nodiscard]] PQXX_LIBEXPORT pqxx::encoding_group
 get_encoding_group(transaction_base const &, sl = sl::current());
+
+
+/// SQL type as which @ref params can send a `TYPE` in binary format.
+/** These are the types with a simple, fixed-width binary representation.
+ * Zero means that `params` always sends `TYPE` as text.
+ */
+template<typename TYPE> inline constexpr oid binary_param_type{0};
+
+template<> inline constexpr oid binary_param_type<bool>{oid_bool};
+template<> inline constexpr oid binary_param_type<short>{oid_int2};
+template<> inline constexpr oid binary_param_type<int>{oid_int4};
+template<>
+inline constexpr oid binary_param_type<long>{
+  (sizeof(long) == 8) ? oid_int8 : oid_int4};
+template<> inline constexpr oid binary_param_type<long long>{oid_int8};
+template<> inline constexpr oid binary_param_type<float>{oid_float4};
+template<> inline constexpr oid binary_param_type<double>{oid_float8};
+#if defined(PQXX_HAVE_YEAR_MONTH_DAY)
+template<>
+inline constexpr oid binary_param_type<std::chrono::year_month_day>{oid_date};
+#endif
+template<>
+inline constexpr oid
+  binary_param_type<std::chrono::sys_time<std::chrono::microseconds>>{
+    oid_timestamptz};
 } // namespace pqxx::internal
 
 
@@ -60,6 +88,12 @@ namespace pqxx
 /** When calling a parameterised statement or a prepared statement, in many
  * cases you can pass parameters into the statement in the form of a
  * `pqxx::params` object.
+ *
+ * When you append a value that needs converting, `params` converts it
+ * straight into a single buffer that it shares between all its parameters.
+ * If you execute the same statement many times, you can @ref clear the
+ * `params` and reuse it.  It keeps its buffers, so once they are large
+ * enough, filling in the parameters does not allocate any memory.
  */
 class PQXX_LIBEXPORT params final
 {
@@ -116,6 +150,35 @@ public:
    */
   void reserve(std::size_t n) &;
 
+  /// Remove all parameters, but keep the allocated storage for reuse.
+  /** The value format (see @ref set_value_format) stays as it is.
+   */
+  void clear() & noexcept;
+
+  /// Send values of fixed-width types in binary format, or as text.
+  /** By default, `params` passes all values as text, except binary strings.
+   * If you set this to @ref format::binary, it sends values of some simple
+   * types in binary format instead: `bool`, `short`, `int`, `long`,
+   * `long long`, `float`, `double`, `std::chrono::year_month_day` (as a
+   * `date`), and `std::chrono::sys_time<std::chrono::microseconds>` (as a
+   * `timestamp with time zone`).  That saves converting them to text and
+   * back.
+   *
+   * For these binary parameters, `params` also tells the server their SQL
+   * types, so it knows how to read them.  The server converts them to the
+   * types that your statement needs, if there is a suitable implicit cast.
+   *
+   * This only affects values you append after setting it.
+   *
+   * @warning A prepared statement gets its parameter types when you prepare
+   * it.  When you execute it, any binary parameters must match those types
+   * exactly: e.g. an `int` for an `integer`, or a `long long` for a `bigint`.
+   */
+  void set_value_format(format fmt) & noexcept { m_format = fmt; }
+
+  /// The format for fixed-width values.  See @ref set_value_format.
+  [[nodiscard]] format value_format() const noexcept { return m_format; }
+
   /// Get the number of parameters currently in this `params`.
   [[nodiscard]] constexpr auto size() const noexcept
   {
@@ -141,7 +204,7 @@ public:
 
   /// Append a non-null string parameter.
   /** Copies the underlying data into internal storage.  For best efficiency,
-   * use the @ref zview variant if you can, or `std::move()`
+   * use the @ref zview variant if you can.
    */
   void append(std::string const &, sl = sl::current()) &;
 
@@ -174,10 +237,13 @@ public:
 
   /// Append a non-null parameter, converting it to its string
   /// representation.
+  /** If the value format is @ref format::binary and `TYPE` has a fixed-width
+   * binary representation, this stores the value in binary instead.  See
+   * @ref set_value_format.
+   */
   template<typename TYPE>
   void append([[maybe_unused]] TYPE const &value, sl loc = sl::current()) &
   {
-    // TODO: Pool storage for multiple string conversions in one buffer?
     if constexpr (pqxx::always_null<TYPE>())
     {
       m_params.emplace_back();
@@ -188,8 +254,24 @@ public:
     }
     else
     {
-      // TODO: Block-allocate storage for parameters.
-      m_params.emplace_back(to_string(value, conversion_context{m_enc, loc}));
+      conversion_context const c{m_enc, loc};
+      if constexpr (pqxx::internal::binary_param_type<TYPE> != 0)
+      {
+        if (m_format == format::binary)
+        {
+          store_binary(value, c);
+          return;
+        }
+      }
+      if constexpr (pqxx::internal::binary_only<TYPE>)
+        throw conversion_error{
+          std::format(
+            "Can't pass {} as a text parameter.  Set the params to send "
+            "values in binary format.",
+            name_type<TYPE>()),
+          loc};
+      else
+        store_text(value, c);
     }
   }
 
@@ -227,15 +309,61 @@ private:
    */
   void append_pack(sl) const noexcept {}
 
+  /// Convert `value` to text, into `m_arena`, and append it.
+  template<typename TYPE> void store_text(TYPE const &value, ctx c)
+  {
+    auto const start{std::size(m_arena)};
+    m_arena.resize(start + pqxx::size_buffer(value));
+    auto const len{
+      pqxx::into_buf(std::span<char>{m_arena}.subspan(start), value, c)};
+    m_arena.resize(start + len);
+    // Text parameters must be zero-terminated.
+    m_arena.push_back('\0');
+    m_params.emplace_back(stored{start, len, 0});
+  }
+
+  /// Write `value` in binary, into `m_arena`, and append it.
+  template<typename TYPE> void store_binary(TYPE const &value, ctx c)
+  {
+    auto const start{std::size(m_arena)};
+    binary_traits<TYPE>::into_binary(m_arena, value, c);
+    m_params.emplace_back(stored{
+      start, std::size(m_arena) - start,
+      pqxx::internal::binary_param_type<TYPE>});
+  }
+
+  /// Append entries from `other`, copying any data it keeps in its arena.
+  void append_entries(params const &other);
+
+  /// A parameter value that we keep in `m_arena`.
+  /** We refer to it by offset, not by pointer, because the arena may move
+   * around in memory as it grows.
+   */
+  struct stored final
+  {
+    /// Where in the arena the value starts.
+    std::size_t offset;
+    /// Size of the value, not counting the terminating zero of a text value.
+    std::size_t size;
+    /// SQL type of a binary value; or zero for a text value.
+    oid type;
+  };
+
   // The way we store a parameter depends on whether it's binary or text
   // (most types are text), and whether we're responsible for storing the
   // contents.
-  using entry =
-    std::variant<std::nullptr_t, zview, std::string, bytes_view, bytes>;
+  using entry = std::variant<
+    std::nullptr_t, zview, std::string, bytes_view, bytes, stored>;
   std::vector<entry> m_params;
 
+  /// Storage for the parameters we convert, all in one buffer.
+  std::string m_arena;
+
   encoding_group m_enc{encoding_group::unknown};
 
+  /// Format in which we store values of fixed-width types.
+  format m_format{format::text};
+
   static constexpr std::string_view s_overflow{
     "Statement parameter length overflow."sv};
 };
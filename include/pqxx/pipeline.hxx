@@ -19,28 +19,38 @@
 
 #include <limits>
 #include <map>
+#include <memory>
 #include <string>
 
+#include "pqxx/params.hxx"
+#include "pqxx/prepared_statement.hxx"
 #include "pqxx/transaction_base.hxx"
 
 
 namespace pqxx
 {
-// TODO: libpq 14 introduced a similar "pipeline mode."  Replace with that.
-
 /// Processes several queries in FIFO manner, optimized for high throughput.
 /** Use a pipeline if you want to keep doing useful work while your queries are
  * executing.  Result retrieval is decoupled from execution request; queries
  * "go in at the front" and results "come out the back."
  *
- * Actually, you can retrieve the results in any order if you want, but it may
- * lead to surprising "time travel" effects if any of the queries fails.  In
- * particular, syntax errors in the queries can confuse things and show up too
- * early in the stream of results.
+ * The pipeline is built on libpq's "pipeline mode," so it requires libpq 14
+ * or better.  (If libpqxx was built against an older libpq, creating a
+ * pipeline will throw @ref feature_not_supported.)  It sends your statements
+ * to the server without waiting for earlier ones to complete, so that the
+ * network round trips overlap.  The server still executes them one by one, in
+ * the order in which you inserted them.
+ *
+ * You can insert plain SQL statements, parameterised statements, and prepared
+ * statements.  Each statement must be a single SQL command; unlike with
+ * @ref transaction_base::exec(), you can't pass several semicolon-separated
+ * commands in one string.  Nor can a statement in a pipeline start a `COPY`.
  *
- * Generally, if any of the queries fails, it will throw an exception at the
- * point where you request its result.  But it may happen earlier, especially
- * if you request results out of chronological order.
+ * You can retrieve the results in any order you like.  If one of the
+ * statements fails, retrieving its result will throw the exception.  In a
+ * @ref nontransaction, a failing statement does not affect the ones that come
+ * after it.  In a regular transaction, of course, the failure aborts the
+ * transaction and so all subsequent statements will fail as well.
  *
  * @warning While a pipeline is active, you cannot execute queries, open
  * streams, etc. on the same transaction.  A transaction can have at most one
@@ -77,13 +87,72 @@ public:
   ~pipeline() noexcept;
 
   /// Add query to the pipeline.
-  /** Queries accumulate in the pipeline, which sends them to the backend in a
-   * batch separated by semicolons.  The queries you insert must not use this
-   * trick themselves, or the pipeline will get hopelessly confused!
+  /** Queries accumulate in the pipeline (see @ref retain()), which sends them
+   * to the backend without waiting for earlier ones to complete.
+   *
+   * The query must be a single SQL statement.
+   *
+   * @return Identifier for this query, unique only within this pipeline.
+   */
+  query_id insert(std::string_view query, sl loc = sl::current()) &
+  {
+    return insert(query, params{}, loc);
+  }
+
+  /// Add parameterised query to the pipeline.
+  /** Works like @ref transaction_base::exec() with parameters: refer to the
+   * parameters in the query as `$1`, `$2`, etc.
+   *
+   * @warning The pipeline keeps a copy of `args`, but if any of those
+   * parameters refer to data that lives outside of the `params` object (such
+   * as a @ref zview or a @ref bytes_view), then that data must stay valid
+   * until the pipeline has issued the query.
+   *
+   * @return Identifier for this query, unique only within this pipeline.
+   */
+  query_id
+  insert(std::string_view query, params const &args, sl loc = sl::current()) &
+  {
+    return insert(query, args, format::text, loc);
+  }
+
+  /// Add parameterised query to the pipeline, with a choice of result format.
+  /** Pass `format::binary` to receive the result data in PostgreSQL's binary
+   * format, as with @ref transaction_base::exec().
+   *
+   * @return Identifier for this query, unique only within this pipeline.
+   */
+  query_id insert(
+    std::string_view query, params const &args, format result_format,
+    sl = sl::current()) &;
+
+  /// Add execution of a prepared statement to the pipeline.
+  /** The same caveat applies as with the parameterised version of `insert()`:
+   * any data that the parameters refer to must stay valid until the pipeline
+   * has issued the statement.
    *
    * @return Identifier for this query, unique only within this pipeline.
    */
-  query_id insert(std::string_view, sl = sl::current()) &;
+  query_id
+  insert(prepped statement, params const &args, sl loc = sl::current()) &
+  {
+    return insert(statement, args, format::text, loc);
+  }
+
+  /// Add a prepared statement to the pipeline, with a choice of result format.
+  /** @return Identifier for this query, unique only within this pipeline.
+   */
+  query_id insert(
+    prepped statement, params const &args, format result_format,
+    sl = sl::current()) &;
+
+  /// Add execution of a prepared statement without parameters.
+  /** @return Identifier for this query, unique only within this pipeline.
+   */
+  query_id insert(prepped statement, sl loc = sl::current()) &
+  {
+    return insert(statement, params{}, loc);
+  }
 
   /// Wait for all ongoing or pending operations to complete, and detach.
   /** Detaches from the transaction when done.
@@ -123,9 +192,6 @@ public:
   /// Retrieve result for given query.
   /** If the query failed for whatever reason, this will throw an exception.
    * The function will block if the query has not finished yet.
-   * @warning If results are retrieved out-of-order, i.e. in a different order
-   * than the one in which their queries were inserted, errors may "propagate"
-   * to subsequent queries.
    */
   result retrieve(query_id qid, sl loc = sl::current())
   {
@@ -139,10 +205,10 @@ public:
   [[nodiscard]] bool empty() const noexcept { return std::empty(m_queries); }
 
   /// Set maximum number of queries to retain before issuing them to backend.
-  /** The pipeline will perform better if multiple queries are issued at once,
-   * but retaining queries until the results are needed (as opposed to issuing
-   * them to the backend immediately) may negate any performance benefits the
-   * pipeline can offer.
+  /** Retaining queries lets the pipeline send them to the backend in a single
+   * network write, but holding them back until the results are needed (as
+   * opposed to issuing them to the backend immediately) may negate any
+   * performance benefits the pipeline can offer.
    *
    * Recommended practice is to set this value no higher than the number of
    * queries you intend to insert at a time.
@@ -158,21 +224,33 @@ public:
 private:
   struct PQXX_PRIVATE Query final
   {
-    explicit Query(std::string_view q) :
-            query{std::make_shared<std::string>(q)}
+    Query(
+      std::string_view q, params const &a, bool is_prepared,
+      format result_fmt) :
+            query{std::make_shared<std::string>(q)},
+            args{a},
+            prepared{is_prepared},
+            result_format{result_fmt}
     {}
 
+    /// The query text, or for a prepared statement, the statement's name.
     // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
     std::shared_ptr<std::string> query;
     // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+    params args;
+    // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+    bool prepared = false;
+    // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+    format result_format = format::text;
+    // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
     result res;
   };
 
   using QueryMap = std::map<query_id, Query>;
 
   void init(sl);
-  void attach();
-  void detach();
+  void attach(sl);
+  void detach(sl);
 
   /// Upper bound to query id's.
   static constexpr query_id qid_limit() noexcept
@@ -187,28 +265,35 @@ private:
   /// Create new query_id.
   PQXX_PRIVATE query_id generate_id();
 
+  /// Add a query to the pipeline.
+  PQXX_PRIVATE query_id insert_query(Query &&, sl);
+
   [[nodiscard]] bool have_pending() const noexcept
   {
     return m_issuedrange.second != m_issuedrange.first;
   }
 
+  /// Send all waiting queries to the backend.
   PQXX_PRIVATE void issue(sl);
 
-  /// The given query failed; never issue anything beyond that.
-  void set_error_at(query_id qid) noexcept
-  {
-    if (qid < m_error) [[unlikely]]
-      m_error = qid;
-  }
-
-  /// Throw pqxx::internal_error.
+  /// Throw pqxx::internal_error.  Nothing in the pipeline will work after.
   [[noreturn]] PQXX_PRIVATE void internal_error(std::string const &err, sl);
 
-  PQXX_PRIVATE bool obtain_result(bool expect_none, sl);
+  /// Consume the protocol trailer for the most recently obtained result.
+  /** In pipeline mode, each query's result is followed by a null result, and
+   * then (because we request a sync point after each query) by a sync result.
+   *
+   * @param block Wait for the trailer to come in, if needed.
+   * @return Did we get all the way through the trailer?  (It may not be
+   *     available yet if `block` is false.)
+   */
+  PQXX_PRIVATE bool finish_result(bool block, sl);
 
-  PQXX_PRIVATE void obtain_dummy(sl);
-  PQXX_PRIVATE void get_further_available_results(sl);
-  PQXX_PRIVATE void check_end_results();
+  /// Obtain the result for the oldest pending query.
+  /** @param block Wait for the result if it is not available yet.
+   * @return Did we get a result?
+   */
+  PQXX_PRIVATE bool obtain_result(bool block, sl);
 
   /// Receive any results that happen to be available; it's not urgent.
   PQXX_PRIVATE void receive_if_available(sl loc);
@@ -224,10 +309,13 @@ private:
   int m_num_waiting = 0;
   query_id m_q_id = 0;
 
-  /// Is there a "dummy query" pending?
-  bool m_dummy_pending = false;
+  /// Do we still need to read the null result that follows a query's result?
+  bool m_null_pending = false;
+
+  /// Do we still need to read the sync result that follows a query?
+  bool m_sync_pending = false;
 
-  /// Point at which an error occurred; no results beyond it will be available
+  /// Point at which an internal error occurred; nothing beyond it will work.
   query_id m_error = qid_limit();
 
   /// Encoding.
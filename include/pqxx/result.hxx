@@ -17,12 +17,19 @@
 #  error "Include libpqxx headers as <pqxx/header>, not <pqxx/header.hxx>."
 #endif
 
+#include <atomic>
+#include <cstdint>
 #include <format>
 #include <functional>
 #include <ios>
 #include <list>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 
 #include "pqxx/except.hxx"
 #include "pqxx/types.hxx"
@@ -67,6 +74,106 @@ struct notice_waiters final
   notice_waiters &operator=(notice_waiters const &) = delete;
   notice_waiters &operator=(notice_waiters &&) = delete;
 };
+
+
+/// Lookup table from column names to column numbers.
+/** Looking up a column by name in libpq means comparing the name to each of
+ * the columns' names in turn.  This index does it in a single hash lookup.
+ *
+ * A name that contains upper-case letters or double quotes needs libpq's
+ * case folding and unquoting rules, so those lookups are still up to libpq.
+ */
+class PQXX_LIBEXPORT column_index final
+{
+public:
+  /// Index the columns of `res`.
+  explicit column_index(pq::PGresult const *res);
+
+  /// Number of columns in the result we indexed.
+  [[nodiscard]] row_size_type columns() const noexcept { return m_columns; }
+
+  /// Does this index also describe the columns of `res`?
+  /** That's the case if `res` has the same column names, in the same order.
+   */
+  [[nodiscard]] bool matches(pq::PGresult const *res) const noexcept;
+
+  /// Can we look up `name` here, or does it need libpq's case folding?
+  [[nodiscard]] static bool can_find(std::string_view name) noexcept;
+
+  /// Number of the first column called `name`, or -1 if there is none.
+  /** Only call this for names where @ref can_find returns `true`.
+   */
+  [[nodiscard]] row_size_type find(std::string_view name) const noexcept;
+
+private:
+  /// Hash for heterogeneous lookups: find a `std::string_view` key.
+  struct hash final
+  {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view name) const noexcept
+    {
+      return std::hash<std::string_view>{}(name);
+    }
+  };
+
+  std::unordered_map<std::string, row_size_type, hash, std::equal_to<>>
+    m_index;
+  row_size_type m_columns;
+};
+
+
+/// Deleter for a result's `PGresult`, with room for data about the result.
+/** Every @ref result object that refers to the same result set shares the
+ * same deleter, inside their `std::shared_ptr`'s control block.  That makes
+ * it a convenient place for information that we compute lazily.
+ *
+ * Copies of a result may live in different threads, so anything we compute
+ * lazily here must be thread-safe.
+ */
+struct PQXX_LIBEXPORT result_deleter final
+{
+  result_deleter() = default;
+
+  /// "Copying" a deleter produces a fresh one.
+  /** The `std::shared_ptr` constructor copies or moves its deleter into the
+   * control block, before any result can see it.  There is nothing to copy
+   * at that point.
+   */
+  result_deleter(result_deleter const &) noexcept : result_deleter{} {}
+  result_deleter(result_deleter &&) noexcept : result_deleter{} {}
+  result_deleter &operator=(result_deleter const &) = delete;
+  result_deleter &operator=(result_deleter &&) = delete;
+  ~result_deleter() = default;
+
+  // NOLINTBEGIN(misc-non-private-member-variables-in-classes)
+  /// Index for looking up columns by name, if we have one yet.
+  /** Only set this directly before the result set is shared.  After that,
+   * write it only through @ref indexing.
+   */
+  std::shared_ptr<column_index const> columns;
+
+  /// Did @ref columns come with the result, from its prepared statement?
+  bool preset_columns{false};
+
+  /// Must we check that @ref columns matches the result before using it?
+  /** The statement may have been redefined through SQL, with the same number
+   * of columns but different names.  We check that on the first lookup by
+   * name, not for every result.
+   */
+  bool verify_columns{false};
+
+  /// Guards the one-time lazy creation or verification of @ref columns.
+  std::once_flag indexing;
+
+  /// Number of times we looked up a column by name without an index.
+  std::atomic<int> unindexed_lookups{0};
+  // NOLINTEND(misc-non-private-member-variables-in-classes)
+
+  void operator()(pq::PGresult const *res) const noexcept
+  {
+    clear_result(res);
+  }
+};
 } // namespace pqxx::internal
 
 
@@ -180,6 +287,46 @@ public:
    */
   template<typename... TYPE> auto iter() const;
 
+  /// Iterate rows, reading them directly into the members of a struct.
+  /** The template arguments are pointers to the members that receive the
+   * respective columns, e.g. `iter_struct<&point::x, &point::y>()`.  See
+   * @ref struct_schema.
+   *
+   * Use this only with a ranged "for" loop.
+   */
+  template<auto... MEMBER> auto iter_struct() const;
+
+  /// Convert all fields in column `col` to `TYPE`, in one go.
+  /** This is faster than converting the same fields one by one: it checks the
+   * column's format and type only once, and then converts all its fields in
+   * a single loop.
+   *
+   * Returns a @ref column_data, which holds the values in a vector, as well
+   * as a bitmap that says which fields were null.  You don't need to use a
+   * `TYPE` that can be null: a null field just becomes a default-constructed
+   * value.
+   *
+   * @throw range_error if there is no column `col`.
+   * @throw conversion_error if a field does not convert to `TYPE`.
+   */
+  template<typename TYPE>
+  [[nodiscard]] auto read_column(row_size_type col, sl = sl::current()) const;
+
+  /// Convert all fields in column `col` to `TYPE`, into your own buffers.
+  /** Writes the values to the first @ref size() elements of `values`, and a
+   * validity bitmap to the first `(size() + 7) / 8` bytes of `validity`.  The
+   * bitmap has the same layout as the one in @ref column_data.
+   *
+   * @return The number of null fields.
+   * @throw range_error if there is no column `col`.
+   * @throw argument_error if either buffer is too small.
+   * @throw conversion_error if a field does not convert to `TYPE`.
+   */
+  template<typename TYPE>
+  result_size_type read_column(
+    row_size_type col, std::span<TYPE> values,
+    std::span<std::uint8_t> validity, sl = sl::current()) const;
+
   [[nodiscard]] PQXX_PURE const_reverse_iterator rbegin() const noexcept;
   [[nodiscard]] PQXX_PURE const_reverse_iterator crbegin() const noexcept;
   [[nodiscard]] PQXX_PURE const_reverse_iterator rend() const noexcept;
@@ -292,6 +439,32 @@ public:
   [[nodiscard]] oid
   column_type(row_size_type col_num, sl = sl::current()) const;
 
+  /// Is the data in column `col_num` in text format or in binary format?
+  /** Results come in text format, unless you ask for binary format when
+   * executing the query.  The conversions in @ref field::as() and friends
+   * check this, and use @ref binary_traits for binary data.
+   *
+   * @warning There is no check for errors, such as an invalid column number.
+   */
+  [[nodiscard]] PQXX_PURE format
+  column_format(row_size_type col_num) const noexcept
+  {
+    // Most results are all text.  Only ask libpq if that's not the case.
+    return m_binary ? binary_column_format(col_num) : format::text;
+  }
+
+  /// Number of parameters of a prepared statement.
+  /** This is only meaningful in the result of
+   * @ref connection::describe_prepared.
+   */
+  [[nodiscard]] PQXX_PURE int param_count() const noexcept;
+
+  /// Type of a prepared statement's parameter, as an OID.
+  /** This is only meaningful in the result of
+   * @ref connection::describe_prepared.
+   */
+  [[nodiscard]] oid param_type(int param_num, sl = sl::current()) const;
+
   /// Return column's type, as an OID from the system catalogue.
   /** By default, as everywhere in PostgreSQL, upper-case letters in
    * identifiers get converted to lower-case, and of course special characters
@@ -561,6 +734,12 @@ private:
 
   encoding_group m_encoding = encoding_group::unknown;
 
+  /// Does this result contain any data in binary format?
+  bool m_binary = false;
+
+  PQXX_PURE [[nodiscard]] format
+  binary_column_format(row_size_type col_num) const noexcept;
+
   static std::string const s_empty_string;
 
   friend class pqxx::internal::gate::result_field_ref;
@@ -580,6 +759,9 @@ private:
 
   PQXX_PRIVATE void check_status(std::string_view desc, sl loc) const;
 
+  /// Look up a column by name.  Returns -1 if there is no such column.
+  PQXX_PRIVATE [[nodiscard]] row_size_type find_column(zview name) const;
+
   friend class pqxx::internal::gate::result_connection;
   friend class pqxx::internal::gate::result_row;
   bool operator!() const noexcept { return m_data.get() == nullptr; }
@@ -22,16 +22,9 @@
 #include "pqxx/result.hxx"
 
 
-namespace pqxx::internal
-{
-template<typename... T> class result_iter;
-} // namespace pqxx::internal
-
-
 namespace pqxx::internal::gate
 {
 class row_ref_const_result_iterator;
-class row_ref_result;
 class row_ref_row;
 } // namespace pqxx::internal::gate
 
@@ -328,7 +321,6 @@ public:
 
 private:
   friend class pqxx::internal::gate::row_ref_const_result_iterator;
-  friend class pqxx::internal::gate::row_ref_result;
   /// Move to another row (positive for forwards, negative for backwards).
   void offset(difference_type d) noexcept { m_index += d; }
 
@@ -342,7 +334,6 @@ private:
         loc};
   }
 
-  template<typename... T> friend class pqxx::internal::result_iter;
   /// Convert entire row to tuple fields, without checking row size.
   template<typename Tuple> void convert(Tuple &t, sl loc) const
   {
@@ -0,0 +1,390 @@
+/* Definitions for pqxx::row_schema, pqxx::struct_schema, and columnar reads.
+ *
+ * These bind the columns of a result to C++ types, once per result.
+ *
+ * DO NOT INCLUDE THIS FILE DIRECTLY; include pqxx/row_schema instead.
+ *
+ * Copyright (c) 2000-2026, Jeroen T. Vermeulen.
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this
+ * mistake, or contact the author.
+ */
+#ifndef PQXX_ROW_SCHEMA_HXX
+#define PQXX_ROW_SCHEMA_HXX
+
+#if !defined(PQXX_HEADER_PRE)
+#  error "Include libpqxx headers as <pqxx/header>, not <pqxx/header.hxx>."
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "pqxx/binary.hxx"
+#include "pqxx/field.hxx"
+#include "pqxx/result.hxx"
+
+
+namespace pqxx::internal
+{
+/// Take a pointer-to-member type apart.
+template<typename> struct member_pointer;
+
+template<typename CLASS, typename MEMBER>
+struct member_pointer<MEMBER CLASS::*> final
+{
+  using class_type = CLASS;
+  using member_type = MEMBER;
+};
+
+
+/// Converts the non-null fields in one column of a result to `TYPE`.
+/** Looks up the column's format and type just once, when you create it.
+ */
+template<typename TYPE> class column_decoder final
+{
+public:
+  /// Prepare to read column `col` of `res`.
+  /** @throw conversion_error if the column is in a format (text or binary)
+   * that we can't convert to `TYPE`.
+   */
+  column_decoder(result const &res, row_size_type col, sl loc) :
+          m_binary{res.column_format(col) == format::binary}
+  {
+    if (m_binary)
+    {
+      if constexpr (not binary_decodable<TYPE>)
+        throw_no_binary_decoder(name_type<TYPE>(), loc);
+      m_type = res.column_type(col, loc);
+    }
+    else if constexpr (binary_only<TYPE>)
+    {
+      throw_binary_only(name_type<TYPE>(), loc);
+    }
+  }
+
+  /// Convert `f`, which must not be null.
+  [[nodiscard]] TYPE decode(field_ref const &f, ctx c) const
+  {
+    if constexpr (binary_decodable<TYPE>)
+    {
+      if (m_binary)
+        return binary_traits<TYPE>::from_binary(
+          // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+          bytes_view{reinterpret_cast<std::byte const *>(f.c_str()), f.size()},
+          m_type, c);
+    }
+    // The constructor made sure that we never get here with a binary-only
+    // type, or with a binary column we can't decode.
+    if constexpr (binary_only<TYPE>)
+      PQXX_UNREACHABLE;
+    else
+      return from_string<TYPE>(f.view(), c);
+  }
+
+private:
+  /// Is the column in binary format?
+  bool m_binary;
+  /// The column's type, if it is in binary format.
+  oid m_type{oid_none};
+};
+
+
+/// Convert column `col` of `res` into `values`, and note its nulls.
+/** This is the loop behind @ref result::read_column.  The caller checks the
+ * sizes of the outputs.  `VALUES` can be a span or a vector, including a
+ * `std::vector<bool>`.
+ *
+ * @return The number of null fields.
+ */
+template<typename TYPE, typename VALUES>
+inline result_size_type read_column(
+  result const &res, row_size_type col, VALUES &values,
+  std::span<std::uint8_t> validity, sl loc)
+{
+  column_decoder<TYPE> const decoder{res, col, loc};
+  conversion_context const c{res.get_encoding_group(), loc};
+  auto const rows{static_cast<std::size_t>(res.size())};
+  result_size_type nulls{0};
+  // Collect each byte of the bitmap locally, and write it just once.
+  for (std::size_t base{0}; base < rows; base += 8u)
+  {
+    std::uint8_t bits{0};
+    auto const end{std::min(base + 8u, rows)};
+    for (auto row{base}; row < end; ++row)
+    {
+      field_ref const f{res, static_cast<result_size_type>(row), col};
+      if (f.is_null()) [[unlikely]]
+      {
+        ++nulls;
+        if constexpr (has_null<TYPE>())
+          values[row] = make_null<TYPE>();
+        else
+          values[row] = TYPE{};
+      }
+      else
+      {
+        values[row] = decoder.decode(f, c);
+        bits |= static_cast<std::uint8_t>(1u << (row - base));
+      }
+    }
+    validity[base / 8u] = bits;
+  }
+  return nulls;
+}
+} // namespace pqxx::internal
+
+
+namespace pqxx
+{
+/// The shape of a result's rows, as a series of C++ types.
+/** When you convert a result's rows one by one, e.g. using @ref row::as, each
+ * row checks its number of columns again, and each field looks up its
+ * column's format and type again.  A `row_schema` does all that once, when
+ * you create it for a given result.  After that, reading a row just converts
+ * its fields, in code that the compiler generates specifically for `TYPE...`.
+ *
+ * This is what @ref result::iter and @ref transaction_base::query use.
+ *
+ * The result must stay valid, and in the same place in memory, for as long as
+ * you use the schema.
+ */
+template<typename... TYPE> class row_schema final
+{
+public:
+  using value_type = std::tuple<TYPE...>;
+
+  /// Number of columns.
+  static constexpr row_size_type width{sizeof...(TYPE)};
+
+  /// Check that `res` has the right shape, and prepare to read its rows.
+  /** @throw usage_error if the result does not have `sizeof...(TYPE)`
+   * columns.
+   * @throw conversion_error if a column is in a format (text or binary) that
+   * we can't convert to its C++ type.
+   */
+  explicit row_schema(result const &res, sl loc = sl::current()) :
+          m_home{&res},
+          m_encoding{res.get_encoding_group()},
+          m_decoders{
+            make_decoders(res, std::index_sequence_for<TYPE...>{}, loc)}
+  {}
+
+  /// The result whose rows this schema reads.
+  [[nodiscard]] result const &home() const noexcept { return *m_home; }
+
+  /// Read row `row_num` as a tuple.
+  [[nodiscard]] value_type
+  read(result_size_type row_num, sl loc = sl::current()) const
+  {
+    return read_row(
+      row_num, std::index_sequence_for<TYPE...>{}, ctx{m_encoding, loc});
+  }
+
+  /// Read row `row_num` into an existing tuple.
+  void read(result_size_type row_num, value_type &out, sl loc = sl::current())
+    const
+  {
+    read_into(
+      row_num, out, std::index_sequence_for<TYPE...>{}, ctx{m_encoding, loc});
+  }
+
+  /// Read just the field in column `COL` of row `row_num`.
+  template<std::size_t COL>
+  [[nodiscard]] auto get(result_size_type row_num, ctx c) const
+  {
+    static_assert(COL < sizeof...(TYPE), "Column number out of range.");
+    using type = std::tuple_element_t<COL, value_type>;
+    constexpr auto col{static_cast<row_size_type>(COL)};
+    field_ref const f{*m_home, row_num, col};
+    if (f.is_null())
+    {
+      if constexpr (has_null<type>())
+        return make_null<type>();
+      else
+        internal::throw_null_conversion(name_type<type>(), c.loc);
+    }
+    return std::get<COL>(m_decoders).decode(f, c);
+  }
+
+private:
+  using decoders = std::tuple<internal::column_decoder<TYPE>...>;
+
+  /// Check the number of columns, and prepare to decode each.
+  template<std::size_t... COL>
+  [[nodiscard]] static decoders
+  make_decoders(result const &res, std::index_sequence<COL...>, sl loc)
+  {
+    res.expect_columns(width, loc);
+    return {internal::column_decoder<TYPE>{
+      res, static_cast<row_size_type>(COL), loc}...};
+  }
+
+  template<std::size_t... COL>
+  [[nodiscard]] value_type read_row(
+    result_size_type row_num, std::index_sequence<COL...>, ctx c) const
+  {
+    return {get<COL>(row_num, c)...};
+  }
+
+  template<std::size_t... COL>
+  void read_into(
+    result_size_type row_num, value_type &out, std::index_sequence<COL...>,
+    ctx c) const
+  {
+    ((std::get<COL>(out) = get<COL>(row_num, c)), ...);
+  }
+
+  result const *m_home;
+  encoding_group m_encoding;
+  decoders m_decoders;
+};
+
+
+/// Read a result's rows straight into the data members of a struct.
+/** The template arguments are pointers to the members that receive the
+ * respective columns: `struct_schema<&point::x, &point::y>` reads a result of
+ * two columns into a `point`, setting its `x` and `y`.  All the other members
+ * keep their default values.
+ *
+ * This works just like @ref row_schema, but without going through a tuple.
+ */
+template<auto... MEMBER> class struct_schema final
+{
+  static_assert(sizeof...(MEMBER) > 0, "A struct_schema needs members.");
+
+public:
+  using value_type = typename internal::member_pointer<
+    std::tuple_element_t<0, std::tuple<decltype(MEMBER)...>>>::class_type;
+  static_assert(
+    (std::is_same_v<
+       typename internal::member_pointer<decltype(MEMBER)>::class_type,
+       value_type> and
+     ...),
+    "All members of a struct_schema must be members of the same class.");
+
+  /// Number of columns.
+  static constexpr row_size_type width{sizeof...(MEMBER)};
+
+  /// Check that `res` has the right shape, and prepare to read its rows.
+  /** @throw usage_error if the result does not have `sizeof...(MEMBER)`
+   * columns.
+   * @throw conversion_error if a column is in a format (text or binary) that
+   * we can't convert to its member's type.
+   */
+  explicit struct_schema(result const &res, sl loc = sl::current()) :
+          m_columns{res, loc}
+  {}
+
+  /// The result whose rows this schema reads.
+  [[nodiscard]] result const &home() const noexcept
+  {
+    return m_columns.home();
+  }
+
+  /// Read row `row_num` as a new object.
+  [[nodiscard]] value_type
+  read(result_size_type row_num, sl loc = sl::current()) const
+  {
+    value_type out{};
+    read(row_num, out, loc);
+    return out;
+  }
+
+  /// Read row `row_num` into the members of an existing object.
+  void read(result_size_type row_num, value_type &out, sl loc = sl::current())
+    const
+  {
+    read_into(
+      row_num, out, std::index_sequence_for<decltype(MEMBER)...>{},
+      ctx{m_columns.home().get_encoding_group(), loc});
+  }
+
+private:
+  template<std::size_t... COL>
+  void read_into(
+    result_size_type row_num, value_type &out, std::index_sequence<COL...>,
+    ctx c) const
+  {
+    ((out.*MEMBER = m_columns.template get<COL>(row_num, c)), ...);
+  }
+
+  row_schema<typename internal::member_pointer<
+    decltype(MEMBER)>::member_type...> m_columns;
+};
+
+
+/// All values in one column of a result, converted to `TYPE`.
+/** This is what @ref result::read_column returns.  The values sit in one
+ * contiguous vector, with a separate bitmap to say which of them are null.
+ */
+template<typename TYPE> struct column_data final
+{
+  /// The column's values, one per row.
+  /** A null field becomes a null `TYPE` if it has one, or a
+   * default-constructed `TYPE` otherwise.
+   */
+  std::vector<TYPE> values;
+
+  /// Validity bitmap: one bit per row, set if the field is not null.
+  /** Row `n` is bit `n % 8` of byte `n / 8`, counting from the least
+   * significant bit.  This is the same layout that Apache Arrow uses.
+   */
+  std::vector<std::uint8_t> validity;
+
+  /// Number of null fields in the column.
+  result_size_type null_count{0};
+
+  /// Was the field in row `row_num` null?
+  [[nodiscard]] bool is_null(result_size_type row_num) const noexcept
+  {
+    auto const n{static_cast<std::size_t>(row_num)};
+    return (validity[n / 8u] & (1u << (n % 8u))) == 0u;
+  }
+};
+
+
+template<typename TYPE>
+inline auto result::read_column(row_size_type col, sl loc) const
+{
+  if (std::cmp_less(col, 0) or std::cmp_greater_equal(col, columns()))
+    throw range_error{"Column out of range.", loc};
+  auto const rows{static_cast<std::size_t>(size())};
+  column_data<TYPE> out;
+  out.values.resize(rows);
+  out.validity.resize((rows + 7u) / 8u);
+  out.null_count = internal::read_column<TYPE>(
+    *this, col, out.values, out.validity, loc);
+  return out;
+}
+
+
+template<typename TYPE>
+inline result_size_type result::read_column(
+  row_size_type col, std::span<TYPE> values, std::span<std::uint8_t> validity,
+  sl loc) const
+{
+  if (std::cmp_less(col, 0) or std::cmp_greater_equal(col, columns()))
+    throw range_error{"Column out of range.", loc};
+  auto const rows{static_cast<std::size_t>(size())};
+  if (std::size(values) < rows)
+    throw argument_error{
+      std::format(
+        "Buffer for {} values is too small for a column of {} rows.",
+        std::size(values), rows),
+      loc};
+  if (std::size(validity) < (rows + 7u) / 8u)
+    throw argument_error{
+      std::format(
+        "Validity bitmap of {} bytes is too small for a column of {} rows.",
+        std::size(validity), rows),
+      loc};
+  return internal::read_column<TYPE>(*this, col, values, validity, loc);
+}
+} // namespace pqxx
+#endif
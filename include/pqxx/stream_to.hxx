@@ -17,6 +17,9 @@
 #  error "Include libpqxx headers as <pqxx/header>, not <pqxx/header.hxx>."
 #endif
 
+#include <limits>
+
+#include "pqxx/binary.hxx"
 #include "pqxx/separated_list.hxx"
 #include "pqxx/transaction_base.hxx"
 
@@ -72,6 +75,20 @@ namespace pqxx
  * either a `std::tuple` or something iterable, such as a `std::vector`, or
  * anything else with a `begin()` and `end()`.
  *
+ * By default the stream uses the `COPY` command's text format.  You can also
+ * ask for `format::binary` when you create the stream.  Binary mode skips all
+ * the text conversion and escaping, but it's a lot stricter about types: the
+ * server reads each field in the binary format for its column's SQL type, so
+ * the C++ type you write must match that SQL type exactly.  Write a `short`
+ * to a `smallint` column, an `int` to an `integer`, a `long long` to a
+ * `bigint`, a `double` to a `double precision`, and so on.  Strings work for
+ * text-like columns, and @ref binary types for `bytea`.  For your own types,
+ * see @ref binary_traits.
+ *
+ * The stream does not send each row to the server as soon as you write it.
+ * Instead it collects rows in a buffer, and passes them to libpq in larger
+ * chunks.  See @ref set_batch_limits.
+ *
  * @warning While a stream is active, you cannot execute queries, open a
  * pipeline, etc. on the same transaction.  A transaction can have at most one
  * object of a type derived from @ref pqxx::transaction_focus active on it at a
@@ -89,13 +106,16 @@ public:
    * @param columns Optionally, the columns to which the stream should write.
    *     If you do not pass this, the stream will write to all columns in the
    *     table, in schema order.
+   * @param fmt Data format for the `COPY`: text or binary.
    */
   static stream_to table(
     transaction_base &tx, table_path path,
-    std::initializer_list<std::string_view> columns = {})
+    std::initializer_list<std::string_view> columns = {},
+    format fmt = format::text)
   {
     auto const &cx{tx.conn()};
-    return raw_table(tx, cx.quote_table(path), cx.quote_columns(columns));
+    return raw_table(
+      tx, cx.quote_table(path), cx.quote_columns(columns), fmt);
   }
 
   /// Create a `stream_to` writing to a named table and columns.
@@ -105,14 +125,16 @@ public:
    * @param tx The transaction within which the stream will operate.
    * @param path A @ref table_path designating the target table.
    * @param columns The columns to which the stream should write.
+   * @param fmt Data format for the `COPY`: text or binary.
    */
   template<pqxx::char_strings COLUMNS>
-  static stream_to
-  table(transaction_base &tx, table_path path, COLUMNS const &columns)
+  static stream_to table(
+    transaction_base &tx, table_path path, COLUMNS const &columns,
+    format fmt = format::text)
   {
     auto const &cx{tx.conn()};
     return stream_to::raw_table(
-      tx, cx.quote_table(path), tx.conn().quote_columns(columns));
+      tx, cx.quote_table(path), tx.conn().quote_columns(columns), fmt);
   }
 
   /// Create a `stream_to` writing to a named table and columns.
@@ -122,12 +144,15 @@ public:
    * @param tx The transaction within which the stream will operate.
    * @param path A @ref table_path designating the target table.
    * @param columns The columns to which the stream should write.
+   * @param fmt Data format for the `COPY`: text or binary.
    */
   template<pqxx::char_strings COLUMNS>
-  static stream_to
-  table(transaction_base &tx, std::string_view path, COLUMNS const &columns)
+  static stream_to table(
+    transaction_base &tx, std::string_view path, COLUMNS const &columns,
+    format fmt = format::text)
   {
-    return stream_to::raw_table(tx, path, tx.conn().quote_columns(columns));
+    return stream_to::raw_table(
+      tx, path, tx.conn().quote_columns(columns), fmt);
   }
 
   /// Stream data to a pre-quoted table and columns.
@@ -155,7 +180,18 @@ public:
     transaction_base &tx, std::string_view path, std::string_view columns = "",
     sl loc = sl::current())
   {
-    return {tx, path, columns, loc};
+    return {tx, path, columns, format::text, loc};
+  }
+
+  /// Stream data to a pre-quoted table and columns, in the given format.
+  /** This is like the other `raw_table`, except you can choose the `COPY`
+   * data format.
+   */
+  static stream_to raw_table(
+    transaction_base &tx, std::string_view path, std::string_view columns,
+    format fmt, sl loc = sl::current())
+  {
+    return {tx, path, columns, fmt, loc};
   }
 
   stream_to(stream_to const &) = delete;
@@ -175,6 +211,10 @@ public:
           m_field_buf{std::move(other.m_field_buf)},
           m_finder{other.m_finder},
           m_created_loc{other.m_created_loc},
+          m_batch_bytes{other.m_batch_bytes},
+          m_batch_rows{other.m_batch_rows},
+          m_rows{other.m_rows},
+          m_format{other.m_format},
           m_finished{other.m_finished}
   {
     other.m_finished = true;
@@ -209,6 +249,37 @@ public:
    */
   void complete(sl loc = sl::current());
 
+  /// Default for the number of buffered bytes that triggers a flush.
+  static constexpr std::size_t default_batch_bytes{64u * 1024u};
+
+  /// Set how much data the stream may buffer before sending it.
+  /** The stream collects the rows you write in a local buffer, and passes
+   * them to libpq in one go.  That is a lot cheaper than passing each row
+   * separately, especially when the rows are small.
+   *
+   * The stream sends its buffered rows when the buffer holds at least
+   * `max_bytes` bytes, or at least `max_rows` rows, whichever comes first.
+   * It also sends them when you call @ref flush or @ref complete.  If you set
+   * either limit to 1 or less, the stream sends each row as you write it.
+   *
+   * By default, there is no limit on the number of rows, and the byte limit
+   * is @ref default_batch_bytes.
+   *
+   * @warning With larger batches, the server may see a bad row some time after
+   * you wrote it.  So you may not get an error for that row until a later
+   * write, or until you @ref complete the stream.
+   */
+  void set_batch_limits(
+    std::size_t max_bytes,
+    std::size_t max_rows = std::numeric_limits<std::size_t>::max(),
+    sl loc = sl::current());
+
+  /// Send any buffered rows to the server right now.
+  /** You normally won't need this: the stream sends its buffered rows
+   * whenever it reaches one of its batch limits, and when it completes.
+   */
+  void flush(sl loc = sl::current());
+
   /// Insert a row of data.
   /** Returns a reference to the stream, so you can chain the calls.
    *
@@ -229,6 +300,8 @@ public:
   /** This can be useful when copying between different databases.  If the
    * source and the destination are on the same database, you'll get better
    * performance doing it all in a regular query.
+   *
+   * This only works for a stream in text format.
    */
   stream_to &operator<<(stream_from &);
 
@@ -241,9 +314,22 @@ public:
    */
   template<typename Row> void write_row(Row const &row, sl loc = sl::current())
   {
-    fill_buffer(
-      row, conversion_context{trans().conn().get_encoding_group(loc), loc});
-    write_buffer(loc);
+    auto const row_start{std::size(m_buffer)};
+    try
+    {
+      conversion_context const c{trans().conn().get_encoding_group(loc), loc};
+      if (m_format == format::binary)
+        fill_binary_buffer(row, c);
+      else
+        fill_buffer(row, c);
+    }
+    catch (...)
+    {
+      // Don't leave a partial row in the buffer.
+      m_buffer.resize(row_start);
+      throw;
+    }
+    write_buffer(row_start, loc);
   }
 
   /// Insert values as a row.
@@ -252,16 +338,33 @@ public:
    */
   template<typename... Ts> void write_values(Ts const &...fields)
   {
-    fill_buffer(fields...);
-    write_buffer(m_created_loc);
+    auto const row_start{std::size(m_buffer)};
+    try
+    {
+      if (m_format == format::binary)
+        fill_binary_buffer(fields...);
+      else
+        fill_buffer(fields...);
+    }
+    catch (...)
+    {
+      // Don't leave a partial row in the buffer.
+      m_buffer.resize(row_start);
+      throw;
+    }
+    write_buffer(row_start, m_created_loc);
   }
 
 private:
   /// Stream a pre-quoted table name and columns list.
   stream_to(
-    transaction_base &tx, std::string_view path, std::string_view columns, sl);
+    transaction_base &tx, std::string_view path, std::string_view columns,
+    format, sl);
 
-  /// Reusable buffer for a row.  Saves doing an allocation for each row.
+  /// Buffer for rows that we haven't sent yet.
+  /** Each complete row in here is terminated by a newline.  We reuse the
+   * buffer after sending its contents, so as to avoid allocations.
+   */
   std::string m_buffer;
 
   /// Reusable buffer for converting/escaping a field.
@@ -273,16 +376,36 @@ private:
   /// The `std::source_location` for where this stream was created.
   sl m_created_loc;
 
+  /// Send the buffered rows once they reach this many bytes.
+  std::size_t m_batch_bytes{default_batch_bytes};
+
+  /// Send the buffered rows once there are this many.
+  std::size_t m_batch_rows{std::numeric_limits<std::size_t>::max()};
+
+  /// Number of rows currently in @c m_buffer.
+  std::size_t m_rows{0};
+
+  /// The `COPY` data format: text or binary.
+  format m_format;
+
   /// Has this stream finished?
   bool m_finished = false;
 
   /// Write a row of raw text-format data into the destination table.
   void write_raw_line(std::string_view, sl);
 
-  /// Write a row of data from @c m_buffer into the destination table.
-  /** Resets the buffer for the next row.
+  /// Terminate the row starting at `row_start` in @c m_buffer.
+  /** If that completes a batch, sends the buffered rows to the server.
    */
-  void write_buffer(sl);
+  void write_buffer(std::size_t row_start, sl);
+
+  /// Count a newly completed row, and flush if we've reached a batch limit.
+  void end_row(sl loc)
+  {
+    ++m_rows;
+    if ((std::size(m_buffer) >= m_batch_bytes) or (m_rows >= m_batch_rows))
+      flush(loc);
+  }
 
   /// COPY encoding for a null field, plus subsequent separator.
   static constexpr std::string_view null_field{"\\N\t"};
@@ -424,7 +547,7 @@ private:
     // actually write it into the buffer.
     std::size_t budget{0};
     for (auto const &f : cont) budget += estimate_buffer(f);
-    m_buffer.reserve(budget);
+    m_buffer.reserve(std::size(m_buffer) + budget);
     for (auto const &f : cont) append_to_buffer(f, c);
   }
 
@@ -449,7 +572,7 @@ private:
   {
     using indexes = std::make_index_sequence<sizeof...(Elts)>;
 
-    m_buffer.reserve(budget_tuple(t, indexes{}));
+    m_buffer.reserve(std::size(m_buffer) + budget_tuple(t, indexes{}));
     append_tuple(t, indexes{}, c);
   }
 
@@ -461,6 +584,85 @@ private:
     (..., append_to_buffer(fields, c));
   }
 
+  /// Append a field to @c m_buffer, in binary `COPY` format.
+  template<typename Field> void append_binary(Field const &f, ctx c)
+  {
+    // Each field starts with a 32-bit length, or -1 for null.
+    if constexpr (pqxx::always_null<Field>())
+    {
+      internal::append_big_endian(m_buffer, std::int32_t{-1});
+    }
+    else if (is_null(f))
+    {
+      internal::append_big_endian(m_buffer, std::int32_t{-1});
+    }
+    else if constexpr (std::is_convertible_v<Field const &, std::string_view>)
+    {
+      // Anything string-like goes in as plain text.
+      std::string_view const text{f};
+      internal::append_big_endian(
+        m_buffer,
+        check_cast<std::int32_t>(
+          std::size(text), std::string_view{"binary field"}, c.loc));
+      m_buffer.append(text);
+    }
+    else if constexpr (internal::binary_encodable<Field>)
+    {
+      // Write the field, then go back and fill in its length.
+      auto const start{std::size(m_buffer)};
+      internal::append_big_endian(m_buffer, std::int32_t{0});
+      binary_traits<Field>::into_binary(m_buffer, f, c);
+      internal::store_big_endian(
+        std::data(m_buffer) + start,
+        check_cast<std::int32_t>(
+          std::size(m_buffer) - start - sizeof(std::int32_t),
+          std::string_view{"binary field"}, c.loc));
+    }
+    else
+    {
+      internal::throw_no_binary_encoder(name_type<Field>(), c.loc);
+    }
+  }
+
+  /// Write a binary `COPY` row into @c m_buffer, from a container of fields.
+  template<typename Container>
+  void fill_binary_buffer(Container const &cont, ctx c)
+    requires(not std::is_same_v<
+             std::remove_cv_t<typename Container::value_type>, char>)
+  {
+    // A row starts with its number of fields.  Fill that in afterwards.
+    auto const start{std::size(m_buffer)};
+    internal::append_big_endian(m_buffer, std::int16_t{0});
+    std::size_t fields{0};
+    for (auto const &f : cont)
+    {
+      append_binary(f, c);
+      ++fields;
+    }
+    internal::store_big_endian(
+      std::data(m_buffer) + start,
+      check_cast<std::int16_t>(fields, std::string_view{"binary row"}, c.loc));
+  }
+
+  /// Write a binary `COPY` row into @c m_buffer, from a tuple of fields.
+  template<typename... Elts>
+  void fill_binary_buffer(std::tuple<Elts...> const &t, ctx c)
+  {
+    internal::append_big_endian(
+      m_buffer, static_cast<std::int16_t>(sizeof...(Elts)));
+    std::apply([this, c](auto const &...f) { (append_binary(f, c), ...); }, t);
+  }
+
+  /// Write a binary `COPY` row into @c m_buffer, from varargs fields.
+  template<typename... Ts> void fill_binary_buffer(Ts const &...fields)
+  {
+    conversion_context const c{
+      trans().conn().get_encoding_group(m_created_loc), m_created_loc};
+    internal::append_big_endian(
+      m_buffer, static_cast<std::int16_t>(sizeof...(Ts)));
+    (..., append_binary(fields, c));
+  }
+
   static constexpr std::string_view s_classname{"stream_to"};
 };
 } // namespace pqxx
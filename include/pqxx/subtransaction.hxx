@@ -76,6 +76,32 @@ namespace pqxx
  * open streams etc. on its parent transaction.  A transaction can have at most
  * one object of a type derived from @ref pqxx::transaction_focus active on it
  * at a time.
+ *
+ * Each subtransaction costs round trips to the server: one to set its
+ * savepoint, and one to release it (or roll back to it).  If you use lots of
+ * small subtransactions, e.g. one per row in a bulk import, pass
+ * `begin_policy::deferred` to the constructor.  The subtransaction then sends
+ * its `SAVEPOINT` along with its first statement.  And if you finish with
+ * @ref exec_and_commit, the `RELEASE SAVEPOINT` goes along with the last
+ * statement.  That way, a subtransaction can do its whole job in one round
+ * trip.  Only if something goes wrong does it need another, to roll back.
+ *
+ * ```cxx
+ * for (auto const &[id, name] : rows)
+ * {
+ *   pqxx::subtransaction sub{tx, pqxx::begin_policy::deferred};
+ *   try
+ *   {
+ *     sub.exec_and_commit(
+ *       "INSERT INTO item (id, name) VALUES ($1, $2)",
+ *       pqxx::params{id, name});
+ *   }
+ *   catch (pqxx::unique_violation const &)
+ *   {
+ *     // The subtransaction has rolled back.  Skip this row.
+ *   }
+ * }
+ * ```
  */
 class PQXX_LIBEXPORT subtransaction final : public transaction_focus,
                                             public dbtransaction
@@ -90,6 +116,17 @@ public:
           subtransaction(t, "", loc)
   {}
 
+  /// Nest a subtransaction, optionally deferring its savepoint.
+  subtransaction(
+    dbtransaction &t, std::string_view tname, begin_policy policy,
+    sl = sl::current());
+
+  /// Nest a subtransaction, optionally deferring its savepoint.
+  subtransaction(
+    dbtransaction &t, begin_policy policy, sl loc = sl::current()) :
+          subtransaction(t, "", policy, loc)
+  {}
+
   /// Nest a subtransaction in another subtransaction.
   subtransaction(
     subtransaction &t, std::string_view name = ""sv, sl loc = sl::current());
@@ -102,12 +139,30 @@ public:
   subtransaction &operator=(subtransaction const &) = delete;
   subtransaction &operator=(subtransaction &&) = delete;
 
+  /// Execute one last statement, and commit, in a single round trip.
+  /** Sends the statement along with the `RELEASE SAVEPOINT`, and if the
+   * subtransaction hasn't set its savepoint yet, the `SAVEPOINT` as well.
+   *
+   * If all goes well, the subtransaction is committed when this returns, and
+   * you get the statement's result.  If the statement fails, you get its
+   * error, and the subtransaction rolls back to its savepoint.
+   */
+  result exec_and_commit(
+    std::string_view query, params const &parms = {}, sl loc = sl::current());
+
+  /// Execute a prepared statement, and commit, in a single round trip.
+  result exec_and_commit(
+    prepped statement, params const &parms = {}, sl loc = sl::current());
+
 private:
   [[nodiscard]] std::string quoted_name() const
   {
     return quote_name(transaction_focus::name());
   }
   void do_commit(sl) override;
+
+  /// The `SAVEPOINT` command, for as long as it may still need to go out.
+  std::string m_savepoint_cmd;
 };
 
 // NOLINTEND(fuchsia-multiple-inheritance)
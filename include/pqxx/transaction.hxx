@@ -31,11 +31,42 @@ protected:
     connection &cx, zview begin_command, std::string &&tname,
     sl = sl::current());
   basic_transaction(connection &cx, zview begin_command, sl = sl::current());
+  basic_transaction(
+    connection &cx, zview begin_command, std::string_view tname,
+    begin_policy policy, sl = sl::current());
+  basic_transaction(
+    connection &cx, zview begin_command, begin_policy policy,
+    sl = sl::current());
 
 private:
   void do_commit(sl) override;
 
 public:
+  /// Execute one last statement, and commit, in a single round trip.
+  /** This sends the statement and the `COMMIT` to the server together, and
+   * waits for both to complete.  If the transaction's `BEGIN` is still
+   * waiting to go out (see @ref begin_policy), that goes along as well.
+   *
+   * If all goes well, the transaction is committed when this returns, and you
+   * get the statement's result.
+   *
+   * If the statement fails, you get its error, and the transaction is
+   * aborted.  If the statement succeeds but the commit fails, you get the
+   * commit's error, and the transaction is aborted as well.
+   *
+   * @throw in_doubt_error if the connection broke, so that there is no way
+   * of telling whether the transaction got committed.
+   */
+  result exec_and_commit(
+    std::string_view query, params const &parms = {}, sl loc = sl::current());
+
+  /// Execute a prepared statement, and commit, in a single round trip.
+  /** Works like the other @ref exec_and_commit, but executes a prepared
+   * statement.
+   */
+  result exec_and_commit(
+    prepped statement, params const &parms = {}, sl loc = sl::current());
+
   basic_transaction() = delete;
   basic_transaction(basic_transaction const &) = delete;
   basic_transaction(basic_transaction &&) = delete;
@@ -105,6 +136,32 @@ public:
             cx, internal::begin_cmd<ISOLATION, READWRITE>, loc}
   {}
 
+  /// Begin a transaction, either right away or along with its first query.
+  /**
+   * @param cx Connection for this transaction to operate on.
+   * @param tname Optional name for transaction.  Must begin with a letter and
+   * may contain letters and digits only.
+   * @param policy Pass `begin_policy::deferred` to save a round trip, by
+   * sending the `BEGIN` along with the first statement you execute.
+   */
+  transaction(
+    connection &cx, std::string_view tname, begin_policy policy,
+    sl loc = sl::current()) :
+          internal::basic_transaction{
+            cx, internal::begin_cmd<ISOLATION, READWRITE>, tname, policy, loc}
+  {}
+
+  /// Begin a transaction, either right away or along with its first query.
+  /**
+   * @param cx Connection for this transaction to operate on.
+   * @param policy Pass `begin_policy::deferred` to save a round trip, by
+   * sending the `BEGIN` along with the first statement you execute.
+   */
+  transaction(connection &cx, begin_policy policy, sl loc = sl::current()) :
+          internal::basic_transaction{
+            cx, internal::begin_cmd<ISOLATION, READWRITE>, policy, loc}
+  {}
+
   transaction(transaction const &) = delete;
   transaction(transaction &&) = delete;
   transaction &operator=(transaction const &) = delete;
@@ -31,6 +31,8 @@
 
 #include "pqxx/connection.hxx"
 #include "pqxx/encoding_group.hxx"
+#include "pqxx/internal/chunked_query.hxx"
+#include "pqxx/internal/statement_batch.hxx"
 #include "pqxx/internal/stream_query.hxx"
 #include "pqxx/isolation.hxx"
 #include "pqxx/prepared_statement.hxx"
@@ -40,6 +42,7 @@
 
 namespace pqxx::internal::gate
 {
+class transaction_blob;
 class transaction_subtransaction;
 class transaction_sql_cursor;
 class transaction_stream_to;
@@ -47,11 +50,21 @@ class transaction_transaction_focus;
 } // namespace pqxx::internal::gate
 
 
+namespace pqxx::internal
+{
+template<typename... TYPE> class async_stream_query;
+template<typename SCHEMA> class result_iteration;
+} // namespace pqxx::internal
+
+
 namespace pqxx
 {
 using namespace std::literals;
 
 
+class event_loop;
+template<typename... TYPE> class row_schema;
+template<typename T> class task;
 class transaction_focus;
 
 
@@ -354,12 +367,28 @@ public:
   result
   exec(std::string_view query, std::string_view desc, sl = sl::current());
 
-  // TODO: Wrap PQdescribePrepared().
-
   result
   exec(std::string_view query, params const &parms, sl loc = sl::current())
   {
-    return internal_exec_params(query, parms.make_c_params(loc), loc);
+    return internal_exec_params(
+      query, parms.make_c_params(loc), format::text, loc);
+  }
+
+  /// Execute a parameterised command, with results in the given format.
+  /** Pass `format::binary` to receive the result data in PostgreSQL's binary
+   * format.  That saves the server the work of rendering the values as text,
+   * and saves libpqxx the work of parsing them.  The @ref field conversions
+   * will then use @ref binary_traits instead of @ref string_traits.
+   *
+   * Binary conversions are stricter than text conversions: you can't for
+   * instance read a `text` value as an `int`.
+   */
+  result exec(
+    std::string_view query, params const &parms, format result_format,
+    sl loc = sl::current())
+  {
+    return internal_exec_params(
+      query, parms.make_c_params(loc), result_format, loc);
   }
 
   /// Execute a command.
@@ -593,6 +622,27 @@ public:
       *this, query, make_context(loc)};
   }
 
+  /// Execute a query in streaming fashion, with data in the given format.
+  /** This works just like the other `stream()`, except you can choose whether
+   * the data comes in as text or in binary format.
+   *
+   * Binary format saves the work of escaping, unescaping, and parsing text.
+   * But the data does not say what SQL type each field has.  So each field is
+   * taken to be of the SQL type that naturally matches the C++ type you're
+   * reading it into: a `short` reads a `smallint`, an `int` reads an
+   * `integer`, a `double` reads a `double precision`, a `std::string` reads
+   * any text-like type, and so on.  If a column doesn't have the right type,
+   * cast it in the query.  The column types need @ref binary_traits
+   * conversions.
+   */
+  template<std::move_constructible... TYPE>
+  [[nodiscard]] auto
+  stream(std::string_view query, format fmt, sl loc = sl::current()) &
+  {
+    return pqxx::internal::stream_query<TYPE...>{
+      *this, query, make_context(loc), fmt};
+  }
+
   /// Perform a streaming query, and for each result row, call `func`.
   /** Here, `func` can be a function, a `std::function`, a lambda, or an
    * object that supports the function call operator.  Of course `func` must
@@ -689,6 +739,52 @@ public:
     return exec(query, loc).expect_rows(rows, loc).iter<TYPE...>();
   }
 
+  /// Default number of rows per chunk for @ref query_chunked.
+  static constexpr int default_chunk_rows{1000};
+
+  /// Execute a query, and iterate its rows as they arrive.
+  /** This works like @ref query, but it does not load the full result before
+   * the first row reaches you.  Instead it receives rows in chunks of up to
+   * `chunk_rows` rows, so that memory use stays bounded however large the
+   * result is.  It supports the same types as @ref query.
+   *
+   * With libpq versions older than 17, there is no "chunked rows mode," so
+   * each chunk holds a single row.
+   *
+   * Unlike @ref stream, this works with any query, e.g. `INSERT ...
+   * RETURNING`.  Until you've read all rows, the transaction is busy.
+   *
+   * @return Something you can iterate using "range `for`" syntax.
+   */
+  template<typename... TYPE>
+  [[nodiscard]] auto query_chunked(
+    std::string_view query, params const &parms = {},
+    int chunk_rows = default_chunk_rows, sl loc = sl::current()) &
+  {
+    return internal::chunked_query<TYPE...>{
+      *this, query, parms.make_c_params(loc), chunk_rows, loc};
+  }
+
+  /// Execute a query, and call `func` for each row as it arrives.
+  /** This is like @ref for_query, except it receives the rows in chunks,
+   * like @ref query_chunked.  So it does not need to hold the full result in
+   * memory.
+   *
+   * Converts each row to data types matching `func`'s parameter types.  The
+   * number of columns in the result set must match the number of parameters.
+   */
+  template<typename CALLABLE>
+  void for_query_chunked(
+    std::string_view query, CALLABLE &&func, params const &parms = {},
+    int chunk_rows = default_chunk_rows, sl loc = sl::current())
+  {
+    using param_types =
+      pqxx::internal::strip_types_t<pqxx::internal::args_t<CALLABLE>>;
+    param_types const *const sample{nullptr};
+    auto rows{query_chunked_like(query, parms, chunk_rows, sample, loc)};
+    for (auto const &fields : rows) std::apply(func, fields);
+  }
+
   /// Execute a query, load the full result, and perform `func` for each row.
   /** Converts each row to data types matching `func`'s parameter types.  The
    * number of columns in the result set must match the number of parameters.
@@ -978,7 +1074,8 @@ public:
   result exec(prepped statement, sl loc = sl::current())
   {
     params const pp;
-    return internal_exec_prepared(statement, pp.make_c_params(loc), loc);
+    return internal_exec_prepared(
+      statement, pp.make_c_params(loc), format::text, loc);
   }
 
   /// Execute prepared statement, read full results, iterate rows of data.
@@ -1059,7 +1156,21 @@ public:
   /// Execute a prepared statement with parameters.
   result exec(prepped statement, params const &parms, sl loc = sl::current())
   {
-    return internal_exec_prepared(statement, parms.make_c_params(loc), loc);
+    return internal_exec_prepared(
+      statement, parms.make_c_params(loc), format::text, loc);
+  }
+
+  /// Execute a prepared statement, with results in the given format.
+  /** Works like the version without `result_format`, but if you pass
+   * `format::binary`, you get the result data in binary format.  See
+   * @ref exec(std::string_view, params const &, format, sl).
+   */
+  result exec(
+    prepped statement, params const &parms, format result_format,
+    sl loc = sl::current())
+  {
+    return internal_exec_prepared(
+      statement, parms.make_c_params(loc), result_format, loc);
   }
 
   /// Execute a prepared statement, and expect a single-row result.
@@ -1101,6 +1212,143 @@ public:
       .expect_rows(rows, loc);
   }
 
+  /**
+   * @name Batch execution
+   *
+   * These functions execute the same statement many times over, once for
+   * each row of parameters in a range.  They send the executions through a
+   * pipeline, so they don't wait for a round trip to the server for each.
+   *
+   * A row can be a tuple-like type such as `std::tuple`, `std::pair`, or
+   * `std::array`; or a @ref params.  For other types, such as your own
+   * structs, list the members to pass as template arguments:
+   *
+   * ```cxx
+   *     struct item { int id; std::string name; };
+   *     std::vector<item> const items{...};
+   *     tx.execute_many<&item::id, &item::name>(
+   *       pqxx::prepped{"insert_item"}, items);
+   * ```
+   *
+   * Each execution is like a separate call to `exec()`.  If one fails, the
+   * batch stops sending more, and throws its error once the executions that
+   * are already on their way have completed.  (In a @ref nontransaction,
+   * those will have taken effect.)
+   *
+   * While the batch executes, the transaction is busy.
+   */
+  //@{
+  /// Execute prepared `statement` for each row; return all results.
+  template<auto... MEMBER, std::ranges::input_range ROWS>
+  std::vector<result>
+  execute_many(prepped statement, ROWS const &rows, sl loc = sl::current())
+  {
+    internal::statement_batch batch{*this, statement, true, true, loc};
+    execute_batch<MEMBER...>(batch, rows, loc);
+    return batch.take_results();
+  }
+
+  /// Execute parameterised `query` for each row; return all results.
+  template<auto... MEMBER, std::ranges::input_range ROWS>
+  std::vector<result> execute_many(
+    std::string_view query, ROWS const &rows, sl loc = sl::current())
+  {
+    internal::statement_batch batch{*this, query, false, true, loc};
+    execute_batch<MEMBER...>(batch, rows, loc);
+    return batch.take_results();
+  }
+
+  /// Execute prepared `statement` for each row; return affected-row counts.
+  /** This does not keep the results in memory.  Use it for statements such
+   * as `INSERT` or `UPDATE`, where you only need to know how many rows each
+   * execution affected.
+   */
+  template<auto... MEMBER, std::ranges::input_range ROWS>
+  std::vector<result::size_type> execute_many_affected(
+    prepped statement, ROWS const &rows, sl loc = sl::current())
+  {
+    internal::statement_batch batch{*this, statement, true, false, loc};
+    execute_batch<MEMBER...>(batch, rows, loc);
+    return batch.take_counts();
+  }
+
+  /// Execute parameterised `query` for each row; return affected-row counts.
+  template<auto... MEMBER, std::ranges::input_range ROWS>
+  std::vector<result::size_type> execute_many_affected(
+    std::string_view query, ROWS const &rows, sl loc = sl::current())
+  {
+    internal::statement_batch batch{*this, query, false, false, loc};
+    execute_batch<MEMBER...>(batch, rows, loc);
+    return batch.take_counts();
+  }
+  //@}
+
+  /**
+   * @name Asynchronous execution
+   *
+   * These functions execute queries without blocking the thread.  Each
+   * returns a @ref task, which you `co_await` in a C++20 coroutine.  While the
+   * query executes, the coroutine is suspended, and an @ref event_loop
+   * resumes it once the connection's socket has data for it.  So a few
+   * threads can keep many queries on many connections in flight at once.
+   *
+   * A function sends its query right away, before you `co_await` its task.
+   * So the query text and parameters need not stay alive until then.
+   *
+   * Include `<pqxx/async>` to use these functions.  There can be only one
+   * query in flight per transaction at any time, and until it completes, you
+   * can't use the transaction for anything else.
+   */
+  //@{
+  /// Execute a command asynchronously.
+  /** Example:
+   *
+   * ```cxx
+   *     pqxx::task<void> show_sum(pqxx::event_loop &loop, pqxx::work &tx)
+   *     {
+   *         auto const r{co_await tx.async_exec(loop, "SELECT 1 + 1")};
+   *         std::cout << r.one_field().as<int>() << '\n';
+   *     }
+   * ```
+   */
+  task<result> async_exec(
+    event_loop &loop, std::string_view query, sl loc = sl::current());
+
+  /// Execute a parameterised command asynchronously.
+  task<result> async_exec(
+    event_loop &loop, std::string_view query, params const &parms,
+    sl loc = sl::current());
+
+  /// Execute a parameterised command asynchronously, in the given format.
+  task<result> async_exec(
+    event_loop &loop, std::string_view query, params const &parms,
+    format result_format, sl loc = sl::current());
+
+  /// Execute a query asynchronously, and iterate its rows as tuples.
+  /** This is the asynchronous version of @ref query.  Once the task
+   * completes, you can iterate its result with "range `for`" syntax.
+   */
+  template<typename... TYPE>
+  task<internal::result_iteration<row_schema<TYPE...>>> async_query(
+    event_loop &loop, std::string_view query, params const &parms = {},
+    sl loc = sl::current());
+
+  /// Stream a query's results asynchronously.
+  /** This is the asynchronous version of @ref stream.  Once the task
+   * completes, `co_await` the stream's `next()` for each row.
+   *
+   * The same restrictions apply as for @ref stream.  In particular, the
+   * stream occupies the transaction until it has read all of its data.
+   *
+   * The stream does not send anything to the server until you first
+   * `co_await` the task.
+   */
+  template<std::move_constructible... TYPE>
+  task<internal::async_stream_query<TYPE...>> async_stream(
+    event_loop &loop, std::string_view query, format fmt = format::text,
+    sl loc = sl::current());
+  //@}
+
   /**
    * @name Error/warning output
    */
@@ -1191,6 +1439,33 @@ protected:
     m_rollback_cmd = std::move(cmd);
   }
 
+  /// Hold on to the command that starts the transaction, for later.
+  /** Instead of executing `begin_command` now, the transaction sends it
+   * along with the first statement it executes.  If it never gets to execute
+   * anything, it never sends the command at all.
+   *
+   * The string must stay valid for as long as the transaction exists.
+   */
+  void defer_begin(zview begin_command) noexcept
+  {
+    m_pending_begin = begin_command;
+  }
+
+  /// Is the transaction's start command still waiting to go out?
+  [[nodiscard]] bool begin_pending() const noexcept
+  {
+    return not std::empty(m_pending_begin);
+  }
+
+  /// Execute a statement and then `commit_cmd`, in a single round trip.
+  /** For transaction types whose commit is a plain SQL command.  Sends any
+   * pending start command ahead of the statement.  Leaves the transaction
+   * committed, or throws the error for whichever of the commands failed.
+   */
+  result internal_exec_and_commit(
+    std::string_view statement, bool prepared, internal::c_params const &args,
+    zview commit_cmd, sl);
+
   /// Execute query on connection directly.
   result direct_exec(std::string_view, std::string_view desc, sl);
   result direct_exec(std::string_view query, sl loc)
@@ -1224,11 +1499,18 @@ private:
 
   PQXX_PRIVATE void check_pending_error();
 
+  friend class pqxx::internal::gate::transaction_blob;
+  friend class pqxx::internal::gate::transaction_subtransaction;
+  /// Execute the pending start command, if any, on its own.
+  PQXX_PRIVATE void send_pending_begin(sl);
+
   result internal_exec_prepared(
-    std::string_view statement, internal::c_params const &args, sl);
+    std::string_view statement, internal::c_params const &args,
+    format result_format, sl);
 
   result internal_exec_params(
-    std::string_view query, internal::c_params const &args, sl);
+    std::string_view query, internal::c_params const &args,
+    format result_format, sl);
 
   /// Describe this transaction to humans, e.g. "transaction 'foo'".
   [[nodiscard]] std::string description() const;
@@ -1239,6 +1521,35 @@ private:
   PQXX_PRIVATE void register_pending_error(zview, sl) noexcept;
   PQXX_PRIVATE void register_pending_error(std::string &&, sl) noexcept;
 
+  /// Send one execution per row to `batch`, then wait for them all.
+  template<auto... MEMBER, typename ROWS>
+  void
+  execute_batch(internal::statement_batch &batch, ROWS const &rows, sl loc)
+  {
+    if constexpr (std::ranges::sized_range<ROWS>)
+      batch.reserve(std::size(rows));
+    // Reuse one params, and so its buffers, for all rows.
+    params args{*this};
+    for (auto const &row : rows)
+    {
+      args.clear();
+      internal::append_row<MEMBER...>(args, row, loc);
+      batch.send(args, loc);
+      if (batch.failed())
+        break;
+    }
+    batch.finish(loc);
+  }
+
+  /// Like @ref query_chunked(), but takes a tuple instead of a type pack.
+  template<typename... ARGS>
+  auto query_chunked_like(
+    std::string_view query, params const &parms, int chunk_rows,
+    std::tuple<ARGS...> const *, sl loc)
+  {
+    return query_chunked<ARGS...>(query, parms, chunk_rows, loc);
+  }
+
   /// Like @ref stream(), but takes a tuple rather than a parameter pack.
   template<typename... ARGS>
   auto stream_like(
@@ -1262,6 +1573,9 @@ private:
   /// SQL command for aborting this type of transaction.
   std::shared_ptr<std::string> m_rollback_cmd;
 
+  /// Start command that still needs to go out with the next statement.
+  zview m_pending_begin;
+
   status m_status = status::active;
 
   bool m_registered = false;
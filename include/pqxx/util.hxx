@@ -745,6 +745,20 @@ inline std::size_t copy_chars(
     dst[at++] = '\0';
   return at;
 }
+
+
+/// Hash for string-keyed containers, allowing lookups by `std::string_view`.
+/** Use it with `std::equal_to<>` to look up keys in an unordered container
+ * without constructing a `std::string` for each lookup.
+ */
+struct string_hash final
+{
+  using is_transparent = void;
+  [[nodiscard]] std::size_t operator()(std::string_view key) const noexcept
+  {
+    return std::hash<std::string_view>{}(key);
+  }
+};
 } // namespace pqxx::internal
 
 
@@ -0,0 +1,321 @@
+/** Implementation of the Arrow C Data Interface export.
+ *
+ * Copyright (c) 2000-2026, Jeroen T. Vermeulen.
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this
+ * mistake, or contact the author.
+ */
+#include "pqxx-source.hxx"
+
+#include <bit>
+#include <limits>
+#include <memory>
+
+#include "pqxx/internal/header-pre.hxx"
+
+#include "pqxx/arrow.hxx"
+
+#include "pqxx/internal/header-post.hxx"
+
+
+namespace
+{
+/// The buffers of one exported column.
+/** An exported child array owns its buffers, so that a consumer can move it
+ * out of its parent.
+ */
+struct child_data final
+{
+  std::vector<std::uint8_t> validity;
+  std::vector<std::byte> data;
+  std::vector<std::int32_t> offsets;
+  std::array<void const *, 3> buffers{};
+};
+
+
+void release_child(ArrowArray *array) noexcept
+{
+  std::unique_ptr<child_data> const owner{
+    static_cast<child_data *>(array->private_data)};
+  array->release = nullptr;
+}
+
+
+/// The child arrays of one exported chunk.
+struct parent_data final
+{
+  explicit parent_data(std::size_t columns) :
+          children(columns), pointers(columns)
+  {}
+
+  std::vector<ArrowArray> children;
+  std::vector<ArrowArray *> pointers;
+  std::array<void const *, 1> buffers{};
+};
+
+
+void release_parent(ArrowArray *array) noexcept
+{
+  std::unique_ptr<parent_data> const owner{
+    static_cast<parent_data *>(array->private_data)};
+  // A consumer may have moved some children out, and released them already.
+  for (auto &child : owner->children)
+    if (child.release != nullptr)
+      child.release(&child);
+  array->release = nullptr;
+}
+
+
+/// The strings for one exported child schema.
+struct child_schema final
+{
+  std::string format;
+  std::string name;
+};
+
+
+void release_child_schema(ArrowSchema *schema) noexcept
+{
+  std::unique_ptr<child_schema> const owner{
+    static_cast<child_schema *>(schema->private_data)};
+  schema->release = nullptr;
+}
+
+
+/// The child schemas of one exported struct schema.
+struct parent_schema final
+{
+  explicit parent_schema(std::size_t columns) :
+          children(columns), pointers(columns)
+  {}
+
+  std::vector<ArrowSchema> children;
+  std::vector<ArrowSchema *> pointers;
+};
+
+
+void release_parent_schema(ArrowSchema *schema) noexcept
+{
+  std::unique_ptr<parent_schema> const owner{
+    static_cast<parent_schema *>(schema->private_data)};
+  for (auto &child : owner->children)
+    if (child.release != nullptr)
+      child.release(&child);
+  schema->release = nullptr;
+}
+
+
+/// Clear the bits from `bits` onwards in a bitmap of `bits` bits.
+void trim_bitmap(std::span<std::uint8_t> bitmap, std::int64_t bits) noexcept
+{
+  auto const spare{static_cast<unsigned>(bits % 8)};
+  if ((spare != 0u) and not std::empty(bitmap))
+    bitmap.back() &= static_cast<std::uint8_t>((1u << spare) - 1u);
+}
+} // namespace
+
+
+pqxx::internal::arrow_column::arrow_column(
+  std::string_view col_name, char const *col_format) :
+        name{col_name}, format{col_format}, kind{layout::fixed}
+{
+  std::string_view const fmt{col_format};
+  if (fmt == "b")
+  {
+    kind = layout::boolean;
+  }
+  else if ((fmt == "u") or (fmt == "z"))
+  {
+    kind = layout::variable;
+    offsets.push_back(0);
+  }
+  else if ((fmt == "c") or (fmt == "C"))
+  {
+    width = 1;
+  }
+  else if ((fmt == "s") or (fmt == "S"))
+  {
+    width = 2;
+  }
+  else if ((fmt == "i") or (fmt == "I") or (fmt == "f"))
+  {
+    width = 4;
+  }
+  else
+  {
+    width = 8;
+  }
+}
+
+
+void pqxx::internal::arrow_columns::add_column(
+  std::string_view name, char const *format)
+{
+  m_columns.emplace_back(name, format);
+}
+
+
+void pqxx::internal::arrow_columns::append_bytes(
+  std::size_t col, bytes_view value, sl loc)
+{
+  auto &c{m_columns[col]};
+  auto const here{std::size(c.data)};
+  auto const end{here + std::size(value)};
+  if (end > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+    throw range_error{
+      std::format(
+        "Arrow column '{}' has outgrown its 32-bit offsets.  Export chunks "
+        "more often.",
+        c.name),
+      loc};
+  start_value(col, true);
+  c.data.insert(std::end(c.data), std::begin(value), std::end(value));
+  c.offsets.push_back(static_cast<std::int32_t>(end));
+  ++c.length;
+}
+
+
+void pqxx::internal::arrow_columns::truncate() noexcept
+{
+  auto const rows{static_cast<std::size_t>(m_rows)};
+  auto const bitmap_size{(rows + 7u) / 8u};
+  for (auto &c : m_columns)
+  {
+    // None of these grow their vectors, so they can't throw.
+    c.validity.resize(bitmap_size);
+    trim_bitmap(c.validity, m_rows);
+    std::int64_t valid{0};
+    for (auto const byte : c.validity) valid += std::popcount(byte);
+    c.null_count = m_rows - valid;
+    switch (c.kind)
+    {
+    case arrow_column::layout::boolean:
+      c.data.resize(bitmap_size);
+      if ((m_rows % 8) != 0)
+        c.data.back() &= static_cast<std::byte>((1u << (m_rows % 8)) - 1u);
+      break;
+    case arrow_column::layout::fixed: c.data.resize(rows * c.width); break;
+    case arrow_column::layout::variable:
+      c.offsets.resize(rows + 1u);
+      c.data.resize(static_cast<std::size_t>(c.offsets.back()));
+      break;
+    }
+    c.length = m_rows;
+  }
+}
+
+
+void pqxx::internal::arrow_columns::export_schema(ArrowSchema *out) const
+{
+  auto const columns{std::size(m_columns)};
+  auto owner{std::make_unique<parent_schema>(columns)};
+  // First allocate everything that may fail.
+  std::vector<std::unique_ptr<child_schema>> strings;
+  strings.reserve(columns);
+  for (auto const &c : m_columns)
+    strings.push_back(
+      std::make_unique<child_schema>(std::string{c.format}, c.name));
+
+  for (std::size_t col{0}; col < columns; ++col)
+  {
+    auto &child{owner->children[col]};
+    auto *const names{strings[col].release()};
+    child = ArrowSchema{
+      .format = names->format.c_str(),
+      .name = names->name.c_str(),
+      .metadata = nullptr,
+      .flags = ARROW_FLAG_NULLABLE,
+      .n_children = 0,
+      .children = nullptr,
+      .dictionary = nullptr,
+      .release = release_child_schema,
+      .private_data = names};
+    owner->pointers[col] = &child;
+  }
+
+  *out = ArrowSchema{
+    .format = "+s",
+    .name = "",
+    .metadata = nullptr,
+    .flags = 0,
+    .n_children = static_cast<std::int64_t>(columns),
+    .children = std::data(owner->pointers),
+    .dictionary = nullptr,
+    .release = release_parent_schema,
+    .private_data = owner.release()};
+}
+
+
+void pqxx::internal::arrow_columns::export_chunk(ArrowArray *out)
+{
+  auto const columns{std::size(m_columns)};
+  auto owner{std::make_unique<parent_data>(columns)};
+  // First allocate everything that may fail, including the fresh offsets
+  // buffers for the next chunk.  After that, we just move buffers around.
+  std::vector<std::unique_ptr<child_data>> buffers;
+  buffers.reserve(columns);
+  std::vector<std::vector<std::int32_t>> fresh_offsets(columns);
+  for (std::size_t col{0}; col < columns; ++col)
+  {
+    buffers.push_back(std::make_unique<child_data>());
+    if (m_columns[col].kind == arrow_column::layout::variable)
+      fresh_offsets[col].push_back(0);
+  }
+
+  for (std::size_t col{0}; col < columns; ++col)
+  {
+    auto &c{m_columns[col]};
+    auto *const data{buffers[col].release()};
+    data->validity = std::move(c.validity);
+    data->data = std::move(c.data);
+    data->offsets = std::move(c.offsets);
+    // Arrow lets us leave out the validity bitmap if there are no nulls.
+    data->buffers[0] =
+      (c.null_count == 0) ? nullptr : std::data(data->validity);
+    std::int64_t n_buffers{2};
+    if (c.kind == arrow_column::layout::variable)
+    {
+      data->buffers[1] = std::data(data->offsets);
+      data->buffers[2] = std::data(data->data);
+      n_buffers = 3;
+    }
+    else
+    {
+      data->buffers[1] = std::data(data->data);
+    }
+
+    auto &child{owner->children[col]};
+    child = ArrowArray{
+      .length = c.length,
+      .null_count = c.null_count,
+      .offset = 0,
+      .n_buffers = n_buffers,
+      .n_children = 0,
+      .buffers = std::data(data->buffers),
+      .children = nullptr,
+      .dictionary = nullptr,
+      .release = release_child,
+      .private_data = data};
+    owner->pointers[col] = &child;
+
+    c.validity.clear();
+    c.data.clear();
+    c.offsets = std::move(fresh_offsets[col]);
+    c.length = 0;
+    c.null_count = 0;
+  }
+
+  *out = ArrowArray{
+    .length = m_rows,
+    .null_count = 0,
+    .offset = 0,
+    .n_buffers = 1,
+    .n_children = static_cast<std::int64_t>(columns),
+    .buffers = std::data(owner->buffers),
+    .children = std::data(owner->pointers),
+    .dictionary = nullptr,
+    .release = release_parent,
+    .private_data = owner.release()};
+  m_rows = 0;
+}
@@ -0,0 +1,440 @@
+/** Implementation of asynchronous, coroutine-based query execution.
+ *
+ * Copyright (c) 2000-2026, Jeroen T. Vermeulen.
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this
+ * mistake, or contact the author.
+ */
+#include "pqxx-source.hxx"
+
+#include <array>
+#include <cerrno>
+#include <memory>
+#include <span>
+#include <vector>
+
+#if __has_include(<sys/epoll.h>)
+#  include <sys/epoll.h>
+#  include <unistd.h>
+#  define PQXX_HAVE_EPOLL
+#endif
+
+#include "pqxx/internal/header-pre.hxx"
+
+extern "C"
+{
+#include <libpq-fe.h>
+}
+
+#include "pqxx/async.hxx"
+#include "pqxx/internal/gates/connection-async.hxx"
+#include "pqxx/transaction_focus.hxx"
+
+#include "pqxx/internal/header-post.hxx"
+
+
+using namespace std::literals;
+
+
+namespace pqxx::internal
+{
+/// Steps in describing a query asynchronously.  See @ref async_describe.
+enum class describe_step
+{
+  /// Prepare the query as the unnamed statement.
+  prepare,
+  /// Describe the unnamed statement.
+  describe,
+};
+
+
+/// A command that's executing asynchronously, on a transaction.
+/** This occupies the transaction for as long as the command executes.  It
+ * also keeps the connection in nonblocking mode, so that sending the command
+ * never waits.
+ */
+class PQXX_PRIVATE async_command final : transaction_focus
+{
+public:
+  /// Send `query` to the server, but don't wait for anything.
+  async_command(
+    transaction_base &tx, std::string_view query, c_params const &args,
+    format result_format, sl loc) :
+          transaction_focus{tx, "async_exec"sv}, m_sock{tx.conn().sock()}
+  {
+    register_me();
+    gate::connection_async gate{trans().conn()};
+    try
+    {
+      gate.set_nonblocking(true, loc);
+      m_query = gate.intern_query(query);
+      gate.start_exec_params(*m_query, args, result_format, loc);
+    }
+    catch (std::exception const &)
+    {
+      finish();
+      throw;
+    }
+  }
+
+  /// Send one step of describing `query` to the server.
+  async_command(
+    transaction_base &tx, std::string_view query, describe_step step,
+    sl loc) :
+          transaction_focus{tx, "async_describe"sv}, m_sock{tx.conn().sock()}
+  {
+    register_me();
+    gate::connection_async gate{trans().conn()};
+    try
+    {
+      gate.set_nonblocking(true, loc);
+      m_query = gate.intern_query(query);
+      if (step == describe_step::prepare)
+        gate.start_prepare_unnamed(*m_query, loc);
+      else
+        gate.start_describe_unnamed(loc);
+    }
+    catch (std::exception const &)
+    {
+      finish();
+      throw;
+    }
+  }
+
+  async_command() = delete;
+  async_command(async_command const &) = delete;
+  async_command &operator=(async_command const &) = delete;
+
+  ~async_command() noexcept { finish(); }
+
+  [[nodiscard]] int sock() const noexcept { return m_sock; }
+
+  /// Send what we can of the command.  Returns `true` once it's all gone out.
+  [[nodiscard]] bool flushed(sl loc)
+  {
+    return gate::connection_async{trans().conn()}.try_flush_output(loc);
+  }
+
+  /// Read what input there is, without waiting.
+  void consume(sl loc)
+  {
+    gate::connection_async gate{trans().conn()};
+    if (not gate.consume_input()) [[unlikely]]
+      throw broken_connection{
+        std::format("Could not read query result: {}", gate.err_msg()),
+        loc};
+  }
+
+  /// Read what input there is.  Returns `true` if a result is ready.
+  [[nodiscard]] bool ready(sl loc)
+  {
+    consume(loc);
+    return not gate::connection_async{trans().conn()}.is_busy();
+  }
+
+  /// Take the next result.  Returns `false` if there are no more.
+  /** Call this only when @ref ready says so.
+   */
+  bool next_result()
+  {
+    if (m_done)
+      return false;
+    auto *const res{static_cast<::PGresult *>(
+      gate::connection_async{trans().conn()}.get_result())};
+    if (res == nullptr)
+    {
+      m_done = true;
+      return false;
+    }
+    m_results.emplace_back(res, PQclear);
+    switch (PQresultStatus(res))
+    {
+    case PGRES_COPY_IN:
+    case PGRES_COPY_OUT:
+    case PGRES_COPY_BOTH:
+      // The connection has entered a COPY.  There won't be more results until
+      // that's done.  (Just like PQexec(), we stop here.)
+      m_done = true;
+      return false;
+    default: return true;
+    }
+  }
+
+  /// Check the results in order, and return the last one.
+  /** If any of them was an error, throws the exception for it.
+   */
+  [[nodiscard]] result take_result(sl loc)
+  {
+    gate::connection_async gate{trans().conn()};
+    result last;
+    if (std::empty(m_results))
+      // Let make_result() figure out what went wrong.
+      last = gate.make_result(nullptr, m_query, loc);
+    for (auto &res : m_results)
+      last = gate.make_result(res.release(), m_query, loc);
+    m_results.clear();
+    return last;
+  }
+
+private:
+  /// Drain any remaining results, leave nonblocking mode, and unregister.
+  void finish() noexcept
+  {
+    gate::connection_async gate{trans().conn()};
+    m_results.clear();
+    try
+    {
+      gate.set_nonblocking(false, sl::current());
+    }
+    catch (std::exception const &)
+    {}
+    // If the command did not complete, wait for it here, so the connection is
+    // ready for the next one.
+    while (not m_done)
+    {
+      auto *const res{static_cast<::PGresult *>(gate.get_result())};
+      if (res == nullptr)
+        break;
+      auto const status{PQresultStatus(res)};
+      PQclear(res);
+      if (
+        (status == PGRES_COPY_IN) or (status == PGRES_COPY_OUT) or
+        (status == PGRES_COPY_BOTH))
+        break;
+    }
+    m_done = true;
+    unregister_me();
+  }
+
+  int m_sock;
+  std::shared_ptr<std::string> m_query;
+  std::vector<std::unique_ptr<::PGresult, void (*)(::PGresult *)>> m_results;
+  bool m_done = false;
+};
+} // namespace pqxx::internal
+
+
+namespace
+{
+/// Wait for `cmd` to complete, and return its result.
+pqxx::task<pqxx::result> await_command(
+  pqxx::event_loop &loop, std::unique_ptr<pqxx::internal::async_command> cmd,
+  pqxx::connection &cx, pqxx::sl loc)
+{
+  // Keep the command in a local variable, so that if anything goes wrong,
+  // it releases the transaction straight away.
+  auto command{std::move(cmd)};
+  auto const sock{command->sock()};
+  while (not command->flushed(loc))
+  {
+    // The server may not read what we send until we've read what it sends,
+    // so take in any input while we wait.  Otherwise we could deadlock.
+    co_await loop.readable_or_writable(sock, loc);
+    command->consume(loc);
+  }
+  do {
+    while (not command->ready(loc)) co_await loop.readable(sock, loc);
+  } while (command->next_result());
+  auto const res{command->take_result(loc)};
+  // Release the transaction before we return, so the caller can use it.
+  command.reset();
+  cx.get_notifs(loc);
+  co_return res;
+}
+} // namespace
+
+
+pqxx::task<pqxx::result> pqxx::internal::async_describe(
+  transaction_base &tx, event_loop &loop, std::string query, sl loc)
+{
+  co_await await_command(
+    loop,
+    std::make_unique<async_command>(tx, query, describe_step::prepare, loc),
+    tx.conn(), loc);
+  co_return co_await await_command(
+    loop,
+    std::make_unique<async_command>(tx, query, describe_step::describe, loc),
+    tx.conn(), loc);
+}
+
+
+pqxx::task<pqxx::result>
+pqxx::transaction_base::async_exec(
+  event_loop &loop, std::string_view query, sl loc)
+{
+  return async_exec(loop, query, params{}, format::text, loc);
+}
+
+
+pqxx::task<pqxx::result> pqxx::transaction_base::async_exec(
+  event_loop &loop, std::string_view query, params const &parms, sl loc)
+{
+  return async_exec(loop, query, parms, format::text, loc);
+}
+
+
+pqxx::task<pqxx::result> pqxx::transaction_base::async_exec(
+  event_loop &loop, std::string_view query, params const &parms,
+  format result_format, sl loc)
+{
+  check_pending_error();
+  auto cmd{std::make_unique<internal::async_command>(
+    *this, query, parms.make_c_params(loc), result_format, loc)};
+  return await_command(loop, std::move(cmd), conn(), loc);
+}
+
+
+pqxx::event_loop::~event_loop() noexcept = default;
+
+
+void pqxx::event_loop::spawn(task<> &&t)
+{
+  m_tasks.push_back(std::move(t));
+  m_tasks.back().start();
+}
+
+
+void pqxx::event_loop::reap()
+{
+  for (auto t{std::begin(m_tasks)}; t != std::end(m_tasks);)
+  {
+    if (t->done())
+    {
+      // Take the task out of the list before get() can throw.
+      auto finished{std::move(*t)};
+      t = m_tasks.erase(t);
+      finished.get();
+    }
+    else
+    {
+      ++t;
+    }
+  }
+}
+
+
+#if defined(PQXX_HAVE_EPOLL)
+
+pqxx::epoll_loop::epoll_loop(sl loc) : m_fd{::epoll_create1(EPOLL_CLOEXEC)}
+{
+  if (m_fd < 0)
+  {
+    std::array<char, 200> errbuf{};
+    throw failure{
+      std::format(
+        "Could not create epoll instance: {}",
+        internal::error_string(errno, errbuf)),
+      loc};
+  }
+}
+
+
+pqxx::epoll_loop::~epoll_loop() noexcept
+{
+  ::close(m_fd);
+}
+
+
+void pqxx::epoll_loop::wait_for(
+  int fd, bool read, bool write, std::coroutine_handle<> h, sl loc)
+{
+  if (m_waiting.contains(fd)) [[unlikely]]
+    throw usage_error{
+      std::format("Two coroutines are waiting for socket {} at once.", fd),
+      loc};
+  ::epoll_event ev{};
+  ev.events = (read ? EPOLLIN : 0u) | (write ? EPOLLOUT : 0u) | EPOLLONESHOT;
+  ev.data.fd = fd;
+  if (::epoll_ctl(m_fd, EPOLL_CTL_ADD, fd, &ev) != 0)
+  {
+    std::array<char, 200> errbuf{};
+    throw failure{
+      std::format(
+        "Could not wait for socket {}: {}", fd,
+        internal::error_string(errno, errbuf)),
+      loc};
+  }
+  m_waiting.emplace(fd, h);
+}
+
+
+void pqxx::epoll_loop::step(sl loc)
+{
+  if (std::empty(m_waiting)) [[unlikely]]
+    throw usage_error{
+      "Event loop has nothing to wait for.  Is a task waiting for something "
+      "else?",
+      loc};
+
+  std::array<::epoll_event, 64> events{};
+  int count{-1};
+  do {
+    count = ::epoll_wait(m_fd, std::data(events), std::size(events), -1);
+  } while ((count < 0) and (errno == EINTR));
+  if (count < 0)
+  {
+    std::array<char, 200> errbuf{};
+    throw failure{
+      std::format(
+        "Error waiting for sockets: {}",
+        internal::error_string(errno, errbuf)),
+      loc};
+  }
+
+  for (auto const &ev :
+       std::span{std::data(events), static_cast<std::size_t>(count)})
+  {
+    auto const fd{ev.data.fd};
+    auto const waiter{m_waiting.find(fd)};
+    if (waiter == std::end(m_waiting)) [[unlikely]]
+      continue;
+    auto const h{waiter->second};
+    m_waiting.erase(waiter);
+    ::epoll_ctl(m_fd, EPOLL_CTL_DEL, fd, nullptr);
+    h.resume();
+  }
+  reap();
+}
+
+#else // PQXX_HAVE_EPOLL
+
+namespace
+{
+[[noreturn]] PQXX_COLD void no_epoll(pqxx::sl loc)
+{
+  throw pqxx::feature_not_supported{
+    "This system does not support epoll.", "", "", loc};
+}
+} // namespace
+
+
+pqxx::epoll_loop::epoll_loop(sl loc)
+{
+  no_epoll(loc);
+}
+
+
+pqxx::epoll_loop::~epoll_loop() noexcept = default;
+
+
+void pqxx::epoll_loop::wait_for(
+  int, bool, bool, std::coroutine_handle<>, sl loc)
+{
+  no_epoll(loc);
+}
+
+
+void pqxx::epoll_loop::step(sl loc)
+{
+  no_epoll(loc);
+}
+
+#endif // PQXX_HAVE_EPOLL
+
+
+void pqxx::epoll_loop::run(sl loc)
+{
+  reap();
+  while (running() > 0) step(loc);
+}
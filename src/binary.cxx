@@ -0,0 +1,186 @@
+/** Implementation of binary-format decoding.
+ *
+ * Copyright (c) 2000-2026, Jeroen T. Vermeulen.
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this
+ * mistake, or contact the author.
+ */
+#include "pqxx-source.hxx"
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <string>
+#include <utility>
+
+#include "pqxx/internal/header-pre.hxx"
+
+#include "pqxx/binary.hxx"
+#include "pqxx/except.hxx"
+
+#include "pqxx/internal/header-post.hxx"
+
+
+namespace
+{
+/// Sign markers in a binary `numeric`.
+constexpr std::uint16_t numeric_pos{0x0000}, numeric_neg{0x4000},
+  numeric_nan{0xc000}, numeric_pinf{0xd000}, numeric_ninf{0xf000};
+
+/// A `numeric` stores its digits in base 10,000: 4 decimal digits each.
+constexpr int numeric_dec_digits{4};
+
+
+/// Append a base-10,000 digit to `out`, as 4 decimal digits.
+void append_numeric_digit(std::string &out, int digit)
+{
+  std::array<char, numeric_dec_digits> buf{};
+  for (auto i{numeric_dec_digits - 1}; i >= 0; --i)
+  {
+    buf.at(static_cast<std::size_t>(i)) =
+      pqxx::internal::number_to_digit(digit % 10);
+    digit /= 10;
+  }
+  out.append(std::data(buf), std::size(buf));
+}
+} // namespace
+
+
+namespace pqxx::internal
+{
+PQXX_COLD void throw_binary_mismatch(
+  std::string_view type_name, oid type, std::size_t size, sl loc)
+{
+  throw conversion_error{
+    std::format(
+      "Can't convert binary value of SQL type {} ({} bytes) to {}.", type,
+      size, type_name),
+    loc};
+}
+
+
+PQXX_COLD void throw_no_binary_decoder(std::string_view type_name, sl loc)
+{
+  throw conversion_error{
+    std::format(
+      "Can't convert binary value to {}: there is no binary conversion for "
+      "that type.  Request the result in text format.",
+      type_name),
+    loc};
+}
+
+
+PQXX_COLD void throw_no_binary_encoder(std::string_view type_name, sl loc)
+{
+  throw conversion_error{
+    std::format(
+      "Can't write {} in binary format: there is no binary conversion for "
+      "that type.",
+      type_name),
+    loc};
+}
+
+
+PQXX_COLD void throw_binary_only(std::string_view type_name, sl loc)
+{
+  throw conversion_error{
+    std::format(
+      "Can't convert text to {}: this type can only be read from a result "
+      "in binary format.",
+      type_name),
+    loc};
+}
+
+
+std::string numeric_to_string(bytes_view data, sl loc)
+{
+  // A binary numeric consists of a header of 4 16-bit integers, followed by
+  // the digits, each of which is also a 16-bit integer.
+  constexpr std::size_t header{8}, digit_size{2};
+  if (std::size(data) < header) [[unlikely]]
+    throw_binary_mismatch("numeric", oid_numeric, std::size(data), loc);
+  auto const ptr{std::data(data)};
+  auto const ndigits{read_big_endian<std::int16_t>(ptr)};
+  auto const weight{read_big_endian<std::int16_t>(ptr + 2)};
+  auto const sign{read_big_endian<std::uint16_t>(ptr + 4)};
+  auto const dscale{read_big_endian<std::int16_t>(ptr + 6)};
+  if (
+    (ndigits < 0) or (dscale < 0) or
+    (std::size(data) !=
+     header + digit_size * static_cast<std::size_t>(ndigits))) [[unlikely]]
+    throw_binary_mismatch("numeric", oid_numeric, std::size(data), loc);
+
+  switch (sign)
+  {
+  case numeric_pos:
+  case numeric_neg: break;
+  case numeric_nan: return "NaN";
+  case numeric_pinf: return "Infinity";
+  case numeric_ninf: return "-Infinity";
+  default:
+    throw conversion_error{
+      std::format("Unknown sign in binary numeric: {}.", sign), loc};
+  }
+
+  auto const digit{[ptr, ndigits](int i) -> int {
+    if ((i < 0) or (i >= ndigits))
+      return 0;
+    return read_big_endian<std::int16_t>(
+      ptr + header + digit_size * static_cast<std::size_t>(i));
+  }};
+
+  std::string out;
+  out.reserve(
+    static_cast<std::size_t>(
+      (std::max(weight + 1, 1) * numeric_dec_digits) + dscale) +
+    3);
+  if (sign == numeric_neg)
+    out.push_back('-');
+
+  // Integral part.  The first base-10,000 digit gets no leading zeroes.
+  if (weight < 0)
+  {
+    out.push_back('0');
+  }
+  else
+  {
+    out += std::format("{}", digit(0));
+    for (int i{1}; i <= weight; ++i) append_numeric_digit(out, digit(i));
+  }
+
+  // Fractional part.  Write whole base-10,000 digits, then cut off at the
+  // display scale.
+  if (dscale > 0)
+  {
+    out.push_back('.');
+    auto const frac_start{std::size(out)};
+    for (int i{weight + 1};
+         std::cmp_less(std::size(out) - frac_start, dscale); ++i)
+      append_numeric_digit(out, digit(i));
+    out.resize(frac_start + static_cast<std::size_t>(dscale));
+  }
+  return out;
+}
+
+
+std::string uuid_to_string(bytes_view data, sl loc)
+{
+  constexpr std::size_t uuid_size{16};
+  if (std::size(data) != uuid_size) [[unlikely]]
+    throw_binary_mismatch("uuid", oid_uuid, std::size(data), loc);
+  constexpr std::string_view hex{"0123456789abcdef"};
+  std::string out;
+  out.reserve(2 * uuid_size + 4);
+  for (std::size_t i{0}; i < uuid_size; ++i)
+  {
+    // Dashes go before bytes 4, 6, 8, and 10.
+    if ((i == 4) or (i == 6) or (i == 8) or (i == 10))
+      out.push_back('-');
+    auto const byte{static_cast<unsigned>(data[i])};
+    out.push_back(hex[byte >> 4u]);
+    out.push_back(hex[byte & 0x0fu]);
+  }
+  return out;
+}
+} // namespace pqxx::internal
@@ -11,6 +11,7 @@
 #include "pqxx/blob.hxx"
 #include "pqxx/except.hxx"
 #include "pqxx/internal/gates/connection-largeobject.hxx"
+#include "pqxx/internal/gates/transaction-blob.hxx"
 
 #include "pqxx/internal/header-post.hxx"
 
@@ -64,6 +65,7 @@ std::string pqxx::blob::errmsg(connection const *cx)
 pqxx::blob
 pqxx::blob::open_internal(dbtransaction &tx, oid id, int mode, sl loc)
 {
+  internal::gate::transaction_blob{tx}.start(loc);
   auto &cx{tx.conn()};
   int const fd{lo_open(real_conn(raw_conn(&cx)), id, mode)};
   if (fd == -1)
@@ -77,6 +79,7 @@ pqxx::blob::open_internal(dbtransaction &tx, oid id, int mode, sl loc)
 
 pqxx::oid pqxx::blob::create(dbtransaction &tx, oid id, sl loc)
 {
+  internal::gate::transaction_blob{tx}.start(loc);
   oid const actual_id{lo_create(real_conn(raw_conn(tx)), id)};
   if (actual_id == 0)
     throw failure{
@@ -92,6 +95,7 @@ void pqxx::blob::remove(dbtransaction &tx, oid id, sl loc)
   if (id == 0)
     throw usage_error{
       "Trying to delete binary large object without an ID.", loc};
+  internal::gate::transaction_blob{tx}.start(loc);
   if (lo_unlink(real_conn(raw_conn(tx)), id) == -1)
     throw failure{
       std::format(
@@ -340,6 +344,7 @@ std::size_t pqxx::blob::append_to_buf(
 
 pqxx::oid pqxx::blob::from_file(dbtransaction &tx, zview path, sl loc)
 {
+  internal::gate::transaction_blob{tx}.start(loc);
   auto id{lo_import(real_conn(raw_conn(tx)), path.c_str())};
   if (id == 0)
     throw failure{
@@ -353,6 +358,7 @@ pqxx::oid pqxx::blob::from_file(dbtransaction &tx, zview path, sl loc)
 
 pqxx::oid pqxx::blob::from_file(dbtransaction &tx, zview path, oid id, sl loc)
 {
+  internal::gate::transaction_blob{tx}.start(loc);
   auto actual_id{
     lo_import_with_oid(real_conn(raw_conn(tx)), path.c_str(), id)};
   if (actual_id == 0)
@@ -367,6 +373,7 @@ pqxx::oid pqxx::blob::from_file(dbtransaction &tx, zview path, oid id, sl loc)
 
 void pqxx::blob::to_file(dbtransaction &tx, oid id, zview path, sl loc)
 {
+  internal::gate::transaction_blob{tx}.start(loc);
   if (lo_export(real_conn(raw_conn(tx)), id, path.c_str()) < 0)
     throw failure{
       std::format(
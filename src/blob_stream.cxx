@@ -0,0 +1,264 @@
+/** Implementation of the blob_reader and blob_writer classes.
+ *
+ * Copyright (c) 2000-2026, Jeroen T. Vermeulen.
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this
+ * mistake, or contact the author.
+ */
+#include "pqxx-source.hxx"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "pqxx/internal/header-pre.hxx"
+
+#include "pqxx/blob.hxx"
+#include "pqxx/blob_stream.hxx"
+#include "pqxx/except.hxx"
+
+#include "pqxx/internal/header-post.hxx"
+
+
+namespace
+{
+constexpr int INV_WRITE{0x00020000}, INV_READ{0x00040000};
+
+
+/// Check the chunk size and depth for a blob stream.
+void check_stream_params(
+  std::string_view what, std::size_t chunk_size, int depth, pqxx::sl loc)
+{
+  if ((chunk_size == 0) or (chunk_size > pqxx::blob::chunk_limit))
+    throw pqxx::range_error{
+      std::format(
+        "Chunk size for {} must be between 1 and {} bytes; got {}.", what,
+        pqxx::blob::chunk_limit, chunk_size),
+      loc};
+  if (depth < 1)
+    throw pqxx::range_error{
+      std::format("Depth for {} must be at least 1; got {}.", what, depth),
+      loc};
+}
+
+
+/// Open a large object through SQL, so that it can take part in a pipeline.
+int open_lo(pqxx::dbtransaction &tx, pqxx::oid id, int mode, pqxx::sl loc)
+{
+  int const fd{
+    tx.exec("SELECT pg_catalog.lo_open($1, $2)", pqxx::params{id, mode}, loc)
+      .one_field(loc)
+      .as<int>(loc)};
+  if (fd < 0) [[unlikely]]
+    throw pqxx::failure{
+      std::format("Could not open binary large object {}.", id), loc};
+  return fd;
+}
+
+
+void close_lo(pqxx::dbtransaction &tx, int fd, pqxx::sl loc)
+{
+  std::ignore =
+    tx.exec("SELECT pg_catalog.lo_close($1)", pqxx::params{fd}, loc)
+      .one_row(loc);
+}
+} // namespace
+
+
+pqxx::blob_reader::blob_reader(
+  dbtransaction &tx, oid id, std::size_t chunk_size, int depth, sl loc) :
+        m_trans{&tx}, m_chunk_size{chunk_size}
+{
+  check_stream_params("blob_reader", chunk_size, depth, loc);
+  // If anything fails after this, the server will close the descriptor when
+  // the transaction ends.
+  m_fd = open_lo(tx, id, INV_READ, loc);
+  m_pipe.emplace(tx, loc);
+  for (int i{0}; i < depth; ++i) request(loc);
+}
+
+
+pqxx::blob_reader::~blob_reader() noexcept
+{
+  try
+  {
+    close();
+  }
+  catch (std::exception const &)
+  {}
+}
+
+
+void pqxx::blob_reader::request(sl loc)
+{
+  m_pipe->insert(
+    "SELECT pg_catalog.loread($1, $2)",
+    params{m_fd, static_cast<int>(m_chunk_size)}, format::binary, loc);
+  ++m_pending;
+}
+
+
+bool pqxx::blob_reader::receive(sl loc)
+{
+  if (m_pending == 0)
+    return false;
+  m_result = m_pipe->retrieve(loc).second;
+  --m_pending;
+  auto const data{m_result.one_field(loc).view()};
+  m_chunk = binary_cast(data);
+  if (std::size(data) < m_chunk_size)
+    // Short read.  We're at the end.  Any further chunks will be empty.
+    m_end = true;
+  else if (not m_end)
+    request(loc);
+  return not std::empty(m_chunk);
+}
+
+
+pqxx::writable_bytes_view
+pqxx::blob_reader::read(std::span<std::byte> buf, sl loc)
+{
+  if (not m_pipe)
+    throw usage_error{"Reading from a blob_reader that was closed.", loc};
+
+  std::size_t filled{0};
+  while (filled < std::size(buf))
+  {
+    if (std::empty(m_chunk))
+    {
+      // Once we've seen the end, the remaining chunks are all empty.
+      if (m_end or not receive(loc))
+        break;
+    }
+    auto const bytes{std::min(std::size(m_chunk), std::size(buf) - filled)};
+    std::memcpy(std::data(buf) + filled, std::data(m_chunk), bytes);
+    m_chunk = m_chunk.subspan(bytes);
+    filled += bytes;
+  }
+  return buf.first(filled);
+}
+
+
+void pqxx::blob_reader::close(sl loc)
+{
+  if (m_pipe)
+  {
+    m_chunk = {};
+    m_result = {};
+    m_pending = 0;
+    m_end = true;
+    // Receive and discard whatever is still on its way.  (Don't leave that to
+    // the pipeline's destructor: it would cancel the queries, and the cancel
+    // request might arrive after they're done, and hit a later query.)
+    m_pipe->flush(loc);
+    m_pipe.reset();
+    close_lo(*m_trans, std::exchange(m_fd, -1), loc);
+  }
+}
+
+
+pqxx::blob_writer::blob_writer(
+  dbtransaction &tx, oid id, std::size_t chunk_size, int depth, sl loc) :
+        m_trans{&tx}, m_chunk_size{chunk_size}, m_depth{depth}
+{
+  check_stream_params("blob_writer", chunk_size, depth, loc);
+  // If anything fails after this, the server will close the descriptor when
+  // the transaction ends.
+  m_fd = open_lo(tx, id, INV_WRITE, loc);
+  m_pipe.emplace(tx, loc);
+}
+
+
+pqxx::blob_writer::~blob_writer() noexcept
+{
+  try
+  {
+    close();
+  }
+  catch (std::exception const &)
+  {}
+}
+
+
+void pqxx::blob_writer::send(bytes_view data, sl loc)
+{
+  if (std::size(m_pending) >= static_cast<std::size_t>(m_depth))
+    receive(loc);
+  // The pipeline issues this right away, so libpq copies the data into its
+  // own buffer before we return.
+  m_pipe->insert(
+    "SELECT pg_catalog.lowrite($1, $2)", params{m_fd, data}, loc);
+  m_pending.push_back(std::size(data));
+}
+
+
+void pqxx::blob_writer::receive(sl loc)
+{
+  auto const written{
+    m_pipe->retrieve(loc).second.one_field(loc).as<int>(loc)};
+  auto const expected{m_pending.front()};
+  m_pending.pop_front();
+  if (std::cmp_not_equal(written, expected)) [[unlikely]]
+    throw failure{
+      std::format(
+        "Wrote {} bytes to binary large object, expected {}.", written,
+        expected),
+      loc};
+}
+
+
+void pqxx::blob_writer::write(bytes_view data, sl loc)
+{
+  if (not m_pipe)
+    throw usage_error{"Writing to a blob_writer that was completed.", loc};
+
+  // Top up the buffer, if there's anything in it.
+  if (not std::empty(m_buffer))
+  {
+    auto const bytes{
+      std::min(m_chunk_size - std::size(m_buffer), std::size(data))};
+    m_buffer.insert(
+      std::end(m_buffer), std::begin(data), std::begin(data) + bytes);
+    data = data.subspan(bytes);
+    if (std::size(m_buffer) < m_chunk_size)
+      return;
+    send(m_buffer, loc);
+    m_buffer.clear();
+  }
+
+  // Send full chunks straight from the caller's memory.
+  while (std::size(data) >= m_chunk_size)
+  {
+    send(data.first(m_chunk_size), loc);
+    data = data.subspan(m_chunk_size);
+  }
+  m_buffer.insert(std::end(m_buffer), std::begin(data), std::end(data));
+}
+
+
+void pqxx::blob_writer::complete(sl loc)
+{
+  if (not m_pipe)
+    return;
+  if (not std::empty(m_buffer))
+  {
+    send(m_buffer, loc);
+    m_buffer.clear();
+  }
+  while (not std::empty(m_pending)) receive(loc);
+  close(loc);
+}
+
+
+void pqxx::blob_writer::close(sl loc)
+{
+  if (m_pipe)
+  {
+    m_buffer.clear();
+    m_pending.clear();
+    m_pipe->flush(loc);
+    m_pipe.reset();
+    close_lo(*m_trans, std::exchange(m_fd, -1), loc);
+  }
+}
@@ -0,0 +1,117 @@
+/** Implementation of the pqxx::internal::row_chunks class.
+ *
+ * Copyright (c) 2000-2026, Jeroen T. Vermeulen.
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this
+ * mistake, or contact the author.
+ */
+#include "pqxx-source.hxx"
+
+#include "pqxx/internal/header-pre.hxx"
+
+extern "C"
+{
+#include <libpq-fe.h>
+}
+
+#include "pqxx/internal/chunked_query.hxx"
+#include "pqxx/internal/gates/connection-chunked_query.hxx"
+#include "pqxx/transaction_base.hxx"
+
+#include "pqxx/internal/header-post.hxx"
+
+
+using namespace std::literals;
+
+
+pqxx::internal::row_chunks::row_chunks(
+  transaction_base &tx, std::string_view query, c_params const &args,
+  int chunk_rows, sl loc) :
+        transaction_focus{tx, "chunked_query"sv}
+{
+  if (chunk_rows < 1)
+    throw range_error{
+      std::format("Chunk size must be at least 1 row; got {}.", chunk_rows),
+      loc};
+  register_me();
+  gate::connection_chunked_query gate{trans().conn()};
+  try
+  {
+    m_query = gate.intern_query(query);
+    gate.start_exec_params(*m_query, args, loc);
+  }
+  catch (std::exception const &)
+  {
+    unregister_me();
+    throw;
+  }
+  try
+  {
+    gate.set_row_chunks(chunk_rows, loc);
+  }
+  catch (std::exception const &)
+  {
+    close();
+    throw;
+  }
+}
+
+
+pqxx::internal::row_chunks::~row_chunks() noexcept
+{
+  close();
+}
+
+
+std::optional<pqxx::result> pqxx::internal::row_chunks::next(sl loc)
+{
+  if (m_done)
+    return {};
+
+  gate::connection_chunked_query gate{trans().conn()};
+  auto *const pgr{gate.get_result()};
+  if (pgr != nullptr)
+  {
+    switch (PQresultStatus(static_cast<::PGresult const *>(pgr)))
+    {
+    case PGRES_SINGLE_TUPLE:
+#if defined(LIBPQ_HAS_CHUNK_MODE)
+    case PGRES_TUPLES_CHUNK:
+#endif
+      [[likely]] return gate.make_result(pgr, m_query, loc);
+
+    default:
+      // This is the final result.  In single-row or chunked mode it holds no
+      // rows, but it tells us whether the query succeeded.
+      break;
+    }
+  }
+
+  try
+  {
+    // If the result is an error, this throws the exception for it.
+    std::ignore = gate.make_result(pgr, m_query, loc);
+  }
+  catch (std::exception const &)
+  {
+    close();
+    throw;
+  }
+  close();
+  return {};
+}
+
+
+void pqxx::internal::row_chunks::close() noexcept
+{
+  if (not m_done)
+  {
+    m_done = true;
+    gate::connection_chunked_query gate{trans().conn()};
+    // Read and discard whatever is left.
+    while (auto *const pgr{gate.get_result()})
+      PQclear(static_cast<::PGresult *>(pgr));
+    unregister_me();
+  }
+}
@@ -29,6 +29,7 @@
 #include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <tuple>
 #include <utility>
 
 // For fcntl().
@@ -196,6 +197,8 @@ pqxx::connection::connection(connection &&rhs, sl loc) :
         m_conn{rhs.m_conn},
         m_notice_waiters{std::move(rhs.m_notice_waiters)},
         m_notification_handlers{std::move(rhs.m_notification_handlers)},
+        m_statements{std::move(rhs.m_statements)},
+        m_queries{std::move(rhs.m_queries)},
         m_created_loc{loc},
         m_unique_id{rhs.m_unique_id}
 {
@@ -440,18 +443,144 @@ pqxx::connection &pqxx::connection::operator=(connection &&rhs)
   m_unique_id = rhs.m_unique_id;
   m_notice_waiters = std::move(rhs.m_notice_waiters);
   m_notification_handlers = std::move(rhs.m_notification_handlers);
+  m_statements = std::move(rhs.m_statements);
+  m_queries = std::move(rhs.m_queries);
   m_created_loc = rhs.m_created_loc;
 
   return *this;
 }
 
 
+namespace
+{
+/// Maximum number of query texts a connection keeps for reuse.
+constexpr std::size_t max_interned_queries{64};
+
+/// Longest query text that a connection keeps for reuse.
+/** Copying a long query is cheap compared to executing it, and we don't want
+ * to hang on to large amounts of memory.
+ */
+constexpr std::size_t max_interned_length{1024};
+
+
+/// Allocator which recycles the control blocks for result data.
+/** A @ref pqxx::result holds its `PGresult` through a `std::shared_ptr`,
+ * which needs a small control block on the heap.  This allocator keeps a few
+ * freed blocks around in each thread, so that in a steady state, executing a
+ * query does not need to allocate a new one.
+ */
+template<typename T> struct block_recycler final
+{
+  using value_type = T;
+
+  block_recycler() noexcept = default;
+  template<typename U> block_recycler(block_recycler<U> const &) noexcept {}
+
+  [[nodiscard]] T *allocate(std::size_t n)
+  {
+    // Make sure we clean up the spare blocks when the thread exits.
+    std::ignore = &janitor;
+    if ((n == 1) and (spares.count > 0)) [[likely]]
+      return spares.blocks.at(--spares.count);
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  void deallocate(T *block, std::size_t n) noexcept
+  {
+    if ((n == 1) and not spares.closed and
+        (spares.count < std::size(spares.blocks))) [[likely]]
+      spares.blocks.at(spares.count++) = block;
+    else
+      std::allocator<T>{}.deallocate(block, n);
+  }
+
+  template<typename U>
+  bool operator==(block_recycler<U> const &) const noexcept
+  {
+    return true;
+  }
+
+private:
+  /// Freed blocks, ready for reuse.
+  /** This is trivially destructible, so it stays usable even while other
+   * thread-local objects (which may hold results) get destroyed.
+   */
+  struct spare_blocks final
+  {
+    std::array<T *, 16> blocks{};
+    std::size_t count{0};
+    /// Has the thread started exiting?  If so, stop keeping spares.
+    bool closed{false};
+  };
+
+  /// Frees the spare blocks when the thread exits.
+  struct spares_janitor final
+  {
+    spares_janitor() noexcept = default;
+    spares_janitor(spares_janitor const &) = delete;
+    spares_janitor &operator=(spares_janitor const &) = delete;
+    ~spares_janitor() noexcept
+    {
+      spares.closed = true;
+      while (spares.count > 0)
+        std::allocator<T>{}.deallocate(spares.blocks.at(--spares.count), 1);
+    }
+  };
+
+  static inline thread_local spare_blocks spares;
+  static inline thread_local spares_janitor janitor;
+};
+} // namespace
+
+
+std::shared_ptr<std::string>
+pqxx::connection::intern_query(std::string_view query)
+{
+  if (std::size(query) > max_interned_length)
+    return std::make_shared<std::string>(query);
+
+  auto &cache{m_queries};
+  auto const found{cache.index.find(query)};
+  if (found != std::end(cache.index)) [[likely]]
+  {
+    auto &hit{cache.slots[found->second]};
+    hit.recent = true;
+    return hit.text;
+  }
+
+  auto text{std::make_shared<std::string>(query)};
+  std::size_t slot{std::size(cache.slots)};
+  if (slot < max_interned_queries)
+  {
+    cache.slots.push_back({text});
+  }
+  else
+  {
+    // Sweep for a slot that we haven't used lately.  Give each one that we
+    // have used a second chance.  This ends after at most one full round.
+    while (cache.slots[cache.hand].recent)
+    {
+      cache.slots[cache.hand].recent = false;
+      cache.hand = (cache.hand + 1) % max_interned_queries;
+    }
+    slot = cache.hand;
+    cache.hand = (cache.hand + 1) % max_interned_queries;
+    cache.index.erase(*cache.slots[slot].text);
+    cache.slots[slot] = {text};
+  }
+  cache.index.emplace(*text, slot);
+  return text;
+}
+
+
 pqxx::result pqxx::connection::make_result(
   internal::pq::PGresult *pgr, std::shared_ptr<std::string> const &query,
-  std::string_view desc, sl loc)
+  std::string_view desc, sl loc,
+  std::shared_ptr<internal::column_index const> *columns)
 {
   std::shared_ptr<internal::pq::PGresult> const smart{
-    pgr, internal::clear_result};
+    pgr, internal::result_deleter{},
+    block_recycler<internal::pq::PGresult>{}};
   if (not smart)
   {
     if (is_open())
@@ -460,6 +589,30 @@ pqxx::result pqxx::connection::make_result(
       throw broken_connection{"Lost connection to the database server.", loc};
   }
   auto const enc{get_encoding_group(loc)};
+  if (columns != nullptr)
+  {
+    auto const *const res{static_cast<::PGresult const *>(pgr)};
+    auto const status{PQresultStatus(res)};
+    if ((status == PGRES_TUPLES_OK) or (status == PGRES_COMMAND_OK))
+    {
+      // If the statement got redefined behind our back, the index may be
+      // stale.  Checking the names would cost us on every execution, so
+      // compare only the number of columns here.  The result checks the
+      // names on its first lookup by name.
+      bool const reuse{*columns and ((*columns)->columns() == PQnfields(res))};
+      if (not reuse)
+        *columns = std::make_shared<internal::column_index const>(pgr);
+      // Let the result use the statement's index.  (Without RTTI we can't
+      // get at the deleter, and it'll just do without.)
+      auto *const shared{std::get_deleter<internal::result_deleter>(smart)};
+      if (shared != nullptr)
+      {
+        shared->columns = *columns;
+        shared->preset_columns = true;
+        shared->verify_columns = reuse;
+      }
+    }
+  }
   auto r{pqxx::internal::gate::result_creation::create(
     smart, query, m_notice_waiters, enc)};
   pqxx::internal::gate::result_creation{r}.check_status(desc, loc);
@@ -592,32 +745,28 @@ void pqxx::connection::listen(
         channel),
       loc};
 
-  std::string str_name{channel};
-
-  auto const pos{m_notification_handlers.lower_bound(str_name)},
-    handlers_end{std::end(m_notification_handlers)};
+  auto const pos{m_notification_handlers.find(channel)};
 
   if (handler)
   {
     // Setting a handler.
-    if ((pos != handlers_end) and (pos->first == channel))
+    if (pos != std::end(m_notification_handlers))
     {
       // Overwrite existing handler.
-      m_notification_handlers.insert_or_assign(
-        pos, std::move(str_name), std::move(handler));
+      pos->second = std::move(handler);
     }
     else
     {
       // We had no handler installed for this name.  Start listening.
       exec(std::format("LISTEN {}", quote_name(channel)), loc).no_rows(loc);
-      m_notification_handlers.emplace_hint(pos, channel, std::move(handler));
+      m_notification_handlers.emplace(channel, std::move(handler));
     }
   }
   else
   {
     // Installing an empty handler.  That's equivalent to removing whatever
     // handler may have been installed previously.
-    if (pos != handlers_end)
+    if (pos != std::end(m_notification_handlers))
     {
       // Yes, we had a handler for this name.  Remove it.
       exec(std::format("UNLISTEN {}", quote_name(channel)), loc).no_rows(loc);
@@ -781,9 +930,12 @@ int pqxx::connection::get_notifs(sl loc)
   {
     notifs++;
 
-    std::string const channel{N->relname};
+    zview const channel{N->relname};
 
-    auto const Hit{m_receivers.equal_range(channel)};
+    auto const Hit{
+      std::empty(m_receivers) ?
+        std::pair{std::end(m_receivers), std::end(m_receivers)} :
+        m_receivers.equal_range(std::string{channel})};
     if (Hit.second != Hit.first)
     {
       std::string const payload{N->extra};
@@ -815,7 +967,7 @@ int pqxx::connection::get_notifs(sl loc)
         }
     }
 
-    auto const handler{m_notification_handlers.find(N->relname)};
+    auto const handler{m_notification_handlers.find(channel)};
     if (handler != std::end(m_notification_handlers))
       (handler->second)(notification{
         .conn = *this,
@@ -900,7 +1052,7 @@ pqxx::connection::get_errorhandlers() const
 pqxx::result
 pqxx::connection::exec(std::string_view query, std::string_view desc, sl loc)
 {
-  return exec(std::make_shared<std::string>(query), desc, loc);
+  return exec(intern_query(query), desc, loc);
 }
 
 
@@ -932,6 +1084,8 @@ void pqxx::connection::prepare(
 
   auto const r{make_result(
     PQprepare(real_conn(m_conn), name, definition, 0, nullptr), q, *q, loc)};
+  if (name[0] != '\0')
+    m_statements.insert_or_assign(name, statement_info{});
 }
 
 
@@ -944,24 +1098,64 @@ void pqxx::connection::prepare(char const definition[], sl loc) &
 void pqxx::connection::unprepare(std::string_view name, sl loc)
 {
   exec(std::format("DEALLOCATE {}", quote_name(name)), loc);
+  // Only forget the statement once the server has.
+  if (auto const known{m_statements.find(name)};
+      known != std::end(m_statements))
+    m_statements.erase(known);
 }
 
 
 pqxx::result pqxx::connection::exec_prepared(
-  std::string_view statement, internal::c_params const &args, sl loc)
+  std::string_view statement, internal::c_params const &args,
+  format result_format, sl loc)
 {
-  auto const q{std::make_shared<std::string>(statement)};
+  auto const known{m_statements.find(statement)};
+  // If we've described the statement, we know how many parameters it takes.
+  // Catch a mismatch before it costs a round trip.
+  if (
+    (known != std::end(m_statements)) and
+    pqxx::internal::gate::result_connection{known->second.description} and
+    std::cmp_not_equal(
+      std::size(args.values), known->second.description.param_count()))
+    throw argument_error{
+      std::format(
+        "Prepared statement '{}' takes {} parameter(s), but got {}.",
+        statement, known->second.description.param_count(),
+        std::size(args.values)),
+      loc};
+  auto const q{intern_query(statement)};
   auto const pq_result{PQexecPrepared(
     real_conn(m_conn), q->c_str(),
     check_cast<int>(std::size(args.values), "exec_prepared"sv, loc),
     args.values.data(), args.lengths.data(), args.formats.data(),
-    static_cast<int>(format::text))};
-  auto r{make_result(pq_result, q, statement, loc)};
+    static_cast<int>(result_format))};
+  auto r{make_result(
+    pq_result, q, statement, loc,
+    (known == std::end(m_statements)) ? nullptr : &known->second.columns)};
   get_notifs(loc);
   return r;
 }
 
 
+pqxx::result pqxx::connection::describe_prepared(zview name, sl loc)
+{
+  auto const known{m_statements.find(std::string_view{name})};
+  if (
+    known != std::end(m_statements) and
+    pqxx::internal::gate::result_connection{known->second.description})
+    return known->second.description;
+
+  auto const q{
+    std::make_shared<std::string>(std::format("[DESCRIBE {}]", name))};
+  auto r{make_result(
+    PQdescribePrepared(real_conn(m_conn), name.c_str()), q, *q, loc,
+    (known == std::end(m_statements)) ? nullptr : &known->second.columns)};
+  if (known != std::end(m_statements))
+    known->second.description = r;
+  return r;
+}
+
+
 void pqxx::connection::close(sl)
 {
   // Just in case PQfinish() doesn't handle nullptr nicely.
@@ -1087,6 +1281,67 @@ pqxx::connection::read_copy_line(sl loc)
 }
 
 
+std::optional<
+  std::pair<std::unique_ptr<char[], void (*)(void const *)>, std::size_t>>
+pqxx::connection::read_copy_line_nonblocking(bool &ended, sl loc)
+{
+  if (not consume_input()) [[unlikely]]
+    throw broken_connection{
+      std::format("Reading of table data failed: {}", err_msg()), loc};
+
+  if (not ended)
+  {
+    char *buf{nullptr};
+    auto const line_len{PQgetCopyData(real_conn(m_conn), &buf, true)};
+    switch (line_len)
+    {
+    case -2: // Error.
+      throw failure{
+        std::format("Reading of table data failed: {}", err_msg()), loc};
+
+    case -1: // End of COPY.
+      ended = true;
+      break;
+
+    case 0: // No complete line available yet.
+      return {};
+
+    default: // Success, got buffer size.
+      [[likely]]
+      {
+        // As in read_copy_line(), ignore the trailing newline.
+        auto const text_len{static_cast<std::size_t>(line_len) - 1};
+        return std::make_pair(
+          std::unique_ptr<char[], void (*)(void const *)>{
+            buf, pqxx::internal::pq::pqfreemem},
+          text_len);
+      }
+    }
+  }
+
+  // The COPY has ended.  Wait for its final result to come in, because
+  // getting it might otherwise block.
+  if (is_busy())
+    return {};
+
+  static auto const q{std::make_shared<std::string>("[END COPY]")};
+  make_result(pq_get_result(m_conn), q, *q, loc);
+  return std::make_pair(
+    std::unique_ptr<char[], void (*)(void const *)>{
+      nullptr, pqxx::internal::pq::pqfreemem},
+    0u);
+}
+
+
+pqxx::result pqxx::connection::describe_query(std::string_view query, sl loc)
+{
+  auto const q{intern_query(query)};
+  std::ignore = make_result(
+    PQprepare(real_conn(m_conn), "", q->c_str(), 0, nullptr), q, loc);
+  return make_result(PQdescribePrepared(real_conn(m_conn), ""), q, loc);
+}
+
+
 void pqxx::connection::write_copy_line(std::string_view line, sl loc)
 {
   static std::string const err_prefix{"Error writing to table: "};
@@ -1099,6 +1354,15 @@ void pqxx::connection::write_copy_line(std::string_view line, sl loc)
 }
 
 
+void pqxx::connection::write_copy_data(std::string_view data, sl loc)
+{
+  auto const size{check_cast<int>(
+    std::ssize(data), "Batch of COPY data is too large to process."sv, loc)};
+  if (pq_put_copy_data(m_conn, data.data(), size) <= 0) [[unlikely]]
+    throw failure{std::format("Error writing to table: {}", err_msg()), loc};
+}
+
+
 void pqxx::connection::end_copy_write(sl loc)
 {
   int const res{PQputCopyEnd(real_conn(m_conn), nullptr)};
@@ -1122,10 +1386,196 @@ void pqxx::connection::end_copy_write(sl loc)
 }
 
 
-void pqxx::connection::start_exec(char const query[])
+#if !defined(LIBPQ_HAS_PIPELINING)
+namespace
 {
-  if (PQsendQuery(real_conn(m_conn), query) == 0) [[unlikely]]
-    throw failure{err_msg()};
+/// Complain that the libpq we're built against can't do pipelining.
+[[noreturn]] PQXX_COLD void no_pipelining(sl loc)
+{
+  throw pqxx::feature_not_supported{
+    "Pipeline mode requires libpq 14 or better.", "", "", loc};
+}
+} // namespace
+#endif
+
+
+void pqxx::connection::enter_pipeline_mode(sl loc)
+{
+#if defined(LIBPQ_HAS_PIPELINING)
+  if (PQenterPipelineMode(real_conn(m_conn)) == 0) [[unlikely]]
+    throw failure{
+      std::format("Could not enter pipeline mode: {}", err_msg()), loc};
+#else
+  no_pipelining(loc);
+#endif
+}
+
+
+void pqxx::connection::exit_pipeline_mode(sl loc)
+{
+#if defined(LIBPQ_HAS_PIPELINING)
+  if (PQexitPipelineMode(real_conn(m_conn)) == 0) [[unlikely]]
+    throw failure{
+      std::format("Could not leave pipeline mode: {}", err_msg()), loc};
+#else
+  no_pipelining(loc);
+#endif
+}
+
+
+namespace
+{
+/// The parameter types to pass to libpq, or null to let the server decide.
+PQXX_PURE Oid const *param_types(pqxx::internal::c_params const &args)
+{
+  return std::empty(args.types) ? nullptr : std::data(args.types);
+}
+} // namespace
+
+
+void pqxx::connection::start_exec_params(
+  zview query, internal::c_params const &args, format result_format, sl loc)
+{
+  if (
+    PQsendQueryParams(
+      real_conn(m_conn), query.c_str(),
+      check_cast<int>(std::size(args.values), "start_exec_params"sv, loc),
+      param_types(args), args.values.data(), args.lengths.data(),
+      args.formats.data(),
+      static_cast<int>(result_format)) == 0) [[unlikely]]
+    throw failure{err_msg(), loc};
+}
+
+
+void pqxx::connection::start_prepare_unnamed(zview query, sl loc)
+{
+  if (PQsendPrepare(real_conn(m_conn), "", query.c_str(), 0, nullptr) == 0)
+    [[unlikely]]
+    throw failure{err_msg(), loc};
+}
+
+
+void pqxx::connection::start_describe_unnamed(sl loc)
+{
+  if (PQsendDescribePrepared(real_conn(m_conn), "") == 0) [[unlikely]]
+    throw failure{err_msg(), loc};
+}
+
+
+void pqxx::connection::start_exec_prepared(
+  zview statement, internal::c_params const &args, format result_format,
+  sl loc)
+{
+  if (
+    PQsendQueryPrepared(
+      real_conn(m_conn), statement.c_str(),
+      check_cast<int>(std::size(args.values), "start_exec_prepared"sv, loc),
+      args.values.data(), args.lengths.data(), args.formats.data(),
+      static_cast<int>(result_format)) == 0) [[unlikely]]
+    throw failure{err_msg(), loc};
+}
+
+
+void pqxx::connection::pipeline_sync(sl loc)
+{
+#if defined(LIBPQ_HAS_SEND_PIPELINE_SYNC)
+  // Since libpq 17 we can queue a sync without also flushing.
+  if (PQsendPipelineSync(real_conn(m_conn)) == 0) [[unlikely]]
+    throw failure{err_msg(), loc};
+#elif defined(LIBPQ_HAS_PIPELINING)
+  if (PQpipelineSync(real_conn(m_conn)) == 0) [[unlikely]]
+    throw failure{err_msg(), loc};
+#else
+  no_pipelining(loc);
+#endif
+}
+
+
+void pqxx::connection::flush_output(sl loc)
+{
+  int res{PQflush(real_conn(m_conn))};
+  // In nonblocking mode, PQflush() may need several tries.  In between, wait
+  // for the socket to accept more data.  The server may be waiting for us to
+  // read its output first, so consume whatever input comes in.
+  while (res == 1)
+  {
+    internal::wait_fd(socket_of(m_conn), true, true, 1, 0, loc);
+    if (PQconsumeInput(real_conn(m_conn)) == 0) [[unlikely]]
+      break;
+    res = PQflush(real_conn(m_conn));
+  }
+  if (res != 0) [[unlikely]]
+  {
+    if (is_open())
+      throw failure{err_msg(), loc};
+    else
+      throw broken_connection{"Lost connection to the database server.", loc};
+  }
+}
+
+
+void pqxx::connection::set_row_chunks(int rows, sl loc)
+{
+#if defined(LIBPQ_HAS_CHUNK_MODE)
+  if (rows > 1)
+  {
+    if (PQsetChunkedRowsMode(real_conn(m_conn), rows) == 0) [[unlikely]]
+      throw failure{"Could not switch to chunked rows mode.", loc};
+    return;
+  }
+#else
+  // Without chunked mode, we make do with single-row mode.
+  std::ignore = rows;
+#endif
+  if (PQsetSingleRowMode(real_conn(m_conn)) == 0) [[unlikely]]
+    throw failure{"Could not switch to single-row mode.", loc};
+}
+
+
+void pqxx::connection::set_nonblocking(bool nonblock, sl loc)
+{
+  if (PQsetnonblocking(real_conn(m_conn), nonblock ? 1 : 0) != 0)
+    [[unlikely]]
+    throw failure{err_msg(), loc};
+}
+
+
+bool pqxx::connection::try_flush_output(sl loc)
+{
+  auto const res{PQflush(real_conn(m_conn))};
+  if (res < 0) [[unlikely]]
+  {
+    if (is_open())
+      throw failure{err_msg(), loc};
+    else
+      throw broken_connection{"Lost connection to the database server.", loc};
+  }
+  return res == 0;
+}
+
+
+void pqxx::connection::consume_pipeline_sync(sl loc)
+{
+#if defined(LIBPQ_HAS_PIPELINING)
+  std::unique_ptr<::PGresult, void (*)(::PGresult *)> const res{
+    static_cast<::PGresult *>(pq_get_result(m_conn)), PQclear};
+  if (res == nullptr) [[unlikely]]
+  {
+    if (not is_open())
+      throw broken_connection{"Lost connection to the database server.", loc};
+    throw internal_error{
+      "Expected a pipeline sync point, but got no result.", loc};
+  }
+  if (auto const status{PQresultStatus(res.get())};
+      status != PGRES_PIPELINE_SYNC) [[unlikely]]
+    throw internal_error{
+      std::format(
+        "Expected a pipeline sync point, got result status {}.",
+        static_cast<int>(status)),
+      loc};
+#else
+  no_pipelining(loc);
+#endif
 }
 
 
@@ -1135,6 +1585,159 @@ pqxx::internal::pq::PGresult *pqxx::connection::get_result()
 }
 
 
+pqxx::result pqxx::connection::exec_after(
+  zview first, std::string_view query, std::string_view desc, sl loc)
+{
+  auto const q{intern_query(query)};
+  auto const both{std::format("{};\n{}", first, *q)};
+  if (PQsendQuery(real_conn(m_conn), both.c_str()) == 0) [[unlikely]]
+  {
+    if (is_open())
+      throw failure{err_msg(), loc};
+    else
+      throw broken_connection{"Lost connection to the database server.", loc};
+  }
+
+  using result_ptr = std::unique_ptr<::PGresult, void (*)(::PGresult *)>;
+  result_ptr head{static_cast<::PGresult *>(pq_get_result(m_conn)), PQclear};
+  // Like PQexec(), keep only the query's last result.  But a COPY means the
+  // caller takes it from here.
+  result_ptr last{nullptr, PQclear};
+  while (auto *const pgr{static_cast<::PGresult *>(pq_get_result(m_conn))})
+  {
+    last.reset(pgr);
+    auto const status{PQresultStatus(pgr)};
+    if (
+      (status == PGRES_COPY_IN) or (status == PGRES_COPY_OUT) or
+      (status == PGRES_COPY_BOTH))
+      break;
+  }
+
+  auto const head_status{PQresultStatus(head.get())};
+  if ((head_status != PGRES_COMMAND_OK) and (head_status != PGRES_TUPLES_OK))
+  {
+    // Either `first` failed, or the server could not parse the combined
+    // string.  In both cases, none of it ran.  Execute the two separately,
+    // so that an error in `query` gets reported against `query`, and only
+    // once `first` has taken effect.
+    head.reset();
+    last.reset();
+    std::ignore = exec(first, loc);
+    return exec(q, desc, loc);
+  }
+
+  // An empty query produces no result of its own.
+  auto res{make_result(
+    (last ? last.release() : head.release()), q, desc, loc)};
+  get_notifs(loc);
+  return res;
+}
+
+
+pqxx::result pqxx::connection::exec_bracketed(
+  zview before, std::string_view statement, bool prepared,
+  internal::c_params const &args, format result_format, zview after,
+  sl loc)
+{
+#if defined(LIBPQ_HAS_PIPELINING)
+  using result_ptr = std::unique_ptr<::PGresult, void (*)(::PGresult *)>;
+  auto const q{intern_query(statement)};
+  auto const send_command{[this, loc](zview cmd) {
+    if (
+      PQsendQueryParams(
+        real_conn(m_conn), cmd.c_str(), 0, nullptr, nullptr, nullptr,
+        nullptr, 0) == 0) [[unlikely]]
+      throw failure{err_msg(), loc};
+  }};
+
+  enter_pipeline_mode(loc);
+  try
+  {
+    if (not std::empty(before))
+      send_command(before);
+    if (prepared)
+      start_exec_prepared(*q, args, result_format, loc);
+    else
+      start_exec_params(*q, args, result_format, loc);
+    if (not std::empty(after))
+      send_command(after);
+    pipeline_sync(loc);
+    flush_output(loc);
+  }
+  catch (std::exception const &)
+  {
+    // Don't leave the connection in pipeline mode, with half a batch queued.
+    try
+    {
+      pipeline_sync(loc);
+      flush_output(loc);
+      while (is_open())
+      {
+        result_ptr const r{
+          static_cast<::PGresult *>(pq_get_result(m_conn)), PQclear};
+        if (r and (PQresultStatus(r.get()) == PGRES_PIPELINE_SYNC))
+          break;
+      }
+      exit_pipeline_mode(loc);
+    }
+    catch (std::exception const &)
+    {}
+    throw;
+  }
+
+  // Each command produces a result, followed by a null pointer.
+  auto const next{[this] {
+    result_ptr r{static_cast<::PGresult *>(pq_get_result(m_conn)), PQclear};
+    if (r)
+      while (auto *const extra{pq_get_result(m_conn)})
+        PQclear(static_cast<::PGresult *>(extra));
+    return r;
+  }};
+  auto before_res{
+    std::empty(before) ? result_ptr{nullptr, PQclear} : next()};
+  auto statement_res{next()};
+  auto after_res{std::empty(after) ? result_ptr{nullptr, PQclear} : next()};
+  consume_pipeline_sync(loc);
+  exit_pipeline_mode(loc);
+
+  // Report the first failure.  Once a command fails, the server skips the
+  // ones after it, so their results would only say "aborted."
+  if (not std::empty(before))
+    std::ignore = make_result(before_res.release(), intern_query(before), loc);
+  auto const known{
+    prepared ? m_statements.find(statement) : std::end(m_statements)};
+  auto res{make_result(
+    statement_res.release(), q, (prepared ? statement : ""sv), loc,
+    (known == std::end(m_statements)) ? nullptr : &known->second.columns)};
+  if (not std::empty(after))
+    std::ignore = make_result(after_res.release(), intern_query(after), loc);
+  get_notifs(loc);
+  return res;
+#else
+  // Without pipelining, there's no way to save the round trips.
+  if (not std::empty(before))
+    std::ignore = exec(before, loc);
+  auto res{
+    prepared ? exec_prepared(statement, args, result_format, loc) :
+               exec_params(statement, args, result_format, loc)};
+  if (not std::empty(after))
+    std::ignore = exec(after, loc);
+  return res;
+#endif
+}
+
+
+bool pqxx::connection::in_transaction_block() const noexcept
+{
+  switch (PQtransactionStatus(real_conn(m_conn)))
+  {
+  case PQTRANS_INTRANS:
+  case PQTRANS_INERROR: return true;
+  default: return false;
+  }
+}
+
+
 std::size_t pqxx::connection::esc_to_buf(
   std::string_view text, std::span<char> buf, sl loc) const
 {
@@ -1347,14 +1950,16 @@ int pqxx::connection::encoding_id(sl loc) const
 
 
 pqxx::result pqxx::connection::exec_params(
-  std::string_view query, internal::c_params const &args, sl loc)
+  std::string_view query, internal::c_params const &args,
+  format result_format, sl loc)
 {
-  auto const q{std::make_shared<std::string>(query)};
+  auto const q{intern_query(query)};
   auto const pq_result{PQexecParams(
     real_conn(m_conn), q->c_str(),
-    check_cast<int>(std::size(args.values), "exec_params"sv, loc), nullptr,
-    args.values.data(), args.lengths.data(), args.formats.data(),
-    static_cast<int>(format::text))};
+    check_cast<int>(std::size(args.values), "exec_params"sv, loc),
+    param_types(args), args.values.data(), args.lengths.data(),
+    args.formats.data(),
+    static_cast<int>(result_format))};
   auto r{make_result(pq_result, q, loc)};
   get_notifs(loc);
   return r;
@@ -0,0 +1,458 @@
+/** Implementation of the pqxx::connection_pool class.
+ *
+ * pqxx::connection_pool hands out connections to the same database.
+ *
+ * Copyright (c) 2000-2026, Jeroen T. Vermeulen.
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this
+ * mistake, or contact the author.
+ */
+#include "pqxx-source.hxx"
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+
+#include "pqxx/internal/header-pre.hxx"
+
+#include "pqxx/connection_pool.hxx"
+#include "pqxx/internal/wait.hxx"
+#include "pqxx/nontransaction.hxx"
+
+#include "pqxx/internal/header-post.hxx"
+
+
+using namespace std::literals;
+
+
+namespace
+{
+using clock_type = std::chrono::steady_clock;
+
+
+/// Drive a connection attempt until it completes, or until `deadline`.
+/** @return Whether the attempt completed.
+ */
+bool drive(
+  pqxx::connecting &attempt, clock_type::time_point deadline, pqxx::sl loc)
+{
+  constexpr long long micros_per_second{1'000'000};
+  while (not attempt.done())
+  {
+    auto const now{clock_type::now()};
+    if (now >= deadline)
+      return false;
+    auto const left{
+      std::chrono::duration_cast<std::chrono::microseconds>(deadline - now)
+        .count()};
+    if (pqxx::internal::wait_fd(
+          attempt.sock(), attempt.wait_to_read(), attempt.wait_to_write(),
+          pqxx::check_cast<unsigned>(
+            left / micros_per_second, "Checkout timeout out of range."sv, loc),
+          static_cast<unsigned>(left % micros_per_second), loc))
+      attempt.process(loc);
+  }
+  return true;
+}
+
+
+/// Is `cx` still usable?  If `ping` is set, check with the server.
+bool healthy(pqxx::connection &cx, bool ping)
+{
+  if (not cx.is_open())
+    return false;
+  if (not ping)
+    return true;
+  try
+  {
+    pqxx::nontransaction tx{cx};
+    tx.exec("SELECT 1").one_field();
+    return true;
+  }
+  catch (pqxx::failure const &)
+  {
+    return false;
+  }
+}
+} // namespace
+
+
+pqxx::pooled_connection &
+pqxx::pooled_connection::operator=(pooled_connection &&rhs) noexcept
+{
+  if (&rhs != this)
+  {
+    give_back();
+    m_pool = rhs.m_pool;
+    m_conn = std::move(rhs.m_conn);
+    m_replayed = rhs.m_replayed;
+  }
+  return *this;
+}
+
+
+void pqxx::pooled_connection::give_back() noexcept
+{
+  if (m_conn)
+  {
+    m_pool->take_back(std::move(m_conn), m_replayed);
+    // If the pool did not take the connection, this closes it.
+    m_conn.reset();
+  }
+}
+
+
+pqxx::connection_pool::connection_pool(
+  std::string connection_string, pool_config config, sl loc) :
+        m_connect{std::move(connection_string)}, m_config{config}
+{
+  if (m_config.max_size == 0)
+    throw argument_error{
+      "Connection pool's max_size must be at least 1.", loc};
+  if (m_config.min_size > m_config.max_size)
+    throw argument_error{
+      std::format(
+        "Connection pool's min_size ({}) is greater than its max_size ({}).",
+        m_config.min_size, m_config.max_size),
+      loc};
+  maintain(loc);
+}
+
+
+pqxx::connection_pool::~connection_pool() noexcept = default;
+
+
+pqxx::pooled_connection pqxx::connection_pool::checkout(sl loc)
+{
+  auto const start{clock::now()};
+  auto const deadline{start + m_config.checkout_timeout};
+  bool waited{false};
+
+  std::unique_lock lock{m_mutex};
+  for (;;)
+  {
+    if (not std::empty(m_idle))
+    {
+      // Take the most recently used connection.  It's the least likely to
+      // have gone stale.
+      auto entry{std::move(m_idle.back())};
+      m_idle.pop_back();
+      ++m_in_use;
+      auto const missing{registrations_since(entry.replayed)};
+      lock.unlock();
+
+      auto const got{clock::now()};
+      bool const ping{(got - entry.since) >= m_config.health_check_after};
+      if (healthy(*entry.conn, ping)) [[likely]]
+      {
+        pooled_connection out{*this, std::move(entry.conn), entry.replayed};
+        replay(*out, missing, out.m_replayed, loc);
+        lock.lock();
+        count_checkout(start, got, waited);
+        return out;
+      }
+
+      // This connection is no good.  Close it and try again.
+      entry.conn.reset();
+      lock.lock();
+      --m_in_use;
+      --m_size;
+      ++m_stats.discarded;
+      continue;
+    }
+
+    // There's no idle connection, so we'll have to get one some other way.
+    std::optional<connecting> attempt;
+    if (not std::empty(m_pending))
+    {
+      // Finish a connection attempt that's already in progress.
+      waited = true;
+      attempt.emplace(std::move(m_pending.back()));
+      m_pending.pop_back();
+    }
+    else if (m_size < m_config.max_size)
+    {
+      // Start a new connection.
+      ++m_size;
+    }
+    else
+    {
+      // The pool is at its maximum size.  Wait for a connection to come back.
+      if (clock::now() >= deadline)
+      {
+        ++m_stats.timeouts;
+        throw failure{
+          std::format(
+            "Timed out waiting for a connection from the pool after {}.",
+            m_config.checkout_timeout),
+          loc};
+      }
+      waited = true;
+      m_available.wait_until(lock, deadline);
+      continue;
+    }
+    lock.unlock();
+
+    std::unique_ptr<connection> conn;
+    try
+    {
+      if (not attempt)
+        attempt.emplace(m_connect, loc);
+      if (drive(*attempt, deadline, loc))
+        conn = std::make_unique<connection>(std::move(*attempt).produce(loc));
+    }
+    catch (std::exception const &)
+    {
+      std::lock_guard const relock{m_mutex};
+      --m_size;
+      ++m_stats.connect_failures;
+      // Wake up a waiting checkout, so it can try to connect.
+      m_available.notify_one();
+      throw;
+    }
+
+    if (not conn)
+    {
+      // Timed out.  Leave the attempt for a later checkout or maintain().
+      lock.lock();
+      m_pending.push_back(std::move(*attempt));
+      ++m_stats.timeouts;
+      throw failure{
+        std::format(
+          "Timed out connecting to the database after {}.",
+          m_config.checkout_timeout),
+        loc};
+    }
+
+    auto const got{clock::now()};
+    lock.lock();
+    ++m_in_use;
+    ++m_stats.connects;
+    auto const missing{registrations_since(0u)};
+    lock.unlock();
+
+    pooled_connection out{*this, std::move(conn), 0u};
+    replay(*out, missing, out.m_replayed, loc);
+    lock.lock();
+    count_checkout(start, got, waited);
+    return out;
+  }
+}
+
+
+void pqxx::connection_pool::prepare(
+  std::string_view name, std::string_view definition, sl loc)
+{
+  std::lock_guard const lock{m_mutex};
+  if (std::ranges::any_of(m_registrations, [name](auto const &reg) {
+        return reg.is_statement and (reg.name == name);
+      }))
+    throw argument_error{
+      std::format(
+        "Connection pool already has a prepared statement named '{}'.", name),
+      loc};
+  m_registrations.push_back(
+    {true, std::string{name}, std::string{definition}, ++m_version});
+}
+
+
+void pqxx::connection_pool::add_session_var(
+  std::string_view var, std::string &&value, sl)
+{
+  std::lock_guard const lock{m_mutex};
+  auto const existing{
+    std::ranges::find_if(m_registrations, [var](auto const &reg) {
+      return not reg.is_statement and (reg.name == var);
+    })};
+  if (existing == std::end(m_registrations))
+  {
+    m_registrations.push_back(
+      {false, std::string{var}, std::move(value), ++m_version});
+  }
+  else
+  {
+    // Replace the old value, so that new connections don't set it only to
+    // overwrite it again.
+    existing->value = std::move(value);
+    existing->version = ++m_version;
+  }
+}
+
+
+void pqxx::connection_pool::maintain(sl loc)
+{
+  std::vector<connecting> pending;
+  std::vector<idle_connection> expired;
+  std::size_t starts{0};
+  {
+    std::lock_guard const lock{m_mutex};
+    pending.swap(m_pending);
+
+    // Close connections that have been idle for too long, oldest first, but
+    // don't go below the minimum size.
+    auto const now{clock::now()};
+    auto const excess{m_size - std::min(m_size, m_config.min_size)};
+    auto const stale{std::ranges::find_if(m_idle, [this, now](auto const &c) {
+      return (now - c.since) < m_config.idle_timeout;
+    })};
+    auto const drop{std::min(
+      excess,
+      static_cast<std::size_t>(std::distance(std::begin(m_idle), stale)))};
+    auto const drop_end{
+      std::next(std::begin(m_idle), static_cast<std::ptrdiff_t>(drop))};
+    std::move(std::begin(m_idle), drop_end, std::back_inserter(expired));
+    m_idle.erase(std::begin(m_idle), drop_end);
+    m_size -= drop;
+
+    // Top up to the minimum size.
+    if (m_size < m_config.min_size)
+    {
+      starts = m_config.min_size - m_size;
+      m_size = m_config.min_size;
+    }
+  }
+
+  // Do the actual work without holding the lock.  Starting an attempt can
+  // block, since libpq resolves the host name synchronously.
+  expired.clear();
+  std::size_t failures{0};
+  for (std::size_t i{0}; i < starts; ++i)
+  {
+    try
+    {
+      pending.emplace_back(m_connect, loc);
+    }
+    catch (std::exception const &)
+    {
+      ++failures;
+    }
+  }
+
+  std::vector<connecting> still_pending;
+  std::vector<idle_connection> ready;
+  for (auto &attempt : pending)
+  {
+    try
+    {
+      // Progress the attempt if its socket is ready, but don't wait.
+      if (pqxx::internal::wait_fd(
+            attempt.sock(), attempt.wait_to_read(), attempt.wait_to_write(),
+            0u, 0u, loc))
+        attempt.process(loc);
+      if (attempt.done())
+        ready.push_back(
+          {std::make_unique<connection>(std::move(attempt).produce(loc)),
+           clock::now(), 0u});
+      else
+        still_pending.push_back(std::move(attempt));
+    }
+    catch (std::exception const &)
+    {
+      // Not just failure: waiting on the socket can throw other errors.  Any
+      // of them only spoil this one attempt.
+      ++failures;
+    }
+  }
+
+  bool const news{not std::empty(ready) or not std::empty(still_pending)};
+  {
+    std::lock_guard const lock{m_mutex};
+    std::ranges::move(still_pending, std::back_inserter(m_pending));
+    std::ranges::move(ready, std::back_inserter(m_idle));
+    m_size -= failures;
+    m_stats.connects += std::size(ready);
+    m_stats.connect_failures += failures;
+  }
+  // Any checkouts that are waiting may now be able to get a connection, or
+  // finish a connection attempt.
+  if (news)
+    m_available.notify_all();
+}
+
+
+pqxx::pool_stats pqxx::connection_pool::stats() const
+{
+  std::lock_guard const lock{m_mutex};
+  pool_stats out{m_stats};
+  out.idle = std::size(m_idle);
+  out.in_use = m_in_use;
+  out.connecting = m_size - out.idle - out.in_use;
+  return out;
+}
+
+
+void pqxx::connection_pool::take_back(
+  std::unique_ptr<connection> &&conn, std::size_t replayed) noexcept
+{
+  bool const usable{conn->is_open()};
+  {
+    std::lock_guard const lock{m_mutex};
+    --m_in_use;
+    if (usable)
+    {
+      try
+      {
+        m_idle.push_back({std::move(conn), clock::now(), replayed});
+      }
+      catch (std::exception const &)
+      {
+        // Out of memory.  Let the caller close the connection.
+      }
+    }
+    if (conn)
+    {
+      --m_size;
+      ++m_stats.discarded;
+    }
+  }
+  m_available.notify_one();
+}
+
+
+std::vector<pqxx::connection_pool::registration>
+pqxx::connection_pool::registrations_since(std::size_t version) const
+{
+  std::vector<registration> missing;
+  std::ranges::copy_if(
+    m_registrations, std::back_inserter(missing),
+    [version](auto const &reg) { return reg.version > version; });
+  // Apply them in the order in which they were made.  A statement may depend
+  // on a session variable, such as `search_path`.
+  std::ranges::sort(missing, {}, &registration::version);
+  return missing;
+}
+
+
+void pqxx::connection_pool::replay(
+  connection &cx, std::vector<registration> const &missing,
+  std::size_t &replayed, sl loc)
+{
+  for (auto const &reg : missing)
+  {
+    if (reg.is_statement)
+      cx.prepare(reg.name, reg.value, loc);
+    else
+      cx.set_session_var(reg.name, reg.value, loc);
+    replayed = reg.version;
+  }
+}
+
+
+void pqxx::connection_pool::count_checkout(
+  clock::time_point start, clock::time_point got, bool waited) noexcept
+{
+  ++m_stats.checkouts;
+  if (waited)
+  {
+    auto const wait{got - start};
+    ++m_stats.waits;
+    m_stats.wait_time += wait;
+    m_stats.max_wait_time = std::max<std::chrono::nanoseconds>(
+      m_stats.max_wait_time, wait);
+  }
+  auto const latency{clock::now() - start};
+  m_stats.checkout_time += latency;
+  m_stats.max_checkout_time =
+    std::max<std::chrono::nanoseconds>(m_stats.max_checkout_time, latency);
+}
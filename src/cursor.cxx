@@ -10,11 +10,18 @@
  */
 #include "pqxx-source.hxx"
 
+#include <algorithm>
 #include <iterator>
 
 #include "pqxx/internal/header-pre.hxx"
 
+extern "C"
+{
+#include <libpq-fe.h>
+}
+
 #include "pqxx/cursor.hxx"
+#include "pqxx/internal/gates/connection-adaptive_cursorstream.hxx"
 #include "pqxx/internal/gates/icursor_iterator-icursorstream.hxx"
 #include "pqxx/internal/gates/icursorstream-icursor_iterator.hxx"
 #include "pqxx/result.hxx"
@@ -23,6 +30,10 @@
 
 #include "pqxx/internal/header-post.hxx"
 
+
+using namespace std::literals;
+
+
 #include "pqxx/internal/ignore-deprecated-pre.hxx"
 pqxx::cursor_base::cursor_base(
   connection &context, std::string_view Name, bool embellish_name, sl loc) :
@@ -320,3 +331,169 @@ void pqxx::icursor_iterator::fill(result const &r)
 {
   m_here = r;
 }
+
+
+namespace
+{
+/// Check an @ref adaptive_cursorstream's configuration.
+/** Returns `query`, so that we can check the configuration before we get to
+ * declaring the cursor.
+ */
+std::string_view check_config(
+  pqxx::cursorstream_config const &config, std::string_view query,
+  pqxx::sl loc)
+{
+  if (config.fetch_bytes == 0)
+    throw pqxx::argument_error{
+      "Cursor fetch size must not be zero bytes.", loc};
+  if (config.initial_stride < 1)
+    throw pqxx::argument_error{
+      std::format(
+        "Attempt to set cursor stride to {}.", config.initial_stride),
+      loc};
+  if (config.max_stride < config.initial_stride)
+    throw pqxx::argument_error{
+      std::format(
+        "Maximum cursor stride ({}) is less than initial stride ({}).",
+        config.max_stride, config.initial_stride),
+      loc};
+  return query;
+}
+} // namespace
+
+
+pqxx::adaptive_cursorstream::adaptive_cursorstream(
+  transaction_base &context, std::string_view query, std::string_view basename,
+  cursorstream_config config, sl loc) :
+        transaction_focus{context, "adaptive_cursorstream"sv, basename},
+        m_cur{
+          context,
+          check_config(config, query, loc),
+          basename,
+          cursor_base::forward_only,
+          cursor_base::read_only,
+          cursor_base::owned,
+          false,
+          loc},
+        m_config{config},
+        m_stride{config.initial_stride}
+{}
+
+
+pqxx::adaptive_cursorstream::~adaptive_cursorstream() noexcept
+{
+  discard_fetch();
+}
+
+
+pqxx::result pqxx::adaptive_cursorstream::fetchblock(sl loc)
+{
+  if (m_done)
+    return m_cur.empty_result();
+  if (m_at_end)
+  {
+    // The last block came up short, so we already know there's no more.
+    m_done = true;
+    return m_cur.empty_result();
+  }
+
+  if (not m_fetch)
+    send_fetch(loc);
+  result r{receive_fetch(loc)};
+  if (std::empty(r))
+    m_done = true;
+  else if (m_config.prefetch and not m_at_end)
+    send_fetch(loc);
+  return r;
+}
+
+
+void pqxx::adaptive_cursorstream::send_fetch(sl loc)
+{
+  internal::gate::connection_adaptive_cursorstream gate{trans().conn()};
+  auto fetch{gate.intern_query(std::format(
+    "FETCH {} IN {}", m_stride, trans().conn().quote_name(m_cur.name())))};
+  register_me();
+  try
+  {
+    gate.start_exec_params(*fetch, loc);
+  }
+  catch (std::exception const &)
+  {
+    unregister_me();
+    throw;
+  }
+  m_fetch = std::move(fetch);
+  m_requested = m_stride;
+}
+
+
+pqxx::result pqxx::adaptive_cursorstream::receive_fetch(sl loc)
+{
+  internal::gate::connection_adaptive_cursorstream gate{trans().conn()};
+  auto const fetch{std::move(m_fetch)};
+
+  // If the result isn't in yet, we're outpacing the server.  Larger fetches
+  // will save us some of the round trips.
+  bool const waited{not gate.consume_input() or gate.is_busy()};
+
+  auto *const pgr{gate.get_result()};
+  std::size_t const bytes{
+    (pgr == nullptr) ?
+      0u :
+      PQresultMemorySize(static_cast<::PGresult const *>(pgr))};
+  result r;
+  try
+  {
+    // If the result is an error, this throws the exception for it.
+    r = gate.make_result(pgr, fetch, loc);
+  }
+  catch (std::exception const &)
+  {
+    m_done = true;
+    while (auto *const extra{gate.get_result()})
+      PQclear(static_cast<::PGresult *>(extra));
+    unregister_me();
+    throw;
+  }
+  while (auto *const extra{gate.get_result()})
+    PQclear(static_cast<::PGresult *>(extra));
+  unregister_me();
+
+  auto const rows{std::size(r)};
+  if (rows < m_requested)
+    m_at_end = true;
+  if (rows > 0)
+  {
+    // Keep a running average, so that one odd block doesn't throw us off.
+    auto const row_bytes{
+      std::max(bytes / static_cast<std::size_t>(rows), std::size_t{1})};
+    m_row_bytes =
+      (m_row_bytes == 0) ? row_bytes : (3 * m_row_bytes + row_bytes) / 4;
+    auto const budget{static_cast<difference_type>(std::clamp(
+      m_config.fetch_bytes / m_row_bytes, std::size_t{1},
+      static_cast<std::size_t>(m_config.max_stride)))};
+    m_stride = std::min(waited ? 2 * m_stride : m_stride, budget);
+  }
+  return r;
+}
+
+
+void pqxx::adaptive_cursorstream::discard_fetch() noexcept
+{
+  if (m_fetch)
+  {
+    m_fetch.reset();
+    internal::gate::connection_adaptive_cursorstream gate{trans().conn()};
+    try
+    {
+      while (auto *const pgr{gate.get_result()})
+        PQclear(static_cast<::PGresult *>(pgr));
+    }
+    catch (std::exception const &)
+    {
+      // The connection is probably broken.  Nothing more we can do.
+    }
+    unregister_me();
+  }
+}
@@ -8,10 +8,16 @@
  */
 #include "pqxx-source.hxx"
 
+#include <bit>
 #include <cstring>
 #include <map>
 #include <sstream>
 
+#if defined(__GNUC__) && defined(__x86_64__)
+#  include <immintrin.h>
+#  define PQXX_FIND_AVX2
+#endif
+
 #include "pqxx/internal/header-pre.hxx"
 
 extern "C"
@@ -24,6 +30,8 @@ extern "C"
 
 #include "pqxx/internal/header-post.hxx"
 
+#include "simd.hxx"
+
 
 using namespace std::literals;
 
@@ -43,11 +51,92 @@ const std::array<std::string_view, 11u> windows_subtypes{
   "866"sv,  "874"sv,  "1250"sv, "1251"sv, "1252"sv, "1253"sv,
   "1254"sv, "1255"sv, "1256"sv, "1257"sv, "1258"sv,
 };
+
+
+/// Portable search for a tab or a backslash.
+/** This uses SSE2 or NEON if the library targets those.
+ */
+constexpr auto find_tab_or_backslash{pqxx::internal::find_ascii_char<
+  pqxx::encoding_group::ascii_safe, '\t', '\\'>};
+
+
+#if defined(PQXX_FIND_AVX2)
+/// Search for a tab or a backslash, 32 bytes at a time, using AVX2.
+[[gnu::target("avx2")]] std::size_t find_tab_or_backslash_avx2(
+  std::string_view haystack, std::size_t here, pqxx::sl loc) noexcept
+{
+  constexpr std::size_t width{32};
+  auto const sz{std::size(haystack)};
+  char const *const data{std::data(haystack)};
+  __m256i const tab{_mm256_set1_epi8('\t')},
+    backslash{_mm256_set1_epi8('\\')};
+  for (; here + width <= sz; here += width)
+  {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    __m256i const chunk{_mm256_loadu_si256(
+      reinterpret_cast<__m256i const *>(data + here))};
+    auto const hits{static_cast<unsigned>(_mm256_movemask_epi8(
+      _mm256_or_si256(
+        _mm256_cmpeq_epi8(chunk, tab), _mm256_cmpeq_epi8(chunk, backslash))))};
+    if (hits != 0)
+      return here + static_cast<std::size_t>(std::countr_zero(hits));
+  }
+  return find_tab_or_backslash(haystack, here, loc);
+}
+#endif // PQXX_FIND_AVX2
+
+
+/// Pick the fastest tab-or-backslash finder that this CPU supports.
+pqxx::internal::char_finder_func *pick_tab_or_backslash_finder() noexcept
+{
+#if defined(PQXX_FIND_AVX2)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return find_tab_or_backslash_avx2;
+#endif
+  return find_tab_or_backslash;
+}
 } // namespace
 
 
 namespace pqxx::internal
 {
+std::size_t find_ascii_or_high(
+  std::string_view haystack, std::size_t here, std::string_view needles,
+  bool stop_at_high) noexcept
+{
+#if defined(PQXX_SIMD_SSE2) || defined(PQXX_SIMD_NEON)
+  auto const count{std::size(needles)};
+  if (count > simd_max_needles) [[unlikely]]
+    return here;
+  std::array<simd_vector, simd_max_needles> splats{};
+  for (std::size_t i{0}; i < count; ++i) splats[i] = simd_splat(needles[i]);
+
+  auto const sz{std::size(haystack)};
+  char const *const data{std::data(haystack)};
+  for (; here + simd_width <= sz; here += simd_width)
+  {
+    auto const masks{simd_scan(data + here, splats, count)};
+    auto const stops{stop_at_high ? (masks.hits | masks.high) : masks.hits};
+    if (stops != 0)
+      return here + simd_first(stops);
+  }
+#else
+  std::ignore = haystack;
+  std::ignore = needles;
+  std::ignore = stop_at_high;
+#endif
+  return here;
+}
+
+
+char_finder_func *get_tab_or_backslash_finder() noexcept
+{
+  static char_finder_func *const finder{pick_tab_or_backslash_finder()};
+  return finder;
+}
+
+
 // LCOV_EXCL_START
 // C++23: Reduce to const std::flat_map on top of constexpr array?
 /// Look up encoding group for an encoding by name.
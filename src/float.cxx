@@ -0,0 +1,775 @@
+/** Fast, locale-independent conversions between floating-point and text.
+ *
+ * Parsing uses the Eisel-Lemire algorithm:
+ *   Daniel Lemire, "Number Parsing at a Gigabyte per Second,"
+ *   Software: Practice and Experience 51 (8), 2021.
+ *
+ * Formatting uses the Schubfach algorithm:
+ *   Raffaello Giulietti, "The Schubfach way to render doubles," 2020.
+ *
+ * Copyright (c) 2000-2026, Jeroen T. Vermeulen.
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this
+ * mistake, or contact the author.
+ */
+#include "pqxx-source.hxx"
+
+#include <array>
+#include <bit>
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "pqxx/internal/header-pre.hxx"
+
+#include "pqxx/internal/float.hxx"
+
+#include "pqxx/internal/header-post.hxx"
+
+#include "float-tables.hxx"
+
+
+namespace
+{
+static_assert(std::numeric_limits<float>::is_iec559);
+static_assert(std::numeric_limits<double>::is_iec559);
+
+
+/// A 128-bit unsigned number.
+struct u128 final
+{
+  std::uint64_t hi, lo;
+};
+
+
+/// Multiply two 64-bit numbers into a 128-bit one.
+inline u128 multiply(std::uint64_t a, std::uint64_t b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+  __extension__ using uint128 = unsigned __int128;
+  auto const product{static_cast<uint128>(a) * b};
+  return {
+    static_cast<std::uint64_t>(product >> 64),
+    static_cast<std::uint64_t>(product)};
+#else
+  constexpr std::uint64_t low32{0xffffffffu};
+  auto const a_lo{a & low32}, a_hi{a >> 32}, b_lo{b & low32}, b_hi{b >> 32};
+  auto const ll{a_lo * b_lo}, lh{a_lo * b_hi}, hl{a_hi * b_lo},
+    hh{a_hi * b_hi};
+  auto const mid{(ll >> 32) + (lh & low32) + (hl & low32)};
+  return {
+    hh + (lh >> 32) + (hl >> 32) + (mid >> 32), (mid << 32) | (ll & low32)};
+#endif
+}
+
+
+/// Power of 5 from the table: 5^q, normalised to 128 bits, rounded down.
+inline u128 pow5(int q) noexcept
+{
+  auto const idx{static_cast<std::size_t>(2 * (q - pqxx::internal::pow5_min))};
+  return {pqxx::internal::pow5_128[idx], pqxx::internal::pow5_128[idx + 1]};
+}
+
+
+/// Properties of the IEEE 754 binary formats we support.
+template<typename T> struct ieee;
+
+template<> struct ieee<double> final
+{
+  using bits = std::uint64_t;
+  /// Number of explicitly stored mantissa bits.
+  static constexpr int mantissa_bits{52};
+  static constexpr int minimum_exponent{-1023};
+  /// Biased exponent value for infinity.
+  static constexpr int infinite_power{0x7ff};
+  /// Range of decimal exponents where a value may fall exactly between two
+  /// doubles.
+  static constexpr int min_round_to_even{-4}, max_round_to_even{23};
+  /// Below this decimal exponent, any 64-bit mantissa rounds to zero.
+  static constexpr int smallest_power{-342};
+  /// Above this decimal exponent, any nonzero mantissa overflows.
+  static constexpr int largest_power{308};
+  /// Powers of 10 up to this one are exact in a double.
+  static constexpr int max_exact_power{22};
+  static constexpr std::array<double, 23> exact_powers{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+};
+
+template<> struct ieee<float> final
+{
+  using bits = std::uint32_t;
+  static constexpr int mantissa_bits{23};
+  static constexpr int minimum_exponent{-127};
+  static constexpr int infinite_power{0xff};
+  static constexpr int min_round_to_even{-17}, max_round_to_even{10};
+  static constexpr int smallest_power{-65};
+  static constexpr int largest_power{38};
+  static constexpr int max_exact_power{10};
+  static constexpr std::array<float, 11> exact_powers{
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+};
+
+
+/// A binary floating-point value in the making: mantissa and exponent.
+struct adjusted_mantissa final
+{
+  std::uint64_t mantissa{0};
+  /// Biased binary exponent.
+  int power2{0};
+
+  bool operator==(adjusted_mantissa const &) const noexcept = default;
+};
+
+
+/// Approximate w * 5^q, with enough precise bits for `T`.
+template<typename T>
+u128 product_approximation(int q, std::uint64_t w) noexcept
+{
+  // We need the implicit bit, one bit for rounding, and one bit that we may
+  // lose if the product is too small.
+  constexpr int precision{ieee<T>::mantissa_bits + 3};
+  constexpr std::uint64_t precision_mask{~std::uint64_t{0} >> precision};
+
+  auto power{pow5(q)};
+  // For q in [-27, 0), the parser needs the power rounded up, not down.  It
+  // is never exact, so that just means adding 1.
+  if ((q < 0) and (q >= -27))
+  {
+    ++power.lo;
+    if (power.lo == 0)
+      ++power.hi;
+  }
+
+  auto first{multiply(w, power.hi)};
+  if ((first.hi & precision_mask) == precision_mask)
+  {
+    // Not sure we have enough precision yet.  Look at the next 64 bits.
+    // Lemire & Mushtak proved that this is always enough.
+    auto const second{multiply(w, power.lo)};
+    first.lo += second.hi;
+    if (second.hi > first.lo)
+      ++first.hi;
+  }
+  return first;
+}
+
+
+/// Compute w * 10^q as a binary floating-point value.  (Eisel-Lemire.)
+/** Requires w != 0, and q in [smallest_power, largest_power].
+ */
+template<typename T>
+adjusted_mantissa compute_float(int q, std::uint64_t w) noexcept
+{
+  using traits = ieee<T>;
+  adjusted_mantissa answer;
+
+  // Normalise w, so its most significant bit is set.
+  auto const lz{std::countl_zero(w)};
+  w <<= lz;
+
+  // (See product_approximation for the rationale.)
+  auto const product{product_approximation<T>(q, w)};
+  auto const upperbit{static_cast<int>(product.hi >> 63)};
+  auto const shift{upperbit + 64 - traits::mantissa_bits - 3};
+
+  answer.mantissa = product.hi >> shift;
+  // This computes floor(log2(5^q)) + q + 63: the binary exponent of 10^q,
+  // adjusted for the normalisation.
+  answer.power2 = (((152170 + 65536) * q) >> 16) + 63 + upperbit - lz -
+                  traits::minimum_exponent;
+
+  if (answer.power2 <= 0)
+  {
+    // Subnormal, or zero.
+    if ((-answer.power2 + 1) >= 64)
+      return {};
+    answer.mantissa >>= -answer.power2 + 1;
+    // Round up.  We can't be exactly halfway: that only happens for decimal
+    // exponents near zero.
+    answer.mantissa += (answer.mantissa & 1u);
+    answer.mantissa >>= 1;
+    // Rounding up may have made it a normal number after all.
+    answer.power2 =
+      (answer.mantissa < (std::uint64_t{1} << traits::mantissa_bits)) ? 0 : 1;
+    return answer;
+  }
+
+  // We normally round up, but if the value is exactly halfway between two
+  // floating-point values, round to even.  That can only happen if 5^q fits
+  // in 64 bits.
+  if (
+    (product.lo <= 1) and (q >= traits::min_round_to_even) and
+    (q <= traits::max_round_to_even) and ((answer.mantissa & 3u) == 1u) and
+    ((answer.mantissa << shift) == product.hi))
+    answer.mantissa &= ~std::uint64_t{1};
+
+  answer.mantissa += (answer.mantissa & 1u);
+  answer.mantissa >>= 1;
+  if (answer.mantissa >= (std::uint64_t{2} << traits::mantissa_bits))
+  {
+    answer.mantissa = std::uint64_t{1} << traits::mantissa_bits;
+    ++answer.power2;
+  }
+
+  answer.mantissa &= ~(std::uint64_t{1} << traits::mantissa_bits);
+  if (answer.power2 >= traits::infinite_power)
+  {
+    answer.power2 = traits::infinite_power;
+    answer.mantissa = 0;
+  }
+  return answer;
+}
+
+
+/// Assemble a floating-point value from its parts.
+template<typename T>
+T to_float(bool negative, adjusted_mantissa const &am) noexcept
+{
+  using bits = typename ieee<T>::bits;
+  auto word{static_cast<bits>(am.mantissa)};
+  word |= static_cast<bits>(am.power2) << ieee<T>::mantissa_bits;
+  if (negative)
+    word |= bits{1} << (sizeof(T) * 8 - 1);
+  return std::bit_cast<T>(word);
+}
+
+
+constexpr bool is_digit(char c) noexcept
+{
+  return (c >= '0') and (c <= '9');
+}
+
+
+/// May `c` occur in the parenthesised part of a "nan(...)"?
+constexpr bool is_nchar(char c) noexcept
+{
+  return is_digit(c) or (((c | 0x20) >= 'a') and ((c | 0x20) <= 'z')) or
+         (c == '_');
+}
+
+
+/// Case-insensitive check: does `text` start with `lower`?
+bool starts_with_nocase(
+  char const *begin, char const *end, std::string_view lower) noexcept
+{
+  if (std::cmp_less(end - begin, std::size(lower)))
+    return false;
+  for (std::size_t i{0}; i < std::size(lower); ++i)
+    if ((begin[i] | 0x20) != lower[i])
+      return false;
+  return true;
+}
+
+
+/// Parse "inf," "infinity," "nan," or "nan(...)", ignoring case.
+template<typename T>
+std::from_chars_result parse_special(
+  char const *begin, char const *here, char const *end, bool negative,
+  T &out) noexcept
+{
+  if (starts_with_nocase(here, end, "inf"))
+  {
+    here += starts_with_nocase(here, end, "infinity") ? 8 : 3;
+    out = negative ? -std::numeric_limits<T>::infinity() :
+                     std::numeric_limits<T>::infinity();
+    return {here, std::errc{}};
+  }
+  if (starts_with_nocase(here, end, "nan"))
+  {
+    here += 3;
+    // There may be an "n-char-sequence" in parentheses.
+    if ((here < end) and (*here == '('))
+    {
+      auto p{here + 1};
+      while ((p < end) and is_nchar(*p)) ++p;
+      if ((p < end) and (*p == ')'))
+        here = p + 1;
+    }
+    out = negative ? -std::numeric_limits<T>::quiet_NaN() :
+                     std::numeric_limits<T>::quiet_NaN();
+    return {here, std::errc{}};
+  }
+  return {begin, std::errc::invalid_argument};
+}
+
+
+/// Digits in a 64-bit mantissa, that we know won't overflow.
+constexpr int max_digits{19};
+
+
+/// Floor of log10(2^e), for e in [-2620, 2620].
+constexpr int floor_log10_pow2(int e) noexcept
+{
+  return (e * 1262611) >> 22;
+}
+
+/// Floor of log10(3/4 * 2^e), for e in [-2985, 2936].
+constexpr int floor_log10_three_quarters_pow2(int e) noexcept
+{
+  return (e * 1262611 - 524031) >> 22;
+}
+
+/// Floor of log2(10^e), for e in [-1233, 1232].
+constexpr int floor_log2_pow10(int e) noexcept
+{
+  return (e * 1741647) >> 19;
+}
+
+
+/// Schubfach's "g" for double: 10^k, normalised to 128 bits, rounded up.
+inline u128 pow10_up_128(int k) noexcept
+{
+  auto g{pow5(k)};
+  // The table rounds down.  Only 5^0 through 5^55 are exact.
+  if ((k < 0) or (k > 55))
+  {
+    ++g.lo;
+    if (g.lo == 0)
+      ++g.hi;
+  }
+  return g;
+}
+
+/// Schubfach's "g" for float: 10^k, normalised to 64 bits, rounded up.
+inline std::uint64_t pow10_up_64(int k) noexcept
+{
+  auto const g{pow5(k)};
+  return g.hi + (((k < 0) or (g.lo != 0)) ? 1u : 0u);
+}
+
+
+/// Multiply, keep the top bits, and round to odd.
+inline std::uint64_t round_to_odd(u128 g, std::uint64_t cp) noexcept
+{
+  auto const x{multiply(g.lo, cp)};
+  auto const y{multiply(g.hi, cp)};
+  auto const z{y.lo + x.hi};
+  auto const y1{y.hi + ((z < y.lo) ? 1u : 0u)};
+  return y1 | ((z > 1) ? 1u : 0u);
+}
+
+inline std::uint32_t round_to_odd(std::uint64_t g, std::uint32_t cp) noexcept
+{
+  auto const b01{(g & 0xffffffffu) * cp};
+  auto const b11{(g >> 32) * cp};
+  auto const hi{b11 + (b01 >> 32)};
+  return static_cast<std::uint32_t>(hi >> 32) |
+         (((hi & 0xffffffffu) > 1) ? 1u : 0u);
+}
+
+
+/// A decimal value: digits times 10 to the power of exponent.
+struct decimal final
+{
+  std::uint64_t digits;
+  int exponent;
+};
+
+
+/// Find the shortest decimal that reads back as the given value.
+/** Takes the raw IEEE fields of a finite, positive value.  This is the core
+ * of the Schubfach algorithm.
+ */
+template<typename T>
+decimal to_decimal(std::uint64_t ieee_mantissa, int ieee_exponent) noexcept
+{
+  using traits = ieee<T>;
+  using word = std::conditional_t<
+    std::is_same_v<T, double>, std::uint64_t, std::uint32_t>;
+  constexpr int bias{-traits::minimum_exponent + traits::mantissa_bits};
+  constexpr word hidden_bit{word{1} << traits::mantissa_bits};
+
+  word c;
+  int q;
+  if (ieee_exponent != 0)
+  {
+    c = hidden_bit | static_cast<word>(ieee_mantissa);
+    q = ieee_exponent - bias;
+    // Small integers are easy.
+    if (
+      (-q >= 0) and (-q <= traits::mantissa_bits) and
+      ((c & ((word{1} << -q) - 1)) == 0))
+      return {static_cast<std::uint64_t>(c >> -q), 0};
+  }
+  else
+  {
+    c = static_cast<word>(ieee_mantissa);
+    q = 1 - bias;
+  }
+
+  bool const is_even{(c % 2) == 0};
+  bool const lower_closer{(ieee_mantissa == 0) and (ieee_exponent > 1)};
+
+  word const cbl{static_cast<word>(4 * c - 2 + (lower_closer ? 1 : 0))};
+  word const cb{static_cast<word>(4 * c)};
+  word const cbr{static_cast<word>(4 * c + 2)};
+
+  int const k{
+    lower_closer ? floor_log10_three_quarters_pow2(q) : floor_log10_pow2(q)};
+  int const h{q + floor_log2_pow10(-k) + 1};
+
+  word vbl, vb, vbr;
+  if constexpr (std::is_same_v<T, double>)
+  {
+    auto const g{pow10_up_128(-k)};
+    vbl = round_to_odd(g, cbl << h);
+    vb = round_to_odd(g, cb << h);
+    vbr = round_to_odd(g, cbr << h);
+  }
+  else
+  {
+    auto const g{pow10_up_64(-k)};
+    vbl = round_to_odd(g, static_cast<std::uint32_t>(cbl << h));
+    vb = round_to_odd(g, static_cast<std::uint32_t>(cb << h));
+    vbr = round_to_odd(g, static_cast<std::uint32_t>(cbr << h));
+  }
+
+  word const lower{static_cast<word>(vbl + (is_even ? 0 : 1))};
+  word const upper{static_cast<word>(vbr - (is_even ? 0 : 1))};
+
+  word const s{static_cast<word>(vb / 4)};
+  if (s >= 10)
+  {
+    // Try one digit less.
+    word const sp{static_cast<word>(s / 10)};
+    bool const up_inside{lower <= 40 * sp};
+    bool const wp_inside{40 * sp + 40 <= upper};
+    if (up_inside != wp_inside)
+      return {sp + (wp_inside ? 1u : 0u), k + 1};
+  }
+
+  bool const u_inside{lower <= 4 * s};
+  bool const w_inside{4 * s + 4 <= upper};
+  if (u_inside != w_inside)
+    return {s + (w_inside ? 1u : 0u), k};
+
+  word const mid{static_cast<word>(4 * s + 2)};
+  bool const round_up{(vb > mid) or ((vb == mid) and ((s & 1) != 0))};
+  return {s + (round_up ? 1u : 0u), k};
+}
+
+
+/// Number of decimal digits in `value`.
+constexpr int count_digits(std::uint64_t value) noexcept
+{
+  int digits{1};
+  while (value >= 10)
+  {
+    value /= 10;
+    ++digits;
+  }
+  return digits;
+}
+
+
+/// Write the `count` digits of `value` into `out`.
+inline void
+write_digits(char *out, std::uint64_t value, int count) noexcept
+{
+  for (auto i{count - 1}; i >= 0; --i)
+  {
+    out[i] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  }
+}
+
+
+/// Write the `count` digits of the integer `mantissa * 2^shift` into `out`.
+/** In fixed-point notation, `std::to_chars` writes large integral values
+ * exactly, not as the shortest digits followed by zeroes.  These values can
+ * exceed 64 bits.
+ */
+void write_exact_digits(
+  char *out, std::uint64_t mantissa, int shift, int count) noexcept
+{
+  // The value, as 32-bit limbs, most significant first.
+  std::array<std::uint32_t, 4> limbs{};
+  u128 const value{
+    (shift == 0) ? 0u : (mantissa >> (64 - shift)), mantissa << shift};
+  limbs[0] = static_cast<std::uint32_t>(value.hi >> 32);
+  limbs[1] = static_cast<std::uint32_t>(value.hi);
+  limbs[2] = static_cast<std::uint32_t>(value.lo >> 32);
+  limbs[3] = static_cast<std::uint32_t>(value.lo);
+  for (auto i{count - 1}; i >= 0; --i)
+  {
+    std::uint64_t remainder{0};
+    for (auto &limb : limbs)
+    {
+      auto const part{(remainder << 32) | limb};
+      limb = static_cast<std::uint32_t>(part / 10);
+      remainder = part % 10;
+    }
+    out[i] = static_cast<char>('0' + remainder);
+  }
+}
+
+
+/// Write a special value (infinity or NaN) the way std::to_chars does.
+char *write_text(std::span<char> buf, std::string_view text) noexcept
+{
+  if (std::size(buf) < std::size(text))
+    return nullptr;
+  std::memcpy(std::data(buf), std::data(text), std::size(text));
+  return std::data(buf) + std::size(text);
+}
+} // namespace
+
+
+namespace pqxx::internal
+{
+template<typename T>
+std::from_chars_result
+parse_float(char const *begin, char const *end, T &out) noexcept
+{
+  using traits = ieee<T>;
+  char const *here{begin};
+  bool const negative{(here < end) and (*here == '-')};
+  if (negative)
+    ++here;
+  if ((here < end) and (((*here | 0x20) == 'i') or ((*here | 0x20) == 'n')))
+    return parse_special(begin, here, end, negative, out);
+
+  // The first (up to) 19 significant digits go into w.  For each digit that
+  // we skip before the decimal point, and each digit that we take after it,
+  // the decimal exponent changes by one.
+  std::uint64_t w{0};
+  int taken{0};
+  std::int64_t scale{0};
+  bool truncated{false}, any_digits{false};
+  for (; (here < end) and is_digit(*here); ++here)
+  {
+    any_digits = true;
+    auto const digit{static_cast<unsigned>(*here - '0')};
+    if (taken < max_digits)
+    {
+      w = 10 * w + digit;
+      if (w != 0)
+        ++taken;
+    }
+    else
+    {
+      ++scale;
+      truncated = truncated or (digit != 0);
+    }
+  }
+  if ((here < end) and (*here == '.'))
+  {
+    ++here;
+    for (; (here < end) and is_digit(*here); ++here)
+    {
+      any_digits = true;
+      auto const digit{static_cast<unsigned>(*here - '0')};
+      if (taken < max_digits)
+      {
+        w = 10 * w + digit;
+        if (w != 0)
+          ++taken;
+        --scale;
+      }
+      else
+      {
+        truncated = truncated or (digit != 0);
+      }
+    }
+  }
+  if (not any_digits)
+    return {begin, std::errc::invalid_argument};
+
+  // The exponent.  If there's an 'e' without a valid number after it, then
+  // the 'e' is not part of the number.
+  std::int64_t exponent{0};
+  if ((here < end) and ((*here | 0x20) == 'e'))
+  {
+    auto p{here + 1};
+    bool const neg_exp{(p < end) and (*p == '-')};
+    if ((p < end) and ((*p == '-') or (*p == '+')))
+      ++p;
+    if ((p < end) and is_digit(*p))
+    {
+      for (; (p < end) and is_digit(*p); ++p)
+        // Beyond this, the exact number doesn't matter.
+        if (exponent < 100'000'000)
+          exponent = 10 * exponent + (*p - '0');
+      if (neg_exp)
+        exponent = -exponent;
+      here = p;
+    }
+  }
+
+  if (w == 0)
+  {
+    out = negative ? -T{0} : T{0};
+    return {here, std::errc{}};
+  }
+
+  auto const q64{exponent + scale};
+  if (q64 < traits::smallest_power)
+    return {here, std::errc::result_out_of_range};
+  if (q64 > traits::largest_power)
+    return {here, std::errc::result_out_of_range};
+  auto const q{static_cast<int>(q64)};
+
+#if (FLT_EVAL_METHOD == 0)
+  // Clinger's fast path: if w and 10^q are both exact, then so is the
+  // result of a single multiplication or division.
+  if (
+    (not truncated) and (w <= (std::uint64_t{2} << traits::mantissa_bits)) and
+    (q >= -traits::max_exact_power) and (q <= traits::max_exact_power))
+  {
+    auto value{static_cast<T>(w)};
+    if (q < 0)
+      value /= traits::exact_powers[static_cast<std::size_t>(-q)];
+    else
+      value *= traits::exact_powers[static_cast<std::size_t>(q)];
+    out = negative ? -value : value;
+    return {here, std::errc{}};
+  }
+#endif
+
+  auto const am{compute_float<T>(q, w)};
+  // If we dropped any digits, the true value lies between w and w + 1.  If
+  // those round to different values, we can't tell which one is right.
+  if (truncated and (compute_float<T>(q, w + 1) != am))
+    return {here, std::errc::not_supported};
+
+  if ((am.power2 == traits::infinite_power) or
+      ((am.power2 == 0) and (am.mantissa == 0)))
+    return {here, std::errc::result_out_of_range};
+  out = to_float<T>(negative, am);
+  return {here, std::errc{}};
+}
+
+
+template<typename T> char *format_float(std::span<char> buf, T value) noexcept
+{
+  using traits = ieee<T>;
+  using bits_t = typename traits::bits;
+  auto const bits{std::bit_cast<bits_t>(value)};
+  constexpr int sign_shift{sizeof(T) * 8 - 1};
+  bool const negative{(bits >> sign_shift) != 0};
+  auto const ieee_mantissa{
+    static_cast<std::uint64_t>(
+      bits & ((bits_t{1} << traits::mantissa_bits) - 1))};
+  auto const ieee_exponent{static_cast<int>(
+    (bits >> traits::mantissa_bits) &
+    static_cast<bits_t>(traits::infinite_power))};
+
+  // The binary exponent is the biased exponent minus this.
+  constexpr int bias{-traits::minimum_exponent + traits::mantissa_bits};
+  char *out{std::data(buf)};
+  char *const end{out + std::size(buf)};
+
+  if (ieee_exponent == traits::infinite_power)
+  {
+    if (ieee_mantissa != 0)
+      return write_text(buf, negative ? "-nan" : "nan");
+    else
+      return write_text(buf, negative ? "-inf" : "inf");
+  }
+
+  if (negative)
+  {
+    if (out == end)
+      return nullptr;
+    *out++ = '-';
+  }
+
+  if ((ieee_exponent == 0) and (ieee_mantissa == 0))
+  {
+    if (out == end)
+      return nullptr;
+    *out++ = '0';
+    return out;
+  }
+
+  auto [digits, exp10]{to_decimal<T>(ieee_mantissa, ieee_exponent)};
+  while ((digits % 10) == 0)
+  {
+    digits /= 10;
+    ++exp10;
+  }
+  int const n{count_digits(digits)};
+  // Exponent in scientific notation.
+  int const sci{exp10 + n - 1};
+
+  // Compare the lengths of fixed-point and scientific notation.  Prefer
+  // fixed-point if they're equally long.
+  int const abs_sci{(sci < 0) ? -sci : sci};
+  int const sci_len{
+    n + ((n > 1) ? 1 : 0) + 2 + ((abs_sci >= 100) ? 3 : 2)};
+  int fixed_len;
+  if (exp10 >= 0)
+    fixed_len = n + exp10;
+  else if (sci >= 0)
+    fixed_len = n + 1;
+  else
+    fixed_len = n + 1 - sci;
+
+  if (fixed_len <= sci_len)
+  {
+    if ((end - out) < fixed_len)
+      return nullptr;
+    if ((exp10 > 0) and (ieee_exponent > bias))
+    {
+      // A large integer.  Write it out exactly.
+      write_exact_digits(
+        out,
+        ieee_mantissa | (std::uint64_t{1} << traits::mantissa_bits),
+        ieee_exponent - bias, fixed_len);
+    }
+    else if (exp10 >= 0)
+    {
+      write_digits(out, digits, n);
+      std::memset(out + n, '0', static_cast<std::size_t>(exp10));
+    }
+    else if (sci >= 0)
+    {
+      // The decimal point goes somewhere in the middle of the digits.
+      auto const whole{static_cast<std::size_t>(sci + 1)};
+      write_digits(out, digits, n);
+      std::memmove(
+        out + whole + 1, out + whole, static_cast<std::size_t>(n) - whole);
+      out[whole] = '.';
+    }
+    else
+    {
+      // "0.000ddd"
+      out[0] = '0';
+      out[1] = '.';
+      std::memset(out + 2, '0', static_cast<std::size_t>(-sci - 1));
+      write_digits(out + 1 - sci, digits, n);
+    }
+    return out + fixed_len;
+  }
+
+  if ((end - out) < sci_len)
+    return nullptr;
+  write_digits(out + ((n > 1) ? 1 : 0), digits, n);
+  if (n > 1)
+  {
+    // Move the first digit in front of the decimal point.
+    out[0] = out[1];
+    out[1] = '.';
+  }
+  char *p{out + n + ((n > 1) ? 1 : 0)};
+  *p++ = 'e';
+  *p++ = (sci < 0) ? '-' : '+';
+  write_digits(
+    p, static_cast<std::uint64_t>(abs_sci), (abs_sci >= 100) ? 3 : 2);
+  return out + sci_len;
+}
+
+
+template PQXX_LIBEXPORT std::from_chars_result
+parse_float(char const *, char const *, float &) noexcept;
+template PQXX_LIBEXPORT std::from_chars_result
+parse_float(char const *, char const *, double &) noexcept;
+template PQXX_LIBEXPORT char *format_float(std::span<char>, float) noexcept;
+template PQXX_LIBEXPORT char *format_float(std::span<char>, double) noexcept;
+} // namespace pqxx::internal
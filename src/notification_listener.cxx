@@ -0,0 +1,198 @@
+/** Implementation of the pqxx::notification_listener class.
+ *
+ * Copyright (c) 2000-2026, Jeroen T. Vermeulen.
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this
+ * mistake, or contact the author.
+ */
+#include "pqxx-source.hxx"
+
+#include <vector>
+
+#include "pqxx/internal/header-pre.hxx"
+
+extern "C"
+{
+#include <libpq-fe.h>
+}
+
+#include "pqxx/internal/gates/connection-notification_listener.hxx"
+#include "pqxx/internal/wait.hxx"
+#include "pqxx/nontransaction.hxx"
+#include "pqxx/notification_listener.hxx"
+
+#include "pqxx/internal/header-post.hxx"
+
+
+namespace
+{
+/// Get the listener notification that a libpq notification represents.
+pqxx::received_notification
+view(pqxx::internal::pq::PGnotify const *notif) noexcept
+{
+  auto const *const n{static_cast<PGnotify const *>(notif)};
+  return {
+    .channel = pqxx::zview{n->relname},
+    .payload = pqxx::zview{n->extra},
+    .backend_pid = n->be_pid,
+  };
+}
+} // namespace
+
+
+pqxx::notification_listener::notification_listener(
+  connection &&cx, listener_config config, sl loc) :
+        m_conn{std::move(cx), loc}, m_config{config}
+{
+  if (m_config.batch_size == 0)
+    throw argument_error{"Notification batch size must not be zero.", loc};
+}
+
+
+pqxx::notification_listener::~notification_listener() noexcept = default;
+
+
+void pqxx::notification_listener::listen(
+  std::string_view channel, handler h, sl loc)
+{
+  auto const pos{m_handlers.find(channel)};
+  if (h)
+  {
+    auto fn{std::make_shared<handler const>(std::move(h))};
+    if (pos != std::end(m_handlers))
+    {
+      pos->second = std::move(fn);
+    }
+    else
+    {
+      // Execute this in a nontransaction.  That way, the connection will not
+      // try to deliver incoming notifications itself.
+      nontransaction tx{m_conn};
+      tx.exec(std::format("LISTEN {}", m_conn.quote_name(channel)), loc)
+        .no_rows(loc);
+      m_handlers.emplace(channel, std::move(fn));
+    }
+  }
+  else if (pos != std::end(m_handlers))
+  {
+    nontransaction tx{m_conn};
+    tx.exec(std::format("UNLISTEN {}", m_conn.quote_name(channel)), loc)
+      .no_rows(loc);
+    m_handlers.erase(pos);
+  }
+}
+
+
+std::size_t pqxx::notification_listener::poll(sl loc)
+{
+  internal::gate::connection_notification_listener gate{m_conn};
+  if (not gate.consume_input()) [[unlikely]]
+    throw broken_connection{"Connection lost.", loc};
+  auto *const cx{static_cast<PGconn *>(gate.raw_connection())};
+
+  std::size_t count{0};
+  if (m_config.hand_off)
+  {
+    // Route the whole batch first, then queue it under a single lock.
+    std::vector<job> batch;
+    for (; count < m_config.batch_size; ++count)
+    {
+      notify_ptr notif{PQnotifies(cx), internal::pq::pqfreemem};
+      if (not notif)
+        break;
+      auto const found{
+        m_handlers.find(static_cast<PGnotify *>(notif.get())->relname)};
+      if (found != std::end(m_handlers)) [[likely]]
+        batch.emplace_back(found->second, std::move(notif));
+    }
+    if (not std::empty(batch))
+    {
+      {
+        std::lock_guard const lock{m_mutex};
+        for (auto &j : batch) m_queue.push_back(std::move(j));
+      }
+      if (std::size(batch) == 1)
+        m_ready.notify_one();
+      else
+        m_ready.notify_all();
+    }
+  }
+  else
+  {
+    for (; count < m_config.batch_size; ++count)
+    {
+      notify_ptr const notif{PQnotifies(cx), internal::pq::pqfreemem};
+      if (not notif)
+        break;
+      auto const data{view(notif.get())};
+      auto const found{m_handlers.find(data.channel)};
+      if (found != std::end(m_handlers)) [[likely]]
+        (*found->second)(data);
+    }
+  }
+  return count;
+}
+
+
+std::size_t
+pqxx::notification_listener::wait(std::chrono::microseconds timeout, sl loc)
+{
+  auto const count{poll(loc)};
+  if (count > 0)
+    return count;
+  auto const secs{
+    std::chrono::duration_cast<std::chrono::seconds>(timeout)};
+  internal::wait_fd(
+    sock(), true, false,
+    check_cast<unsigned>(secs.count(), "Seconds out of range.", loc),
+    check_cast<unsigned>(
+      (timeout - secs).count(), "Microseconds out of range.", loc),
+    loc);
+  return poll(loc);
+}
+
+
+void pqxx::notification_listener::run(job const &j)
+{
+  (*j.fn)(view(j.notif.get()));
+}
+
+
+void pqxx::notification_listener::serve(std::stop_token stop)
+{
+  std::unique_lock lock{m_mutex};
+  while (m_ready.wait(lock, stop, [this] { return not std::empty(m_queue); }))
+  {
+    auto const j{std::move(m_queue.front())};
+    m_queue.pop_front();
+    lock.unlock();
+    run(j);
+    lock.lock();
+  }
+}
+
+
+std::size_t pqxx::notification_listener::run_queued(std::size_t max)
+{
+  std::size_t count{0};
+  while (count < max)
+  {
+    std::unique_lock lock{m_mutex};
+    if (std::empty(m_queue))
+      break;
+    auto const j{std::move(m_queue.front())};
+    m_queue.pop_front();
+    lock.unlock();
+    ++count;
+    run(j);
+  }
+  return count;
+}
+
+
+std::size_t pqxx::notification_listener::queued() const
+{
+  std::lock_guard const lock{m_mutex};
+  return std::size(m_queue);
+}
@@ -31,11 +31,76 @@ pqxx::internal::get_encoding_group(pqxx::transaction_base const &tx, sl loc)
 }
 
 
+namespace
+{
+/// Largest number of parameters for which we keep spare buffers.
+/** We don't want to hang on to huge buffers after a one-off giant statement.
+ */
+constexpr std::size_t max_spare_params{1024};
+
+
+/// Has the thread started exiting?  If so, stop keeping spare buffers.
+thread_local bool spares_closed{false};
+
+
+/// A thread's spare buffers for the next @ref pqxx::internal::c_params.
+struct spare_buffers final
+{
+  spare_buffers() noexcept = default;
+  spare_buffers(spare_buffers const &) = delete;
+  spare_buffers &operator=(spare_buffers const &) = delete;
+  ~spare_buffers() noexcept { spares_closed = true; }
+
+  std::vector<char const *> values;
+  std::vector<int> lengths;
+  std::vector<int> formats;
+  std::vector<pqxx::oid> types;
+  /// Are the buffers here, ready for reuse?
+  bool available{false};
+};
+
+
+thread_local spare_buffers spares;
+} // namespace
+
+
+pqxx::internal::c_params::c_params() noexcept
+{
+  if (not spares_closed and spares.available) [[likely]]
+  {
+    spares.available = false;
+    values = std::move(spares.values);
+    lengths = std::move(spares.lengths);
+    formats = std::move(spares.formats);
+    types = std::move(spares.types);
+  }
+}
+
+
+pqxx::internal::c_params::~c_params() noexcept
+{
+  if (
+    spares_closed or spares.available or (values.capacity() == 0) or
+    (values.capacity() > max_spare_params))
+    return;
+  values.clear();
+  lengths.clear();
+  formats.clear();
+  types.clear();
+  spares.values = std::move(values);
+  spares.lengths = std::move(lengths);
+  spares.formats = std::move(formats);
+  spares.types = std::move(types);
+  spares.available = true;
+}
+
+
 void pqxx::internal::c_params::reserve(std::size_t n) &
 {
   values.reserve(n);
   lengths.reserve(n);
   formats.reserve(n);
+  types.reserve(n);
 }
 
 
@@ -45,6 +110,13 @@ void pqxx::params::reserve(std::size_t n) &
 }
 
 
+void pqxx::params::clear() & noexcept
+{
+  m_params.clear();
+  m_arena.clear();
+}
+
+
 void pqxx::params::append(sl) &
 {
   m_params.emplace_back(nullptr);
@@ -59,7 +131,10 @@ void pqxx::params::append(zview value, sl) &
 
 void pqxx::params::append(std::string const &value, sl) &
 {
-  m_params.emplace_back(value);
+  auto const start{std::size(m_arena)};
+  m_arena.append(value);
+  m_arena.push_back('\0');
+  m_params.emplace_back(stored{start, std::size(value), 0});
 }
 
 
@@ -69,10 +144,24 @@ void pqxx::params::append(std::string &&value, sl) &
 }
 
 
+void pqxx::params::append_entries(params const &other)
+{
+  this->reserve(std::size(other.m_params) + std::size(this->m_params));
+  // The other params' arena values go into our own arena, at this offset.
+  auto const base{std::size(m_arena)};
+  m_arena.append(other.m_arena);
+  for (auto const &param : other.m_params)
+    if (auto const *const value{std::get_if<stored>(&param)})
+      m_params.emplace_back(
+        stored{base + value->offset, value->size, value->type});
+    else
+      m_params.emplace_back(param);
+}
+
+
 void pqxx::params::append(params const &value, sl) &
 {
-  this->reserve(std::size(value.m_params) + std::size(this->m_params));
-  for (auto const &param : value.m_params) m_params.emplace_back(param);
+  append_entries(value);
 }
 
 
@@ -91,10 +180,8 @@ void pqxx::params::append(bytes &&value, sl) &
 void pqxx::params::append(params &&value, sl) &
 {
   // TODO: If currently empty, just "steal" value's m_params wholesale.
-  // C++23: Use append_range()?
-  this->reserve(std::size(value.m_params) + std::size(this->m_params));
-  for (auto const &param : value.m_params) m_params.emplace_back(param);
-  value.m_params.clear();
+  append_entries(value);
+  value.clear();
 }
 
 
@@ -102,26 +189,42 @@ pqxx::internal::c_params pqxx::params::make_c_params(sl loc) const
 {
   pqxx::internal::c_params p;
   p.reserve(std::size(m_params));
+  bool typed{false};
   for (auto const &param : m_params)
     std::visit(
-      [&p, &loc](auto const &value) {
+      [this, &p, &loc, &typed](auto const &value) {
         using T = std::remove_cvref_t<decltype(value)>;
 
         if constexpr (std::is_same_v<T, std::nullptr_t>)
         {
           p.values.push_back(nullptr);
           p.lengths.push_back(0);
+          p.formats.push_back(static_cast<int>(param_format(value)));
+          p.types.push_back(0);
+        }
+        else if constexpr (std::is_same_v<T, stored>)
+        {
+          p.values.push_back(std::data(m_arena) + value.offset);
+          p.lengths.push_back(check_cast<int>(value.size, s_overflow, loc));
+          auto const fmt{(value.type == 0) ? format::text : format::binary};
+          p.formats.push_back(static_cast<int>(fmt));
+          p.types.push_back(value.type);
+          typed = typed or (value.type != 0);
         }
         else
         {
           p.values.push_back(reinterpret_cast<char const *>(std::data(value)));
           p.lengths.push_back(
             check_cast<int>(std::ssize(value), s_overflow, loc));
+          p.formats.push_back(static_cast<int>(param_format(value)));
+          p.types.push_back(0);
         }
-
-        p.formats.push_back(static_cast<int>(param_format(value)));
       },
       param);
 
+  // If all types are zero, we may as well not pass them at all.
+  if (not typed)
+    p.types.clear();
+
   return p;
 }
@@ -17,9 +17,7 @@
 #include "pqxx/dbtransaction.hxx"
 #include "pqxx/internal/gates/connection-pipeline.hxx"
 #include "pqxx/internal/gates/result-creation.hxx"
-#include "pqxx/internal/gates/result-pipeline.hxx"
 #include "pqxx/pipeline.hxx"
-#include "pqxx/separated_list.hxx"
 
 #include "pqxx/internal/header-post.hxx"
 
@@ -27,18 +25,11 @@
 using namespace std::literals::string_view_literals;
 
 
-namespace
-{
-constexpr std::string_view theSeparator{"; "sv}, theDummyValue{"1"sv},
-  theDummyQuery{"SELECT 1; "sv};
-} // namespace
-
-
 void pqxx::pipeline::init(sl loc)
 {
   m_encoding = trans().conn().get_encoding_group(loc);
   m_issuedrange = make_pair(std::end(m_queries), std::end(m_queries));
-  attach();
+  attach(loc);
 }
 
 
@@ -51,29 +42,75 @@ pqxx::pipeline::~pipeline() noexcept
   }
   catch (std::exception const &)
   {}
-  detach();
+  try
+  {
+    detach(loc);
+  }
+  catch (std::exception const &)
+  {}
 }
 
 
-void pqxx::pipeline::attach()
+void pqxx::pipeline::attach(sl loc)
 {
   if (not registered())
+  {
     register_me();
+    try
+    {
+      pqxx::internal::gate::connection_pipeline{trans().conn()}
+        .enter_pipeline_mode(loc);
+    }
+    catch (std::exception const &)
+    {
+      unregister_me();
+      throw;
+    }
+  }
 }
 
 
-void pqxx::pipeline::detach()
+void pqxx::pipeline::detach(sl loc)
 {
   if (registered())
+  {
+    // Unregister even if we fail to leave pipeline mode.  The connection is
+    // probably broken in that case.
+    try
+    {
+      finish_result(true, loc);
+      pqxx::internal::gate::connection_pipeline{trans().conn()}
+        .exit_pipeline_mode(loc);
+    }
+    catch (std::exception const &)
+    {
+      unregister_me();
+      throw;
+    }
     unregister_me();
+  }
 }
 
 
-pqxx::pipeline::query_id pqxx::pipeline::insert(std::string_view q, sl loc) &
+pqxx::pipeline::query_id pqxx::pipeline::insert(
+  std::string_view q, params const &args, format result_format, sl loc) &
 {
-  attach();
+  return insert_query(Query{q, args, false, result_format}, loc);
+}
+
+
+pqxx::pipeline::query_id pqxx::pipeline::insert(
+  prepped statement, params const &args, format result_format, sl loc) &
+{
+  return insert_query(Query{statement, args, true, result_format}, loc);
+}
+
+
+pqxx::pipeline::query_id pqxx::pipeline::insert_query(Query &&q, sl loc)
+{
+  attach(loc);
   query_id const qid{generate_id()};
-  auto const i{m_queries.insert(std::make_pair(qid, Query(q))).first};
+  auto const i{m_queries.insert(std::make_pair(qid, std::move(q))).first};
 
   if (m_issuedrange.second == std::end(m_queries))
   {
@@ -87,8 +124,7 @@ pqxx::pipeline::query_id pqxx::pipeline::insert(std::string_view q, sl loc) &
   {
     if (have_pending())
       receive_if_available(loc);
-    if (not have_pending())
-      issue(loc);
+    issue(loc);
   }
 
   return qid;
@@ -97,14 +133,11 @@ pqxx::pipeline::query_id pqxx::pipeline::insert(std::string_view q, sl loc) &
 
 void pqxx::pipeline::complete(sl loc)
 {
-  if (have_pending())
-    receive(m_issuedrange.second, loc);
   if (m_num_waiting and (m_error == qid_limit()))
-  {
     issue(loc);
-    receive(std::end(m_queries), loc);
-  }
-  detach();
+  if (have_pending())
+    receive(m_issuedrange.second, loc);
+  detach(loc);
 }
 
 
@@ -116,22 +149,24 @@ void pqxx::pipeline::flush(sl loc)
       receive(m_issuedrange.second, loc);
     m_issuedrange.first = m_issuedrange.second = std::end(m_queries);
     m_num_waiting = 0;
-    m_dummy_pending = false;
     m_queries.clear();
   }
-  detach();
+  detach(loc);
 }
 
 
 PQXX_COLD void pqxx::pipeline::cancel(sl loc)
 {
-  while (have_pending())
+  if (have_pending())
   {
     pqxx::internal::gate::connection_pipeline(trans().conn())
       .cancel_query(loc);
-    auto canceled_query{m_issuedrange.first};
-    ++m_issuedrange.first;
-    m_queries.erase(canceled_query);
+
+    // Drain the results, whether the queries got cancelled or not, so that
+    // the connection stays in a usable state.
+    auto const canceled{m_issuedrange.first};
+    receive(m_issuedrange.second, loc);
+    m_queries.erase(canceled, m_issuedrange.second);
   }
 }
 
@@ -141,9 +176,10 @@ bool pqxx::pipeline::is_finished(pipeline::query_id q) const
   if (not m_queries.contains(q))
     throw std::logic_error{
       std::format("Requested status for unknown query '{}'.", q)};
-  return (QueryMap::const_iterator(m_issuedrange.first) ==
-          std::end(m_queries)) or
-         (q < m_issuedrange.first->first and q < m_error);
+  return (q < m_error) and
+         ((QueryMap::const_iterator(m_issuedrange.first) ==
+           std::end(m_queries)) or
+          (q < m_issuedrange.first->first));
 }
 
 
@@ -174,13 +210,10 @@ int pqxx::pipeline::retain(int retain_max) &
 
 void pqxx::pipeline::resume(sl loc) &
 {
-  if (have_pending())
-    receive_if_available(loc);
-  if (not have_pending() and m_num_waiting)
-  {
+  if (m_num_waiting and (m_error == qid_limit()))
     issue(loc);
+  if (have_pending())
     receive_if_available(loc);
-  }
 }
 
 
@@ -195,172 +228,95 @@ pqxx::pipeline::query_id pqxx::pipeline::generate_id()
 
 void pqxx::pipeline::issue(sl loc)
 {
-  // Retrieve that null result for the last query, if needed.
-  obtain_result(false, loc);
-
   // Don't issue anything if we've encountered an error.
   if (m_error < qid_limit())
     return;
 
-  // Start with oldest query (lowest id) not in previous issue range.
-  auto oldest{m_issuedrange.second};
-
-  // Construct cumulative query string for entire batch.
-  auto cum{separated_list(
-    theSeparator, oldest, std::end(m_queries),
-    [](QueryMap::const_iterator i) { return *i->second.query; })};
-  auto const num_issued{
-    QueryMap::size_type(std::distance(oldest, std::end(m_queries)))};
-  bool const prepend_dummy{num_issued > 1};
-  if (prepend_dummy)
-    cum = std::format("{}{}", theDummyQuery, cum);
-
-  pqxx::internal::gate::connection_pipeline{trans().conn()}.start_exec(
-    cum.c_str());
-
-  // Since we managed to send out these queries, update state to reflect this.
-  m_dummy_pending = prepend_dummy;
-  m_issuedrange.first = oldest;
-  m_issuedrange.second = std::end(m_queries);
-  m_num_waiting -= check_cast<int>(num_issued, "pipeline issue()"sv, loc);
+  pqxx::internal::gate::connection_pipeline gate{trans().conn()};
+
+  // Send the queries one by one, starting with the oldest one that we have
+  // not issued yet.  After each, request a sync point.  That way, if one
+  // query fails, it does not stop the server from executing the next.
+  //
+  // When nothing is pending, m_issuedrange.first is the same iterator as
+  // m_issuedrange.second, so it will remain pointing at the oldest query.
+  while (m_issuedrange.second != std::end(m_queries))
+  {
+    auto const &q{m_issuedrange.second->second};
+    auto const args{q.args.make_c_params(loc)};
+    if (q.prepared)
+      gate.start_exec_prepared(*q.query, args, q.result_format, loc);
+    else
+      gate.start_exec_params(*q.query, args, q.result_format, loc);
+    gate.pipeline_sync(loc);
+
+    // Since we managed to send out this query, update state to reflect this.
+    ++m_issuedrange.second;
+    --m_num_waiting;
+  }
+  gate.flush_output(loc);
 }
 
 
 PQXX_COLD void pqxx::pipeline::internal_error(std::string const &err, sl loc)
 {
-  set_error_at(0);
+  m_error = 0;
   throw pqxx::internal_error{err, loc};
 }
 
 
-bool pqxx::pipeline::obtain_result(bool expect_none, sl loc)
+bool pqxx::pipeline::finish_result(bool block, sl loc)
 {
   pqxx::internal::gate::connection_pipeline gate{trans().conn()};
-  std::shared_ptr<pqxx::internal::pq::PGresult> const r{
-    gate.get_result(), pqxx::internal::clear_result};
-  if (not r)
+  if (m_null_pending)
   {
-    if (have_pending() and not expect_none) [[unlikely]]
-    {
-      set_error_at(m_issuedrange.first->first);
-      m_issuedrange.second = m_issuedrange.first;
-    }
-    return false;
+    if (not block and gate.is_busy())
+      return false;
+    std::shared_ptr<pqxx::internal::pq::PGresult> const r{
+      gate.get_result(), pqxx::internal::clear_result};
+    if (r) [[unlikely]]
+      internal_error("Multiple results for one query.", loc);
+    m_null_pending = false;
   }
-
-  pqxx::internal::gate::connection_pipeline const pgate{trans().conn()};
-  auto handler{pgate.get_notice_waiters()};
-  result const res{pqxx::internal::gate::result_creation::create(
-    r, std::begin(m_queries)->second.query, handler, m_encoding)};
-
-  if (not have_pending()) [[unlikely]]
+  if (m_sync_pending)
   {
-    set_error_at(std::begin(m_queries)->first);
-    throw std::logic_error{
-      "Got more results from pipeline than there were queries."};
+    if (not block and gate.is_busy())
+      return false;
+    gate.consume_pipeline_sync(loc);
+    m_sync_pending = false;
   }
-
-  // Must be the result for the oldest pending query.
-  if (not std::empty(m_issuedrange.first->second.res)) [[unlikely]]
-    internal_error("Multiple results for one query.", loc);
-
-  m_issuedrange.first->second.res = res;
-  ++m_issuedrange.first;
-
   return true;
 }
 
 
-void pqxx::pipeline::obtain_dummy(sl loc)
+bool pqxx::pipeline::obtain_result(bool block, sl loc)
 {
-  conversion_context const c{{}, loc};
-
-  // Allocate once, re-use across invocations.
-  static auto const text{
-    std::make_shared<std::string>("[DUMMY PIPELINE QUERY]")};
+  if (not finish_result(block, loc) or not have_pending())
+    return false;
 
   pqxx::internal::gate::connection_pipeline gate{trans().conn()};
-  std::shared_ptr<pqxx::internal::pq::PGresult> const r{
-    gate.get_result(), pqxx::internal::clear_result};
-  m_dummy_pending = false;
+  if (not block and gate.is_busy())
+    return false;
 
+  std::shared_ptr<pqxx::internal::pq::PGresult> const r{
+    gate.get_result(), pqxx::internal::result_deleter{}};
   if (not r) [[unlikely]]
+  {
+    if (not trans().conn().is_open())
+      throw broken_connection{loc};
     internal_error(
       "Pipeline got no result from backend when it expected one.", loc);
-
-  pqxx::internal::gate::connection_pipeline const pgate{trans().conn()};
-  auto handler{pgate.get_notice_waiters()};
-  result const R{pqxx::internal::gate::result_creation::create(
-    r, text, handler, m_encoding)};
-
-  bool OK{false};
-  try
-  {
-    pqxx::internal::gate::result_creation{R}.check_status(loc);
-    OK = true;
   }
-  catch (sql_error const &)
-  {}
-  if (OK) [[likely]]
-  {
-    if (std::size(R) > 1) [[unlikely]]
-      internal_error("Unexpected result for dummy query in pipeline.", loc);
 
-    if (R.at(0).at(0).view() != theDummyValue) [[unlikely]]
-      internal_error(
-        "Dummy query in pipeline returned unexpected value.", loc);
-    return;
-  }
+  auto handler{gate.get_notice_waiters()};
+  auto &holder{m_issuedrange.first->second};
+  holder.res = pqxx::internal::gate::result_creation::create(
+    r, holder.query, handler, m_encoding);
+  ++m_issuedrange.first;
+  m_null_pending = true;
+  m_sync_pending = true;
 
-  // TODO: Can we actually re-issue statements after a failure?
-  /* Execution of this batch failed.
-   *
-   * When we send multiple statements in one go, the backend treats them as a
-   * single transaction.  So the entire batch was effectively rolled back.
-   *
-   * Since none of the queries in the batch were actually executed, we can
-   * afford to replay them one by one until we find the exact query that
-   * caused the error.  This gives us not only a more specific error message
-   * to report, but also tells us which query to report it for.
-   */
-  // First, give the whole batch the same syntax error message, in case all
-  // else is going to fail.
-  for (auto i{m_issuedrange.first}; i != m_issuedrange.second; ++i)
-    i->second.res = R;
-
-  // Remember where the end of this batch was
-  auto const stop{m_issuedrange.second};
-
-  // Retrieve that null result for the last query, if needed
-  obtain_result(true, loc);
-
-  // Reset internal state to forget botched batch attempt
-  m_num_waiting += check_cast<int>(
-    std::distance(m_issuedrange.first, stop), "pipeline obtain_dummy()"sv,
-    loc);
-  m_issuedrange.second = m_issuedrange.first;
-
-  // Issue queries in failed batch one at a time.
-  unregister_me();
-  try
-  {
-    do {
-      m_num_waiting--;
-      auto const query{*m_issuedrange.first->second.query};
-      auto &holder{m_issuedrange.first->second};
-      holder.res = trans().exec(query, loc);
-      pqxx::internal::gate::result_creation{holder.res}.check_status(loc);
-      ++m_issuedrange.first;
-    } while (m_issuedrange.first != stop);
-  }
-  catch (std::exception const &)
-  {
-    auto const thud{m_issuedrange.first->first};
-    ++m_issuedrange.first;
-    m_issuedrange.second = m_issuedrange.first;
-    auto q{m_issuedrange.first};
-    set_error_at((q == std::end(m_queries)) ? thud + 1 : q->first);
-  }
+  return true;
 }
 
 
@@ -378,79 +334,45 @@ pqxx::pipeline::retrieve(pipeline::QueryMap::iterator q, sl loc)
   if (
     m_issuedrange.second != std::end(m_queries) and
     (q->first >= m_issuedrange.second->first))
-  {
-    if (have_pending())
-      receive(m_issuedrange.second, loc);
-    if (m_error == qid_limit())
-      issue(loc);
-  }
+    issue(loc);
 
   // If result not in yet, get it; else get at least whatever's convenient.
   if (have_pending())
   {
     if (q->first >= m_issuedrange.first->first)
-    {
-      auto suc{q};
-      ++suc;
-      receive(suc, loc);
-    }
+      receive(std::next(q), loc);
     else
-    {
       receive_if_available(loc);
-    }
   }
 
   if (q->first >= m_error)
     throw std::runtime_error{
       "Could not complete query in pipeline due to error in earlier query."};
 
-  // Don't leave the backend idle if there are queries waiting to be issued.
-  if (m_num_waiting and not have_pending() and (m_error == qid_limit()))
-    issue(loc);
-
   // We do a strange dance with the first argument, just so we get the "move"
   // version of std::make_pair().
-  auto p{
-    std::make_pair(query_id{q->first}, std::move(std::move(q->second.res)))};
+  auto p{std::make_pair(query_id{q->first}, std::move(q->second.res))};
   m_queries.erase(q);
   pqxx::internal::gate::result_creation{p.second}.check_status(loc);
   return p;
 }
 
 
-void pqxx::pipeline::get_further_available_results(sl loc)
-{
-  pqxx::internal::gate::connection_pipeline gate{trans().conn()};
-  while (not gate.is_busy() and obtain_result(false, loc))
-    if (not gate.consume_input())
-      throw broken_connection{loc};
-}
-
-
 void pqxx::pipeline::receive_if_available(sl loc)
 {
   pqxx::internal::gate::connection_pipeline gate{trans().conn()};
   if (not gate.consume_input())
     throw broken_connection{loc};
-  if (gate.is_busy())
-    return;
-
-  if (m_dummy_pending)
-    obtain_dummy(loc);
-  if (have_pending())
-    get_further_available_results(loc);
+  while (obtain_result(false, loc));
 }
 
 
 void pqxx::pipeline::receive(pipeline::QueryMap::const_iterator stop, sl loc)
 {
-  if (m_dummy_pending)
-    obtain_dummy(loc);
-
-  while (obtain_result(false, loc) and
-         QueryMap::const_iterator{m_issuedrange.first} != stop);
+  while (have_pending() and
+         QueryMap::const_iterator{m_issuedrange.first} != stop)
+    obtain_result(true, loc);
 
   // Also haul in any remaining "targets of opportunity".
-  if (QueryMap::const_iterator{m_issuedrange.first} == stop)
-    get_further_available_results(loc);
+  receive_if_available(loc);
 }
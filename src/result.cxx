@@ -10,6 +10,7 @@
  */
 #include "pqxx-source.hxx"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <stdexcept>
@@ -94,10 +95,68 @@ pqxx::result::result(
         m_data{rhs},
         m_query{query},
         m_notice_waiters{notice_waiters},
-        m_encoding(enc)
+        m_encoding(enc),
+        m_binary{rhs and (PQbinaryTuples(real_res(rhs.get())) != 0)}
 {}
 
 
+pqxx::internal::column_index::column_index(pq::PGresult const *res) :
+        m_columns{PQnfields(real_res(res))}
+{
+  m_index.reserve(static_cast<std::size_t>(m_columns));
+  // If there are multiple columns of the same name, emplace() keeps the
+  // first, just like PQfnumber() would find.
+  for (row_size_type col{0}; col < m_columns; ++col)
+    m_index.emplace(PQfname(real_res(res), col), col);
+}
+
+
+bool pqxx::internal::column_index::matches(
+  pq::PGresult const *res) const noexcept
+{
+  if (PQnfields(real_res(res)) != m_columns)
+    return false;
+  std::size_t distinct{0};
+  for (row_size_type col{0}; col < m_columns; ++col)
+  {
+    char const *const name{PQfname(real_res(res), col)};
+    auto const found{m_index.find(name)};
+    if (found == std::end(m_index))
+      return false;
+    if (found->second == col)
+      ++distinct;
+    else if (
+      (found->second > col) or
+      (std::strcmp(PQfname(real_res(res), found->second), name) != 0))
+      return false;
+  }
+  // Every name in the index must still be there.
+  return distinct == std::size(m_index);
+}
+
+
+bool pqxx::internal::column_index::can_find(std::string_view name) noexcept
+{
+  // This mirrors PQfnumber(): if the name contains any character that it
+  // would case-fold, or a double quote, it goes through a slower path.  We
+  // also leave non-ASCII names to libpq, since its case folding of those
+  // depends on the locale.
+  return not std::empty(name) and
+         std::ranges::none_of(name, [](char c) {
+           return (c == '"') or ((c >= 'A') and (c <= 'Z')) or
+                  (static_cast<unsigned char>(c) >= 0x80);
+         });
+}
+
+
+pqxx::row_size_type
+pqxx::internal::column_index::find(std::string_view name) const noexcept
+{
+  auto const found{m_index.find(name)};
+  return (found == std::end(m_index)) ? -1 : found->second;
+}
+
+
 pqxx::result::const_reverse_iterator pqxx::result::rbegin() const noexcept
 {
   return const_reverse_iterator{end()};
@@ -357,10 +416,16 @@ std::string pqxx::result::status_error(sl loc) const
     break;
 
 #if defined(LIBPQ_HAS_PIPELINING)
-  case PGRES_PIPELINE_SYNC:    // Pipeline mode synchronisation point.
+  case PGRES_PIPELINE_SYNC: // Pipeline mode synchronisation point.
+    break;
+
   case PGRES_PIPELINE_ABORTED: // Previous command in pipeline failed.
-    throw feature_not_supported{
-      "Not supported yet: libpq pipelines.", "", "", loc};
+    // There's no SQLSTATE for this, so throw_sql_error() would take it for a
+    // broken connection.
+    throw sql_error{
+      "Statement was not executed because an earlier statement in the "
+      "pipeline failed.",
+      query(), "", loc};
 #endif
 
   case PGRES_BAD_RESPONSE: // The server's response was not understood.
@@ -369,9 +434,11 @@ std::string pqxx::result::status_error(sl loc) const
     [[unlikely]] err = PQresultErrorMessage(real_res(m_data.get()));
     break;
 
-  case PGRES_SINGLE_TUPLE:
-    throw feature_not_supported{
-      "Not supported: single-row mode.", "", "", loc};
+  case PGRES_SINGLE_TUPLE: // One row, in single-row mode.
+#if defined(LIBPQ_HAS_CHUNK_MODE)
+  case PGRES_TUPLES_CHUNK: // Some rows, in chunked rows mode.
+#endif
+    break;
 
   default:
     throw internal_error{
@@ -459,9 +526,71 @@ pqxx::oid pqxx::result::column_type(row::size_type col_num, sl loc) const
 }
 
 
+pqxx::format
+pqxx::result::binary_column_format(row::size_type col_num) const noexcept
+{
+  return static_cast<format>(PQfformat(real_res(m_data.get()), col_num));
+}
+
+
+int pqxx::result::param_count() const noexcept
+{
+  return PQnparams(real_res(m_data.get()));
+}
+
+
+pqxx::oid pqxx::result::param_type(int param_num, sl loc) const
+{
+  oid const t{PQparamtype(real_res(m_data.get()), param_num)};
+  if (t == oid_none)
+    throw argument_error{
+      std::format(
+        "Attempt to retrieve type of nonexistent statement parameter {}.",
+        param_num),
+      loc};
+  return t;
+}
+
+
+pqxx::row_size_type pqxx::result::find_column(zview col_name) const
+{
+  // All copies of this result share the same deleter, so that's where we keep
+  // the column index.
+  auto *const shared{std::get_deleter<internal::result_deleter>(m_data)};
+  if ((shared == nullptr) or not internal::column_index::can_find(col_name))
+    return PQfnumber(real_res(m_data.get()), col_name.c_str());
+
+  if (not shared->preset_columns)
+  {
+    // Building an index costs more than a single lookup.  But if we're
+    // looking up a second column, or the same column in a second row,
+    // chances are there will be many more.
+    //
+    // Other copies of this result may be doing the same thing in other
+    // threads, so count atomically and build the index only once.
+    if (shared->unindexed_lookups.fetch_add(1, std::memory_order_relaxed) == 0)
+      return PQfnumber(real_res(m_data.get()), col_name.c_str());
+    std::call_once(shared->indexing, [this, shared] {
+      shared->columns =
+        std::make_shared<internal::column_index const>(m_data.get());
+    });
+  }
+  else if (shared->verify_columns)
+  {
+    // The index came from the statement.  Make sure it still fits.
+    std::call_once(shared->indexing, [this, shared] {
+      if (not shared->columns->matches(m_data.get()))
+        shared->columns =
+          std::make_shared<internal::column_index const>(m_data.get());
+    });
+  }
+  return shared->columns->find(col_name);
+}
+
+
 pqxx::row::size_type pqxx::result::column_number(zview col_name, sl loc) const
 {
-  auto const n{PQfnumber(real_res(m_data.get()), col_name.c_str())};
+  auto const n{find_column(col_name)};
   if (n == -1)
     throw argument_error{
       std::format("Unknown column name: '{}'.", to_string(col_name)), loc};
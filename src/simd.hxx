@@ -0,0 +1,137 @@
+/** SIMD helpers for the libpqxx kernels.
+ *
+ * This is a private header.  Include it only from the library's own source
+ * files, never from a public header: it pulls in compiler intrinsics.
+ *
+ * Copyright (c) 2000-2026, Jeroen T. Vermeulen.
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this
+ * mistake, or contact the author.
+ */
+#ifndef PQXX_SIMD_HXX
+#define PQXX_SIMD_HXX
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// We only use instruction sets that the compiler targets anyway: SSE2 is part
+// of the x86-64 baseline, and NEON is part of the AArch64 baseline.  So there
+// is no need for runtime detection.
+#if defined(__SSE2__) || defined(_M_X64)
+#  include <emmintrin.h>
+#  define PQXX_SIMD_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#  include <arm_neon.h>
+#  define PQXX_SIMD_NEON
+#endif
+
+
+#if defined(PQXX_SIMD_SSE2) || defined(PQXX_SIMD_NEON)
+namespace pqxx::internal
+{
+/// Number of bytes we scan at a time using SIMD instructions.
+inline constexpr std::size_t simd_width{16};
+
+
+/// Bit masks describing a block of @ref simd_width bytes of text.
+/** Each byte in the block maps to @ref simd_bits bits in each mask, in order.
+ * Use @ref simd_first to find the first byte whose bits are set.
+ */
+struct simd_masks final
+{
+  /// Bytes that match any of the characters we're looking for.
+  std::uint64_t hits;
+  /// Bytes outside the ASCII range, i.e. with their high bit set.
+  std::uint64_t high;
+};
+
+
+/// Maximum number of characters in a @ref simd_needles.
+inline constexpr std::size_t simd_max_needles{8};
+
+
+#  if defined(PQXX_SIMD_SSE2)
+/// Number of bits per byte in a @ref simd_masks mask.
+inline constexpr int simd_bits{1};
+
+/// One 16-byte vector register.
+using simd_vector = __m128i;
+
+/// Fill a vector with copies of `c`.
+inline simd_vector simd_splat(char c) noexcept { return _mm_set1_epi8(c); }
+
+/// Compare a block of text against a set of characters, which we splatted.
+template<std::size_t N>
+inline simd_masks
+simd_scan(char const *block, std::array<simd_vector, N> const &needles,
+          std::size_t count) noexcept
+{
+  __m128i const chunk{
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    _mm_loadu_si128(reinterpret_cast<__m128i const *>(block))};
+  __m128i matches{_mm_setzero_si128()};
+  for (std::size_t i{0}; i < count; ++i)
+    matches = _mm_or_si128(matches, _mm_cmpeq_epi8(chunk, needles[i]));
+  return {
+    static_cast<std::uint64_t>(
+      static_cast<unsigned>(_mm_movemask_epi8(matches))),
+    static_cast<std::uint64_t>(
+      static_cast<unsigned>(_mm_movemask_epi8(chunk)))};
+}
+#  elif defined(PQXX_SIMD_NEON)
+/// Number of bits per byte in a @ref simd_masks mask.
+/** NEON has no "movemask" instruction.  We narrow each byte of a comparison
+ * result down to 4 bits instead, which gives us a 64-bit mask.
+ */
+inline constexpr int simd_bits{4};
+
+/// One 16-byte vector register.
+using simd_vector = uint8x16_t;
+
+/// Fill a vector with copies of `c`.
+inline simd_vector simd_splat(char c) noexcept
+{
+  return vdupq_n_u8(static_cast<std::uint8_t>(c));
+}
+
+/// Turn a NEON comparison result into a mask of 4 bits per byte.
+inline std::uint64_t simd_narrow(uint8x16_t bytes) noexcept
+{
+  return vget_lane_u64(
+    vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(bytes), 4)), 0);
+}
+
+/// Compare a block of text against a set of characters, which we splatted.
+template<std::size_t N>
+inline simd_masks
+simd_scan(char const *block, std::array<simd_vector, N> const &needles,
+          std::size_t count) noexcept
+{
+  uint8x16_t const chunk{
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    vld1q_u8(reinterpret_cast<std::uint8_t const *>(block))};
+  uint8x16_t matches{vdupq_n_u8(0)};
+  for (std::size_t i{0}; i < count; ++i)
+    matches = vorrq_u8(matches, vceqq_u8(chunk, needles[i]));
+  return {
+    simd_narrow(matches), simd_narrow(vcgeq_u8(chunk, vdupq_n_u8(0x80)))};
+}
+#  endif
+
+
+/// Offset of the first byte in a block whose bits are set in `mask`.
+/** Returns @ref simd_width if there is no such byte.
+ */
+inline std::size_t simd_first(std::uint64_t mask) noexcept
+{
+  if (mask == 0)
+    return simd_width;
+  return static_cast<std::size_t>(std::countr_zero(mask) / simd_bits);
+}
+} // namespace pqxx::internal
+#endif
+#endif
@@ -0,0 +1,195 @@
+/** Implementation of the pqxx::internal::statement_batch class.
+ *
+ * Copyright (c) 2000-2026, Jeroen T. Vermeulen.
+ *
+ * See COPYING for copyright license.  If you did not receive a file called
+ * COPYING with this source code, please notify the distributor of this
+ * mistake, or contact the author.
+ */
+#include "pqxx-source.hxx"
+
+#include <optional>
+
+#include "pqxx/internal/header-pre.hxx"
+
+extern "C"
+{
+#include <libpq-fe.h>
+}
+
+#include "pqxx/internal/gates/connection-statement_batch.hxx"
+#include "pqxx/internal/statement_batch.hxx"
+#include "pqxx/transaction_base.hxx"
+
+#include "pqxx/internal/header-post.hxx"
+
+
+using namespace std::literals;
+
+
+namespace
+{
+/// Maximum number of executions to keep in flight.
+/** Once we reach this many, we receive results until we're down to half.
+ * That way we don't pile up an unlimited number of queued executions and
+ * results in libpq's buffers.  It does mean that we wait for the server at
+ * that point, but by then it has plenty of work queued up.
+ */
+constexpr std::size_t max_in_flight{512};
+} // namespace
+
+
+pqxx::internal::statement_batch::statement_batch(
+  transaction_base &tx, std::string_view statement, bool prepared,
+  bool keep_results, sl loc) :
+        transaction_focus{tx, "execute_many"sv},
+        m_prepared{prepared},
+        m_keep_results{keep_results}
+{
+  register_me();
+  gate::connection_statement_batch gate{trans().conn()};
+  try
+  {
+    m_statement = gate.intern_query(statement);
+    // In blocking mode, sending could wait for the server to read our
+    // output, while the server waits for us to read its results.  With
+    // large parameters and large results, that would deadlock.  In
+    // nonblocking mode, flush_output() reads input while it sends.
+    gate.set_nonblocking(true, loc);
+    gate.enter_pipeline_mode(loc);
+  }
+  catch (std::exception const &)
+  {
+    leave_nonblocking_mode(loc);
+    unregister_me();
+    throw;
+  }
+}
+
+
+pqxx::internal::statement_batch::~statement_batch() noexcept
+{
+  close(sl::current());
+}
+
+
+void pqxx::internal::statement_batch::reserve(std::size_t n)
+{
+  if (m_keep_results)
+    m_results.reserve(n);
+  else
+    m_counts.reserve(n);
+}
+
+
+void pqxx::internal::statement_batch::send(params const &args, sl loc)
+{
+  gate::connection_statement_batch gate{trans().conn()};
+  auto const c_args{args.make_c_params(loc)};
+  if (m_prepared)
+    gate.start_exec_prepared(*m_statement, c_args, loc);
+  else
+    gate.start_exec_params(*m_statement, c_args, loc);
+  gate.pipeline_sync(loc);
+  ++m_in_flight;
+
+  if (m_in_flight >= max_in_flight) [[unlikely]]
+  {
+    gate.flush_output(loc);
+    while (m_in_flight > max_in_flight / 2) receive(loc);
+  }
+}
+
+
+void pqxx::internal::statement_batch::receive(sl loc)
+{
+  gate::connection_statement_batch gate{trans().conn()};
+  std::optional<result> res;
+  try
+  {
+    // If the result is an error, this throws the exception for it.
+    res = gate.make_result(gate.get_result(), m_statement, loc);
+  }
+  catch (std::exception const &)
+  {
+    if (not trans().conn().is_open())
+      throw;
+    if (not m_error)
+      m_error = std::current_exception();
+  }
+
+  // Each execution's result is followed by a null pointer, and a sync point.
+  while (auto *const extra{gate.get_result()})
+    PQclear(static_cast<::PGresult *>(extra));
+  gate.consume_pipeline_sync(loc);
+  --m_in_flight;
+
+  if (res)
+  {
+    if (m_keep_results)
+      m_results.push_back(std::move(*res));
+    else
+      m_counts.push_back(res->affected_rows());
+  }
+}
+
+
+void pqxx::internal::statement_batch::finish(sl loc)
+{
+  gate::connection_statement_batch gate{trans().conn()};
+  if (m_in_flight > 0)
+    gate.flush_output(loc);
+  while (m_in_flight > 0) receive(loc);
+  m_done = true;
+  try
+  {
+    gate.exit_pipeline_mode(loc);
+  }
+  catch (std::exception const &)
+  {
+    leave_nonblocking_mode(loc);
+    unregister_me();
+    throw;
+  }
+  leave_nonblocking_mode(loc);
+  unregister_me();
+  if (m_error)
+    std::rethrow_exception(m_error);
+}
+
+
+void pqxx::internal::statement_batch::close(sl loc) noexcept
+{
+  if (not m_done)
+  {
+    m_done = true;
+    try
+    {
+      gate::connection_statement_batch gate{trans().conn()};
+      if (m_in_flight > 0)
+        gate.flush_output(loc);
+      while (m_in_flight > 0) receive(loc);
+      gate.exit_pipeline_mode(loc);
+    }
+    catch (std::exception const &)
+    {
+      // The connection is probably broken.  Nothing more we can do.
+    }
+    leave_nonblocking_mode(loc);
+    unregister_me();
+  }
+}
+
+
+void pqxx::internal::statement_batch::leave_nonblocking_mode(sl loc) noexcept
+{
+  try
+  {
+    gate::connection_statement_batch{trans().conn()}.set_nonblocking(
+      false, loc);
+  }
+  catch (std::exception const &)
+  {
+    // The connection is probably broken.  Nothing more we can do.
+  }
+}
@@ -24,6 +24,8 @@
 #include "pqxx/except.hxx"
 #include "pqxx/strconv.hxx"
 
+#include "pqxx/internal/float.hxx"
+
 #include "pqxx/internal/header-post.hxx"
 
 
@@ -115,6 +117,37 @@ template<typename T>
 concept arith = pqxx::internal::integer<T> or std::floating_point<T>;
 
 
+/// Floating-point types for which we have our own fast conversions.
+template<typename T>
+concept fast_float = std::same_as<T, float> or std::same_as<T, double>;
+
+
+template<fast_float T>
+PQXX_COLD T parse_long_float(char const *begin, char const *end);
+
+
+/// Parse a number, like `std::from_chars`.
+template<arith T>
+inline std::from_chars_result
+parse_number(char const *begin, char const *end, T &out)
+{
+  if constexpr (fast_float<T>)
+  {
+    auto const res{pqxx::internal::parse_float(begin, end, out)};
+    if (res.ec == std::errc::not_supported) [[unlikely]]
+    {
+      out = parse_long_float<T>(begin, res.ptr);
+      return {res.ptr, std::errc{}};
+    }
+    return res;
+  }
+  else
+  {
+    return std::from_chars(begin, end, out);
+  }
+}
+
+
 /// Call to_chars, report errors as exceptions, add zero, return pointer.
 template<arith T>
 inline char *wrap_to_chars(std::span<char> buf, T const &value, pqxx::sl loc)
@@ -176,7 +209,7 @@ inline TYPE from_string_arithmetic(std::string_view in, pqxx::ctx c)
   while (here < end and (*here == ' ' or *here == '\t')) ++here;
 
   TYPE out{};
-  auto const res{std::from_chars(here, end, out)};
+  auto const res{parse_number(here, end, out)};
   if (res.ec == std::errc() and res.ptr == end) [[likely]]
     return out;
 
@@ -317,6 +350,26 @@ to_dumb_stringstream(dumb_stringstream<F> &s, F value)
   return s.str();
 }
 #endif
+
+
+/// Parse a number that has too many digits for our fast parser.
+/** The text must be a valid number, as accepted by
+ * @ref pqxx::internal::parse_float.
+ */
+template<fast_float T>
+PQXX_COLD T parse_long_float(char const *begin, char const *end)
+{
+  T out{};
+#if defined(PQXX_HAVE_CHARCONV_FLOAT)
+  std::from_chars(begin, end, out);
+#else
+  thread_local dumb_stringstream<T> S;
+  S.seekg(0);
+  S.clear();
+  from_dumb_stringstream(S, out, std::string_view{begin, end});
+#endif
+  return out;
+}
 } // namespace
 
 
@@ -326,7 +379,11 @@ namespace pqxx::internal
 template<std::floating_point T>
 std::string to_string_float(T value, [[maybe_unused]] ctx c)
 {
-#if defined(PQXX_HAVE_CHARCONV_FLOAT)
+#if !defined(PQXX_HAVE_CHARCONV_FLOAT)
+  if constexpr (not fast_float<T>)
+    return std::format("{}", value);
+  else
+#endif
   {
     static constexpr auto space{pqxx::size_buffer(value)};
     std::string buf;
@@ -335,20 +392,18 @@ std::string to_string_float(T value, [[maybe_unused]] ctx c)
     buf.resize(static_cast<std::size_t>(std::size(view)));
     return buf;
   }
-#else
-  return std::format("{}", value);
-#endif
 }
 
 
 template<std::floating_point T>
 T float_string_traits<T>::from_string(std::string_view text, pqxx::ctx c)
 {
-#if defined(PQXX_HAVE_CHARCONV_FLOAT)
-  return from_string_arithmetic<T>(text, c);
-#else
-  return from_string_awful_float<T>(text, c);
+#if !defined(PQXX_HAVE_CHARCONV_FLOAT)
+  if constexpr (not fast_float<T>)
+    return from_string_awful_float<T>(text, c);
+  else
 #endif
+    return from_string_arithmetic<T>(text, c);
 }
 
 
@@ -357,14 +412,23 @@ std::string_view
 float_string_traits<T>::to_buf(std::span<char> buf, T const &value, ctx c)
 {
   auto const begin{std::data(buf)};
-#if defined(PQXX_HAVE_CHARCONV_FLOAT)
+  if constexpr (fast_float<T>)
+  {
+    auto const ptr{pqxx::internal::format_float(buf, value)};
+    if (ptr == nullptr) [[unlikely]]
+      throw conversion_overrun{
+        std::format(
+          "Could not convert {} to string: buffer too small ({} bytes).",
+          name_type<T>(), std::size(buf)),
+        c.loc};
+    return {begin, static_cast<std::size_t>(ptr - begin)};
+  }
+  else
   {
-    // Definitely prefer to let the standard library handle this!
+#if defined(PQXX_HAVE_CHARCONV_FLOAT)
     auto const ptr{wrap_to_chars(buf, value, c.loc)};
     return {begin, std::size_t(ptr - begin)};
-  }
 #else
-  {
     auto const end{begin + std::size(buf)};
     auto const res{std::format_to_n(begin, end - begin, "{}", value)};
     if (std::cmp_greater_equal(res.size, end - begin))
@@ -373,8 +437,8 @@ float_string_traits<T>::to_buf(std::span<char> buf, T const &value, ctx c)
           "Buffer too small for converting {} to string.", name_type<T>()),
         c.loc};
     return {begin, static_cast<std::size_t>(res.size)};
-  }
 #endif
+  }
 }
 
 
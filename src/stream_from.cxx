@@ -30,6 +30,8 @@ pqxx::internal::char_finder_func *get_finder(pqxx::transaction_base const &tx)
 {
   pqxx::sl const loc{pqxx::sl::current()};
   auto const group{tx.conn().get_encoding_group(loc)};
+  if (group == pqxx::encoding_group::ascii_safe)
+    return pqxx::internal::get_tab_or_backslash_finder();
   return pqxx::internal::get_char_finder<'\t', '\\'>(group, loc);
 }
 
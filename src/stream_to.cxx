@@ -10,6 +10,8 @@
  */
 #include "pqxx-source.hxx"
 
+#include <exception>
+
 #include "pqxx/internal/header-pre.hxx"
 
 #include "pqxx/internal/gates/connection-stream_to.hxx"
@@ -25,17 +27,28 @@ using namespace std::literals;
 
 void begin_copy(
   pqxx::transaction_base &tx, std::string_view table, std::string_view columns,
-  pqxx::sl loc)
+  pqxx::format fmt, pqxx::sl loc)
 {
+  auto const options{
+    (fmt == pqxx::format::binary) ? " (FORMAT binary)"sv : ""sv};
   pqxx::result res;
   if (std::empty(columns))
-    res = tx.exec(std::format("COPY {} FROM STDIN", table));
+    res = tx.exec(std::format("COPY {} FROM STDIN{}", table, options));
   else
-    res = tx.exec(std::format("COPY {} ({}) FROM STDIN", table, columns));
+    res = tx.exec(
+      std::format("COPY {} ({}) FROM STDIN{}", table, columns, options));
   res.no_rows(loc);
 }
 
 
+/// Header for binary `COPY` data: signature, flags, and extension length.
+constexpr std::string_view binary_copy_header{
+  "PGCOPY\n\377\r\n\0"
+  "\0\0\0\0"
+  "\0\0\0\0",
+  19};
+
+
 /// Return the escape character for escaping the given special character.
 char escape_char(char special, pqxx::sl loc)
 {
@@ -74,22 +87,57 @@ pqxx::stream_to::~stream_to() noexcept
 
 void pqxx::stream_to::write_raw_line(std::string_view text, sl loc)
 {
-  internal::gate::connection_stream_to{trans().conn()}.write_copy_line(
-    text, loc);
+  if (m_format == format::binary) [[unlikely]]
+    throw usage_error{
+      "Can't write text-format COPY lines to a binary stream_to.", loc};
+  m_buffer.append(text);
+  m_buffer.push_back('\n');
+  end_row(loc);
 }
 
 
-void pqxx::stream_to::write_buffer(sl loc)
+void pqxx::stream_to::write_buffer(std::size_t row_start, sl loc)
 {
-  if (not std::empty(m_buffer))
+  if (m_format == format::binary)
+  {
+    // Binary rows have no terminator.
+  }
+  else if (std::size(m_buffer) > row_start)
   {
     // In append_to_buffer() we write a tab after each field.  We only want a
-    // tab _between_ fields.  Remove that last one.
+    // tab _between_ fields.  Replace that last one with the line terminator.
     assert(m_buffer[std::size(m_buffer) - 1] == '\t');
-    m_buffer.resize(std::size(m_buffer) - 1);
+    m_buffer[std::size(m_buffer) - 1] = '\n';
+  }
+  else
+  {
+    m_buffer.push_back('\n');
+  }
+  end_row(loc);
+}
+
+
+void pqxx::stream_to::flush(sl loc)
+{
+  if (not std::empty(m_buffer))
+  {
+    internal::gate::connection_stream_to{trans().conn()}.write_copy_data(
+      m_buffer, loc);
+    m_buffer.clear();
   }
-  write_raw_line(m_buffer, loc);
-  m_buffer.clear();
+  m_rows = 0;
+}
+
+
+void pqxx::stream_to::set_batch_limits(
+  std::size_t max_bytes, std::size_t max_rows, sl loc)
+{
+  m_batch_bytes = max_bytes;
+  m_batch_rows = max_rows;
+  if (
+    (m_rows > 0) and
+    ((std::size(m_buffer) >= m_batch_bytes) or (m_rows >= m_batch_rows)))
+    flush(loc);
 }
 
 
@@ -108,14 +156,17 @@ pqxx::stream_to &pqxx::stream_to::operator<<(stream_from &tr)
 
 pqxx::stream_to::stream_to(
   transaction_base &tx, std::string_view path, std::string_view columns,
-  sl loc) :
+  format fmt, sl loc) :
         transaction_focus{tx, s_classname, path},
         m_finder{pqxx::internal::get_char_finder<
           '\b', '\f', '\n', '\r', '\t', '\v', '\\'>(
           tx.conn().get_encoding_group(loc), loc)},
-        m_created_loc{loc}
+        m_created_loc{loc},
+        m_format{fmt}
 {
-  begin_copy(tx, path, columns, loc);
+  begin_copy(tx, path, columns, fmt, loc);
+  if (fmt == format::binary)
+    m_buffer.append(binary_copy_header);
   register_me();
 }
 
@@ -124,9 +175,26 @@ void pqxx::stream_to::complete(sl loc)
 {
   if (!m_finished)
   {
+    // Send whatever rows we still have buffered.  Even if that fails, we
+    // still need to end the COPY.
+    std::exception_ptr flush_error;
+    try
+    {
+      // Binary data ends in a "row" with -1 fields.
+      if (m_format == format::binary)
+        internal::append_big_endian(m_buffer, std::int16_t{-1});
+      flush(loc);
+    }
+    catch (std::exception const &)
+    {
+      flush_error = std::current_exception();
+      m_buffer.clear();
+    }
     m_finished = true;
     unregister_me();
     internal::gate::connection_stream_to{trans().conn()}.end_copy_write(loc);
+    if (flush_error)
+      std::rethrow_exception(flush_error);
   }
 }
 
@@ -16,6 +16,7 @@
 #include "pqxx/internal/header-pre.hxx"
 
 #include "pqxx/connection.hxx"
+#include "pqxx/internal/gates/transaction-subtransaction.hxx"
 #include "pqxx/subtransaction.hxx"
 
 #include "pqxx/internal/header-post.hxx"
@@ -26,16 +27,27 @@ using namespace std::literals;
 
 pqxx::subtransaction::subtransaction(
   dbtransaction &t, std::string_view tname, sl loc) :
+        subtransaction(t, tname, begin_policy::immediate, loc)
+{}
+
+
+pqxx::subtransaction::subtransaction(
+  dbtransaction &t, std::string_view tname, begin_policy policy, sl loc) :
         transaction_focus{t, "subtransaction"sv, t.conn().adorn_name(tname)},
         // We can't initialise the rollback command here, because we don't yet
         // have a full object to implement quoted_name().
         dbtransaction{t.conn(), tname, std::shared_ptr<std::string>{}, loc}
 {
+  // A savepoint needs the parent to have started on the server.
+  internal::gate::transaction_subtransaction{t}.start(loc);
+  auto const quoted{quoted_name()};
   set_rollback_cmd(std::make_shared<std::string>(
-    std::format("ROLLBACK TO SAVEPOINT {}", quoted_name())));
-  direct_exec(
-    std::make_shared<std::string>(std::format("SAVEPOINT {}", quoted_name())),
-    loc);
+    std::format("ROLLBACK TO SAVEPOINT {}", quoted)));
+  m_savepoint_cmd = std::format("SAVEPOINT {}", quoted);
+  if (policy == begin_policy::deferred)
+    defer_begin(m_savepoint_cmd);
+  else
+    direct_exec(m_savepoint_cmd, loc);
 }
 
 
@@ -59,8 +71,29 @@ pqxx::subtransaction::~subtransaction() noexcept
 
 void pqxx::subtransaction::do_commit(sl loc)
 {
+  // If we never set the savepoint, there's nothing to release.
+  if (begin_pending())
+    return;
   direct_exec(
     std::make_shared<std::string>(
       std::format("RELEASE SAVEPOINT {}", quoted_name())),
     loc);
 }
+
+
+pqxx::result pqxx::subtransaction::exec_and_commit(
+  std::string_view query, params const &parms, sl loc)
+{
+  auto const release{std::format("RELEASE SAVEPOINT {}", quoted_name())};
+  return internal_exec_and_commit(
+    query, false, parms.make_c_params(loc), release, loc);
+}
+
+
+pqxx::result pqxx::subtransaction::exec_and_commit(
+  prepped statement, params const &parms, sl loc)
+{
+  auto const release{std::format("RELEASE SAVEPOINT {}", quoted_name())};
+  return internal_exec_and_commit(
+    statement, true, parms.make_c_params(loc), release, loc);
+}
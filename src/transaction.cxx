@@ -48,6 +48,31 @@ pqxx::internal::basic_transaction::basic_transaction(
 }
 
 
+pqxx::internal::basic_transaction::basic_transaction(
+  connection &cx, zview begin_command, std::string_view tname,
+  begin_policy policy, sl loc) :
+        dbtransaction(cx, tname, loc)
+{
+  register_transaction();
+  if (policy == begin_policy::deferred)
+    defer_begin(begin_command);
+  else
+    direct_exec(begin_command, loc);
+}
+
+
+pqxx::internal::basic_transaction::basic_transaction(
+  connection &cx, zview begin_command, begin_policy policy, sl loc) :
+        dbtransaction(cx, loc)
+{
+  register_transaction();
+  if (policy == begin_policy::deferred)
+    defer_begin(begin_command);
+  else
+    direct_exec(begin_command, loc);
+}
+
+
 // This should stop the compiler from generating the same vtables and
 // destructor in multiple translation units.  More importantly, if we don't do
 // this, the sanitisers in g++ 7 and clang++ 6 complain about pointers to
@@ -59,6 +84,11 @@ pqxx::internal::basic_transaction::~basic_transaction() noexcept = default;
 
 void pqxx::internal::basic_transaction::do_commit(sl loc)
 {
+  // If we never started the transaction on the server, there's nothing to
+  // commit.
+  if (begin_pending())
+    return;
+
   static auto const commit_q{std::make_shared<std::string>("COMMIT"sv)};
   try
   {
@@ -106,3 +136,19 @@ void pqxx::internal::basic_transaction::do_commit(sl loc)
     }
   }
 }
+
+
+pqxx::result pqxx::internal::basic_transaction::exec_and_commit(
+  std::string_view query, params const &parms, sl loc)
+{
+  return internal_exec_and_commit(
+    query, false, parms.make_c_params(loc), "COMMIT"_zv, loc);
+}
+
+
+pqxx::result pqxx::internal::basic_transaction::exec_and_commit(
+  prepped statement, params const &parms, sl loc)
+{
+  return internal_exec_and_commit(
+    statement, true, parms.make_c_params(loc), "COMMIT"_zv, loc);
+}
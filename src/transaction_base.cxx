@@ -188,7 +188,11 @@ void pqxx::transaction_base::commit(sl loc)
 
 void pqxx::transaction_base::do_abort(sl loc)
 {
-  if (m_rollback_cmd)
+  // If we never started the transaction on the server, there's nothing to
+  // roll back.
+  if (begin_pending())
+    m_pending_begin = {};
+  else if (m_rollback_cmd)
     direct_exec(m_rollback_cmd, loc);
 }
 
@@ -236,15 +240,23 @@ void pqxx::transaction_base::abort(sl loc)
 
 namespace
 {
+/// Class name for @ref command.
+constexpr std::string_view command_class{"command"sv};
+
+
 /// Guard command execution against clashes with pipelines and such.
 /** A transaction can have only one focus at a time.  Command execution is the
  * most basic example of a transaction focus.
+ *
+ * The command's name only shows up in an error message, if the transaction
+ * already has a focus.  So when executing a query, only pass the query as the
+ * name in that case.  That saves us copying the query every time.
  */
 class PQXX_PRIVATE command : pqxx::transaction_focus
 {
 public:
   command(pqxx::transaction_base &tx, std::string_view oname) :
-          transaction_focus{tx, "command"sv, oname}
+          transaction_focus{tx, command_class, oname}
   {
     register_me();
   }
@@ -324,20 +336,90 @@ pqxx::result pqxx::transaction_base::exec_n(
 
 
 pqxx::result pqxx::transaction_base::internal_exec_prepared(
-  std::string_view statement, internal::c_params const &args, sl loc)
-{
-  command const cmd{*this, statement};
-  return pqxx::internal::gate::connection_transaction{conn()}.exec_prepared(
-    statement, args, loc);
+  std::string_view statement, internal::c_params const &args,
+  format result_format, sl loc)
+{
+  command const cmd{*this, (m_focus == nullptr) ? ""sv : statement};
+  pqxx::internal::gate::connection_transaction gate{conn()};
+  if (begin_pending())
+    return gate.exec_bracketed(
+      std::exchange(m_pending_begin, {}), statement, true, args,
+      result_format, {}, loc);
+  return gate.exec_prepared(statement, args, result_format, loc);
 }
 
 
 pqxx::result pqxx::transaction_base::internal_exec_params(
-  std::string_view query, internal::c_params const &args, sl loc)
+  std::string_view query, internal::c_params const &args,
+  format result_format, sl loc)
+{
+  command const cmd{*this, (m_focus == nullptr) ? ""sv : query};
+  pqxx::internal::gate::connection_transaction gate{conn()};
+  if (begin_pending())
+    return gate.exec_bracketed(
+      std::exchange(m_pending_begin, {}), query, false, args, result_format,
+      {}, loc);
+  return gate.exec_params(query, args, result_format, loc);
+}
+
+
+pqxx::result pqxx::transaction_base::internal_exec_and_commit(
+  std::string_view statement, bool prepared, internal::c_params const &args,
+  zview commit_cmd, sl loc)
 {
-  command const cmd{*this, query};
-  return pqxx::internal::gate::connection_transaction{conn()}.exec_params(
-    query, args, loc);
+  check_pending_error();
+  if (m_status != status::active)
+    throw usage_error{
+      std::format(
+        "Attempt to commit {}, which is already closed.", description()),
+      loc};
+  if (not m_conn.is_open())
+    throw broken_connection{
+      "Broken connection to backend; cannot complete transaction.", loc};
+
+  // If another focus is active, that's the caller's mistake.  Throw before
+  // we get to the part where failure means rolling back.
+  command const cmd{*this, (m_focus == nullptr) ? ""sv : statement};
+  pqxx::internal::gate::connection_transaction gate{conn()};
+  result res;
+  try
+  {
+    res = gate.exec_bracketed(
+      std::exchange(m_pending_begin, {}), statement, prepared, args,
+      format::text, commit_cmd, loc);
+  }
+  catch (std::exception const &e)
+  {
+    if (not m_conn.is_open())
+    {
+      // We lost the connection.  There's no telling whether the commit
+      // went through.
+      m_status = status::in_doubt;
+      process_notice(std::format("{}\n", e.what()));
+      throw in_doubt_error{
+        std::format(
+          "Connection lost while committing {}.  There is no way to tell "
+          "whether it succeeded or was aborted except to check manually.",
+          description()),
+        loc};
+    }
+    if (gate.in_transaction_block())
+    {
+      // The statement failed, so the server skipped the commit.  Roll back.
+      abort(loc);
+    }
+    else
+    {
+      // Either the transaction never started, or the commit failed.  Either
+      // way, the server has already closed the transaction.
+      m_status = status::aborted;
+      close(loc);
+    }
+    throw;
+  }
+  m_status = status::committed;
+  close(loc);
+  return res;
 }
 
 
@@ -443,6 +525,10 @@ void pqxx::transaction_base::register_focus(transaction_focus *new_focus)
   internal::check_unique_register(
     m_focus, get_classname(m_focus), get_obj_name(m_focus), new_focus,
     get_classname(new_focus), get_obj_name(new_focus));
+  // A plain command can take a pending start command along.  Pipelines,
+  // streams, and so on need the transaction to have started already.
+  if (begin_pending() and (get_classname(new_focus) != command_class))
+    send_pending_begin(m_created_loc);
   m_focus = new_focus;
 }
 
@@ -469,8 +555,10 @@ pqxx::result pqxx::transaction_base::direct_exec(
   std::string_view cmd, std::string_view desc, sl loc)
 {
   check_pending_error();
-  return pqxx::internal::gate::connection_transaction{conn()}.exec(
-    cmd, desc, loc);
+  pqxx::internal::gate::connection_transaction gate{conn()};
+  if (begin_pending())
+    return gate.exec_after(std::exchange(m_pending_begin, {}), cmd, desc, loc);
+  return gate.exec(cmd, desc, loc);
 }
 
 
@@ -480,12 +568,23 @@ pqxx::result pqxx::transaction_base::direct_exec(
   std::shared_ptr<std::string> cmd, std::string_view desc, sl loc)
 {
   check_pending_error();
-  return pqxx::internal::gate::connection_transaction{conn()}.exec(
-    cmd, desc, loc);
+  pqxx::internal::gate::connection_transaction gate{conn()};
+  if (begin_pending())
+    return gate.exec_after(
+      std::exchange(m_pending_begin, {}), *cmd, desc, loc);
+  return gate.exec(cmd, desc, loc);
 }
 // NOLINTEND(performance-unnecessary-value-param)
 
 
+void pqxx::transaction_base::send_pending_begin(sl loc)
+{
+  if (begin_pending())
+    pqxx::internal::gate::connection_transaction{conn()}.exec(
+      std::exchange(m_pending_begin, {}), loc);
+}
+
+
 void pqxx::transaction_base::register_pending_error(zview err, sl loc) noexcept
 {
   if (std::empty(m_pending_error) and not std::empty(err))
@@ -16,6 +16,11 @@
 #include <cstring>
 #include <new>
 
+#if defined(__GNUC__) && defined(__x86_64__)
+#  include <immintrin.h>
+#  define PQXX_HEX_AVX2
+#endif
+
 #include "pqxx/internal/header-pre.hxx"
 
 extern "C"
@@ -29,6 +34,8 @@ extern "C"
 
 #include "pqxx/internal/header-post.hxx"
 
+#include "simd.hxx"
+
 
 using namespace std::literals;
 
@@ -151,6 +158,346 @@ static_assert(nibble('a') == 10);
 static_assert(nibble('f') == 15);
 #endif
 // LCOV_EXCL_STOP
+
+
+/// Number of binary bytes that the SIMD hex kernels handle at a time.
+constexpr std::size_t hex_block{16u};
+
+
+#if defined(PQXX_SIMD_SSE2)
+/// Hex-encode whole blocks of binary data, as far as possible.
+/** Writes 2 hex digits per byte to `out`.  Returns the number of input bytes
+ * it has processed, which will be a multiple of @ref hex_block.
+ */
+std::size_t
+hex_encode_blocks(std::byte const *in, std::size_t size, char *out) noexcept
+{
+  __m128i const low_mask{_mm_set1_epi8(0x0f)};
+  __m128i const nine{_mm_set1_epi8(9)};
+  // Distance from '9' + 1 to 'a'.
+  __m128i const letter_gap{_mm_set1_epi8('a' - '0' - ten)};
+  __m128i const zero_char{_mm_set1_epi8('0')};
+
+  auto const to_hex{[&](__m128i nibbles) {
+    __m128i const letters{
+      _mm_and_si128(_mm_cmpgt_epi8(nibbles, nine), letter_gap)};
+    return _mm_add_epi8(_mm_add_epi8(nibbles, zero_char), letters);
+  }};
+
+  std::size_t done{0u};
+  for (; done + hex_block <= size; done += hex_block)
+  {
+    __m128i const bytes{
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + done))};
+    __m128i const hi{
+      to_hex(_mm_and_si128(_mm_srli_epi16(bytes, 4), low_mask))};
+    __m128i const lo{to_hex(_mm_and_si128(bytes, low_mask))};
+    // Interleave the high and low digits.
+    auto const dest{out + 2 * done};
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    _mm_storeu_si128(
+      reinterpret_cast<__m128i *>(dest), _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(
+      reinterpret_cast<__m128i *>(dest + hex_block),
+      _mm_unpackhi_epi8(hi, lo));
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+  return done;
+}
+
+
+/// Translate a block of 16 hex digits to nibble values.
+/** Returns false if any of the characters is not a hex digit.
+ */
+inline bool hex_nibbles(__m128i chars, __m128i &nibbles) noexcept
+{
+  // These are signed comparisons, but anything from 0x80 up is negative and
+  // so ends up below '0'.
+  __m128i const digit{_mm_and_si128(
+    _mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+    _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), chars))};
+  // Letters, folded to lower case.
+  __m128i const lower{_mm_or_si128(chars, _mm_set1_epi8(0x20))};
+  __m128i const letter{_mm_and_si128(
+    _mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+    _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lower))};
+  if (_mm_movemask_epi8(_mm_or_si128(digit, letter)) != 0xffff)
+    return false;
+  nibbles = _mm_or_si128(
+    _mm_and_si128(digit, _mm_sub_epi8(chars, _mm_set1_epi8('0'))),
+    _mm_and_si128(letter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - ten))));
+  return true;
+}
+
+
+/// Decode whole blocks of hex digits, as far as possible.
+/** Reads `size` hex digits from `in`, and writes one byte per pair to `out`.
+ * Returns the number of digits it has processed.  It stops at the first block
+ * that contains anything other than hex digits, leaving that block for the
+ * caller to diagnose.
+ */
+std::size_t
+hex_decode_blocks(char const *in, std::size_t size, std::byte *out) noexcept
+{
+  __m128i const low_byte{_mm_set1_epi16(0x00f0)};
+  std::size_t done{0u};
+  for (; done + 2 * hex_block <= size; done += 2 * hex_block)
+  {
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    __m128i first, second;
+    if (
+      not hex_nibbles(
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + done)),
+        first) or
+      not hex_nibbles(
+        _mm_loadu_si128(
+          reinterpret_cast<__m128i const *>(in + done + hex_block)),
+        second))
+      break;
+    // In each 16-bit lane, the low byte holds the high nibble and vice versa.
+    auto const combine{[low_byte](__m128i pairs) {
+      return _mm_or_si128(
+        _mm_and_si128(_mm_slli_epi16(pairs, 4), low_byte),
+        _mm_srli_epi16(pairs, 8));
+    }};
+    _mm_storeu_si128(
+      reinterpret_cast<__m128i *>(out + done / 2),
+      _mm_packus_epi16(combine(first), combine(second)));
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+  return done;
+}
+
+
+#  if defined(PQXX_HEX_AVX2)
+/// Hex-encode whole blocks of binary data, 32 bytes at a time, using AVX2.
+/** Leaves any remaining whole 16-byte block to @ref hex_encode_blocks.
+ */
+[[gnu::target("avx2")]] std::size_t hex_encode_blocks_avx2(
+  std::byte const *in, std::size_t size, char *out) noexcept
+{
+  constexpr std::size_t width{2 * hex_block};
+  __m256i const low_mask{_mm256_set1_epi8(0x0f)};
+  __m256i const nine{_mm256_set1_epi8(9)};
+  __m256i const letter_gap{_mm256_set1_epi8('a' - '0' - ten)};
+  __m256i const zero_char{_mm256_set1_epi8('0')};
+
+  std::size_t done{0u};
+  for (; done + width <= size; done += width)
+  {
+    __m256i const bytes{
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + done))};
+    // (No lambdas here: they would not inherit the function's target.)
+    __m256i const hi_nibbles{
+      _mm256_and_si256(_mm256_srli_epi16(bytes, 4), low_mask)},
+      lo_nibbles{_mm256_and_si256(bytes, low_mask)};
+    __m256i const hi{_mm256_add_epi8(
+      _mm256_add_epi8(hi_nibbles, zero_char),
+      _mm256_and_si256(_mm256_cmpgt_epi8(hi_nibbles, nine), letter_gap))};
+    __m256i const lo{_mm256_add_epi8(
+      _mm256_add_epi8(lo_nibbles, zero_char),
+      _mm256_and_si256(_mm256_cmpgt_epi8(lo_nibbles, nine), letter_gap))};
+    // AVX2 interleaves within each 128-bit lane.  Swap the middle two lanes
+    // of the pair to get the digits back in order.
+    __m256i const first{_mm256_unpacklo_epi8(hi, lo)},
+      second{_mm256_unpackhi_epi8(hi, lo)};
+    auto const dest{out + 2 * done};
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    _mm256_storeu_si256(
+      reinterpret_cast<__m256i *>(dest),
+      _mm256_permute2x128_si256(first, second, 0x20));
+    _mm256_storeu_si256(
+      reinterpret_cast<__m256i *>(dest + width),
+      _mm256_permute2x128_si256(first, second, 0x31));
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+  return done + hex_encode_blocks(in + done, size - done, out + 2 * done);
+}
+
+
+/// Translate a block of 32 hex digits to nibble values, using AVX2.
+/** Returns false if any of the characters is not a hex digit.
+ */
+[[gnu::target("avx2")]] inline bool
+hex_nibbles_avx2(__m256i chars, __m256i &nibbles) noexcept
+{
+  __m256i const digit{_mm256_and_si256(
+    _mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0' - 1)),
+    _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chars))};
+  __m256i const lower{_mm256_or_si256(chars, _mm256_set1_epi8(0x20))};
+  __m256i const letter{_mm256_and_si256(
+    _mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+    _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower))};
+  if (_mm256_movemask_epi8(_mm256_or_si256(digit, letter)) != -1)
+    return false;
+  nibbles = _mm256_or_si256(
+    _mm256_and_si256(digit, _mm256_sub_epi8(chars, _mm256_set1_epi8('0'))),
+    _mm256_and_si256(
+      letter, _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - ten))));
+  return true;
+}
+
+
+/// Decode whole blocks of hex digits, 64 at a time, using AVX2.
+/** Leaves the rest to @ref hex_decode_blocks, including any block that
+ * contains anything other than hex digits.
+ */
+[[gnu::target("avx2")]] std::size_t hex_decode_blocks_avx2(
+  char const *in, std::size_t size, std::byte *out) noexcept
+{
+  constexpr std::size_t width{2 * hex_block};
+  __m256i const low_byte{_mm256_set1_epi16(0x00f0)};
+  std::size_t done{0u};
+  for (; done + 2 * width <= size; done += 2 * width)
+  {
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    __m256i first, second;
+    if (
+      not hex_nibbles_avx2(
+        _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + done)),
+        first) or
+      not hex_nibbles_avx2(
+        _mm256_loadu_si256(
+          reinterpret_cast<__m256i const *>(in + done + width)),
+        second))
+      break;
+    // In each 16-bit lane, the low byte holds the high nibble and vice versa.
+    __m256i const first_bytes{_mm256_or_si256(
+      _mm256_and_si256(_mm256_slli_epi16(first, 4), low_byte),
+      _mm256_srli_epi16(first, 8))};
+    __m256i const second_bytes{_mm256_or_si256(
+      _mm256_and_si256(_mm256_slli_epi16(second, 4), low_byte),
+      _mm256_srli_epi16(second, 8))};
+    // The pack works within each 128-bit lane, so it leaves the 8-byte
+    // quarters in the order 0, 2, 1, 3.
+    _mm256_storeu_si256(
+      reinterpret_cast<__m256i *>(out + done / 2),
+      _mm256_permute4x64_epi64(
+        _mm256_packus_epi16(first_bytes, second_bytes), 0xd8));
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+  return done + hex_decode_blocks(in + done, size - done, out + done / 2);
+}
+#  endif // PQXX_HEX_AVX2
+#elif defined(PQXX_SIMD_NEON)
+/// Hex-encode whole blocks of binary data, as far as possible.
+/** Writes 2 hex digits per byte to `out`.  Returns the number of input bytes
+ * it has processed, which will be a multiple of @ref hex_block.
+ */
+std::size_t
+hex_encode_blocks(std::byte const *in, std::size_t size, char *out) noexcept
+{
+  // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+  uint8x16_t const digits{
+    vld1q_u8(reinterpret_cast<std::uint8_t const *>(std::data(hex_digits)))};
+  std::size_t done{0u};
+  for (; done + hex_block <= size; done += hex_block)
+  {
+    uint8x16_t const bytes{
+      vld1q_u8(reinterpret_cast<std::uint8_t const *>(in + done))};
+    // Storing the pair interleaves the high and low digits for us.
+    uint8x16x2_t const hex{
+      vqtbl1q_u8(digits, vshrq_n_u8(bytes, 4)),
+      vqtbl1q_u8(digits, vandq_u8(bytes, vdupq_n_u8(0x0f)))};
+    vst2q_u8(reinterpret_cast<std::uint8_t *>(out + 2 * done), hex);
+  }
+  // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+  return done;
+}
+
+
+/// Translate a block of 16 hex digits to nibble values.
+/** Returns false if any of the characters is not a hex digit.
+ */
+inline bool hex_nibbles(uint8x16_t chars, uint8x16_t &nibbles) noexcept
+{
+  uint8x16_t const from_digit{vsubq_u8(chars, vdupq_n_u8('0'))};
+  uint8x16_t const digit{vcltq_u8(from_digit, vdupq_n_u8(ten))};
+  // Letters, folded to lower case.
+  uint8x16_t const from_letter{
+    vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a'))};
+  uint8x16_t const letter{vcltq_u8(from_letter, vdupq_n_u8(6))};
+  if (vminvq_u8(vorrq_u8(digit, letter)) != 0xff)
+    return false;
+  nibbles =
+    vbslq_u8(digit, from_digit, vaddq_u8(from_letter, vdupq_n_u8(ten)));
+  return true;
+}
+
+
+/// Decode whole blocks of hex digits, as far as possible.
+/** Reads `size` hex digits from `in`, and writes one byte per pair to `out`.
+ * Returns the number of digits it has processed.  It stops at the first block
+ * that contains anything other than hex digits, leaving that block for the
+ * caller to diagnose.
+ */
+std::size_t
+hex_decode_blocks(char const *in, std::size_t size, std::byte *out) noexcept
+{
+  std::size_t done{0u};
+  for (; done + 2 * hex_block <= size; done += 2 * hex_block)
+  {
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    // Loading a pair separates the high and low digits for us.
+    uint8x16x2_t const chars{
+      vld2q_u8(reinterpret_cast<std::uint8_t const *>(in + done))};
+    uint8x16_t hi, lo;
+    if (not hex_nibbles(chars.val[0], hi) or not hex_nibbles(chars.val[1], lo))
+      break;
+    vst1q_u8(
+      reinterpret_cast<std::uint8_t *>(out + done / 2),
+      vorrq_u8(vshlq_n_u8(hi, 4), lo));
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+  return done;
+}
+#else
+/// Without SIMD support, leave all the work to the caller.
+constexpr std::size_t
+hex_encode_blocks(std::byte const *, std::size_t, char *) noexcept
+{
+  return 0u;
+}
+
+/// Without SIMD support, leave all the work to the caller.
+constexpr std::size_t
+hex_decode_blocks(char const *, std::size_t, std::byte *) noexcept
+{
+  return 0u;
+}
+#endif
+
+
+using hex_encoder_func =
+  std::size_t(std::byte const *, std::size_t, char *) noexcept;
+using hex_decoder_func =
+  std::size_t(char const *, std::size_t, std::byte *) noexcept;
+
+
+/// Pick the fastest hex encoding kernel that this CPU supports.
+hex_encoder_func *pick_hex_encoder() noexcept
+{
+#if defined(PQXX_SIMD_SSE2) && defined(PQXX_HEX_AVX2)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return hex_encode_blocks_avx2;
+#endif
+  return hex_encode_blocks;
+}
+
+
+/// Pick the fastest hex decoding kernel that this CPU supports.
+hex_decoder_func *pick_hex_decoder() noexcept
+{
+#if defined(PQXX_SIMD_SSE2) && defined(PQXX_HEX_AVX2)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return hex_decode_blocks_avx2;
+#endif
+  return hex_decode_blocks;
+}
 } // namespace
 
 
@@ -164,9 +511,14 @@ void esc_bin(bytes_view binary_data, std::span<char> buffer) noexcept
   buffer[here++] = '\\';
   buffer[here++] = 'x';
 
+  static hex_encoder_func *const encode_blocks{pick_hex_encoder()};
+  auto const done{encode_blocks(
+    std::data(binary_data), std::size(binary_data), std::data(buffer) + here)};
+  here += 2 * done;
+
   constexpr int nibble_bits{4};
   constexpr int nibble_mask{0x0f};
-  for (auto const byte : binary_data)
+  for (auto const byte : binary_data.subspan(done))
   {
     auto uc{static_cast<unsigned char>(byte)};
 
@@ -205,7 +557,11 @@ void unesc_bin(
       "Escaped binary data did not start with '\\x'`.  Is the server or libpq "
       "too old?",
       loc);
-  std::size_t out{0u};
+  static hex_decoder_func *const decode_blocks{pick_hex_decoder()};
+  auto const done{decode_blocks(
+    std::data(escaped_data) + in, in_size - in, std::data(buffer))};
+  in += done;
+  std::size_t out{done / 2};
   while (in < in_size)
   {
     int const hi{nibble(escaped_data[in++])};
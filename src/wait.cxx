@@ -95,7 +95,7 @@ T to_milli(unsigned seconds, unsigned microseconds, pqxx::sl loc)
 } // namespace
 
 
-void pqxx::internal::wait_fd(
+bool pqxx::internal::wait_fd(
   int fd, bool for_read, bool for_write, unsigned seconds,
   unsigned microseconds, [[maybe_unused]] sl loc)
 {
@@ -149,6 +149,7 @@ void pqxx::internal::wait_fd(
     };
     throw std::runtime_error{pqxx::internal::error_string(err_code, errbuf)};
   }
+  return code > 0;
 }
 
 
@@ -0,0 +1,226 @@
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+
+#include <pqxx/arrow>
+#include <pqxx/transaction>
+
+#include "helpers.hxx"
+
+namespace
+{
+using namespace std::literals;
+
+
+/// Read value `n` from buffer `buf` of an Arrow array.
+template<typename T>
+T arrow_at(ArrowArray const &array, std::size_t buf, std::size_t n)
+{
+  T value;
+  std::memcpy(
+    &value,
+    static_cast<std::byte const *>(array.buffers[buf]) + n * sizeof(T),
+    sizeof(T));
+  return value;
+}
+
+
+/// Is bit `n` set in buffer `buf` of an Arrow array?
+bool arrow_bit(ArrowArray const &array, std::size_t buf, std::size_t n)
+{
+  auto const bits{static_cast<std::uint8_t const *>(array.buffers[buf])};
+  return ((bits[n / 8] >> (n % 8)) & 1u) != 0u;
+}
+
+
+/// Read string `n` from a UTF-8 or binary Arrow array.
+std::string_view arrow_string(ArrowArray const &array, std::size_t n)
+{
+  auto const begin{arrow_at<std::int32_t>(array, 1, n)},
+    end{arrow_at<std::int32_t>(array, 1, n + 1)};
+  return {
+    static_cast<char const *>(array.buffers[2]) + begin,
+    static_cast<std::size_t>(end - begin)};
+}
+
+
+void test_arrow_schema(pqxx::test::context &)
+{
+  pqxx::arrow_builder<
+    bool, std::int16_t, std::optional<int>, std::uint64_t, float, double,
+    std::string_view, pqxx::bytes> const builder{
+    {"flag", "small", "num", "big", "f", "g", "text", "data"}};
+
+  ArrowSchema schema;
+  builder.export_schema(&schema);
+  PQXX_CHECK_EQUAL(std::string_view{schema.format}, "+s");
+  PQXX_CHECK_EQUAL(schema.n_children, 8);
+  std::string_view const formats[]{"b", "s", "i", "L", "f", "g", "u", "z"};
+  for (std::size_t col{0}; col < std::size(formats); ++col)
+  {
+    auto const &child{*schema.children[col]};
+    PQXX_CHECK_EQUAL(std::string_view{child.format}, formats[col]);
+    PQXX_CHECK_EQUAL(child.flags, ARROW_FLAG_NULLABLE);
+  }
+  PQXX_CHECK_EQUAL(std::string_view{schema.children[6]->name}, "text");
+
+  // A consumer may move a child out, and release it separately.
+  ArrowSchema moved{*schema.children[0]};
+  schema.children[0]->release = nullptr;
+  schema.release(&schema);
+  PQXX_CHECK(schema.release == nullptr);
+  PQXX_CHECK_EQUAL(std::string_view{moved.name}, "flag");
+  moved.release(&moved);
+}
+
+
+void test_arrow_chunks(pqxx::test::context &)
+{
+  pqxx::arrow_builder<
+    std::optional<int>, bool, std::optional<std::string_view>>
+    builder{{"num", "flag", "text"}};
+
+  for (int n{0}; n < 10; ++n)
+  {
+    std::optional<int> num;
+    if ((n % 3) != 0)
+      num = n;
+    std::optional<std::string_view> text;
+    if (n != 4)
+      text = ((n % 2) == 0) ? ""sv : "n"sv;
+    builder.append({num, (n % 2) == 0, text});
+  }
+  PQXX_CHECK_EQUAL(builder.rows(), 10);
+
+  ArrowArray chunk;
+  builder.export_chunk(&chunk);
+  PQXX_CHECK_EQUAL(builder.rows(), 0);
+  PQXX_CHECK_EQUAL(chunk.length, 10);
+  PQXX_CHECK_EQUAL(chunk.n_children, 3);
+
+  auto const &num{*chunk.children[0]};
+  PQXX_CHECK_EQUAL(num.length, 10);
+  PQXX_CHECK_EQUAL(num.null_count, 4);
+  PQXX_CHECK_EQUAL(num.n_buffers, 2);
+  PQXX_CHECK(not arrow_bit(num, 0, 0));
+  PQXX_CHECK(arrow_bit(num, 0, 1));
+  PQXX_CHECK(not arrow_bit(num, 0, 9));
+  PQXX_CHECK_EQUAL(arrow_at<int>(num, 1, 7), 7);
+
+  auto const &flag{*chunk.children[1]};
+  PQXX_CHECK_EQUAL(flag.null_count, 0);
+  // With no nulls, there is no validity bitmap.
+  PQXX_CHECK(flag.buffers[0] == nullptr);
+  PQXX_CHECK(arrow_bit(flag, 1, 8));
+  PQXX_CHECK(not arrow_bit(flag, 1, 9));
+
+  auto const &text{*chunk.children[2]};
+  PQXX_CHECK_EQUAL(text.n_buffers, 3);
+  PQXX_CHECK_EQUAL(text.null_count, 1);
+  PQXX_CHECK_EQUAL(arrow_string(text, 3), "n");
+  PQXX_CHECK_EQUAL(arrow_string(text, 4), "");
+  PQXX_CHECK_EQUAL(arrow_string(text, 6), "");
+  chunk.release(&chunk);
+  PQXX_CHECK(chunk.release == nullptr);
+
+  // The next chunk starts afresh.
+  builder.append({1, true, "next"sv});
+  builder.export_chunk(&chunk);
+  PQXX_CHECK_EQUAL(chunk.length, 1);
+  PQXX_CHECK_EQUAL(chunk.children[0]->null_count, 0);
+  PQXX_CHECK_EQUAL(arrow_string(*chunk.children[2], 0), "next");
+  chunk.release(&chunk);
+}
+
+
+void test_arrow_from_result(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  auto const r{tx.exec(
+    "SELECT n AS id, CASE WHEN n = 2 THEN NULL ELSE 'v' || n END AS val "
+    "FROM generate_series(1, 3) AS n")};
+
+  pqxx::arrow_builder<long, std::optional<std::string_view>> builder{r};
+  builder.append(r);
+  ArrowSchema schema;
+  builder.export_schema(&schema);
+  PQXX_CHECK_EQUAL(std::string_view{schema.children[1]->name}, "val");
+  schema.release(&schema);
+
+  ArrowArray chunk;
+  builder.export_chunk(&chunk);
+  PQXX_CHECK_EQUAL(chunk.length, 3);
+  PQXX_CHECK_EQUAL(arrow_at<long>(*chunk.children[0], 1, 2), 3L);
+  PQXX_CHECK_EQUAL(chunk.children[1]->null_count, 1);
+  PQXX_CHECK_EQUAL(arrow_string(*chunk.children[1], 2), "v3");
+  chunk.release(&chunk);
+
+  PQXX_CHECK_THROWS(
+    (pqxx::arrow_builder<int>{r}), pqxx::usage_error);
+}
+
+
+void test_arrow_from_stream(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  pqxx::arrow_builder<int, std::optional<std::string_view>> builder{
+    {"n", "xs"}};
+
+  // The stream's string_views only live until the next row, so the builder
+  // must copy them.  Export every 4 rows: n = 1..4, then n = 5..7.
+  ArrowArray chunks[2];
+  std::size_t exported{0};
+  for (auto const &row : tx.stream<int, std::optional<std::string_view>>(
+         "SELECT n, CASE WHEN n % 3 = 0 THEN NULL ELSE repeat('x', n) END "
+         "FROM generate_series(1, 7) AS n"))
+  {
+    builder.append(row);
+    if (builder.rows() == 4)
+      builder.export_chunk(&chunks[exported++]);
+  }
+  builder.export_chunk(&chunks[exported++]);
+  PQXX_CHECK_EQUAL(exported, 2u);
+
+  auto const &first{chunks[0]}, &second{chunks[1]};
+  PQXX_CHECK_EQUAL(first.length, 4);
+  PQXX_CHECK_EQUAL(second.length, 3);
+  PQXX_CHECK_EQUAL(arrow_at<int>(*first.children[0], 1, 0), 1);
+  PQXX_CHECK_EQUAL(arrow_at<int>(*second.children[0], 1, 0), 5);
+  PQXX_CHECK(first.children[0]->buffers[0] == nullptr);
+  PQXX_CHECK(second.children[0]->buffers[0] == nullptr);
+
+  // Each chunk has its own validity bitmap, and its offsets start at zero.
+  auto const &xs1{*first.children[1]};
+  PQXX_CHECK_EQUAL(xs1.null_count, 1);
+  PQXX_CHECK(arrow_bit(xs1, 0, 0));
+  PQXX_CHECK(arrow_bit(xs1, 0, 1));
+  PQXX_CHECK(not arrow_bit(xs1, 0, 2));
+  PQXX_CHECK(arrow_bit(xs1, 0, 3));
+  std::int32_t const offsets1[]{0, 1, 3, 3, 7};
+  for (std::size_t i{0}; i < std::size(offsets1); ++i)
+    PQXX_CHECK_EQUAL(arrow_at<std::int32_t>(xs1, 1, i), offsets1[i]);
+  PQXX_CHECK_EQUAL(arrow_string(xs1, 3), "xxxx");
+
+  auto const &xs2{*second.children[1]};
+  PQXX_CHECK_EQUAL(xs2.null_count, 1);
+  PQXX_CHECK(arrow_bit(xs2, 0, 0));
+  PQXX_CHECK(not arrow_bit(xs2, 0, 1));
+  PQXX_CHECK(arrow_bit(xs2, 0, 2));
+  std::int32_t const offsets2[]{0, 5, 5, 12};
+  for (std::size_t i{0}; i < std::size(offsets2); ++i)
+    PQXX_CHECK_EQUAL(arrow_at<std::int32_t>(xs2, 1, i), offsets2[i]);
+  PQXX_CHECK_EQUAL(arrow_string(xs2, 0), "xxxxx");
+  PQXX_CHECK_EQUAL(arrow_string(xs2, 2), "xxxxxxx");
+
+  for (auto &chunk : chunks) chunk.release(&chunk);
+}
+
+
+PQXX_REGISTER_TEST(test_arrow_schema);
+PQXX_REGISTER_TEST(test_arrow_chunks);
+PQXX_REGISTER_TEST(test_arrow_from_result);
+PQXX_REGISTER_TEST(test_arrow_from_stream);
+} // namespace
@@ -0,0 +1,261 @@
+#include <format>
+#include <optional>
+#include <string>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#  include <unistd.h>
+#endif
+
+#include <pqxx/async>
+#include <pqxx/nontransaction>
+#include <pqxx/transaction>
+
+#include "helpers.hxx"
+
+namespace
+{
+pqxx::task<int> add(int a, int b)
+{
+  co_return a + b;
+}
+
+
+pqxx::task<int> add_three(int a, int b, int c)
+{
+  auto const ab{co_await add(a, b)};
+  co_return co_await add(ab, c);
+}
+
+
+pqxx::task<> fail()
+{
+  throw pqxx::usage_error{"Failing on purpose."};
+  co_return;
+}
+
+
+/// Can we use @ref pqxx::epoll_loop on this system?
+bool have_epoll()
+{
+  try
+  {
+    pqxx::epoll_loop const loop;
+    return true;
+  }
+  catch (pqxx::feature_not_supported const &)
+  {
+    return false;
+  }
+}
+
+
+void test_task_chains_coroutines(pqxx::test::context &)
+{
+  auto sum{add_three(1, 2, 3)};
+  PQXX_CHECK(not sum.done());
+  sum.start();
+  PQXX_CHECK(sum.done());
+  PQXX_CHECK_EQUAL(sum.get(), 6);
+
+  auto failure{fail()};
+  failure.start();
+  PQXX_CHECK(failure.done());
+  PQXX_CHECK_THROWS(failure.get(), pqxx::usage_error);
+
+  auto unstarted{add(1, 1)};
+  PQXX_CHECK_THROWS(unstarted.get(), pqxx::usage_error);
+}
+
+
+#if __has_include(<unistd.h>)
+pqxx::task<> read_byte(pqxx::event_loop &loop, int fd, std::string &out)
+{
+  co_await loop.readable(fd);
+  char c{};
+  PQXX_CHECK_EQUAL(::read(fd, &c, 1), 1);
+  out.push_back(c);
+}
+
+
+void test_epoll_loop_resumes_waiting_tasks(pqxx::test::context &)
+{
+  std::optional<pqxx::epoll_loop> loop;
+  try
+  {
+    loop.emplace();
+  }
+  catch (pqxx::feature_not_supported const &)
+  {
+    // No epoll on this system.
+    return;
+  }
+
+  int fds[2]{};
+  PQXX_CHECK_EQUAL(::pipe(fds), 0);
+  std::string out;
+  loop->spawn(read_byte(*loop, fds[0], out));
+  PQXX_CHECK(std::empty(out));
+  PQXX_CHECK_EQUAL(::write(fds[1], "x", 1), 1);
+  loop->run();
+  PQXX_CHECK_EQUAL(out, "x");
+
+  // Only one task can wait for a socket at a time.  The loop reports the
+  // failure, and can then carry on with the other task.
+  loop->spawn(read_byte(*loop, fds[0], out));
+  loop->spawn(read_byte(*loop, fds[0], out));
+  PQXX_CHECK_EQUAL(::write(fds[1], "y", 1), 1);
+  PQXX_CHECK_THROWS(loop->run(), pqxx::usage_error);
+  loop->run();
+  PQXX_CHECK_EQUAL(out, "xy");
+
+  ::close(fds[0]);
+  ::close(fds[1]);
+}
+#endif
+
+
+void test_async_exec(pqxx::test::context &)
+{
+  if (not have_epoll())
+    return;
+  pqxx::epoll_loop loop;
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+
+  auto const r{loop.run(tx.async_exec(loop, "SELECT 1 + 1"))};
+  PQXX_CHECK_EQUAL(r.one_field().as<int>(), 2);
+
+  // Parameters need not outlive the call.
+  auto pending{tx.async_exec(loop, "SELECT $1 * 2", pqxx::params{21})};
+  PQXX_CHECK_EQUAL(loop.run(std::move(pending)).one_field().as<int>(), 42);
+
+  // While a query is in flight, the transaction is busy.
+  auto busy{tx.async_exec(loop, "SELECT 3")};
+  PQXX_CHECK_THROWS(tx.exec("SELECT 4"), pqxx::usage_error);
+  PQXX_CHECK_EQUAL(loop.run(std::move(busy)).one_field().as<int>(), 3);
+  PQXX_CHECK_EQUAL(tx.query_value<int>("SELECT 5"), 5);
+
+  // A query too big to send in one go.
+  std::string const big(4'000'000, 'x');
+  PQXX_CHECK_EQUAL(
+    loop.run(tx.async_exec(loop, "SELECT length($1)", pqxx::params{big}))
+      .one_field()
+      .as<std::size_t>(),
+    std::size(big));
+}
+
+
+void test_async_exec_reports_errors(pqxx::test::context &)
+{
+  if (not have_epoll())
+    return;
+  pqxx::epoll_loop loop;
+  pqxx::connection cx;
+  pqxx::nontransaction tx{cx};
+
+  PQXX_CHECK_THROWS(
+    loop.run(tx.async_exec(loop, "SELECT * FROM pg_nonexistent_table")),
+    pqxx::sql_error);
+
+  // The connection is still usable.
+  PQXX_CHECK_EQUAL(tx.query_value<int>("SELECT 6"), 6);
+}
+
+
+pqxx::task<std::vector<int>>
+sum_rows(pqxx::event_loop &loop, pqxx::transaction_base &tx)
+{
+  std::vector<int> out;
+  for (auto [a, b] : co_await tx.async_query<int, int>(
+         loop, "SELECT x, $1 * x FROM generate_series(1, 3) AS x",
+         pqxx::params{10}))
+    out.push_back(a + b);
+  co_return out;
+}
+
+
+void test_async_query(pqxx::test::context &)
+{
+  if (not have_epoll())
+    return;
+  pqxx::epoll_loop loop;
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  auto const sums{loop.run(sum_rows(loop, tx))};
+  PQXX_CHECK_EQUAL(std::size(sums), 3u);
+  PQXX_CHECK_EQUAL(sums[0], 11);
+  PQXX_CHECK_EQUAL(sums[1], 22);
+  PQXX_CHECK_EQUAL(sums[2], 33);
+}
+
+
+pqxx::task<std::string> concatenate(
+  pqxx::event_loop &loop, pqxx::transaction_base &tx, pqxx::format fmt)
+{
+  auto stream{co_await tx.async_stream<int, std::string>(
+    loop, "SELECT x, 'n' || x FROM generate_series(1, 4) AS x", fmt)};
+  std::string out;
+  while (auto row{co_await stream.next()})
+  {
+    auto const &[x, name]{*row};
+    out += std::format("{}={};", x, name);
+  }
+  PQXX_CHECK(stream.done());
+  co_return out;
+}
+
+
+void test_async_stream(pqxx::test::context &)
+{
+  if (not have_epoll())
+    return;
+  pqxx::epoll_loop loop;
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  PQXX_CHECK_EQUAL(
+    loop.run(concatenate(loop, tx, pqxx::format::text)),
+    "1=n1;2=n2;3=n3;4=n4;");
+  PQXX_CHECK_EQUAL(
+    loop.run(concatenate(loop, tx, pqxx::format::binary)),
+    "1=n1;2=n2;3=n3;4=n4;");
+  PQXX_CHECK_EQUAL(tx.query_value<int>("SELECT 7"), 7);
+}
+
+
+pqxx::task<>
+sleep_and_count(pqxx::event_loop &loop, std::vector<int> &done, int id)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  co_await tx.async_exec(loop, "SELECT pg_sleep($1)", pqxx::params{0.1 * id});
+  done.push_back(id);
+}
+
+
+void test_async_runs_queries_concurrently(pqxx::test::context &)
+{
+  if (not have_epoll())
+    return;
+  pqxx::epoll_loop loop;
+  std::vector<int> done;
+  // Spawn the slowest first.  The fastest should still finish first.
+  for (int id{3}; id > 0; --id) loop.spawn(sleep_and_count(loop, done, id));
+  loop.run();
+  PQXX_CHECK_EQUAL(std::size(done), 3u);
+  PQXX_CHECK_EQUAL(done[0], 1);
+  PQXX_CHECK_EQUAL(done[1], 2);
+  PQXX_CHECK_EQUAL(done[2], 3);
+}
+
+
+PQXX_REGISTER_TEST(test_task_chains_coroutines);
+#if __has_include(<unistd.h>)
+PQXX_REGISTER_TEST(test_epoll_loop_resumes_waiting_tasks);
+#endif
+PQXX_REGISTER_TEST(test_async_exec);
+PQXX_REGISTER_TEST(test_async_exec_reports_errors);
+PQXX_REGISTER_TEST(test_async_query);
+PQXX_REGISTER_TEST(test_async_stream);
+PQXX_REGISTER_TEST(test_async_runs_queries_concurrently);
+} // namespace
@@ -0,0 +1,267 @@
+#include <pqxx/binary>
+#include <pqxx/time>
+#include <pqxx/transaction>
+
+#include "helpers.hxx"
+
+namespace
+{
+/// Build a `pqxx::bytes` from a list of byte values.
+pqxx::bytes make_bytes(std::initializer_list<unsigned> values)
+{
+  pqxx::bytes out;
+  for (auto v : values) out.push_back(static_cast<std::byte>(v));
+  return out;
+}
+
+
+void test_binary_traits_decode_numbers(pqxx::test::context &)
+{
+  using namespace pqxx::internal;
+
+  auto const int4{make_bytes({0xff, 0xff, 0xff, 0xfe})};
+  PQXX_CHECK_EQUAL(
+    pqxx::binary_traits<int>::from_binary(int4, oid_int4, {}), -2);
+  PQXX_CHECK_EQUAL(
+    pqxx::binary_traits<long long>::from_binary(int4, oid_int4, {}), -2LL);
+  PQXX_CHECK_THROWS(
+    std::ignore =
+      pqxx::binary_traits<unsigned>::from_binary(int4, oid_int4, {}),
+    pqxx::range_error);
+  PQXX_CHECK_THROWS(
+    std::ignore = pqxx::binary_traits<int>::from_binary(int4, oid_int8, {}),
+    pqxx::conversion_error);
+
+  auto const int8{make_bytes({0, 0, 0, 1, 0, 0, 0, 0})};
+  PQXX_CHECK_EQUAL(
+    pqxx::binary_traits<long long>::from_binary(int8, oid_int8, {}),
+    0x100000000LL);
+  PQXX_CHECK_THROWS(
+    std::ignore = pqxx::binary_traits<int>::from_binary(int8, oid_int8, {}),
+    pqxx::range_error);
+
+  // 1.5 as a float8.
+  auto const float8{make_bytes({0x3f, 0xf8, 0, 0, 0, 0, 0, 0})};
+  PQXX_CHECK_EQUAL(
+    pqxx::binary_traits<double>::from_binary(float8, oid_float8, {}), 1.5);
+  // -2.0 as a float4.
+  auto const float4{make_bytes({0xc0, 0, 0, 0})};
+  PQXX_CHECK_EQUAL(
+    pqxx::binary_traits<float>::from_binary(float4, oid_float4, {}), -2.0f);
+
+  PQXX_CHECK(pqxx::binary_traits<bool>::from_binary(
+    make_bytes({1}), oid_bool, {}));
+  PQXX_CHECK(not pqxx::binary_traits<bool>::from_binary(
+    make_bytes({0}), oid_bool, {}));
+}
+
+
+void test_binary_traits_decode_numeric(pqxx::test::context &)
+{
+  using pqxx::internal::oid_numeric;
+  using traits = pqxx::binary_traits<std::string>;
+
+  // 12345.678: digits 1, 2345, 6780 (base 10,000); weight 1; scale 3.
+  auto const pos{make_bytes(
+    {0, 3, 0, 1, 0, 0, 0, 3, 0, 1, 0x09, 0x29, 0x1a, 0x7c})};
+  PQXX_CHECK_EQUAL(traits::from_binary(pos, oid_numeric, {}), "12345.678");
+  PQXX_CHECK_EQUAL(
+    pqxx::binary_traits<double>::from_binary(pos, oid_numeric, {}),
+    12345.678);
+
+  // -0.0012: digit 12; weight -1; scale 4.
+  auto const neg{make_bytes({0, 1, 0xff, 0xff, 0x40, 0, 0, 4, 0, 12})};
+  PQXX_CHECK_EQUAL(traits::from_binary(neg, oid_numeric, {}), "-0.0012");
+
+  // 20000: digit 2; weight 1; scale 0.
+  auto const big{make_bytes({0, 1, 0, 1, 0, 0, 0, 0, 0, 2})};
+  PQXX_CHECK_EQUAL(traits::from_binary(big, oid_numeric, {}), "20000");
+  PQXX_CHECK_EQUAL(
+    pqxx::binary_traits<int>::from_binary(big, oid_numeric, {}), 20000);
+
+  // Zero: no digits at all.
+  auto const zero{make_bytes({0, 0, 0, 0, 0, 0, 0, 2})};
+  PQXX_CHECK_EQUAL(traits::from_binary(zero, oid_numeric, {}), "0.00");
+
+  auto const nan{make_bytes({0, 0, 0, 0, 0xc0, 0, 0, 0})};
+  PQXX_CHECK_EQUAL(traits::from_binary(nan, oid_numeric, {}), "NaN");
+
+  PQXX_CHECK_THROWS(
+    std::ignore = traits::from_binary(make_bytes({0, 1}), oid_numeric, {}),
+    pqxx::conversion_error);
+}
+
+
+void test_binary_traits_decode_other(pqxx::test::context &)
+{
+  using namespace pqxx::internal;
+
+  auto const uuid{make_bytes(
+    {0xa0, 0xee, 0xbc, 0x99, 0x9c, 0x0b, 0x4e, 0xf8, 0xbb, 0x6d, 0x6b, 0xb9,
+     0xbd, 0x38, 0x0a, 0x11})};
+  PQXX_CHECK_EQUAL(
+    pqxx::binary_traits<std::string>::from_binary(uuid, oid_uuid, {}),
+    "a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11");
+  PQXX_CHECK_EQUAL(
+    std::size(
+      pqxx::binary_traits<pqxx::bytes>::from_binary(uuid, oid_uuid, {})),
+    16u);
+
+  auto const text{make_bytes({'h', 'i'})};
+  PQXX_CHECK_EQUAL(
+    pqxx::binary_traits<std::string_view>::from_binary(text, oid_text, {}),
+    "hi");
+  PQXX_CHECK_THROWS(
+    std::ignore =
+      pqxx::binary_traits<std::string_view>::from_binary(text, oid_int2, {}),
+    pqxx::conversion_error);
+
+  // A 1-dimensional int4 array: {7, NULL, -1}.
+  auto const arr{make_bytes(
+    {0, 0, 0, 1,  0, 0, 0, 1,  0, 0, 0, 23, 0, 0, 0, 3, 0, 0, 0, 1,
+     0, 0, 0, 4,  0, 0, 0, 7,  0xff, 0xff, 0xff, 0xff,
+     0, 0, 0, 4,  0xff, 0xff, 0xff, 0xff})};
+  auto const opts{
+    pqxx::binary_traits<std::vector<std::optional<int>>>::from_binary(
+      arr, 1007, {})};
+  PQXX_CHECK_EQUAL(std::size(opts), 3u);
+  PQXX_CHECK_EQUAL(opts.at(0).value(), 7);
+  PQXX_CHECK(not opts.at(1).has_value());
+  PQXX_CHECK_EQUAL(opts.at(2).value(), -1);
+  PQXX_CHECK_THROWS(
+    std::ignore =
+      pqxx::binary_traits<std::vector<int>>::from_binary(arr, 1007, {}),
+    pqxx::conversion_error);
+
+  // 2000-01-01 plus one day and one microsecond.
+  using time_type = std::chrono::sys_time<std::chrono::microseconds>;
+  auto const ts{make_bytes({0, 0, 0, 0x14, 0x1d, 0xd7, 0x60, 0x01})};
+  PQXX_CHECK(
+    pqxx::binary_traits<time_type>::from_binary(ts, oid_timestamptz, {}) ==
+    time_type{std::chrono::sys_days{std::chrono::year{2000} / 1 / 2}} +
+      std::chrono::microseconds{1});
+}
+
+
+/// Encode `value` in binary, and decode the result as SQL type `type`.
+template<typename T> T round_trip(T const &value, pqxx::oid type)
+{
+  std::string buf;
+  pqxx::binary_traits<T>::into_binary(buf, value, {});
+  return pqxx::binary_traits<T>::from_binary(pqxx::binary_cast(buf), type, {});
+}
+
+
+void test_binary_traits_encode(pqxx::test::context &)
+{
+  using namespace pqxx::internal;
+
+  std::string buf;
+  pqxx::binary_traits<int>::into_binary(buf, -2, {});
+  PQXX_CHECK_EQUAL(buf, (std::string{"\xff\xff\xff\xfe", 4}));
+
+  PQXX_CHECK_EQUAL(round_trip(short{-300}, oid_int2), -300);
+  PQXX_CHECK_EQUAL(round_trip(1234567890123LL, oid_int8), 1234567890123LL);
+  PQXX_CHECK_EQUAL(round_trip(-0.125, oid_float8), -0.125);
+  PQXX_CHECK_EQUAL(round_trip(3.5f, oid_float4), 3.5f);
+  PQXX_CHECK(round_trip(true, oid_bool));
+  PQXX_CHECK_EQUAL(round_trip(std::string{"x\ty"}, oid_text), "x\ty");
+
+  // There's no SQL type for large unsigned values.
+  buf.clear();
+  PQXX_CHECK_THROWS(
+    pqxx::binary_traits<unsigned>::into_binary(buf, 0xffffffffu, {}),
+    pqxx::range_error);
+
+  using time_type = std::chrono::sys_time<std::chrono::microseconds>;
+  time_type const ts{
+    std::chrono::sys_days{std::chrono::year{1999} / 12 / 31} +
+    std::chrono::microseconds{3}};
+  PQXX_CHECK(round_trip(ts, oid_timestamp) == ts);
+
+  PQXX_CHECK_EQUAL(guess_binary_type<short>(2), oid_int2);
+  PQXX_CHECK_EQUAL(guess_binary_type<long long>(8), oid_int8);
+  PQXX_CHECK_EQUAL(guess_binary_type<std::optional<double>>(8), oid_float8);
+  PQXX_CHECK_EQUAL(guess_binary_type<std::string>(3), oid_text);
+  PQXX_CHECK_EQUAL(guess_binary_type<pqxx::bytes>(3), oid_bytea);
+}
+
+
+void test_exec_binary_result(pqxx::test::context &tctx)
+{
+  auto const num{tctx.make_num(100000)};
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+
+  auto const r{tx.exec(
+    "SELECT $1::integer, $1::bigint, $1::float8, true, "
+    "'\\x0001ff'::bytea, 'a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11'::uuid, "
+    "'-123.4500'::numeric, ARRAY[1, NULL, 3], 'txt'::text",
+    pqxx::params{num}, pqxx::format::binary)};
+  auto const row{r.one_row()};
+  PQXX_CHECK(r.column_format(0) == pqxx::format::binary);
+
+  PQXX_CHECK_EQUAL(row[0].as<int>(), num);
+  PQXX_CHECK_EQUAL(row[1].as<long long>(), num);
+  PQXX_CHECK_EQUAL(row[2].as<double>(), static_cast<double>(num));
+  PQXX_CHECK(row[3].as<bool>());
+  PQXX_CHECK(
+    row[4].as<pqxx::bytes>() ==
+    (pqxx::bytes{std::byte{0}, std::byte{1}, std::byte{0xff}}));
+  PQXX_CHECK_EQUAL(
+    row[5].as<std::string>(), "a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11");
+  PQXX_CHECK_EQUAL(row[6].as<std::string>(), "-123.4500");
+  auto const arr{row[7].as<std::vector<std::optional<int>>>()};
+  PQXX_CHECK_EQUAL(std::size(arr), 3u);
+  PQXX_CHECK(not arr.at(1).has_value());
+  PQXX_CHECK_EQUAL(row[8].as<std::string_view>(), "txt");
+
+  // Binary conversions care about the SQL type.
+  PQXX_CHECK_THROWS(std::ignore = row[8].as<int>(), pqxx::conversion_error);
+
+  auto const [i, s]{
+    tx.exec("SELECT 7::smallint, 'x'::varchar", {}, pqxx::format::binary)
+      .one_row()
+      .as<short, std::string>()};
+  PQXX_CHECK_EQUAL(i, 7);
+  PQXX_CHECK_EQUAL(s, "x");
+}
+
+
+void test_exec_prepared_binary_result(pqxx::test::context &tctx)
+{
+  auto const name{tctx.make_name("pqxx-binary")};
+  pqxx::connection cx;
+  cx.prepare(name, "SELECT $1::date, $2::timestamptz, NULL::integer");
+  pqxx::work tx{cx};
+  auto const row{tx.exec(
+                     pqxx::prepped{name},
+                     pqxx::params{"2024-02-29", "2000-01-02 00:00:00+00"},
+                     pqxx::format::binary)
+                   .one_row()};
+#if defined(PQXX_HAVE_YEAR_MONTH_DAY)
+  PQXX_CHECK(
+    row[0].as<std::chrono::year_month_day>() ==
+    std::chrono::year_month_day{std::chrono::year{2024} / 2 / 29});
+#endif
+  using time_type = std::chrono::sys_time<std::chrono::microseconds>;
+  PQXX_CHECK(
+    row[1].as<time_type>() ==
+    time_type{std::chrono::sys_days{std::chrono::year{2000} / 1 / 2}});
+  PQXX_CHECK(not row[2].as<std::optional<int>>().has_value());
+
+  // In text format, the timestamp type can't convert.
+  PQXX_CHECK_THROWS(
+    std::ignore = tx.exec("SELECT now()").one_field().as<time_type>(),
+    pqxx::conversion_error);
+}
+
+} // namespace
+
+
+PQXX_REGISTER_TEST(test_binary_traits_decode_numbers);
+PQXX_REGISTER_TEST(test_binary_traits_decode_numeric);
+PQXX_REGISTER_TEST(test_binary_traits_decode_other);
+PQXX_REGISTER_TEST(test_binary_traits_encode);
+PQXX_REGISTER_TEST(test_exec_binary_result);
+PQXX_REGISTER_TEST(test_exec_prepared_binary_result);
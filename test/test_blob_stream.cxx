@@ -0,0 +1,103 @@
+#include <pqxx/blob>
+#include <pqxx/blob_stream>
+#include <pqxx/transaction>
+
+#include "helpers.hxx"
+
+namespace
+{
+/// Generate `size` bytes of arbitrary binary data.
+pqxx::bytes make_data(pqxx::test::context &tctx, std::size_t size)
+{
+  pqxx::bytes data;
+  data.reserve(size);
+  for (std::size_t i{0}; i < size; ++i)
+    data.push_back(static_cast<std::byte>(tctx.random_char()));
+  return data;
+}
+
+
+/// Read all of large object `id` through a @ref pqxx::blob_reader.
+pqxx::bytes read_all(
+  pqxx::dbtransaction &tx, pqxx::oid id, std::size_t chunk, std::size_t step)
+{
+  pqxx::blob_reader reader{tx, id, chunk, 3};
+  pqxx::bytes out;
+  pqxx::bytes buf(step);
+  for (auto got{reader.read(buf)}; not std::empty(got); got = reader.read(buf))
+    out.insert(std::end(out), std::begin(got), std::end(got));
+  PQXX_CHECK(reader.eof());
+  return out;
+}
+
+
+void test_blob_writer_and_reader(pqxx::test::context &tctx)
+{
+  auto const data{make_data(tctx, 10123)};
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  auto const id{pqxx::blob::create(tx)};
+
+  {
+    pqxx::blob_writer writer{tx, id, 1000, 3};
+    // A small write goes into the buffer, a large one mostly goes straight
+    // out, and the rest tops up the buffer again.
+    pqxx::bytes_view const view{data};
+    writer.write(view.first(7));
+    writer.write(view.subspan(7, 5000));
+    writer.write(view.subspan(5007));
+    writer.complete();
+    PQXX_CHECK_THROWS(writer.write(view.first(1)), pqxx::usage_error);
+  }
+
+  // The transaction is free for other queries again.
+  pqxx::bytes check;
+  pqxx::blob::to_buf(tx, id, check, 20000);
+  PQXX_CHECK(check == data);
+
+  PQXX_CHECK(read_all(tx, id, 1000, 333) == data);
+  PQXX_CHECK(read_all(tx, id, 4096, 10000) == data);
+}
+
+
+void test_blob_reader_stops_at_end(pqxx::test::context &tctx)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+
+  // An empty object.
+  auto const empty{pqxx::blob::create(tx)};
+  PQXX_CHECK(std::empty(read_all(tx, empty, 100, 10)));
+
+  // An object that's an exact multiple of the chunk size.
+  auto const data{make_data(tctx, 300)};
+  auto const id{pqxx::blob::from_buf(tx, data)};
+  PQXX_CHECK(read_all(tx, id, 100, 100) == data);
+
+  // We can stop reading half-way.
+  {
+    pqxx::blob_reader reader{tx, id, 10, 4};
+    pqxx::bytes buf(15);
+    PQXX_CHECK_EQUAL(std::size(reader.read(buf)), 15u);
+    PQXX_CHECK(not reader.eof());
+    reader.close();
+    PQXX_CHECK_THROWS(reader.read(buf), pqxx::usage_error);
+  }
+  PQXX_CHECK_EQUAL(tx.query_value<int>("SELECT 1"), 1);
+}
+
+
+void test_blob_stream_checks_parameters(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  auto const id{pqxx::blob::create(tx)};
+  PQXX_CHECK_THROWS((pqxx::blob_reader{tx, id, 0}), pqxx::range_error);
+  PQXX_CHECK_THROWS((pqxx::blob_writer{tx, id, 100, 0}), pqxx::range_error);
+}
+
+
+PQXX_REGISTER_TEST(test_blob_writer_and_reader);
+PQXX_REGISTER_TEST(test_blob_reader_stops_at_end);
+PQXX_REGISTER_TEST(test_blob_stream_checks_parameters);
+} // namespace
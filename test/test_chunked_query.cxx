@@ -0,0 +1,119 @@
+#include <format>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+#include <pqxx/nontransaction>
+#include <pqxx/transaction>
+
+#include "helpers.hxx"
+
+namespace
+{
+void test_query_chunked(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+
+  long total{0};
+  int count{0};
+  for (auto [x, name] : tx.query_chunked<int, std::string_view>(
+         "SELECT x, 'n' || x FROM generate_series(1, $1) AS x",
+         pqxx::params{2500}, 1000))
+  {
+    ++count;
+    PQXX_CHECK_EQUAL(x, count);
+    PQXX_CHECK_EQUAL(name, std::format("n{}", count));
+    total += x;
+  }
+  PQXX_CHECK_EQUAL(count, 2500);
+  PQXX_CHECK_EQUAL(total, 2500L * 2501L / 2L);
+
+  // Once we've read all rows, the transaction is free again.
+  PQXX_CHECK_EQUAL(tx.query_value<int>("SELECT 1"), 1);
+}
+
+
+void test_query_chunked_handles_any_query(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+
+  for ([[maybe_unused]] auto const &row :
+       tx.query_chunked<int>("SELECT 1 WHERE false"))
+    PQXX_CHECK(false, "Got a row from an empty result.");
+
+  tx.exec("CREATE TEMP TABLE chunky (id integer)").no_rows();
+  std::string ids;
+  for (auto [id] : tx.query_chunked<int>(
+         "INSERT INTO chunky (id) SELECT generate_series(1, 3) RETURNING id",
+         {}, 2))
+    ids += std::to_string(id);
+  PQXX_CHECK_EQUAL(ids, "123");
+}
+
+
+void test_for_query_chunked(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  std::string out;
+  tx.for_query_chunked(
+    "SELECT x, x * x FROM generate_series(1, 4) AS x",
+    [&out](int x, int square) { out += std::format("{}:{} ", x, square); },
+    {}, 3);
+  PQXX_CHECK_EQUAL(out, "1:1 2:4 3:9 4:16 ");
+}
+
+
+void test_query_chunked_reports_errors(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::nontransaction tx{cx};
+
+  PQXX_CHECK_THROWS(
+    std::ignore = tx.query_chunked<int>("SELECT 1", {}, 0),
+    pqxx::range_error);
+
+  // This query fails after it's produced a few rows.
+  int seen{0};
+  auto const fail{[&] {
+    for ([[maybe_unused]] auto const &row : tx.query_chunked<int>(
+           "SELECT 10 / (3 - x) FROM generate_series(1, 5) AS x", {}, 1))
+      ++seen;
+  }};
+  PQXX_CHECK_THROWS(fail(), pqxx::sql_error);
+  PQXX_CHECK_EQUAL(seen, 2);
+
+  // The connection is still usable.
+  PQXX_CHECK_EQUAL(tx.query_value<int>("SELECT 2"), 2);
+}
+
+
+void test_query_chunked_occupies_transaction(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  {
+    auto rows{tx.query_chunked<int>("SELECT generate_series(1, 10)")};
+    PQXX_CHECK_THROWS(tx.exec("SELECT 1"), pqxx::usage_error);
+
+    // Stop iterating early.
+    int seen{0};
+    for (auto [x] : rows)
+    {
+      PQXX_CHECK_EQUAL(x, ++seen);
+      if (seen == 2)
+        break;
+    }
+  }
+  PQXX_CHECK_EQUAL(tx.query_value<int>("SELECT 3"), 3);
+}
+
+
+PQXX_REGISTER_TEST(test_query_chunked);
+PQXX_REGISTER_TEST(test_query_chunked_handles_any_query);
+PQXX_REGISTER_TEST(test_for_query_chunked);
+PQXX_REGISTER_TEST(test_query_chunked_reports_errors);
+PQXX_REGISTER_TEST(test_query_chunked_occupies_transaction);
+} // namespace
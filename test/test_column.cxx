@@ -47,7 +47,40 @@ void test_table_column(pqxx::test::context &)
 
   PQXX_CHECK_THROWS_EXCEPTION(col = X.table_column(3));
 }
+
+
+void test_column_number_by_name(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  auto const r{tx.exec(
+    R"(SELECT n, n * 2 AS twice, -n AS "Neg", 0 AS n, 'x' AS "a""b" )"
+    "FROM generate_series(1, 3) AS n")};
+
+  // The first lookups go straight to libpq, the later ones use an index.
+  // Either way, they follow the same rules.
+  auto const copy{r};
+  for (auto const row : r)
+  {
+    auto const n{row["n"].as<int>()};
+    PQXX_CHECK_EQUAL(row["twice"].as<int>(), 2 * n);
+    PQXX_CHECK_EQUAL(row["TWICE"].as<int>(), 2 * n);
+    PQXX_CHECK_EQUAL(row[R"("Neg")"].as<int>(), -n);
+    PQXX_CHECK_EQUAL(row[R"("a""b")"].view(), "x");
+    PQXX_CHECK_THROWS(std::ignore = row["Neg"], pqxx::argument_error);
+    PQXX_CHECK_THROWS(std::ignore = row["neg"], pqxx::argument_error);
+    PQXX_CHECK_THROWS(std::ignore = row[""], pqxx::argument_error);
+  }
+
+  // With duplicate names, we get the first column of that name.
+  PQXX_CHECK_EQUAL(r.column_number("n"), 0);
+  // Copies of the result share the index.
+  PQXX_CHECK_EQUAL(copy.column_number("twice"), 1);
+  PQXX_CHECK_THROWS(
+    std::ignore = copy.column_number("thrice"), pqxx::argument_error);
+}
 } // namespace
 
 
 PQXX_REGISTER_TEST(test_table_column);
+PQXX_REGISTER_TEST(test_column_number_by_name);
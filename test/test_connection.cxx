@@ -1,3 +1,5 @@
+#include <cstdlib>
+#include <new>
 #include <numeric>
 
 #include <pqxx/nontransaction>
@@ -5,6 +7,38 @@
 
 #include "helpers.hxx"
 
+namespace
+{
+/// Number of `operator new` calls in this thread so far.
+/** Tests run in parallel threads, so each thread counts its own.
+ */
+thread_local std::size_t allocations{0};
+} // namespace
+
+
+// Count allocations, so we can check that the library avoids them.
+void *operator new(std::size_t size)
+{
+  ++allocations;
+  if (auto *const block{std::malloc((size == 0u) ? 1u : size)};
+      block != nullptr)
+    return block;
+  throw std::bad_alloc{};
+}
+
+
+void operator delete(void *block) noexcept
+{
+  std::free(block);
+}
+
+
+void operator delete(void *block, std::size_t) noexcept
+{
+  std::free(block);
+}
+
+
 namespace
 {
 void test_connection_string_constructor(pqxx::test::context &)
@@ -417,6 +451,44 @@ void test_connection_duplicate_params_overwrite(pqxx::test::context &tctx)
 }
 
 
+void test_connection_reuses_query_texts(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  auto const query{"SELECT $1::integer"};
+  auto const r1{tx.exec(query, pqxx::params{1})},
+    r2{tx.exec(query, pqxx::params{2})};
+  PQXX_CHECK_EQUAL(r1.query(), query);
+  PQXX_CHECK_EQUAL(r2.query(), query);
+  // Both results share the same copy of the query text.
+  PQXX_CHECK(&r1.query() == &r2.query());
+  PQXX_CHECK_EQUAL(r1.one_field().as<int>(), 1);
+  PQXX_CHECK_EQUAL(r2.one_field().as<int>(), 2);
+
+  // That goes for prepared statements' names as well.
+  cx.prepare("reused", query);
+  auto const p1{tx.exec(pqxx::prepped{"reused"}, pqxx::params{3})},
+    p2{tx.exec(pqxx::prepped{"reused"}, pqxx::params{4})};
+  PQXX_CHECK_EQUAL(p1.query(), "reused");
+  PQXX_CHECK(&p1.query() == &p2.query());
+  PQXX_CHECK_EQUAL(p2.one_field().as<int>(), 4);
+}
+
+
+void test_connection_exec_does_not_allocate(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  // The first execution interns the query text, and leaves a spare block for
+  // the next result's shared_ptr.  (It also sends the deferred BEGIN.)
+  std::ignore = tx.exec("SELECT 1");
+
+  auto const before{allocations};
+  for (int i{0}; i < 10; ++i) std::ignore = tx.exec("SELECT 1");
+  PQXX_CHECK_EQUAL(allocations, before);
+}
+
+
 void test_quote_columns_quotes_and_escapes(pqxx::test::context &)
 {
   pqxx::connection const cx;
@@ -450,4 +522,6 @@ PQXX_REGISTER_TEST(test_connection_takes_empty_string_and_params);
 PQXX_REGISTER_TEST(test_connection_takes_empty_string_and_empty_params);
 PQXX_REGISTER_TEST(test_connection_rejects_bad_string);
 PQXX_REGISTER_TEST(test_connection_duplicate_params_overwrite);
+PQXX_REGISTER_TEST(test_connection_reuses_query_texts);
+PQXX_REGISTER_TEST(test_connection_exec_does_not_allocate);
 } // namespace
@@ -0,0 +1,208 @@
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include <pqxx/connection_pool>
+#include <pqxx/nontransaction>
+#include <pqxx/transaction>
+
+#include "helpers.hxx"
+
+namespace
+{
+using namespace std::literals;
+
+
+void test_connection_pool_checks_config(pqxx::test::context &)
+{
+  pqxx::pool_config no_size;
+  no_size.min_size = 0;
+  no_size.max_size = 0;
+  PQXX_CHECK_THROWS(
+    pqxx::connection_pool("", no_size), pqxx::argument_error);
+
+  pqxx::pool_config upside_down;
+  upside_down.min_size = 3;
+  upside_down.max_size = 2;
+  PQXX_CHECK_THROWS(
+    pqxx::connection_pool("", upside_down), pqxx::argument_error);
+
+  // With a minimum size of zero, the pool does not connect until it needs to.
+  pqxx::pool_config lazy;
+  lazy.min_size = 0;
+  pqxx::connection_pool pool{"", lazy};
+  auto const stats{pool.stats()};
+  PQXX_CHECK_EQUAL(stats.idle, 0u);
+  PQXX_CHECK_EQUAL(stats.in_use, 0u);
+  PQXX_CHECK_EQUAL(stats.connecting, 0u);
+  PQXX_CHECK_EQUAL(stats.checkouts, 0u);
+
+  pool.prepare("stmt", "SELECT 1");
+  PQXX_CHECK_THROWS(pool.prepare("stmt", "SELECT 2"), pqxx::argument_error);
+  PQXX_CHECK_THROWS(
+    pool.set_session_var("application_name", std::optional<int>{}),
+    pqxx::variable_set_to_null);
+}
+
+
+void test_connection_pool_checkout(pqxx::test::context &)
+{
+  pqxx::pool_config config;
+  config.min_size = 1;
+  config.max_size = 2;
+  pqxx::connection_pool pool{"", config};
+
+  {
+    auto cx{pool.checkout()};
+    PQXX_CHECK(static_cast<bool>(cx));
+    pqxx::work tx{*cx};
+    PQXX_CHECK_EQUAL(tx.query_value<int>("SELECT 99"), 99);
+    tx.commit();
+  }
+
+  // The connection went back into the pool.  The next checkout gets it again.
+  auto stats{pool.stats()};
+  PQXX_CHECK_EQUAL(stats.checkouts, 1u);
+  PQXX_CHECK_EQUAL(stats.idle, 1u);
+  PQXX_CHECK_EQUAL(stats.in_use, 0u);
+
+  auto first{pool.checkout()};
+  auto second{pool.checkout()};
+  PQXX_CHECK(&first.get() != &second.get());
+  stats = pool.stats();
+  PQXX_CHECK_EQUAL(stats.checkouts, 3u);
+  PQXX_CHECK_EQUAL(stats.in_use, 2u);
+  PQXX_CHECK_EQUAL(stats.idle, 0u);
+
+  first.give_back();
+  PQXX_CHECK(not first);
+  PQXX_CHECK_EQUAL(pool.stats().idle, 1u);
+}
+
+
+void test_connection_pool_replays_registrations(pqxx::test::context &)
+{
+  pqxx::pool_config config;
+  config.min_size = 0;
+  pqxx::connection_pool pool{"", config};
+  pool.prepare("pooled_double", "SELECT 2 * $1::integer");
+  pool.set_session_var("application_name", "pooled"sv);
+
+  auto cx{pool.checkout()};
+  {
+    pqxx::work tx{*cx};
+    PQXX_CHECK_EQUAL(
+      tx.exec(pqxx::prepped{"pooled_double"}, pqxx::params{21}).one_field()
+        .as<int>(),
+      42);
+  }
+  PQXX_CHECK_EQUAL(cx->get_var("application_name"), "pooled");
+
+  // Registrations also apply to connections that were already open.
+  cx.give_back();
+  pool.prepare("pooled_triple", "SELECT 3 * $1::integer");
+  cx = pool.checkout();
+  PQXX_CHECK_EQUAL(pool.stats().connects, 1u);
+  // Neither checkout had to wait: one opened its own connection, and the
+  // other found it idle.
+  PQXX_CHECK_EQUAL(pool.stats().waits, 0u);
+  {
+    pqxx::work tx{*cx};
+    PQXX_CHECK_EQUAL(
+      tx.exec(pqxx::prepped{"pooled_triple"}, pqxx::params{3}).one_field()
+        .as<int>(),
+      9);
+  }
+
+  // Setting a variable again replaces its value, on old and new connections.
+  cx.give_back();
+  pool.set_session_var("application_name", "repooled"sv);
+  auto old_cx{pool.checkout()}, new_cx{pool.checkout()};
+  PQXX_CHECK_EQUAL(pool.stats().connects, 2u);
+  PQXX_CHECK_EQUAL(old_cx->get_var("application_name"), "repooled");
+  PQXX_CHECK_EQUAL(new_cx->get_var("application_name"), "repooled");
+}
+
+
+void test_connection_pool_times_out(pqxx::test::context &)
+{
+  pqxx::pool_config config;
+  config.min_size = 0;
+  config.max_size = 1;
+  config.checkout_timeout = 10ms;
+  pqxx::connection_pool pool{"", config};
+
+  auto cx{pool.checkout()};
+  PQXX_CHECK_THROWS(std::ignore = pool.checkout(), pqxx::failure);
+  auto const stats{pool.stats()};
+  PQXX_CHECK_EQUAL(stats.timeouts, 1u);
+  PQXX_CHECK_EQUAL(stats.checkouts, 1u);
+}
+
+
+void test_connection_pool_is_thread_safe(pqxx::test::context &)
+{
+  pqxx::pool_config config;
+  config.min_size = 1;
+  config.max_size = 2;
+  pqxx::connection_pool pool{"", config};
+
+  constexpr int threads{4}, rounds{10};
+  std::vector<std::thread> workers;
+  // An exception must not escape from a thread, so pass it on to the test.
+  std::vector<std::exception_ptr> errors(threads);
+  for (int t{0}; t < threads; ++t)
+    workers.emplace_back([&pool, &error = errors.at(t)] {
+      try
+      {
+        for (int r{0}; r < rounds; ++r)
+        {
+          auto cx{pool.checkout()};
+          pqxx::nontransaction tx{*cx};
+          std::ignore = tx.query_value<int>("SELECT 1");
+        }
+      }
+      catch (...)
+      {
+        error = std::current_exception();
+      }
+    });
+  for (auto &w : workers) w.join();
+  for (auto const &error : errors)
+    if (error)
+      std::rethrow_exception(error);
+
+  auto const stats{pool.stats()};
+  PQXX_CHECK_EQUAL(stats.checkouts, std::size_t{threads * rounds});
+  PQXX_CHECK_EQUAL(stats.in_use, 0u);
+  PQXX_CHECK(stats.connects <= 2u);
+  PQXX_CHECK(stats.max_checkout_time >= stats.max_wait_time);
+}
+
+
+void test_connection_pool_closes_idle_connections(pqxx::test::context &)
+{
+  pqxx::pool_config config;
+  config.min_size = 1;
+  config.max_size = 3;
+  config.idle_timeout = 0ms;
+  pqxx::connection_pool pool{"", config};
+
+  {
+    auto a{pool.checkout()}, b{pool.checkout()}, c{pool.checkout()};
+  }
+  PQXX_CHECK_EQUAL(pool.stats().idle, 3u);
+
+  // The pool closes idle connections, but keeps its minimum size.
+  pool.maintain();
+  PQXX_CHECK_EQUAL(pool.stats().idle, 1u);
+}
+
+
+PQXX_REGISTER_TEST(test_connection_pool_checks_config);
+PQXX_REGISTER_TEST(test_connection_pool_checkout);
+PQXX_REGISTER_TEST(test_connection_pool_replays_registrations);
+PQXX_REGISTER_TEST(test_connection_pool_times_out);
+PQXX_REGISTER_TEST(test_connection_pool_is_thread_safe);
+PQXX_REGISTER_TEST(test_connection_pool_closes_idle_connections);
+} // namespace
@@ -66,7 +66,87 @@ void test_icursorstream_tracks_creation_location(pqxx::test::context &)
 }
 
 
+void test_adaptive_cursorstream(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  pqxx::adaptive_cursorstream s{
+    tx, "SELECT * FROM generate_series(1, 5000)", "adaptive",
+    pqxx::cursorstream_config{.initial_stride = 10, .max_stride = 1000}};
+  PQXX_CHECK_EQUAL(s.stride(), 10);
+
+  int count{0};
+  pqxx::result r;
+  while (s >> r)
+  {
+    PQXX_CHECK_LESS_EQUAL(std::size(r), 1000);
+    for (auto const &row : r)
+    {
+      ++count;
+      PQXX_CHECK_EQUAL(row[0].as<int>(), count);
+    }
+  }
+  PQXX_CHECK(std::empty(r));
+  PQXX_CHECK_EQUAL(count, 5000);
+  PQXX_CHECK_GREATER(s.stride(), 10);
+  PQXX_CHECK_LESS_EQUAL(s.stride(), 1000);
+
+  // Once we've read all rows, the transaction is free again.
+  PQXX_CHECK_EQUAL(tx.query_value<int>("SELECT 7"), 7);
+}
+
+
+void test_adaptive_cursorstream_keeps_to_byte_budget(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  pqxx::adaptive_cursorstream s{
+    tx, "SELECT repeat('x', 10000) FROM generate_series(1, 100)", "wide",
+    pqxx::cursorstream_config{.fetch_bytes = 50000, .prefetch = false}};
+
+  pqxx::result r;
+  s >> r;
+  PQXX_CHECK_EQUAL(std::size(r), 64);
+  // Rows take up more than 10 kB each, so at most 5 fit in the budget.
+  PQXX_CHECK_LESS_EQUAL(s.stride(), 5);
+  PQXX_CHECK_GREATER_EQUAL(s.stride(), 1);
+
+  // Without prefetching, the transaction is free between fetches.
+  PQXX_CHECK_EQUAL(tx.query_value<int>("SELECT 8"), 8);
+  s >> r;
+  PQXX_CHECK_LESS_EQUAL(std::size(r), 5);
+}
+
+
+void test_adaptive_cursorstream_occupies_transaction(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  {
+    pqxx::adaptive_cursorstream s{
+      tx, "SELECT * FROM generate_series(1, 100)", "busy",
+      pqxx::cursorstream_config{.initial_stride = 2}};
+    pqxx::result r;
+    s >> r;
+    PQXX_CHECK_EQUAL(std::size(r), 2);
+
+    // The next fetch is in flight, so the transaction is busy.
+    PQXX_CHECK_THROWS(tx.exec("SELECT 1"), pqxx::usage_error);
+  }
+  // Destroying the stream frees up the transaction.
+  PQXX_CHECK_EQUAL(tx.query_value<int>("SELECT 9"), 9);
+
+  PQXX_CHECK_THROWS(
+    pqxx::adaptive_cursorstream(
+      tx, "SELECT 1", "bad", pqxx::cursorstream_config{.initial_stride = 0}),
+    pqxx::argument_error);
+}
+
+
 PQXX_REGISTER_TEST(test_cursor);
 PQXX_REGISTER_TEST(test_cursor_constants);
 PQXX_REGISTER_TEST(test_icursorstream_tracks_creation_location);
+PQXX_REGISTER_TEST(test_adaptive_cursorstream);
+PQXX_REGISTER_TEST(test_adaptive_cursorstream_keeps_to_byte_budget);
+PQXX_REGISTER_TEST(test_adaptive_cursorstream_occupies_transaction);
 } // namespace
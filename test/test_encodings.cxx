@@ -189,7 +189,79 @@ void test_find_chars_reports_malencoded_text(pqxx::test::context &tctx)
 }
 
 
+/// Search long texts in `ENC`, mixing ASCII and tricky multibyte characters.
+/** The texts are long enough to exercise the vectorised search, with the
+ * embedded '|' bytes landing at every position in a block.
+ */
+template<pqxx::encoding_group ENC> void check_long_search()
+{
+  auto const finder{pqxx::internal::get_char_finder<'|', ','>(ENC, loc())};
+  for (std::size_t lead{0}; lead < 40; ++lead)
+    for (std::size_t reps{0}; reps < 20; reps += 3)
+    {
+      std::string text(lead, 'x');
+      for (std::size_t i{0}; i < reps; ++i) text += tricky<ENC>;
+      text += eels<ENC>;
+      auto const end{std::size(text)};
+      PQXX_CHECK_EQUAL(finder(text, 0, loc()), end);
+      text += "ab,|";
+      PQXX_CHECK_EQUAL(finder(text, 0, loc()), end + 2);
+      PQXX_CHECK_EQUAL(finder(text, end + 3, loc()), end + 3);
+    }
+}
+
+
+void test_find_chars_in_long_text(pqxx::test::context &)
+{
+  check_long_search<pqxx::encoding_group::two_tier>();
+  check_long_search<pqxx::encoding_group::gb18030>();
+  check_long_search<pqxx::encoding_group::sjis>();
+
+  // The ASCII-safe group has no tricky text, so give it some UTF-8.
+  auto const finder{pqxx::internal::get_char_finder<'|', ','>(
+    pqxx::encoding_group::ascii_safe, loc())};
+  for (std::size_t lead{0}; lead < 40; ++lead)
+  {
+    std::string text(lead, 'x');
+    for (int i{0}; i < 10; ++i) text += "\xc3\xa9\xe2\x82\xac";
+    auto const end{std::size(text)};
+    PQXX_CHECK_EQUAL(finder(text, 0, loc()), end);
+    text += "|";
+    PQXX_CHECK_EQUAL(finder(text, 0, loc()), end);
+  }
+}
+
+
+void test_tab_or_backslash_finder(pqxx::test::context &)
+{
+  auto const find{pqxx::internal::get_tab_or_backslash_finder()};
+
+  PQXX_CHECK_EQUAL(find(""sv, 0, loc()), 0u);
+  PQXX_CHECK_EQUAL(find("abc"sv, 0, loc()), 3u);
+  PQXX_CHECK_EQUAL(find("a\tb"sv, 0, loc()), 1u);
+  PQXX_CHECK_EQUAL(find("a\tb"sv, 2, loc()), 3u);
+
+  // Try every position of a single special character, in texts long enough to
+  // go through the vectorised code paths, and the leftovers at the end.
+  for (std::size_t len{1}; len < 100; ++len)
+    for (std::size_t pos{0}; pos < len; ++pos)
+    {
+      std::string text(len, 'x');
+      text[pos] = ((pos % 2) == 0) ? '\t' : '\\';
+      PQXX_CHECK_EQUAL(find(text, 0, loc()), pos);
+      PQXX_CHECK_EQUAL(find(text, pos, loc()), pos);
+      PQXX_CHECK_EQUAL(find(text, pos + 1, loc()), len);
+    }
+
+  // Bytes with the high bit set must not confuse it.
+  std::string const utf8{"\xc3\xa9\xe2\x82\xac\xf0\x9f\x90\x9f\xc3\xa9\xe2"
+                         "\x82\xac\xf0\x9f\x90\x9f\xc3\xa9\xe2\x82\xac\\"};
+  PQXX_CHECK_EQUAL(find(utf8, 0, loc()), std::size(utf8) - 1);
+}
+
 PQXX_REGISTER_TEST(test_find_chars);
 PQXX_REGISTER_TEST(test_find_chars_fails_for_unfinished_character);
 PQXX_REGISTER_TEST(test_find_chars_reports_malencoded_text);
+PQXX_REGISTER_TEST(test_find_chars_in_long_text);
+PQXX_REGISTER_TEST(test_tab_or_backslash_finder);
 } // namespace
@@ -214,8 +214,45 @@ void test_binary_esc_checks_buffer_length(pqxx::test::context &)
 }
 
 
+/// Escape & unescape binary data long enough to go through the fast paths.
+void test_esc_bin_long(pqxx::test::context &tctx)
+{
+  // Odd size, so that there's some data left over after the 16-byte blocks.
+  pqxx::bytes data;
+  std::string expected{"\\x"};
+  for (int i{0}; i < 1001; ++i)
+  {
+    auto const byte{static_cast<unsigned>(i % 256)};
+    data.push_back(static_cast<std::byte>(byte));
+    expected += std::format("{:02x}", byte);
+  }
+
+  auto const escaped{pqxx::internal::esc_bin(data)};
+  PQXX_CHECK_EQUAL(escaped, expected);
+  PQXX_CHECK(pqxx::internal::unesc_bin(escaped, pqxx::sl::current()) == data);
+
+  // Upper-case hex digits are fine too.
+  std::string upper{escaped};
+  for (auto &c : upper)
+    if (c >= 'a' and c <= 'f')
+      c = static_cast<char>(c - 'a' + 'A');
+  PQXX_CHECK(pqxx::internal::unesc_bin(upper, pqxx::sl::current()) == data);
+
+  // A bad character anywhere is an error, whether in a block or in the tail.
+  for (char const bad : {'g', 'G', '/', ':', '@', '`', '\x80'})
+  {
+    std::string broken{escaped};
+    broken.at(2u + static_cast<std::size_t>(tctx.make_num(2000))) = bad;
+    PQXX_CHECK_THROWS(
+      std::ignore = pqxx::internal::unesc_bin(broken, pqxx::sl::current()),
+      pqxx::failure);
+  }
+}
+
+
 PQXX_REGISTER_TEST(test_escaping);
 PQXX_REGISTER_TEST(test_esc_escapes_into_buffer);
 PQXX_REGISTER_TEST(test_esc_accepts_various_types);
 PQXX_REGISTER_TEST(test_binary_esc_checks_buffer_length);
+PQXX_REGISTER_TEST(test_esc_bin_long);
 } // namespace
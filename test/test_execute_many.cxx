@@ -0,0 +1,116 @@
+#include <array>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <pqxx/nontransaction>
+#include <pqxx/transaction>
+
+#include "helpers.hxx"
+
+namespace
+{
+void test_execute_many(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  tx.exec("CREATE TEMP TABLE many (id integer, name text)").no_rows();
+  cx.prepare("insert_many", "INSERT INTO many VALUES ($1, $2) RETURNING id");
+
+  std::vector<std::tuple<int, std::string>> rows;
+  for (int i{0}; i < 1200; ++i) rows.emplace_back(i, std::to_string(i));
+
+  auto const results{tx.execute_many(pqxx::prepped{"insert_many"}, rows)};
+  PQXX_CHECK_EQUAL(std::size(results), std::size(rows));
+  int expected{0};
+  for (auto const &r : results)
+  {
+    PQXX_CHECK_EQUAL(r.one_field().as<int>(), expected);
+    ++expected;
+  }
+
+  // Once the batch is done, the transaction is free again.
+  PQXX_CHECK_EQUAL(tx.query_value<int>("SELECT count(*) FROM many"), 1200);
+  PQXX_CHECK_EQUAL(
+    tx.query_value<std::string>("SELECT name FROM many WHERE id = 999"),
+    "999");
+
+  // An unprepared statement works too.
+  std::vector<std::array<int, 1>> const ids{{1}, {2}, {3}};
+  auto const names{
+    tx.execute_many("SELECT name FROM many WHERE id = $1", ids)};
+  PQXX_CHECK_EQUAL(std::size(names), 3u);
+  PQXX_CHECK_EQUAL(names[2].one_field().as<std::string>(), "3");
+}
+
+
+struct item
+{
+  int id;
+  std::string name;
+};
+
+
+void test_execute_many_affected(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  tx.exec("CREATE TEMP TABLE items (id integer, name text)").no_rows();
+  tx.exec("INSERT INTO items VALUES (1, 'x'), (1, 'y'), (2, 'z')").no_rows();
+
+  std::vector<item> const items{{1, "a"}, {2, "b"}, {3, "c"}};
+  auto const counts{tx.execute_many_affected<&item::name, &item::id>(
+    "UPDATE items SET name = $1 WHERE id = $2", items)};
+  PQXX_CHECK_EQUAL(std::size(counts), 3u);
+  PQXX_CHECK_EQUAL(counts[0], 2);
+  PQXX_CHECK_EQUAL(counts[1], 1);
+  PQXX_CHECK_EQUAL(counts[2], 0);
+  PQXX_CHECK_EQUAL(
+    tx.query_value<int>("SELECT count(*) FROM items WHERE name = 'a'"), 2);
+
+  // An empty range executes nothing.
+  PQXX_CHECK(
+    std::empty(tx.execute_many_affected<&item::name, &item::id>(
+      "UPDATE items SET name = $1 WHERE id = $2", std::vector<item>{})));
+}
+
+
+void test_execute_many_reports_errors(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::nontransaction tx{cx};
+
+  std::vector<std::tuple<int>> const divisors{{1}, {2}, {0}, {4}};
+  PQXX_CHECK_THROWS(
+    std::ignore = tx.execute_many("SELECT 12 / $1::integer", divisors),
+    pqxx::data_exception);
+
+  // The batch leaves the connection in a usable state.
+  PQXX_CHECK_EQUAL(tx.query_value<int>("SELECT 8"), 8);
+}
+
+
+void test_execute_many_with_large_data(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+
+  // Enough data in both directions to fill the socket buffers.  If sending
+  // blocked while the server was waiting for us to read its results, this
+  // would deadlock.
+  std::string const big(64 * 1024, 'x');
+  std::vector<std::tuple<std::string>> const rows(200, {big});
+  auto const results{tx.execute_many("SELECT $1::text", rows)};
+  PQXX_CHECK_EQUAL(std::size(results), std::size(rows));
+  PQXX_CHECK_EQUAL(results.back().one_field().as<std::string>(), big);
+
+  // The connection is back in blocking mode, and usable.
+  PQXX_CHECK_EQUAL(tx.query_value<int>("SELECT 9"), 9);
+}
+
+
+PQXX_REGISTER_TEST(test_execute_many);
+PQXX_REGISTER_TEST(test_execute_many_affected);
+PQXX_REGISTER_TEST(test_execute_many_reports_errors);
+PQXX_REGISTER_TEST(test_execute_many_with_large_data);
+} // namespace
@@ -1,4 +1,6 @@
+#include <bit>
 #include <cmath>
+#include <cstdint>
 
 #include <pqxx/transaction>
 
@@ -169,8 +171,116 @@ void test_long_float(pqxx::test::context &)
 }
 
 
+/// Check that `value` converts to `text`, and back.
+template<typename T> void check_float_text(T value, std::string_view text)
+{
+  PQXX_CHECK_EQUAL(pqxx::to_string(value), text);
+  PQXX_CHECK_EQUAL(
+    std::bit_cast<std::uint64_t>(
+      static_cast<double>(pqxx::from_string<T>(text))),
+    std::bit_cast<std::uint64_t>(static_cast<double>(value)),
+    std::format("Bad round trip for '{}'.", text));
+}
+
+
+/// Test our own conversions against known-good text.
+void test_float_text(pqxx::test::context &)
+{
+  check_float_text(0.1, "0.1");
+  check_float_text(-0.0, "-0");
+  check_float_text(100.0, "100");
+  check_float_text(1234.5, "1234.5");
+  check_float_text(0.0001, "1e-04");
+  check_float_text(1e22, "1e+22");
+  check_float_text(1e23, "1e+23");
+  // Large integers come out exactly, not as the shortest digits plus zeroes.
+  check_float_text(123456789012345680000.0, "123456789012345683968");
+  check_float_text(9007199254740992.0, "9007199254740992");
+  check_float_text(5e-324, "5e-324");
+  check_float_text(1.7976931348623157e308, "1.7976931348623157e+308");
+
+  check_float_text(0.1f, "0.1");
+  check_float_text(16777216.0f, "16777216");
+  check_float_text(1e10f, "1e+10");
+  check_float_text(123456.7f, "123456.7");
+  check_float_text(1e-45f, "1e-45");
+  check_float_text(3.4028235e38f, "3.4028235e+38");
+}
+
+
+/// Test parsing of awkward floating-point text.
+void test_float_parse(pqxx::test::context &)
+{
+  PQXX_CHECK_EQUAL(pqxx::from_string<double>("  1.5"), 1.5);
+  PQXX_CHECK_EQUAL(pqxx::from_string<double>(".5"), 0.5);
+  PQXX_CHECK_EQUAL(pqxx::from_string<double>("5."), 5.0);
+  PQXX_CHECK_EQUAL(pqxx::from_string<double>("1E3"), 1000.0);
+  PQXX_CHECK_EQUAL(pqxx::from_string<float>("-2.5e-1"), -0.25f);
+  PQXX_CHECK(std::isnan(pqxx::from_string<double>("NaN")));
+  PQXX_CHECK_EQUAL(
+    pqxx::from_string<double>("-Infinity"),
+    -std::numeric_limits<double>::infinity());
+
+  // Exactly halfway between two doubles: round to even.
+  PQXX_CHECK_EQUAL(
+    pqxx::from_string<double>("9007199254740993"), 9007199254740992.0);
+  // More digits than fit in 64 bits, and they matter for the rounding.
+  PQXX_CHECK_EQUAL(
+    pqxx::from_string<double>("9007199254740993.0000000000000000001"),
+    9007199254740994.0);
+  PQXX_CHECK_EQUAL(
+    pqxx::from_string<double>("0.1000000000000000000000000000001"), 0.1);
+  PQXX_CHECK_EQUAL(
+    pqxx::from_string<double>("2.4703282292062328e-324"),
+    std::numeric_limits<double>::denorm_min());
+
+  [[maybe_unused]] double x{};
+  PQXX_CHECK_THROWS(
+    x = pqxx::from_string<double>("1e400"), pqxx::conversion_error);
+  PQXX_CHECK_THROWS(
+    x = pqxx::from_string<double>("1e-400"), pqxx::conversion_error);
+  PQXX_CHECK_THROWS(
+    x = pqxx::from_string<double>("1e"), pqxx::conversion_error);
+  PQXX_CHECK_THROWS(
+    x = pqxx::from_string<double>("-"), pqxx::conversion_error);
+  PQXX_CHECK_THROWS(
+    x = pqxx::from_string<double>("."), pqxx::conversion_error);
+}
+
+
+/// Check that arbitrary values of type `T` survive a round trip.
+template<typename T, typename BITS>
+void round_trip_floats(pqxx::test::context &tctx)
+{
+  for (int i{0}; i < 10000; ++i)
+  {
+    auto const bits{static_cast<BITS>(
+      (std::uint64_t(tctx.make_num()) << 62) ^
+      (std::uint64_t(tctx.make_num()) << 31) ^
+      std::uint64_t(tctx.make_num()))};
+    auto const value{std::bit_cast<T>(bits)};
+    if (std::isnan(value))
+      continue;
+    auto const text{pqxx::to_string(value)};
+    PQXX_CHECK_EQUAL(
+      std::bit_cast<BITS>(pqxx::from_string<T>(text)), bits,
+      std::format("Bad round trip for '{}'.", text));
+  }
+}
+
+
+void test_float_round_trip(pqxx::test::context &tctx)
+{
+  round_trip_floats<float, std::uint32_t>(tctx);
+  round_trip_floats<double, std::uint64_t>(tctx);
+}
+
+
 PQXX_REGISTER_TEST(test_infinities);
 PQXX_REGISTER_TEST(test_bug_262);
 PQXX_REGISTER_TEST(test_bad_float);
 PQXX_REGISTER_TEST(test_long_float);
+PQXX_REGISTER_TEST(test_float_text);
+PQXX_REGISTER_TEST(test_float_parse);
+PQXX_REGISTER_TEST(test_float_round_trip);
 } // namespace
@@ -0,0 +1,107 @@
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pqxx/nontransaction>
+#include <pqxx/notification_listener>
+#include <pqxx/transaction>
+
+#include "helpers.hxx"
+
+namespace
+{
+/// Keep calling `wait()` until `done()` returns true, or we give up.
+template<typename FUNC>
+void wait_until(pqxx::notification_listener &listener, FUNC done)
+{
+  for (int i{0}; (i < 100) and not done(); ++i)
+    listener.wait(std::chrono::milliseconds{100});
+}
+
+
+void test_notification_listener_dispatches(pqxx::test::context &)
+{
+  pqxx::notification_listener listener{pqxx::connection{}};
+
+  std::vector<std::string> got;
+  int pid{0};
+  listener.listen(
+    "pqxx-listener-a", [&](pqxx::received_notification const &n) {
+      got.emplace_back(std::string{n.channel} + ":" + std::string{n.payload});
+      pid = n.backend_pid;
+    });
+  listener.listen(
+    "pqxx-listener-b", [&](pqxx::received_notification const &n) {
+      got.emplace_back("b:" + std::string{n.payload});
+    });
+
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  tx.notify("pqxx-listener-a", "one");
+  tx.notify("pqxx-listener-b", "two");
+  tx.notify("pqxx-listener-c", "nobody listens");
+  tx.notify("pqxx-listener-a");
+  tx.commit();
+
+  wait_until(listener, [&got] { return std::size(got) >= 3; });
+  PQXX_CHECK_EQUAL(std::size(got), 3u);
+  PQXX_CHECK_EQUAL(got[0], "pqxx-listener-a:one");
+  PQXX_CHECK_EQUAL(got[1], "b:two");
+  PQXX_CHECK_EQUAL(got[2], "pqxx-listener-a:");
+  PQXX_CHECK_EQUAL(pid, cx.backendpid());
+
+  // After cancelling, we receive nothing more on the channel.
+  listener.listen("pqxx-listener-a");
+  pqxx::nontransaction{cx}.notify("pqxx-listener-a", "three");
+  listener.wait(std::chrono::milliseconds{200});
+  PQXX_CHECK_EQUAL(std::size(got), 3u);
+  PQXX_CHECK_EQUAL(listener.queued(), 0u);
+}
+
+
+void test_notification_listener_hands_off(pqxx::test::context &)
+{
+  pqxx::notification_listener listener{
+    pqxx::connection{},
+    pqxx::listener_config{.hand_off = true, .batch_size = 8}};
+
+  std::atomic<int> sum{0};
+  listener.listen("pqxx-listener-work", [&sum](auto const &n) {
+    sum += pqxx::from_string<int>(n.payload);
+  });
+
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  for (int i{1}; i <= 100; ++i)
+    tx.notify("pqxx-listener-work", pqxx::to_string(i));
+  tx.commit();
+
+  // Without workers, the notifications just pile up in the queue.
+  std::size_t received{0};
+  for (int i{0}; (i < 100) and (received < 100u); ++i)
+    received += listener.wait(std::chrono::milliseconds{100});
+  PQXX_CHECK_EQUAL(received, 100u);
+  PQXX_CHECK_EQUAL(listener.queued(), 100u);
+  PQXX_CHECK_EQUAL(sum.load(), 0);
+
+  PQXX_CHECK_EQUAL(listener.run_queued(10), 10u);
+  PQXX_CHECK_EQUAL(sum.load(), 55);
+
+  {
+    std::vector<std::jthread> workers;
+    for (int w{0}; w < 4; ++w)
+      workers.emplace_back(
+        [&listener](std::stop_token stop) { listener.serve(stop); });
+    for (int i{0}; (i < 100) and (listener.queued() > 0u); ++i)
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  }
+  PQXX_CHECK_EQUAL(listener.queued(), 0u);
+  PQXX_CHECK_EQUAL(sum.load(), 5050);
+}
+
+
+PQXX_REGISTER_TEST(test_notification_listener_dispatches);
+PQXX_REGISTER_TEST(test_notification_listener_hands_off);
+} // namespace
@@ -1,3 +1,8 @@
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+
 #include <pqxx/pqxx>
 
 #include "helpers.hxx"
@@ -6,6 +11,7 @@
 namespace
 {
 using pqxx::operator""_zv;
+using namespace std::literals;
 
 
 void test_statement_params(pqxx::test::context &)
@@ -27,5 +33,120 @@ void test_statement_params(pqxx::test::context &)
 }
 
 
+void test_params_convert_into_arena(pqxx::test::context &)
+{
+  pqxx::params p;
+  p.append(42);
+  p.append(std::string{"text"});
+  p.append(std::optional<int>{});
+  {
+    auto const c{p.make_c_params(pqxx::sl::current())};
+    PQXX_CHECK_EQUAL(std::size(c.values), 3u);
+    PQXX_CHECK_EQUAL(std::string_view{c.values[0]}, "42");
+    PQXX_CHECK_EQUAL(c.lengths[0], 2);
+    PQXX_CHECK_EQUAL(std::string_view{c.values[1]}, "text");
+    PQXX_CHECK(c.values[2] == nullptr);
+    PQXX_CHECK_EQUAL(c.formats[0], 0);
+    // Text parameters don't need types.
+    PQXX_CHECK(std::empty(c.types));
+  }
+
+  // Appending one params to another copies its converted values.
+  pqxx::params q;
+  q.append(7);
+  q.append(p);
+  p.clear();
+  PQXX_CHECK_EQUAL(std::size(p), 0u);
+  p.append(99);
+  {
+    auto const c{q.make_c_params(pqxx::sl::current())};
+    PQXX_CHECK_EQUAL(std::size(c.values), 4u);
+    PQXX_CHECK_EQUAL(std::string_view{c.values[0]}, "7");
+    PQXX_CHECK_EQUAL(std::string_view{c.values[1]}, "42");
+    PQXX_CHECK_EQUAL(std::string_view{c.values[2]}, "text");
+  }
+}
+
+
+void test_params_binary_values(pqxx::test::context &)
+{
+  pqxx::params p;
+  PQXX_CHECK(p.value_format() == pqxx::format::text);
+  p.set_value_format(pqxx::format::binary);
+  p.append(258);
+  p.append(true);
+  p.append(1.5);
+  p.append(std::string_view{"text"});
+  p.append(std::optional<short>{});
+
+  auto const c{p.make_c_params(pqxx::sl::current())};
+  PQXX_CHECK_EQUAL(std::size(c.values), 5u);
+  PQXX_CHECK_EQUAL(std::size(c.types), 5u);
+
+  PQXX_CHECK_EQUAL(c.formats[0], 1);
+  PQXX_CHECK_EQUAL(c.types[0], 23u);
+  PQXX_CHECK_EQUAL(c.lengths[0], 4);
+  PQXX_CHECK_EQUAL((std::string_view{c.values[0], 4}), "\0\0\1\2"sv);
+
+  PQXX_CHECK_EQUAL(c.types[1], 16u);
+  PQXX_CHECK_EQUAL(c.lengths[1], 1);
+  PQXX_CHECK_EQUAL(c.types[2], 701u);
+  PQXX_CHECK_EQUAL(c.lengths[2], 8);
+
+  // Other types still go as text, and let the server decide on the type.
+  PQXX_CHECK_EQUAL(c.formats[3], 0);
+  PQXX_CHECK_EQUAL(c.types[3], 0u);
+  PQXX_CHECK(c.values[4] == nullptr);
+
+  pqxx::params t;
+  PQXX_CHECK_THROWS(
+    t.append(std::chrono::sys_time<std::chrono::microseconds>{}),
+    pqxx::conversion_error);
+}
+
+
+void test_params_binary_round_trip(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  tx.exec("CREATE TEMP TABLE arena (i bigint, f float8, b boolean, t text)")
+    .no_rows();
+
+  pqxx::params p;
+  p.set_value_format(pqxx::format::binary);
+  for (int i{0}; i < 10; ++i)
+  {
+    p.clear();
+    p.append(i);
+    p.append(i * 0.5);
+    p.append(i % 2 == 0);
+    p.append(pqxx::to_string(i));
+    tx.exec("INSERT INTO arena (i, f, b, t) VALUES ($1, $2, $3, $4)", p)
+      .no_rows();
+  }
+
+  auto const [count, total, halves, evens, texts]{
+    tx.query1<int, long long, double, int, std::string>(
+      "SELECT count(*), sum(i), sum(f), count(*) FILTER (WHERE b), "
+      "string_agg(t, '' ORDER BY i) FROM arena")};
+  PQXX_CHECK_EQUAL(count, 10);
+  PQXX_CHECK_EQUAL(total, 45LL);
+  PQXX_CHECK_EQUAL(halves, 22.5);
+  PQXX_CHECK_EQUAL(evens, 5);
+  PQXX_CHECK_EQUAL(texts, "0123456789");
+
+  auto const now{std::chrono::time_point_cast<std::chrono::microseconds>(
+    std::chrono::system_clock::now())};
+  p.clear();
+  p.append(now);
+  PQXX_CHECK_EQUAL(
+    tx.query_value<std::string>("SELECT pg_typeof($1)::text", p),
+    "timestamp with time zone");
+}
+
+
 PQXX_REGISTER_TEST(test_statement_params);
+PQXX_REGISTER_TEST(test_params_convert_into_arena);
+PQXX_REGISTER_TEST(test_params_binary_values);
+PQXX_REGISTER_TEST(test_params_binary_round_trip);
 } // namespace
@@ -1,5 +1,6 @@
 #include <chrono>
 
+#include <pqxx/nontransaction>
 #include <pqxx/pipeline>
 #include <pqxx/transaction>
 
@@ -79,7 +80,57 @@ void test_pipeline(pqxx::test::context &)
     std::chrono::duration_cast<std::chrono::seconds>(finish - start).count()};
   PQXX_CHECK_LESS(seconds, 5, "Canceling a sleep took suspiciously long.");
 }
+
+
+void test_pipeline_params_and_prepared(pqxx::test::context &tctx)
+{
+  auto const name{tctx.make_name("pqxx-pipe")};
+  auto const x{tctx.make_num(1000)}, y{tctx.make_num(1000)};
+
+  pqxx::connection cx;
+  cx.prepare(name, "SELECT $1::integer * 2");
+  pqxx::work tx{cx};
+  pqxx::pipeline pipe{tx};
+
+  auto const plain{pipe.insert("SELECT 'plain'")};
+  auto const param{pipe.insert("SELECT $1::integer + $2", pqxx::params{x, y})};
+  auto const prep{pipe.insert(pqxx::prepped{name}, pqxx::params{x})};
+
+  // Retrieve out of order.
+  PQXX_CHECK_EQUAL(pipe.retrieve(prep).one_field().as<int>(), x * 2);
+  PQXX_CHECK_EQUAL(pipe.retrieve(plain).one_field().view(), "plain");
+  PQXX_CHECK_EQUAL(pipe.retrieve(param).one_field().as<int>(), x + y);
+  PQXX_CHECK(std::empty(pipe));
+}
+
+
+void test_pipeline_isolates_errors(pqxx::test::context &tctx)
+{
+  auto const value{tctx.make_num(1000)};
+
+  pqxx::connection cx;
+  pqxx::nontransaction tx{cx};
+  pqxx::pipeline pipe{tx};
+  pipe.retain(10);
+
+  auto const before{pipe.insert(std::format("SELECT {}", value))};
+  auto const bad{pipe.insert("SELECT * FROM pqxx_nonexistent_table")};
+  auto const after{pipe.insert(std::format("SELECT {} + 1", value))};
+  pipe.resume();
+
+  // The failing query does not stop the others from executing.
+  PQXX_CHECK_EQUAL(pipe.retrieve(after).one_field().as<int>(), value + 1);
+  PQXX_CHECK(pipe.is_finished(bad));
+  PQXX_CHECK_THROWS(pipe.retrieve(bad), pqxx::undefined_table);
+  PQXX_CHECK_EQUAL(pipe.retrieve(before).one_field().as<int>(), value);
+  pipe.complete();
+
+  // The connection is back in its normal state.
+  PQXX_CHECK_EQUAL(tx.exec("SELECT 9").one_field().as<int>(), 9);
+}
 } // namespace
 
 PQXX_REGISTER_TEST(test_pipeline_is_consistent);
 PQXX_REGISTER_TEST(test_pipeline);
+PQXX_REGISTER_TEST(test_pipeline_params_and_prepared);
+PQXX_REGISTER_TEST(test_pipeline_isolates_errors);
@@ -404,6 +404,88 @@ void test_prepped_query_does_not_need_terminating_zero(pqxx::test::context &)
 }
 
 
+void test_describe_prepared(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::transaction tx{cx};
+  cx.prepare("described", "SELECT $1::integer AS num, $2::text AS txt");
+
+  auto const desc{cx.describe_prepared("described")};
+  PQXX_CHECK_EQUAL(std::size(desc), 0);
+  PQXX_CHECK_EQUAL(desc.param_count(), 2);
+  PQXX_CHECK_EQUAL(
+    desc.param_type(0), tx.query_value<pqxx::oid>("SELECT 'int4'::regtype"));
+  PQXX_CHECK_EQUAL(
+    desc.param_type(1), tx.query_value<pqxx::oid>("SELECT 'text'::regtype"));
+  PQXX_CHECK_THROWS(std::ignore = desc.param_type(2), pqxx::argument_error);
+  PQXX_CHECK_EQUAL(desc.columns(), 2);
+  PQXX_CHECK_EQUAL(std::string_view{desc.column_name(1)}, "txt");
+  PQXX_CHECK_EQUAL(desc.column_number("txt"), 1);
+
+  // Now that we know the parameters, we can check them ourselves.
+  PQXX_CHECK_THROWS(
+    tx.exec(pqxx::prepped{"described"}, pqxx::params{1}),
+    pqxx::argument_error);
+  PQXX_CHECK_EQUAL(
+    tx.exec(pqxx::prepped{"described"}, pqxx::params{1, "x"})
+      .one_row()["txt"]
+      .as<std::string>(),
+    "x");
+}
+
+
+void test_prepared_column_lookup(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::transaction tx{cx};
+  cx.prepare(
+    "columns", R"(SELECT 1 AS one, 2 AS two, 3 AS "Three", 4 AS one)");
+
+  for (int i{0}; i < 2; ++i)
+  {
+    auto const r{tx.exec(pqxx::prepped{"columns"})};
+    auto const row{r.one_row()};
+    PQXX_CHECK_EQUAL(row["two"].as<int>(), 2);
+    // With duplicate names, we get the first column of that name.
+    PQXX_CHECK_EQUAL(row["one"].as<int>(), 1);
+    // Lookups follow the usual case folding and quoting rules.
+    PQXX_CHECK_EQUAL(row["TWO"].as<int>(), 2);
+    PQXX_CHECK_EQUAL(row[R"("Three")"].as<int>(), 3);
+    PQXX_CHECK_THROWS(std::ignore = row["Three"], pqxx::argument_error);
+    PQXX_CHECK_THROWS(std::ignore = row["four"], pqxx::argument_error);
+  }
+
+  // Redefining the statement replaces what we know about its columns.
+  cx.unprepare("columns");
+  cx.prepare("columns", "SELECT 5 AS five");
+  PQXX_CHECK_EQUAL(
+    tx.exec(pqxx::prepped{"columns"}).one_row()["five"].as<int>(), 5);
+  PQXX_CHECK_THROWS(
+    std::ignore = tx.exec(pqxx::prepped{"columns"}).one_row()["two"],
+    pqxx::argument_error);
+}
+
+
+void test_prepared_column_lookup_survives_sql_redefinition(
+  pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  cx.prepare("swapped", "SELECT 1 AS a, 2 AS b");
+  auto const before{tx.exec(pqxx::prepped{"swapped"}).one_row()};
+  PQXX_CHECK_EQUAL(before["a"].as<int>(), 1);
+  PQXX_CHECK_EQUAL(before["b"].as<int>(), 2);
+
+  // Redefine the statement behind libpqxx's back, with the same number of
+  // columns but in a different order.
+  tx.exec("DEALLOCATE swapped").no_rows();
+  tx.exec("PREPARE swapped AS SELECT 3 AS b, 4 AS a").no_rows();
+  auto const after{tx.exec(pqxx::prepped{"swapped"}).one_row()};
+  PQXX_CHECK_EQUAL(after["a"].as<int>(), 4);
+  PQXX_CHECK_EQUAL(after["b"].as<int>(), 3);
+}
+
+
 PQXX_REGISTER_TEST(test_prepared_statements);
 PQXX_REGISTER_TEST(test_placeholders_generates_names);
 PQXX_REGISTER_TEST(test_wrong_number_of_params);
@@ -411,4 +493,7 @@ PQXX_REGISTER_TEST(test_query_prepped);
 PQXX_REGISTER_TEST(test_query_value_prepped);
 PQXX_REGISTER_TEST(test_for_query_prepped);
 PQXX_REGISTER_TEST(test_prepped_query_does_not_need_terminating_zero);
+PQXX_REGISTER_TEST(test_describe_prepared);
+PQXX_REGISTER_TEST(test_prepared_column_lookup);
+PQXX_REGISTER_TEST(test_prepared_column_lookup_survives_sql_redefinition);
 } // namespace
@@ -1,4 +1,8 @@
+#include <array>
+#include <cstdint>
 #include <iterator>
+#include <optional>
+#include <vector>
 
 #include <pqxx/stream_to>
 #include <pqxx/transaction>
@@ -155,9 +159,130 @@ void test_result_for_each(pqxx::test::context &)
 }
 
 
+void test_row_schema(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  auto const query{
+    "SELECT n, 'row ' || n, CASE WHEN n > 1 THEN n * 1.5 END "
+    "FROM generate_series(1, 3) AS n"};
+
+  // The schema works the same, whether the data is in text or binary format.
+  for (auto const fmt : {pqxx::format::text, pqxx::format::binary})
+  {
+    auto const r{tx.exec(query, pqxx::params{}, fmt)};
+    pqxx::row_schema<int, std::string, std::optional<double>> const schema{r};
+    PQXX_CHECK_EQUAL(schema.width, 3);
+
+    auto const [n, text, half]{schema.read(0)};
+    PQXX_CHECK_EQUAL(n, 1);
+    PQXX_CHECK_EQUAL(text, "row 1");
+    PQXX_CHECK(not half.has_value());
+
+    std::tuple<int, std::string, std::optional<double>> row;
+    schema.read(2, row);
+    PQXX_CHECK_EQUAL(std::get<0>(row), 3);
+    PQXX_CHECK_EQUAL(std::get<1>(row), "row 3");
+    PQXX_CHECK_EQUAL(std::get<2>(row).value_or(0), 4.5);
+
+    // A null in a type that doesn't support it is still an error.
+    pqxx::row_schema<int, std::string, double> const strict{r};
+    PQXX_CHECK_THROWS(
+      std::ignore = strict.read(0), pqxx::conversion_error);
+    PQXX_CHECK_EQUAL(std::get<2>(strict.read(1)), 3.0);
+  }
+
+  // The schema checks the number of columns once, up front.
+  auto const r{tx.exec(query)};
+  PQXX_CHECK_THROWS(
+    (pqxx::row_schema<int, std::string>{r}), pqxx::usage_error);
+}
+
+
+struct sample_row
+{
+  int num{0};
+  std::string text;
+  int untouched{-1};
+};
+
+
+void test_result_iter_struct(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  auto const r{
+    tx.exec("SELECT n, 'row ' || n FROM generate_series(1, 3) AS n")};
+
+  std::vector<sample_row> rows;
+  for (auto const &row : r.iter_struct<&sample_row::num, &sample_row::text>())
+    rows.push_back(row);
+  PQXX_CHECK_EQUAL(std::size(rows), 3u);
+  PQXX_CHECK_EQUAL(rows.at(2).num, 3);
+  PQXX_CHECK_EQUAL(rows.at(2).text, "row 3");
+  PQXX_CHECK_EQUAL(rows.at(2).untouched, -1);
+
+  pqxx::struct_schema<&sample_row::text, &sample_row::num> const schema{r};
+  PQXX_CHECK_THROWS(std::ignore = schema.read(0), pqxx::conversion_error);
+  PQXX_CHECK_THROWS(
+    (pqxx::struct_schema<&sample_row::num>{r}), pqxx::usage_error);
+}
+
+
+void test_result_read_column(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  auto const query{
+    "SELECT CASE WHEN n % 3 = 0 THEN NULL ELSE n END, 'x' "
+    "FROM generate_series(1, 10) AS n"};
+
+  for (auto const fmt : {pqxx::format::text, pqxx::format::binary})
+  {
+    auto const r{tx.exec(query, pqxx::params{}, fmt)};
+    auto const col{r.read_column<int>(0)};
+    PQXX_CHECK_EQUAL(std::size(col.values), 10u);
+    PQXX_CHECK_EQUAL(std::size(col.validity), 2u);
+    PQXX_CHECK_EQUAL(col.null_count, 3);
+    PQXX_CHECK_EQUAL(col.values.at(0), 1);
+    PQXX_CHECK_EQUAL(col.values.at(9), 10);
+    PQXX_CHECK(not col.is_null(0));
+    PQXX_CHECK(col.is_null(2));
+    PQXX_CHECK_EQUAL(col.values.at(2), 0);
+    // Rows 2 and 5 are null in the first byte; row 8 in the second.
+    PQXX_CHECK_EQUAL(int{col.validity.at(0)}, 0xdb);
+    PQXX_CHECK_EQUAL(int{col.validity.at(1)}, 0x02);
+
+    auto const opt{r.read_column<std::optional<int>>(0)};
+    PQXX_CHECK(not opt.values.at(5).has_value());
+    PQXX_CHECK_EQUAL(opt.values.at(6).value_or(0), 7);
+  }
+
+  auto const r{tx.exec(query)};
+  std::array<long, 10> values{};
+  std::array<std::uint8_t, 2> validity{};
+  PQXX_CHECK_EQUAL(
+    r.read_column<long>(0, values, validity), 3);
+  PQXX_CHECK_EQUAL(values.at(3), 4L);
+  PQXX_CHECK_EQUAL(int{validity.at(1)}, 0x02);
+
+  std::array<std::uint8_t, 1> short_bitmap{};
+  PQXX_CHECK_THROWS(
+    r.read_column<long>(0, values, short_bitmap),
+    pqxx::argument_error);
+  PQXX_CHECK_THROWS(
+    std::ignore = r.read_column<int>(2), pqxx::range_error);
+  PQXX_CHECK_THROWS(
+    std::ignore = r.read_column<int>(1), pqxx::conversion_error);
+}
+
+
 PQXX_REGISTER_TEST(test_result_iteration);
 PQXX_REGISTER_TEST(test_result_iter);
 PQXX_REGISTER_TEST(test_result_iterator_swap);
 PQXX_REGISTER_TEST(test_result_iterator_assignment);
 PQXX_REGISTER_TEST(test_result_for_each);
+PQXX_REGISTER_TEST(test_row_schema);
+PQXX_REGISTER_TEST(test_result_iter_struct);
+PQXX_REGISTER_TEST(test_result_read_column);
 } // namespace
@@ -1,5 +1,7 @@
 #include <pqxx/transaction>
 
+#include <pqxx/internal/wait.hxx>
+
 #include "helpers.hxx"
 #include "sample_types.hxx"
 
@@ -64,6 +66,18 @@ void test_stream_iterates(pqxx::test::context &)
 }
 
 
+void test_stream_iterator_dereferences_repeatedly(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  auto stream{tx.stream<std::string>(R"(SELECT 'a\b\\c')")};
+  auto const it{stream.begin()};
+  PQXX_CHECK(it != stream.end());
+  // Parsing unescapes the line, so a second parse would get this wrong.
+  PQXX_CHECK_EQUAL(std::get<0>(*it), R"(a\b\\c)");
+  PQXX_CHECK_EQUAL(std::get<0>(*it), R"(a\b\\c)");
+}
+
 void test_stream_reads_simple_values(pqxx::test::context &)
 {
   pqxx::connection cx;
@@ -317,15 +331,127 @@ void test_stream_only_requires_move_constructor(pqxx::test::context &tctx)
   PQXX_CHECK(found);
 }
 
+
+void test_stream_reads_binary(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  int rows{0};
+  for (auto [n, big, d, s, b, opt] :
+       tx.stream<int, long long, double, std::string_view, bool,
+                 std::optional<short>>(
+         "SELECT n, n::bigint * 1000000000, n / 2.0::float8, "
+         "'x\t' || n::text, n % 2 = 0, NULLIF(n % 3, 0)::smallint "
+         "FROM generate_series(1, 10) AS n",
+         pqxx::format::binary))
+  {
+    ++rows;
+    PQXX_CHECK_EQUAL(n, rows);
+    PQXX_CHECK_EQUAL(big, rows * 1000000000LL);
+    PQXX_CHECK_EQUAL(d, rows / 2.0);
+    PQXX_CHECK_EQUAL(s, std::format("x\t{}", rows));
+    PQXX_CHECK_EQUAL(b, (rows % 2) == 0);
+    PQXX_CHECK_EQUAL(opt.has_value(), (rows % 3) != 0);
+  }
+  PQXX_CHECK_EQUAL(rows, 10);
+
+  // An empty binary stream has a header and a trailer, but no rows.
+  for (auto [n] : tx.stream<int>("SELECT 1 WHERE false", pqxx::format::binary))
+    PQXX_CHECK(false, std::format("Unexpectedly got a value: {}", n));
+}
+
+
+void test_binary_stream_checks_string_types(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+
+  // Text-like columns read fine into strings.
+  for (auto [t, v, c] : tx.stream<std::string, std::string_view, std::string>(
+         "SELECT 'abc'::text, 'def'::varchar, 'g'::char(2)",
+         pqxx::format::binary))
+  {
+    PQXX_CHECK_EQUAL(t, "abc");
+    PQXX_CHECK_EQUAL(v, "def");
+    PQXX_CHECK_EQUAL(c, "g ");
+  }
+
+  // A uuid or numeric is not text, but a std::string can convert it.
+  for (auto [u, n] : tx.stream<std::string, std::optional<std::string>>(
+         "SELECT 'a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11'::uuid, 12.5::numeric",
+         pqxx::format::binary))
+  {
+    PQXX_CHECK_EQUAL(u, "a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11");
+    PQXX_CHECK_EQUAL(n.value_or(""), "12.5");
+  }
+
+  // Other types don't convert.  We used to hand out their raw binary data.
+  // (Abandoning a stream leaves its connection unusable, so each of these
+  // gets its own connection.)
+  auto const read_view{[](std::string_view query) {
+    pqxx::connection cx2;
+    pqxx::work tx2{cx2};
+    for (auto [v] : tx2.stream<std::string_view>(query, pqxx::format::binary))
+      pqxx::ignore_unused(v);
+  }};
+  PQXX_CHECK_THROWS(
+    read_view("SELECT now()::timestamptz"), pqxx::conversion_error);
+  PQXX_CHECK_THROWS(read_view("SELECT 12.5::numeric"), pqxx::conversion_error);
+}
+
+
+void test_stream_reads_without_blocking(pqxx::test::context &)
+{
+  // Run two streams, on two connections, from a single thread.
+  pqxx::connection cx1, cx2;
+  pqxx::work tx1{cx1}, tx2{cx2};
+  auto s1{tx1.stream<int, std::string_view>(
+    "SELECT n, repeat('x', n) FROM generate_series(1, 500) AS n")};
+  auto s2{tx2.stream<int>(
+    "SELECT n FROM generate_series(1, 300) AS n", pqxx::format::binary)};
+
+  int count1{0}, count2{0};
+  while (not s1.done() or not s2.done())
+  {
+    bool progress{false};
+    while (auto const row{s1.try_read_row()})
+    {
+      ++count1;
+      PQXX_CHECK_EQUAL(std::get<0>(*row), count1);
+      PQXX_CHECK_EQUAL(std::size(std::get<1>(*row)), std::size_t(count1));
+      progress = true;
+    }
+    while (auto const row{s2.try_read_row()})
+    {
+      ++count2;
+      PQXX_CHECK_EQUAL(std::get<0>(*row), count2);
+      progress = true;
+    }
+    if (not progress and not s1.done())
+      pqxx::internal::wait_fd(cx1.sock(), true, false, 0, 10000);
+  }
+  PQXX_CHECK_EQUAL(count1, 500);
+  PQXX_CHECK_EQUAL(count2, 300);
+
+  // Both connections are usable again.
+  PQXX_CHECK_EQUAL(tx1.query_value<int>("SELECT 1"), 1);
+  PQXX_CHECK_EQUAL(tx2.query_value<int>("SELECT 2"), 2);
+}
+
+
 PQXX_REGISTER_TEST(test_stream_handles_empty);
 PQXX_REGISTER_TEST(test_stream_does_escaping);
 PQXX_REGISTER_TEST(test_stream_reads_simple_values);
 PQXX_REGISTER_TEST(test_stream_reads_string_view);
 PQXX_REGISTER_TEST(test_stream_iterates);
+PQXX_REGISTER_TEST(test_stream_iterator_dereferences_repeatedly);
 PQXX_REGISTER_TEST(test_stream_reads_nulls_as_optionals);
 PQXX_REGISTER_TEST(test_stream_reads_arrays);
 PQXX_REGISTER_TEST(test_stream_parses_awkward_strings);
 PQXX_REGISTER_TEST(test_stream_handles_nulls_in_all_places);
 PQXX_REGISTER_TEST(test_stream_handles_empty_string);
 PQXX_REGISTER_TEST(test_stream_only_requires_move_constructor);
+PQXX_REGISTER_TEST(test_stream_reads_binary);
+PQXX_REGISTER_TEST(test_binary_stream_checks_string_types);
+PQXX_REGISTER_TEST(test_stream_reads_without_blocking);
 } // namespace
@@ -735,6 +735,89 @@ void test_stream_to_bool(pqxx::test::context &tctx)
 }
 
 
+void test_stream_to_batches_rows(pqxx::test::context &tctx)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  auto const table{tctx.make_name("pqxx_batch")};
+  tx.exec(std::format(
+            "CREATE TEMP TABLE {} (n integer, s text)", tx.quote_name(table)))
+    .no_rows();
+  auto stream{pqxx::stream_to::table(tx, {table}, {"n", "s"})};
+
+  // Flush every 7 rows, or every 100 bytes, whichever comes first.
+  stream.set_batch_limits(100, 7);
+  int const rows{1000};
+  for (int n{0}; n < rows; ++n)
+    if ((n % 2) == 0)
+      stream.write_values(n, std::format("row\t{}", n));
+    else
+      stream << std::make_tuple(n, std::optional<std::string>{});
+
+  // Switch to unlimited batches, and force a flush halfway.
+  stream.set_batch_limits(std::numeric_limits<std::size_t>::max());
+  stream.write_values(rows, "x");
+  stream.flush();
+  stream.write_values(rows + 1, "y");
+  stream.complete();
+
+  auto const [count, sum, nulls]{
+    tx.query1<int, long long, int>(std::format(
+      "SELECT count(*), sum(n), count(*) FILTER (WHERE s IS NULL) FROM {}",
+      tx.quote_name(table)))};
+  PQXX_CHECK_EQUAL(count, rows + 2);
+  PQXX_CHECK_EQUAL(sum, (rows + 1LL) * (rows + 2LL) / 2);
+  PQXX_CHECK_EQUAL(nulls, rows / 2);
+  PQXX_CHECK_EQUAL(
+    tx.query_value<std::string>(std::format(
+      "SELECT s FROM {} WHERE n = 998", tx.quote_name(table))),
+    "row\t998");
+}
+
+
+void test_stream_to_binary(pqxx::test::context &tctx)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  auto const table{tctx.make_name("pqxx_binary")};
+  tx.exec(std::format(
+            "CREATE TEMP TABLE {} "
+            "(i integer, b bigint, s smallint, d float8, f float4, "
+            "ok boolean, t text, data bytea, maybe integer)",
+            tx.quote_name(table)))
+    .no_rows();
+  auto stream{pqxx::stream_to::table(
+    tx, {table}, {"i", "b", "s", "d", "f", "ok", "t", "data", "maybe"},
+    pqxx::format::binary)};
+  stream.write_values(
+    -1, 10000000000LL, short{7}, 0.5, 1.5f, true, "a\tb\\c",
+    pqxx::bytes{std::byte{0}, std::byte{0xff}}, std::optional<int>{});
+  stream << std::make_tuple(
+    2, -3LL, short{-4}, -0.25, 0.0f, false, std::string{}, pqxx::bytes{},
+    std::optional<int>{99});
+  stream.complete();
+
+  auto const r{tx.exec(std::format(
+    "SELECT i, b, s, d, f, ok, t, data, maybe FROM {} ORDER BY i",
+    tx.quote_name(table)))};
+  PQXX_CHECK_EQUAL(std::size(r), 2);
+  PQXX_CHECK_EQUAL(r[0][0].as<int>(), -1);
+  PQXX_CHECK_EQUAL(r[0][1].as<long long>(), 10000000000LL);
+  PQXX_CHECK_EQUAL(r[0][2].as<short>(), 7);
+  PQXX_CHECK_EQUAL(r[0][3].as<double>(), 0.5);
+  PQXX_CHECK_EQUAL(r[0][4].as<float>(), 1.5f);
+  PQXX_CHECK(r[0][5].as<bool>());
+  PQXX_CHECK_EQUAL(r[0][6].as<std::string>(), "a\tb\\c");
+  PQXX_CHECK(
+    r[0][7].as<pqxx::bytes>() ==
+    (pqxx::bytes{std::byte{0}, std::byte{0xff}}));
+  PQXX_CHECK(r[0][8].is_null());
+  PQXX_CHECK_EQUAL(r[1][1].as<long long>(), -3LL);
+  PQXX_CHECK_EQUAL(r[1][6].as<std::string>(), "");
+  PQXX_CHECK_EQUAL(r[1][8].as<int>(), 99);
+}
+
+
 PQXX_REGISTER_TEST(test_stream_to);
 PQXX_REGISTER_TEST(test_container_stream_to);
 PQXX_REGISTER_TEST(test_stream_to_does_nonnull_optional);
@@ -748,4 +831,6 @@ PQXX_REGISTER_TEST(test_stream_to_empty_strings);
 PQXX_REGISTER_TEST(test_stream_to_transcodes);
 PQXX_REGISTER_TEST(test_stream_to_handles_embedded_special_values);
 PQXX_REGISTER_TEST(test_stream_to_bool);
+PQXX_REGISTER_TEST(test_stream_to_batches_rows);
+PQXX_REGISTER_TEST(test_stream_to_binary);
 } // namespace
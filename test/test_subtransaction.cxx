@@ -74,5 +74,101 @@ void test_subtransaction(pqxx::test::context &)
 }
 
 
+void test_deferred_subtransaction(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx, pqxx::begin_policy::deferred};
+  make_table(tx);
+
+  // A deferred subtransaction that does nothing is fine.
+  pqxx::subtransaction{tx, pqxx::begin_policy::deferred}.commit();
+  pqxx::subtransaction{tx, pqxx::begin_policy::deferred}.abort();
+
+  {
+    pqxx::subtransaction sub{tx, "keep", pqxx::begin_policy::deferred};
+    insert_row(sub);
+    insert_row(sub);
+    sub.commit();
+  }
+  {
+    pqxx::subtransaction sub{tx, pqxx::begin_policy::deferred};
+    insert_row(sub);
+    sub.abort();
+  }
+  PQXX_CHECK_EQUAL(count_rows(tx), 2);
+  tx.abort();
+
+  // A subtransaction starts a deferred parent transaction.
+  pqxx::work tx2{cx, pqxx::begin_policy::deferred};
+  pqxx::subtransaction sub{tx2};
+  PQXX_CHECK_EQUAL(sub.query_value<int>("SELECT 1"), 1);
+}
+
+
+void test_subtransaction_exec_and_commit(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  tx.exec("CREATE TEMP TABLE items (id integer PRIMARY KEY)").no_rows();
+
+  // Import rows one by one, skipping the ones that fail.
+  int failures{0};
+  for (int const id : {1, 2, 2, 3, 1, 4})
+  {
+    pqxx::subtransaction sub{tx, pqxx::begin_policy::deferred};
+    try
+    {
+      PQXX_CHECK_EQUAL(
+        sub
+          .exec_and_commit(
+            "INSERT INTO items (id) VALUES ($1) RETURNING id",
+            pqxx::params{id})
+          .one_field()
+          .as<int>(),
+        id);
+    }
+    catch (pqxx::unique_violation const &)
+    {
+      ++failures;
+    }
+  }
+  PQXX_CHECK_EQUAL(failures, 2);
+  PQXX_CHECK_EQUAL(tx.query_value<int>("SELECT count(*) FROM items"), 4);
+
+  // It also works with a savepoint that's already been set.
+  pqxx::subtransaction sub{tx};
+  PQXX_CHECK_EQUAL(
+    sub.exec_and_commit("SELECT sum(id) FROM items").one_field().as<int>(),
+    10);
+  PQXX_CHECK_THROWS(sub.exec("SELECT 1"), pqxx::usage_error);
+  tx.commit();
+}
+
+
+void test_deferred_subtransaction_survives_syntax_error(
+  pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  make_table(tx);
+  insert_row(tx);
+
+  {
+    pqxx::subtransaction sub{tx, pqxx::begin_policy::deferred};
+    PQXX_CHECK_THROWS(sub.exec("SELEKT 1"), pqxx::syntax_error);
+    // The savepoint got set before the error, so we can roll back to it.
+    sub.abort();
+  }
+
+  // The parent transaction is still usable.
+  insert_row(tx);
+  PQXX_CHECK_EQUAL(count_rows(tx), 2);
+  tx.commit();
+}
+
+
 PQXX_REGISTER_TEST(test_subtransaction);
+PQXX_REGISTER_TEST(test_deferred_subtransaction);
+PQXX_REGISTER_TEST(test_subtransaction_exec_and_commit);
+PQXX_REGISTER_TEST(test_deferred_subtransaction_survives_syntax_error);
 } // namespace
@@ -1,4 +1,5 @@
 #include <pqxx/nontransaction>
+#include <pqxx/pipeline>
 #include <pqxx/robusttransaction>
 
 #include "helpers.hxx"
@@ -138,7 +139,162 @@ void test_transaction(pqxx::test::context &tctx)
 }
 
 
+void test_deferred_begin(pqxx::test::context &)
+{
+  pqxx::connection cx;
+
+  // A deferred transaction that never executes anything is fine.
+  pqxx::work tx1{cx, pqxx::begin_policy::deferred};
+  tx1.commit();
+  pqxx::work tx2{cx, pqxx::begin_policy::deferred};
+  tx2.abort();
+
+  // The BEGIN goes out with the first statement.  Within a transaction,
+  // now() stays the same.
+  pqxx::work tx3{cx, pqxx::begin_policy::deferred};
+  auto const start{tx3.query_value<std::string>("SELECT now()::text")};
+  PQXX_CHECK_EQUAL(tx3.query_value<std::string>("SELECT now()::text"), start);
+  tx3.exec("CREATE TEMP TABLE deferred (x integer)").no_rows();
+  tx3.abort();
+
+  // Aborting rolled back the table creation.  This time the first statement
+  // has parameters, so the BEGIN goes out in a pipeline.
+  pqxx::work tx4{cx, "tx4", pqxx::begin_policy::deferred};
+  PQXX_CHECK_EQUAL(
+    tx4.exec("SELECT count(*) FROM pg_tables WHERE tablename = $1",
+             pqxx::params{"deferred"})
+      .one_field()
+      .as<int>(),
+    0);
+  PQXX_CHECK_EQUAL(
+    tx4.query_value<std::string>("SELECT now()::text"),
+    tx4.query_value<std::string>("SELECT now()::text"));
+  tx4.commit();
+
+  // Other isolation levels work the same way.
+  pqxx::transaction<pqxx::serializable> tx5{
+    cx, pqxx::begin_policy::deferred};
+  PQXX_CHECK_EQUAL(tx5.query_value<int>("SELECT 5"), 5);
+  tx5.commit();
+}
+
+
+void test_deferred_begin_starts_for_streams(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx, pqxx::begin_policy::deferred};
+  std::string start;
+  for (auto [now] : tx.stream<std::string>("SELECT now()::text")) start = now;
+  PQXX_CHECK_EQUAL(tx.query_value<std::string>("SELECT now()::text"), start);
+}
+
+
+void test_deferred_begin_survives_syntax_error(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx, pqxx::begin_policy::deferred};
+
+  // The error is about our query, not about the BEGIN that went with it.
+  std::string failed;
+  try
+  {
+    tx.exec("SELEKT 1").no_rows();
+  }
+  catch (pqxx::syntax_error const &e)
+  {
+    failed = e.query();
+  }
+  PQXX_CHECK_EQUAL(failed, "SELEKT 1");
+
+  // The transaction did start, and the error aborted it.  It does not
+  // quietly fall back to autocommit.
+  std::string sqlstate;
+  try
+  {
+    std::ignore = tx.query_value<int>("SELECT 1");
+  }
+  catch (pqxx::sql_error const &e)
+  {
+    sqlstate = e.sqlstate();
+  }
+  PQXX_CHECK_EQUAL(sqlstate, "25P02");
+}
+
+
+void test_exec_and_commit(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::nontransaction{cx}
+    .exec("CREATE TEMP TABLE commits (x integer)")
+    .no_rows();
+
+  pqxx::work tx1{cx, pqxx::begin_policy::deferred};
+  PQXX_CHECK_EQUAL(
+    tx1
+      .exec_and_commit(
+        "INSERT INTO commits VALUES ($1) RETURNING x", pqxx::params{7})
+      .one_field()
+      .as<int>(),
+    7);
+  PQXX_CHECK_THROWS(tx1.exec("SELECT 1"), pqxx::usage_error);
+
+  pqxx::work tx2{cx};
+  tx2.exec("INSERT INTO commits VALUES (8)").no_rows();
+  PQXX_CHECK_THROWS(
+    tx2.exec_and_commit("SELECT 1 / 0"), pqxx::data_exception);
+  PQXX_CHECK_THROWS(tx2.commit(), pqxx::usage_error);
+
+  cx.prepare("sum_commits", "SELECT sum(x) FROM commits");
+  pqxx::work tx3{cx, pqxx::begin_policy::deferred};
+  PQXX_CHECK_EQUAL(
+    tx3.exec_and_commit(pqxx::prepped{"sum_commits"}).one_field().as<int>(),
+    7);
+
+  // If the COMMIT fails, that's the error we see.
+  pqxx::work tx4{cx};
+  tx4.exec("CREATE TEMP TABLE unique_commits (id integer UNIQUE DEFERRABLE "
+           "INITIALLY DEFERRED)")
+    .no_rows();
+  std::string failed;
+  try
+  {
+    std::ignore =
+      tx4.exec_and_commit("INSERT INTO unique_commits VALUES (1), (1)");
+  }
+  catch (pqxx::unique_violation const &e)
+  {
+    failed = e.query();
+  }
+  PQXX_CHECK_EQUAL(failed, "COMMIT");
+  PQXX_CHECK_THROWS(tx4.commit(), pqxx::usage_error);
+
+  // The connection is in a sane state.
+  pqxx::work tx5{cx};
+  PQXX_CHECK_EQUAL(tx5.query_value<int>("SELECT count(*) FROM commits"), 1);
+}
+
+
+void test_exec_and_commit_focus_clash(pqxx::test::context &)
+{
+  pqxx::connection cx;
+  pqxx::work tx{cx};
+  {
+    pqxx::pipeline pipe{tx};
+    // Calling exec_and_commit() while a pipeline is open is a mistake, but
+    // it does not cost us the transaction.
+    PQXX_CHECK_THROWS(tx.exec_and_commit("SELECT 1"), pqxx::usage_error);
+  }
+  PQXX_CHECK_EQUAL(tx.query_value<int>("SELECT 2"), 2);
+  tx.commit();
+}
+
+
 PQXX_REGISTER_TEST(test_nontransaction_continues_after_error);
 PQXX_REGISTER_TEST(test_nontransaction_autocommits);
 PQXX_REGISTER_TEST(test_transaction);
+PQXX_REGISTER_TEST(test_deferred_begin);
+PQXX_REGISTER_TEST(test_deferred_begin_starts_for_streams);
+PQXX_REGISTER_TEST(test_deferred_begin_survives_syntax_error);
+PQXX_REGISTER_TEST(test_exec_and_commit);
+PQXX_REGISTER_TEST(test_exec_and_commit_focus_clash);
 } // namespace
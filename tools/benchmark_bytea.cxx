@@ -0,0 +1,258 @@
+// Microbenchmarks for libpqxx's bytea hex encoding and decoding.
+/** This tool times how fast libpqxx can convert binary data to and from
+ * PostgreSQL's hex escape format, as used for `bytea` values.
+ *
+ * For each direction it compares:
+ *
+ * 1. a plain conversion that handles one nibble at a time,
+ * 2. the conversion that libpqxx actually uses.
+ *
+ * It needs no database.  Use the "--help" (or "-h") option for instructions.
+ */
+#include <pqxx/pqxx>
+
+#include <chrono>
+#include <format>
+#include <iostream>
+
+namespace
+{
+using namespace std::literals;
+
+
+/// Fatal but well-handled error.
+struct fail final : std::runtime_error
+{
+  explicit fail(std::string const &whatarg) : std::runtime_error{whatarg} {}
+};
+
+
+/// Early successful exit.
+struct early_exit final : std::exception
+{};
+
+
+struct options
+{
+  /// Size of the binary data, in bytes.
+  std::size_t size = 4u * 1024u * 1024u;
+
+  /// Number of times to convert the data.
+  std::size_t rounds = 100u;
+};
+
+
+/// Compose arbitrary binary data.
+pqxx::bytes make_data(options const &opts)
+{
+  pqxx::bytes data;
+  data.reserve(opts.size);
+  // A simple linear congruential generator will do.
+  std::uint32_t state{1u};
+  for (std::size_t i{0}; i < opts.size; ++i)
+  {
+    state = state * 1664525u + 1013904223u;
+    data.push_back(static_cast<std::byte>(state >> 24));
+  }
+  return data;
+}
+
+
+/// Hex-encode `data`, one nibble at a time.
+/** This is how libpqxx did it before vectorising the conversion.
+ */
+void esc_nibblewise(pqxx::bytes_view data, std::span<char> buffer)
+{
+  constexpr auto digits{"0123456789abcdef"sv};
+  std::size_t here{0u};
+  buffer[here++] = '\\';
+  buffer[here++] = 'x';
+  for (auto const byte : data)
+  {
+    auto const uc{static_cast<unsigned char>(byte)};
+    buffer[here++] = digits[uc >> 4];
+    buffer[here++] = digits[uc & 0x0f];
+  }
+  buffer[here] = '\0';
+}
+
+
+/// Translate a hex digit to a nibble, or -1 if it's not a valid digit.
+constexpr int nibble(int c) noexcept
+{
+  if (c >= '0' and c <= '9')
+    return c - '0';
+  else if (c >= 'a' and c <= 'f')
+    return 10 + (c - 'a');
+  else if (c >= 'A' and c <= 'F')
+    return 10 + (c - 'A');
+  else
+    return -1;
+}
+
+
+/// Decode hex-escaped `text`, one nibble at a time.
+/** This is how libpqxx did it before vectorising the conversion.
+ */
+void unesc_nibblewise(std::string_view text, std::span<std::byte> buffer)
+{
+  std::size_t out{0u};
+  for (std::size_t in{2u}; in < std::size(text); in += 2)
+  {
+    int const hi{nibble(text[in])}, lo{nibble(text[in + 1])};
+    if ((hi < 0) or (lo < 0))
+      throw fail{"Invalid hex-escaped data."};
+    buffer[out++] = static_cast<std::byte>((hi << 4) | lo);
+  }
+}
+
+
+/// Run `func` `rounds` times, and print the throughput.
+/** The throughput is in terms of binary data, in both directions.
+ */
+template<typename FUNC>
+void time_run(
+  std::string_view name, std::size_t bytes, std::size_t rounds, FUNC func)
+{
+  using timer = std::chrono::steady_clock;
+
+  auto const start{timer::now()};
+  for (std::size_t round{0}; round < rounds; ++round) func();
+  auto const finish{timer::now()};
+  auto const seconds{
+    std::chrono::duration_cast<std::chrono::duration<double, std::ratio<1>>>(
+      finish - start)};
+  auto const megabytes{
+    static_cast<double>(bytes * rounds) / (1024.0 * 1024.0)};
+
+  std::cerr << std::format(
+    "{}: {:.3f}s ({:.0f} MiB/s)\n", name, seconds.count(),
+    megabytes / seconds.count());
+}
+
+
+void run_and_compare(options const &opts)
+{
+  auto const data{make_data(opts)};
+  auto const loc{pqxx::sl::current()};
+  std::string nibblewise, fast;
+  nibblewise.resize(pqxx::internal::size_esc_bin(opts.size));
+  fast.resize(pqxx::internal::size_esc_bin(opts.size));
+
+  time_run("encode-nibblewise", opts.size, opts.rounds, [&] {
+    esc_nibblewise(data, nibblewise);
+  });
+  time_run("encode-pqxx", opts.size, opts.rounds, [&] {
+    pqxx::internal::esc_bin(data, fast);
+  });
+  if (fast != nibblewise)
+    throw fail{"Inconsistent results from hex encoding."};
+
+  // Strip the terminating zero.
+  auto const text{std::string_view{fast}.substr(0, std::size(fast) - 1)};
+  pqxx::bytes decoded_nibblewise(opts.size), decoded_fast(opts.size);
+  time_run("decode-nibblewise", opts.size, opts.rounds, [&] {
+    unesc_nibblewise(text, decoded_nibblewise);
+  });
+  time_run("decode-pqxx", opts.size, opts.rounds, [&] {
+    pqxx::internal::unesc_bin(text, decoded_fast, loc);
+  });
+  if ((decoded_fast != data) or (decoded_nibblewise != data))
+    throw fail{"Inconsistent results from hex decoding."};
+}
+
+
+constexpr auto help_output =
+  R"xx(Bytea hex conversion benchmark for libpqxx.
+
+Times how fast libpqxx can convert binary data to and from the hex escape
+format that PostgreSQL uses for bytea values.
+
+Options:
+  --help or -h
+      Show this explanation, and exit.
+  --rounds <R> or -r <R>
+      Convert the data <R> times.
+  --size <S> or -s <S>
+      Convert <S> bytes of binary data.
+)xx";
+
+
+[[noreturn]] void exit_with_help()
+{
+  std::cout << help_output;
+  throw early_exit{};
+}
+
+
+/// Options that take an argument.
+enum class arg_opts
+{
+  none,
+  rounds,
+  size
+};
+
+
+options parse_opts(char *argv[])
+{
+  options opts;
+
+  arg_opts want = arg_opts::none;
+  for (std::size_t i{1}; argv[i]; ++i)
+  {
+    std::string_view const arg{argv[i]};
+    if (want == arg_opts::none)
+    {
+      if ((arg == "--help") or (arg == "-h"))
+        exit_with_help();
+      else if ((arg == "--rounds") or (arg == "-r"))
+        want = arg_opts::rounds;
+      else if ((arg == "--size") or (arg == "-s"))
+        want = arg_opts::size;
+      else
+        throw fail{std::format("Unexpected argument: '{}'.", arg)};
+    }
+    else
+    {
+      auto const value{pqxx::from_string<std::size_t>(arg)};
+      switch (want)
+      {
+      case arg_opts::rounds: opts.rounds = value; break;
+      case arg_opts::size: opts.size = value; break;
+      case arg_opts::none: PQXX_UNREACHABLE;
+      }
+      want = arg_opts::none;
+    }
+  }
+
+  if (want != arg_opts::none)
+    throw fail{"Last option is missing an argument."};
+
+  return opts;
+}
+} // namespace
+
+
+int main(int, char *argv[])
+{
+  try
+  {
+    run_and_compare(parse_opts(argv));
+  }
+  catch (early_exit const &)
+  {
+    return 0;
+  }
+  catch (fail const &err)
+  {
+    std::cerr << err.what() << '\n';
+    return 1;
+  }
+  catch (std::exception const &err)
+  {
+    std::cerr << err.what() << '\n';
+    return 2;
+  }
+  return 0;
+}
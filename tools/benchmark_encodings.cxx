@@ -0,0 +1,295 @@
+// Microbenchmarks for libpqxx's encoding-aware text search.
+/** This tool times how fast libpqxx can scan text for special ASCII
+ * characters, in each of the encoding groups it supports.  This search is at
+ * the heart of parsing arrays, composite values, and `COPY` data.
+ *
+ * For each encoding group it compares:
+ *
+ * 1. a plain search that walks the text one character at a time,
+ * 2. the search function that libpqxx actually uses.
+ *
+ * It needs no database.  Use the "--help" (or "-h") option for instructions.
+ */
+#include <pqxx/pqxx>
+
+#include <pqxx/internal/encodings.hxx>
+
+#include <chrono>
+#include <format>
+#include <iostream>
+
+namespace
+{
+using namespace std::literals;
+
+
+/// Fatal but well-handled error.
+struct fail final : std::runtime_error
+{
+  explicit fail(std::string const &whatarg) : std::runtime_error{whatarg} {}
+};
+
+
+/// Early successful exit.
+struct early_exit final : std::exception
+{};
+
+
+struct options
+{
+  /// Size of the text to scan, in bytes.
+  std::size_t size = 1024u * 1024u;
+
+  /// Number of times to scan the text.
+  std::size_t rounds = 100u;
+
+  /// Average number of bytes between special characters.
+  std::size_t field = 24u;
+};
+
+
+/// Sample text in each encoding group.
+/** The non-ASCII texts contain multibyte characters which happen to contain
+ * bytes with the same values as the characters we search for.
+ */
+template<pqxx::encoding_group ENC> std::string_view const sample;
+
+/// Big5: Traditional Chinese, with '\' as a trail byte in "\xa5\x5c".
+template<>
+auto const sample<pqxx::encoding_group::two_tier>{
+  "\xa7\xda\xaa\xba\xae\xf0\xb9\xd4\xa5\x5c\xb2\xee"sv};
+/// ASCII-safe: UTF-8, mixing ASCII and multibyte characters.
+template<>
+auto const sample<pqxx::encoding_group::ascii_safe>{
+  "Gr\xc3\xbc\xc3\x9f Gott, \xe2\x82\xac 10"sv};
+/// GB18030: Simplified Chinese, with '\' as a trail byte in "\x81\x5c".
+template<>
+auto const sample<pqxx::encoding_group::gb18030>{
+  "\xce\xd2\xb5\xc4\x81\x5c\xc6\xf8\xb5\xe6"sv};
+/// SJIS: Japanese, with '\' as a trail byte in "\x83\x5c".
+template<>
+auto const sample<pqxx::encoding_group::sjis>{
+  "\x8e\x84\x82\xcc\x83\x5c\x83\x7a\xb1\xb2"sv};
+
+
+/// Compose a text in `ENC`: fields of sample text, separated by tabs.
+/** Every field starts with some plain ASCII, since that is what most real-life
+ * data looks like.
+ */
+template<pqxx::encoding_group ENC> std::string make_text(options const &opts)
+{
+  std::string text;
+  text.reserve(opts.size + opts.field + std::size(sample<ENC>));
+  std::size_t next_tab{opts.field};
+  while (std::size(text) < opts.size)
+  {
+    text += "id 12345 ";
+    text += sample<ENC>;
+    if (std::size(text) >= next_tab)
+    {
+      text.push_back('\t');
+      next_tab = std::size(text) + opts.field;
+    }
+  }
+  return text;
+}
+
+
+/// Find a tab or backslash by walking through `text` glyph by glyph.
+/** This is how libpqxx did it before vectorising the search.
+ */
+template<pqxx::encoding_group ENC>
+std::size_t
+find_glyphwise(std::string_view text, std::size_t here, pqxx::sl loc)
+{
+  auto const sz{std::size(text)};
+  while (here < sz)
+  {
+    if ((text[here] == '\t') or (text[here] == '\\'))
+      return here;
+    here = pqxx::internal::glyph_scanner<ENC>::call(text, here, loc);
+  }
+  return sz;
+}
+
+
+/// Scan `text` with `find` for all its tabs & backslashes, `rounds` times.
+/** Returns the number of hits, as a check that the searches agree.
+ */
+std::size_t scan(
+  pqxx::internal::char_finder_func *find, std::string_view text,
+  std::size_t rounds)
+{
+  auto const loc{pqxx::sl::current()};
+  auto const sz{std::size(text)};
+  std::size_t hits{0};
+  for (std::size_t round{0}; round < rounds; ++round)
+    for (auto here{find(text, 0, loc)}; here < sz;
+         here = find(text, here + 1, loc))
+      ++hits;
+  return hits;
+}
+
+
+/// Time a scan, print the throughput, and return the number of hits.
+std::size_t time_scan(
+  std::string_view name, pqxx::internal::char_finder_func *find,
+  std::string_view text, std::size_t rounds)
+{
+  using timer = std::chrono::steady_clock;
+
+  auto const start{timer::now()};
+  auto const hits{scan(find, text, rounds)};
+  auto const finish{timer::now()};
+  auto const seconds{
+    std::chrono::duration_cast<std::chrono::duration<double, std::ratio<1>>>(
+      finish - start)};
+  auto const megabytes{
+    static_cast<double>(std::size(text) * rounds) / (1024.0 * 1024.0)};
+
+  std::cerr << std::format(
+    "{}: {:.3f}s ({:.0f} MiB/s)\n", name, seconds.count(),
+    megabytes / seconds.count());
+  return hits;
+}
+
+
+/// Benchmark searches in encoding group `ENC`.
+template<pqxx::encoding_group ENC>
+void run_and_compare(std::string_view enc_name, options const &opts)
+{
+  auto const text{make_text<ENC>(opts)};
+  auto const loc{pqxx::sl::current()};
+
+  auto const glyphwise{time_scan(
+    std::format("{}-glyphwise", enc_name), find_glyphwise<ENC>, text,
+    opts.rounds)};
+  auto const pqxx_find{time_scan(
+    std::format("{}-pqxx", enc_name),
+    pqxx::internal::get_char_finder<'\t', '\\'>(ENC, loc), text,
+    opts.rounds)};
+  if (pqxx_find != glyphwise)
+    throw fail{std::format(
+      "Inconsistent search results for {}: glyphwise search found {}, "
+      "libpqxx search found {}.",
+      enc_name, glyphwise, pqxx_find)};
+
+  if constexpr (ENC == pqxx::encoding_group::ascii_safe)
+  {
+    // This is the one that stream_from and stream_query use.
+    auto const stream_find{time_scan(
+      std::format("{}-stream", enc_name),
+      pqxx::internal::get_tab_or_backslash_finder(), text, opts.rounds)};
+    if (stream_find != glyphwise)
+      throw fail{std::format(
+        "Inconsistent search results for {}: glyphwise search found {}, "
+        "stream search found {}.",
+        enc_name, glyphwise, stream_find)};
+  }
+}
+
+
+constexpr auto help_output =
+  R"xx(Text search benchmark for libpqxx.
+
+Times how fast libpqxx can find special ASCII characters in text, in each of
+the encoding groups it supports.
+
+Options:
+  --field <F> or -f <F>
+      Put a tab roughly every <F> bytes.
+  --help or -h
+      Show this explanation, and exit.
+  --rounds <R> or -r <R>
+      Scan the text <R> times.
+  --size <S> or -s <S>
+      Scan a text of <S> bytes.
+)xx";
+
+
+[[noreturn]] void exit_with_help()
+{
+  std::cout << help_output;
+  throw early_exit{};
+}
+
+
+/// Options that take an argument.
+enum class arg_opts
+{
+  none,
+  field,
+  rounds,
+  size
+};
+
+
+options parse_opts(char *argv[])
+{
+  options opts;
+
+  arg_opts want = arg_opts::none;
+  for (std::size_t i{1}; argv[i]; ++i)
+  {
+    std::string_view const arg{argv[i]};
+    if (want == arg_opts::none)
+    {
+      if ((arg == "--field") or (arg == "-f"))
+        want = arg_opts::field;
+      else if ((arg == "--help") or (arg == "-h"))
+        exit_with_help();
+      else if ((arg == "--rounds") or (arg == "-r"))
+        want = arg_opts::rounds;
+      else if ((arg == "--size") or (arg == "-s"))
+        want = arg_opts::size;
+      else
+        throw fail{std::format("Unexpected argument: '{}'.", arg)};
+    }
+    else
+    {
+      auto const value{pqxx::from_string<std::size_t>(arg)};
+      switch (want)
+      {
+      case arg_opts::field: opts.field = value; break;
+      case arg_opts::rounds: opts.rounds = value; break;
+      case arg_opts::size: opts.size = value; break;
+      case arg_opts::none: PQXX_UNREACHABLE;
+      }
+      want = arg_opts::none;
+    }
+  }
+
+  if (want != arg_opts::none)
+    throw fail{"Last option is missing an argument."};
+
+  return opts;
+}
+} // namespace
+
+
+int main(int, char *argv[])
+{
+  try
+  {
+    options const opts{parse_opts(argv)};
+    run_and_compare<pqxx::encoding_group::ascii_safe>("ascii_safe", opts);
+    run_and_compare<pqxx::encoding_group::two_tier>("two_tier", opts);
+    run_and_compare<pqxx::encoding_group::gb18030>("gb18030", opts);
+    run_and_compare<pqxx::encoding_group::sjis>("sjis", opts);
+  }
+  catch (early_exit const &)
+  {
+    return 0;
+  }
+  catch (fail const &err)
+  {
+    std::cerr << err.what() << '\n';
+    return 1;
+  }
+  catch (std::exception const &err)
+  {
+    std::cerr << err.what() << '\n';
+    return 2;
+  }
+  return 0;
+}
@@ -0,0 +1,122 @@
+#! /usr/bin/env python3
+"""Generate the table of powers of 5 for floating-point conversions.
+
+Writes `src/float-tables.hxx`.  The table holds 5^q for each q in a range,
+normalised so that its most significant bit is bit 127 of a 128-bit number,
+and rounded down.  Because 10^q is 5^q * 2^q, these are also the normalised
+powers of 10.
+
+The parser (Eisel-Lemire) and the formatter (Schubfach) both derive the
+values they need from this one table.  This script checks that they can.
+"""
+
+from argparse import ArgumentParser
+from pathlib import Path
+
+
+# Range of powers.  The parser needs [-342, 308]; the formatter needs
+# [-292, 326].
+POW_MIN = -342
+POW_MAX = 326
+
+
+def normalised(q: int) -> int:
+    """Return 5^q, normalised to [2^127, 2^128), rounded down."""
+    if q >= 0:
+        power = 5**q
+        bits = power.bit_length()
+        if bits <= 128:
+            return power << (128 - bits)
+        return power >> (bits - 128)
+    power = 5**-q
+    z = power.bit_length()
+    return 2 ** (z + 127) // power
+
+
+def eisel_lemire_entry(q: int) -> int:
+    """Return the table entry that the Eisel-Lemire algorithm expects.
+
+    This follows the original generator for the algorithm: for negative
+    powers it rounds up, and truncates to 128 bits afterwards.
+    """
+    if q >= 0:
+        return normalised(q)
+    power = 5**-q
+    z = power.bit_length()
+    if q >= -27:
+        return 2 ** (z + 127) // power + 1
+    value = 2 ** (2 * z + 128) // power + 1
+    return value >> (value.bit_length() - 128)
+
+
+def check() -> None:
+    """Check that the parser can derive its entries from ours."""
+    for q in range(POW_MIN, 309):
+        adjust = 1 if -27 <= q < 0 else 0
+        assert eisel_lemire_entry(q) == normalised(q) + adjust, q
+
+
+def generate() -> str:
+    """Return the contents of the table header."""
+    lines = [
+        "/* Table of powers of 5, for floating-point conversions.",
+        " *",
+        " * Generated by tools/generate_float_tables.py.  Do not edit.",
+        " *",
+        " * Copyright (c) 2000-2026, Jeroen T. Vermeulen.",
+        " *",
+        " * See COPYING for copyright license.  If you did not receive a "
+        "file called",
+        " * COPYING with this source code, please notify the distributor "
+        "of this",
+        " * mistake, or contact the author.",
+        " */",
+        "#ifndef PQXX_FLOAT_TABLES_HXX",
+        "#define PQXX_FLOAT_TABLES_HXX",
+        "",
+        "#include <array>",
+        "#include <cstdint>",
+        "",
+        "namespace pqxx::internal",
+        "{",
+        "/// Lowest power of 5 in @ref pow5_128.",
+        f"inline constexpr int pow5_min{{{POW_MIN}}};",
+        "/// Highest power of 5 in @ref pow5_128.",
+        f"inline constexpr int pow5_max{{{POW_MAX}}};",
+        "",
+        "/// Powers of 5, normalised to 128 bits and rounded down.",
+        "/** Each power takes two entries: the high 64 bits, then the low 64.",
+        " */",
+        "inline constexpr std::array<std::uint64_t, "
+        "2 * (pow5_max - pow5_min + 1)>",
+        "  pow5_128{",
+    ]
+    mask = (1 << 64) - 1
+    for q in range(POW_MIN, POW_MAX + 1):
+        value = normalised(q)
+        sep = "," if q < POW_MAX else ""
+        lines.append(
+            f"    0x{value >> 64:016x}u, 0x{value & mask:016x}u{sep} "
+            f"// 5^{q}"
+        )
+    lines += ["  };", "} // namespace pqxx::internal", "#endif", ""]
+    return "\n".join(lines)
+
+
+def main() -> None:
+    """Main entry point."""
+    parser = ArgumentParser(description=__doc__)
+    parser.add_argument(
+        "--output",
+        "-o",
+        type=Path,
+        default=Path(__file__).parent.parent / "src" / "float-tables.hxx",
+        help="Output file.  Defaults to src/float-tables.hxx.",
+    )
+    args = parser.parse_args()
+    check()
+    args.output.write_text(generate(), encoding="ascii")
+
+
+if __name__ == "__main__":
+    main()